@@ -1,47 +1,30 @@
-QT += core widgets serialport charts
+# 顶层工程：先编译 nmeacore 静态库，再编译图形界面、命令行工具、数据生成器和串口浸泡测试
+TEMPLATE = subdirs
 
-CONFIG += c++17
+SUBDIRS += \
+    core \
+    app \
+    cli \
+    generator
 
-TARGET = AI-serial-NEMA
-TEMPLATE = app
+core.file = core/nmeacore.pro
 
-# 源文件
-SOURCES += \
-    main.cpp \
-    mainwindow.cpp \
-    serialmanager.cpp \
-    nmeaparser.cpp \
-    chartmanager.cpp
+app.file = satellite_app.pro
+app.depends = core
 
-# 头文件
-HEADERS += \
-    mainwindow.h \
-    serialmanager.h \
-    nmeaparser.h \
-    chartmanager.h \
-    gnssdata.h
+cli.file = cli/nmea-inspect.pro
+cli.depends = core
 
-# UI文件
-FORMS += \
-    mainwindow.ui
+generator.file = generator/nmea-generate.pro
+generator.depends = core
 
-# 资源文件
-RESOURCES += resources.qrc
+# 单元测试（make check）
+SUBDIRS += tests
+tests.depends = core
 
-# 编译配置
-CONFIG += debug_and_release
-CONFIG(debug, debug|release) {
-    DESTDIR = debug
-    OBJECTS_DIR = debug/obj
-    MOC_DIR = debug/moc
-    RCC_DIR = debug/rcc
-    UI_DIR = debug/ui
-}
-
-CONFIG(release, debug|release) {
-    DESTDIR = release
-    OBJECTS_DIR = release/obj
-    MOC_DIR = release/moc
-    RCC_DIR = release/rcc
-    UI_DIR = release/ui
+# 浸泡测试依赖伪终端，只在 Linux/Unix 上编译
+unix {
+    SUBDIRS += soak
+    soak.file = soak/nmea-soak.pro
+    soak.depends = core
 }
@@ -0,0 +1,271 @@
+#include "accuracystats.h"
+#include <QtMath>
+#include <algorithm>
+
+// 所有定位的汇总分组
+static const int kAllFixes = -1;
+
+P2Quantile::P2Quantile(double quantile)
+    : m_quantile(quantile)
+    , m_count(0)
+{
+    for (int i = 0; i < 5; ++i) {
+        m_heights[i] = 0.0;
+        m_positions[i] = i + 1;
+    }
+    m_desired[0] = 1.0;
+    m_desired[1] = 1.0 + 2.0 * quantile;
+    m_desired[2] = 1.0 + 4.0 * quantile;
+    m_desired[3] = 3.0 + 2.0 * quantile;
+    m_desired[4] = 5.0;
+    m_increments[0] = 0.0;
+    m_increments[1] = quantile / 2.0;
+    m_increments[2] = quantile;
+    m_increments[3] = (1.0 + quantile) / 2.0;
+    m_increments[4] = 1.0;
+}
+
+void P2Quantile::add(double value)
+{
+    // 前 5 个样本直接保存并排序
+    if (m_count < 5) {
+        m_heights[m_count++] = value;
+        if (m_count == 5) {
+            std::sort(m_heights, m_heights + 5);
+        }
+        return;
+    }
+    ++m_count;
+
+    // 找到样本所在的区间，必要时更新两端的极值
+    int cell;
+    if (value < m_heights[0]) {
+        m_heights[0] = value;
+        cell = 0;
+    } else if (value >= m_heights[4]) {
+        m_heights[4] = qMax(m_heights[4], value);
+        cell = 3;
+    } else {
+        cell = 0;
+        while (cell < 3 && value >= m_heights[cell + 1]) {
+            ++cell;
+        }
+    }
+
+    for (int i = cell + 1; i < 5; ++i) {
+        m_positions[i] += 1.0;
+    }
+    for (int i = 0; i < 5; ++i) {
+        m_desired[i] += m_increments[i];
+    }
+
+    // 调整中间三个标记的高度（抛物线插值，越界时退化为线性插值）
+    for (int i = 1; i <= 3; ++i) {
+        const double offset = m_desired[i] - m_positions[i];
+        if ((offset >= 1.0 && m_positions[i + 1] - m_positions[i] > 1.0)
+            || (offset <= -1.0 && m_positions[i - 1] - m_positions[i] < -1.0)) {
+            const double sign = offset >= 0.0 ? 1.0 : -1.0;
+            const double parabolic = m_heights[i] + sign / (m_positions[i + 1] - m_positions[i - 1])
+                * ((m_positions[i] - m_positions[i - 1] + sign) * (m_heights[i + 1] - m_heights[i])
+                       / (m_positions[i + 1] - m_positions[i])
+                   + (m_positions[i + 1] - m_positions[i] - sign) * (m_heights[i] - m_heights[i - 1])
+                       / (m_positions[i] - m_positions[i - 1]));
+            if (m_heights[i - 1] < parabolic && parabolic < m_heights[i + 1]) {
+                m_heights[i] = parabolic;
+            } else {
+                const int j = i + int(sign);
+                m_heights[i] += sign * (m_heights[j] - m_heights[i]) / (m_positions[j] - m_positions[i]);
+            }
+            m_positions[i] += sign;
+        }
+    }
+}
+
+double P2Quantile::value() const
+{
+    if (m_count == 0) {
+        return 0.0;
+    }
+    if (m_count < 5) {
+        // 样本太少时直接取排序后的最近秩
+        double sorted[5];
+        std::copy(m_heights, m_heights + m_count, sorted);
+        std::sort(sorted, sorted + m_count);
+        const int index = qBound(0, int(qCeil(m_quantile * m_count)) - 1, int(m_count) - 1);
+        return sorted[index];
+    }
+    return m_heights[2];
+}
+
+AccuracyStatistics::Group::Group()
+    : count(0)
+    , sumSquaredHorizontal(0.0)
+    , horizontal50(0.50)
+    , horizontal95(0.95)
+    , vertical95(0.95)
+    , passCount(0)
+    , passHorizontal50(0.50)
+    , passHorizontal95(0.95)
+    , passVertical95(0.95)
+{
+    for (int i = 0; i < 3; ++i) {
+        mean[i] = 0.0;
+        m2[i] = 0.0;
+    }
+}
+
+void AccuracyStatistics::Group::add(double east, double north, double up, bool relativeToReference)
+{
+    // Welford 增量更新
+    ++count;
+    const double values[3] = {east, north, up};
+    for (int i = 0; i < 3; ++i) {
+        const double delta = values[i] - mean[i];
+        mean[i] += delta / double(count);
+        m2[i] += delta * (values[i] - mean[i]);
+    }
+
+    // 误差：相对参考点，或相对当前的平均位置
+    const double errorEast = relativeToReference ? east : east - mean[0];
+    const double errorNorth = relativeToReference ? north : north - mean[1];
+    const double errorUp = relativeToReference ? up : up - mean[2];
+    const double horizontal2 = errorEast * errorEast + errorNorth * errorNorth;
+
+    sumSquaredHorizontal += horizontal2;
+    horizontal50.add(qSqrt(horizontal2));
+    horizontal95.add(qSqrt(horizontal2));
+    vertical95.add(qAbs(errorUp));
+}
+
+void AccuracyStatistics::Group::addPass(double east, double north, double up)
+{
+    const double errorEast = east - mean[0];
+    const double errorNorth = north - mean[1];
+    const double horizontal = qSqrt(errorEast * errorEast + errorNorth * errorNorth);
+    passHorizontal50.add(horizontal);
+    passHorizontal95.add(horizontal);
+    passVertical95.add(qAbs(up - mean[2]));
+}
+
+AccuracyStatistics::AccuracyStatistics()
+    : m_hasReference(false)
+{
+}
+
+void AccuracyStatistics::setReference(double latitude, double longitude, double altitude)
+{
+    m_hasReference = true;
+    m_frame.setOrigin(latitude, longitude, altitude);
+    m_groups.clear();
+}
+
+void AccuracyStatistics::clearReference()
+{
+    m_hasReference = false;
+    m_frame.reset();
+    m_groups.clear();
+}
+
+void AccuracyStatistics::clear()
+{
+    // 参考点保留，平均位置模式下的原点随数据重新确定
+    if (!m_hasReference) {
+        m_frame.reset();
+    }
+    m_groups.clear();
+}
+
+void AccuracyStatistics::addFix(double latitude, double longitude, double altitude, int fixQuality)
+{
+    if (!m_frame.isValid()) {
+        m_frame.setOrigin(latitude, longitude, altitude);
+    }
+
+    double east, north, up;
+    m_frame.toEnu(latitude, longitude, altitude, east, north, up);
+    m_groups[fixQuality].add(east, north, up, m_hasReference);
+    m_groups[kAllFixes].add(east, north, up, m_hasReference);
+}
+
+void AccuracyStatistics::addEpoch(const SatelliteData &data)
+{
+    // 只统计有效定位
+    if (data.fixQuality <= 0 || (data.latitude == 0.0 && data.longitude == 0.0)) {
+        return;
+    }
+    addFix(data.latitude, data.longitude, data.altitude, data.fixQuality);
+}
+
+bool AccuracyStatistics::needsMeanPass() const
+{
+    if (m_hasReference) {
+        return false;
+    }
+    for (const Group &group : m_groups) {
+        if (group.count != group.passCount) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AccuracyStatistics::beginMeanPass()
+{
+    for (Group &group : m_groups) {
+        group.passCount = group.count;
+        group.passHorizontal50 = P2Quantile(0.50);
+        group.passHorizontal95 = P2Quantile(0.95);
+        group.passVertical95 = P2Quantile(0.95);
+    }
+}
+
+void AccuracyStatistics::addMeanPassFix(double latitude, double longitude, double altitude, int fixQuality)
+{
+    if (m_hasReference || !m_frame.isValid()) {
+        return;
+    }
+
+    // 只加入已有的分组，第二遍期间平均位置不变
+    double east, north, up;
+    m_frame.toEnu(latitude, longitude, altitude, east, north, up);
+    auto it = m_groups.find(fixQuality);
+    if (it != m_groups.end()) {
+        it->addPass(east, north, up);
+    }
+    it = m_groups.find(kAllFixes);
+    if (it != m_groups.end()) {
+        it->addPass(east, north, up);
+    }
+}
+
+AccuracyResult AccuracyStatistics::result(int fixQuality) const
+{
+    AccuracyResult result;
+    auto it = m_groups.constFind(fixQuality);
+    if (it == m_groups.constEnd() || it->count == 0) {
+        return result;
+    }
+
+    const Group &group = it.value();
+    const double denominator = group.count > 1 ? double(group.count - 1) : 1.0;
+    result.count = group.count;
+    result.meanEast = group.mean[0];
+    result.meanNorth = group.mean[1];
+    result.meanUp = group.mean[2];
+    result.sigmaEast = qSqrt(group.m2[0] / denominator);
+    result.sigmaNorth = qSqrt(group.m2[1] / denominator);
+    result.sigmaUp = qSqrt(group.m2[2] / denominator);
+    // 平均位置模式有第二遍结果时用第二遍（之后新加入的定位要等下一遍）
+    const bool pass = !m_hasReference && group.passHorizontal50.count() > 0;
+    result.cep50 = pass ? group.passHorizontal50.value() : group.horizontal50.value();
+    result.cep95 = pass ? group.passHorizontal95.value() : group.horizontal95.value();
+    result.vertical95 = pass ? group.passVertical95.value() : group.vertical95.value();
+
+    // 相对参考点用均方根；相对平均位置直接由方差得到
+    if (m_hasReference) {
+        result.drms2 = 2.0 * qSqrt(group.sumSquaredHorizontal / double(group.count));
+    } else {
+        result.drms2 = 2.0 * qSqrt(result.sigmaEast * result.sigmaEast + result.sigmaNorth * result.sigmaNorth);
+    }
+    return result;
+}
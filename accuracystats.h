@@ -0,0 +1,106 @@
+#ifndef ACCURACYSTATS_H
+#define ACCURACYSTATS_H
+
+#include <QMap>
+#include <QList>
+#include "satellitedata.h"
+#include "localframe.h"
+
+// P² 流式分位数估计（Jain & Chlamtac），固定 5 个标记，每个样本 O(1)，内存固定
+class P2Quantile
+{
+public:
+    explicit P2Quantile(double quantile = 0.5);
+
+    void add(double value);
+    double value() const;
+    quint64 count() const { return m_count; }
+
+private:
+    double m_quantile;
+    quint64 m_count;
+    double m_heights[5];
+    double m_positions[5];
+    double m_desired[5];
+    double m_increments[5];
+};
+
+// 静态测试的定位精度统计结果（单位：米）
+struct AccuracyResult {
+    quint64 count;
+    double meanEast;
+    double meanNorth;
+    double meanUp;
+    double sigmaEast;
+    double sigmaNorth;
+    double sigmaUp;
+    double cep50;              // 水平误差 50% 分位
+    double cep95;              // 水平误差 95% 分位
+    double drms2;              // 2DRMS
+    double vertical95;         // 垂直误差绝对值 95% 分位
+
+    AccuracyResult() : count(0), meanEast(0), meanNorth(0), meanUp(0),
+                       sigmaEast(0), sigmaNorth(0), sigmaUp(0),
+                       cep50(0), cep95(0), drms2(0), vertical95(0) {}
+};
+
+// 在线定位精度统计。
+// 每个 GGA 定位结果先转换到参考点的局部 ENU 坐标（LocalFrame 预先计算参考点的曲率半径，
+// 单个定位点不再做三角运算），再按定位质量（单点/差分/RTK浮点/RTK固定...）分组，
+// 累计 Welford 均值方差和 P² 分位数。每个定位 O(1)，内存与会话长度无关。
+//
+// 设置了参考点时误差相对参考点；否则以第一个定位点为坐标原点，误差相对平均位置：
+// 标准差和 2DRMS 由方差得到，本来就相对最终的平均位置；CEP 和垂直分位数需要第二遍，
+// 调用者用 beginMeanPass() + addMeanPassFix() 把同样的定位（通常来自 EpochHistory）再送一遍。
+// 还没有第二遍结果时，分位数是相对运行中平均位置的估计（早期定位的误差偏大）。
+class AccuracyStatistics
+{
+public:
+    AccuracyStatistics();
+
+    void setReference(double latitude, double longitude, double altitude);
+    void clearReference();
+    bool hasReference() const { return m_hasReference; }
+
+    void clear();
+    void addFix(double latitude, double longitude, double altitude, int fixQuality);
+    void addEpoch(const SatelliteData &data);
+
+    // 平均位置模式的第二遍：分位数相对当前的平均位置重新统计
+    bool needsMeanPass() const;
+    void beginMeanPass();
+    void addMeanPassFix(double latitude, double longitude, double altitude, int fixQuality);
+
+    // 按定位质量分组的结果，-1 为所有定位
+    QList<int> fixQualities() const { return m_groups.keys(); }
+    AccuracyResult result(int fixQuality) const;
+
+private:
+    struct Group {
+        quint64 count;
+        double mean[3];
+        double m2[3];
+        double sumSquaredHorizontal;   // 相对参考点的水平误差平方和
+        P2Quantile horizontal50;
+        P2Quantile horizontal95;
+        P2Quantile vertical95;
+
+        // 第二遍：相对第二遍开始时的平均位置，passCount 为那时的定位数
+        quint64 passCount;
+        P2Quantile passHorizontal50;
+        P2Quantile passHorizontal95;
+        P2Quantile passVertical95;
+
+        Group();
+        void add(double east, double north, double up, bool relativeToReference);
+        void addPass(double east, double north, double up);
+    };
+
+    // 坐标原点：参考点或第一个定位点
+    bool m_hasReference;
+    LocalFrame m_frame;
+
+    QMap<int, Group> m_groups;
+};
+
+#endif // ACCURACYSTATS_H
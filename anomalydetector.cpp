@@ -0,0 +1,396 @@
+#include "anomalydetector.h"
+#include "localframe.h"
+#include <QHash>
+#include <QPair>
+#include <QTime>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QtMath>
+
+static const qint64 kDayMs = 24 * 3600 * 1000;
+
+QString AnomalyEvent::typeName(Type type)
+{
+    switch (type) {
+    case PositionJump: return "位置跳变";
+    case FixDegraded: return "定位质量下降";
+    case SignalDrop: return "信噪比整体下降";
+    case TimeGap: return "时间不连续";
+    case ChecksumBurst: return "校验和错误";
+    default: return "未知";
+    }
+}
+
+QString AnomalyEvent::formatTime(qint64 timeMs)
+{
+    if (timeMs >= kDayMs) {
+        return QDateTime::fromMSecsSinceEpoch(timeMs, Qt::UTC).toString("yyyy-MM-dd hh:mm:ss");
+    }
+    return QTime::fromMSecsSinceStartOfDay(int(timeMs)).toString("hh:mm:ss");
+}
+
+QString AnomalyEvent::description() const
+{
+    QString detail;
+    switch (type) {
+    case PositionJump:
+        detail = QString("跳变 %1 m").arg(value, 0, 'f', 1);
+        break;
+    case FixDegraded:
+        detail = QString("降为 %1").arg(int(value));
+        break;
+    case SignalDrop:
+        detail = QString("平均下降 %1 dB").arg(value, 0, 'f', 1);
+        break;
+    case TimeGap:
+        detail = value <= 0.0 ? QString("时间倒退 %1 s").arg(-value, 0, 'f', 3)
+                              : QString("间隔 %1 s").arg(value, 0, 'f', 3);
+        break;
+    case ChecksumBurst:
+        detail = QString("最近窗口内 %1 条").arg(int(value));
+        break;
+    default:
+        break;
+    }
+    return QString("%1 UTC  %2: %3").arg(formatTime(timeMs), typeName(type), detail);
+}
+
+static bool hasFix(const SatelliteData &data)
+{
+    return data.fixQuality > 0 && (data.latitude != 0.0 || data.longitude != 0.0);
+}
+
+// 位置跳变：相邻定位的位移扣除速度推算的位移后，超过近期残差水平的若干倍
+class PositionJumpDetector : public AnomalyDetector
+{
+public:
+    PositionJumpDetector() { reset(); }
+
+    void reset() override
+    {
+        m_frame.reset();
+        m_hasPrevious = false;
+        m_residualLevel = 0.0;
+        m_samples = 0;
+    }
+
+    void process(const SatelliteData &data, QVector<AnomalyEvent> &events) override
+    {
+        if (!hasFix(data)) {
+            return;
+        }
+        if (!m_frame.isValid()) {
+            m_frame.setOrigin(data.latitude, data.longitude, data.altitude);
+        }
+
+        double east = 0.0, north = 0.0, up = 0.0;
+        m_frame.toEnu(data.latitude, data.longitude, data.altitude, east, north, up);
+
+        if (m_hasPrevious) {
+            const double dt = (data.utcTimeMs - m_previousTimeMs) / 1000.0;
+            // 时间异常或长时间中断由时间检测器报告，这里只比较相邻历元
+            if (dt > 0.0 && dt <= kMaxInterval) {
+                const double step = qSqrt((east - m_previousEast) * (east - m_previousEast)
+                                          + (north - m_previousNorth) * (north - m_previousNorth));
+                const double residual = qAbs(step - data.speed * dt);
+                const double threshold = qMax(kMinJump, kJumpFactor * m_residualLevel);
+                if (m_samples >= kWarmupSamples && residual > threshold) {
+                    events.append(AnomalyEvent(data.utcTimeMs, AnomalyEvent::PositionJump, step));
+                }
+                // 残差水平用限幅后的值更新，避免一次跳变抬高门限
+                m_residualLevel += kAlpha * (qMin(residual, threshold) - m_residualLevel);
+                ++m_samples;
+            }
+        }
+
+        m_previousEast = east;
+        m_previousNorth = north;
+        m_previousTimeMs = data.utcTimeMs;
+        m_hasPrevious = true;
+    }
+
+private:
+    static constexpr double kMinJump = 10.0;        // 米
+    static constexpr double kJumpFactor = 8.0;
+    static constexpr double kAlpha = 0.05;
+    static constexpr double kMaxInterval = 10.0;    // 秒
+    static constexpr int kWarmupSamples = 5;
+
+    LocalFrame m_frame;
+    bool m_hasPrevious;
+    double m_previousEast;
+    double m_previousNorth;
+    qint64 m_previousTimeMs;
+    double m_residualLevel;
+    int m_samples;
+};
+
+// 定位质量下降：按 RTK固定 > RTK浮点 > 差分 > 单点 > 无定位 排序，等级降低时报告
+class FixDegradedDetector : public AnomalyDetector
+{
+public:
+    FixDegradedDetector() { reset(); }
+
+    void reset() override { m_previousRank = -1; }
+
+    void process(const SatelliteData &data, QVector<AnomalyEvent> &events) override
+    {
+        const int rank = fixRank(data.fixQuality);
+        if (m_previousRank >= 0 && rank < m_previousRank) {
+            events.append(AnomalyEvent(data.utcTimeMs, AnomalyEvent::FixDegraded, data.fixQuality));
+        }
+        m_previousRank = rank;
+    }
+
+private:
+    static int fixRank(int fixQuality)
+    {
+        switch (fixQuality) {
+        case 4: return 5;   // RTK固定解
+        case 5: return 4;   // RTK浮点解
+        case 2: return 3;   // 差分
+        case 3: return 3;   // PPS
+        case 1: return 2;   // 单点
+        case 6: return 1;   // 推算
+        default: return 0;  // 无定位
+        }
+    }
+
+    int m_previousRank;
+};
+
+// 信噪比整体下降（干扰特征）：每颗卫星维护信噪比基线，
+// 绝大多数卫星同时明显低于基线（或失锁）时报告一次，恢复后才会再次报告。
+class SignalDropDetector : public AnomalyDetector
+{
+public:
+    SignalDropDetector() { reset(); }
+
+    void reset() override
+    {
+        m_baselines.clear();
+        m_dropped = false;
+    }
+
+    void process(const SatelliteData &data, QVector<AnomalyEvent> &events) override
+    {
+        int compared = 0;
+        int dropped = 0;
+        double sumDelta = 0.0;
+        for (const SatelliteInfo &satellite : data.satellites) {
+            auto it = m_baselines.find(qMakePair(satellite.system, satellite.id));
+            if (it == m_baselines.end() || it->samples < kWarmupSamples) {
+                continue;
+            }
+            // 失锁（信噪比为0）按下降到0计算
+            const double delta = satellite.snr - it->level;
+            ++compared;
+            sumDelta += delta;
+            if (delta <= -kSatelliteDrop) {
+                ++dropped;
+            }
+        }
+
+        const double meanDelta = compared > 0 ? sumDelta / compared : 0.0;
+        if (!m_dropped) {
+            if (compared >= kMinSatellites && dropped >= compared * kDroppedFraction && meanDelta <= -kMeanDrop) {
+                m_dropped = true;
+                events.append(AnomalyEvent(data.utcTimeMs, AnomalyEvent::SignalDrop, -meanDelta));
+            }
+        } else if (meanDelta > -kSatelliteDrop) {
+            m_dropped = false;
+        }
+
+        // 下降期间不更新基线，否则基线会跟着被干扰的信号下降
+        if (m_dropped) {
+            return;
+        }
+        for (const SatelliteInfo &satellite : data.satellites) {
+            if (satellite.snr <= 0) {
+                continue;
+            }
+            Baseline &baseline = m_baselines[qMakePair(satellite.system, satellite.id)];
+            if (baseline.samples == 0) {
+                baseline.level = satellite.snr;
+            } else {
+                baseline.level += kAlpha * (satellite.snr - baseline.level);
+            }
+            ++baseline.samples;
+        }
+    }
+
+private:
+    struct Baseline {
+        double level;
+        int samples;
+        Baseline() : level(0.0), samples(0) {}
+    };
+
+    static constexpr double kAlpha = 0.05;
+    static constexpr double kSatelliteDrop = 3.0;     // dB
+    static constexpr double kMeanDrop = 6.0;          // dB
+    static constexpr double kDroppedFraction = 0.8;
+    static constexpr int kMinSatellites = 4;
+    static constexpr int kWarmupSamples = 10;
+
+    QHash<QPair<QString, int>, Baseline> m_baselines;
+    bool m_dropped;
+};
+
+// 时间不连续：时间倒退、重复，或间隔明显大于正常的历元间隔
+class TimeGapDetector : public AnomalyDetector
+{
+public:
+    TimeGapDetector() { reset(); }
+
+    void reset() override
+    {
+        m_previousTimeMs = -1;
+        m_nominalMs = 0.0;
+    }
+
+    void process(const SatelliteData &data, QVector<AnomalyEvent> &events) override
+    {
+        qint64 timeMs = data.utcTimeMs;
+        if (m_previousTimeMs < 0) {
+            m_previousTimeMs = timeMs;
+            return;
+        }
+
+        // 没有日期时时间为当天毫秒数，跨过UTC零点时补上一天
+        if (timeMs < kDayMs && m_previousTimeMs - timeMs > kDayMs / 2) {
+            timeMs += kDayMs;
+        }
+
+        const qint64 interval = timeMs - m_previousTimeMs;
+        if (interval <= 0) {
+            events.append(AnomalyEvent(data.utcTimeMs, AnomalyEvent::TimeGap, interval / 1000.0));
+        } else {
+            if (m_nominalMs > 0.0 && interval > qMax(kGapFactor * m_nominalMs, m_nominalMs + kMinGapMs)) {
+                events.append(AnomalyEvent(data.utcTimeMs, AnomalyEvent::TimeGap, interval / 1000.0));
+            }
+            // 正常间隔：更短的间隔立即采用，更长的缓慢跟随
+            if (m_nominalMs <= 0.0 || interval < m_nominalMs) {
+                m_nominalMs = interval;
+            } else if (interval < kGapFactor * m_nominalMs) {
+                m_nominalMs += kAlpha * (interval - m_nominalMs);
+            }
+        }
+        m_previousTimeMs = data.utcTimeMs;
+    }
+
+private:
+    static constexpr double kGapFactor = 2.5;
+    static constexpr double kMinGapMs = 500.0;
+    static constexpr double kAlpha = 0.05;
+
+    qint64 m_previousTimeMs;
+    double m_nominalMs;
+};
+
+// 校验和错误集中出现：最近若干历元内的错误语句数超过门限时报告，窗口内没有错误后复位
+class ChecksumBurstDetector : public AnomalyDetector
+{
+public:
+    ChecksumBurstDetector() { reset(); }
+
+    void reset() override
+    {
+        for (int i = 0; i < kWindow; ++i) {
+            m_window[i] = 0;
+        }
+        m_next = 0;
+        m_sum = 0;
+        m_previousErrors = 0;
+        m_inBurst = false;
+    }
+
+    void process(const SatelliteData &data, QVector<AnomalyEvent> &events) override
+    {
+        // 解析器重置后计数从0开始
+        int errors = data.checksumErrors - m_previousErrors;
+        if (errors < 0) {
+            errors = data.checksumErrors;
+        }
+        m_previousErrors = data.checksumErrors;
+
+        m_sum += errors - m_window[m_next];
+        m_window[m_next] = errors;
+        m_next = (m_next + 1) % kWindow;
+
+        if (!m_inBurst && m_sum >= kBurstErrors) {
+            m_inBurst = true;
+            events.append(AnomalyEvent(data.utcTimeMs, AnomalyEvent::ChecksumBurst, m_sum));
+        } else if (m_inBurst && m_sum == 0) {
+            m_inBurst = false;
+        }
+    }
+
+private:
+    enum { kWindow = 10, kBurstErrors = 3 };
+
+    int m_window[kWindow];
+    int m_next;
+    int m_sum;
+    int m_previousErrors;
+    bool m_inBurst;
+};
+
+AnomalyMonitor::AnomalyMonitor()
+{
+    m_detectors.emplace_back(new PositionJumpDetector);
+    m_detectors.emplace_back(new FixDegradedDetector);
+    m_detectors.emplace_back(new SignalDropDetector);
+    m_detectors.emplace_back(new TimeGapDetector);
+    m_detectors.emplace_back(new ChecksumBurstDetector);
+    clear();
+}
+
+AnomalyMonitor::~AnomalyMonitor()
+{
+}
+
+void AnomalyMonitor::clear()
+{
+    for (const std::unique_ptr<AnomalyDetector> &detector : m_detectors) {
+        detector->reset();
+    }
+    m_events.clear();
+    for (int i = 0; i < AnomalyEvent::TypeCount; ++i) {
+        m_counts[i] = 0;
+    }
+    m_epochCount = 0;
+    m_firstTimeMs = 0;
+    m_lastTimeMs = 0;
+    m_totalCostNs = 0;
+    m_maxCostNs = 0;
+    m_overBudget = 0;
+}
+
+int AnomalyMonitor::addEpoch(const SatelliteData &data)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    if (m_epochCount == 0) {
+        m_firstTimeMs = data.utcTimeMs;
+    }
+    m_lastTimeMs = data.utcTimeMs;
+    ++m_epochCount;
+
+    const int before = m_events.size();
+    for (const std::unique_ptr<AnomalyDetector> &detector : m_detectors) {
+        detector->process(data, m_events);
+    }
+    for (int i = before; i < m_events.size(); ++i) {
+        ++m_counts[m_events[i].type];
+    }
+
+    const qint64 cost = timer.nsecsElapsed();
+    m_totalCostNs += cost;
+    m_maxCostNs = qMax(m_maxCostNs, cost);
+    if (cost > EpochBudgetNs) {
+        ++m_overBudget;
+    }
+    return m_events.size() - before;
+}
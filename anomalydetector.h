@@ -0,0 +1,88 @@
+#ifndef ANOMALYDETECTOR_H
+#define ANOMALYDETECTOR_H
+
+#include <QVector>
+#include <QString>
+#include <memory>
+#include <vector>
+#include "satellitedata.h"
+
+// 检测到的一个异常事件
+struct AnomalyEvent {
+    enum Type {
+        PositionJump,      // 位置跳变：value 为跳变距离（米）
+        FixDegraded,       // 定位质量下降：value 为新的定位质量
+        SignalDrop,        // 所有卫星信噪比同时下降（干扰特征）：value 为平均下降量（dB）
+        TimeGap,           // 时间不连续：value 为与上一历元的间隔（秒，≤0 表示时间倒退或重复）
+        ChecksumBurst,     // 校验和错误集中出现：value 为最近窗口内的错误数
+        TypeCount
+    };
+
+    qint64 timeMs;         // 与 SatelliteData::utcTimeMs 相同
+    Type type;
+    double value;
+
+    AnomalyEvent() : timeMs(0), type(PositionJump), value(0.0) {}
+    AnomalyEvent(qint64 t, Type ty, double v) : timeMs(t), type(ty), value(v) {}
+
+    static QString typeName(Type type);
+    static QString formatTime(qint64 timeMs);
+    QString description() const;
+};
+
+// 检测器接口：每个完整历元调用一次 process，检测器只保留 O(1) 的滚动状态
+class AnomalyDetector
+{
+public:
+    virtual ~AnomalyDetector() {}
+
+    virtual void reset() = 0;
+    virtual void process(const SatelliteData &data, QVector<AnomalyEvent> &events) = 0;
+};
+
+// 异常监测：依次运行所有检测器，汇总事件并按类型计数。
+// 事件按历元顺序追加，时间轴据此标注。
+class AnomalyMonitor
+{
+public:
+    // 所有检测器处理一个历元的耗时预算
+    enum { EpochBudgetNs = 50000 };
+
+    AnomalyMonitor();
+    ~AnomalyMonitor();
+
+    void clear();
+
+    // 返回本历元新增的事件数
+    int addEpoch(const SatelliteData &data);
+
+    const QVector<AnomalyEvent> &events() const { return m_events; }
+    int count(AnomalyEvent::Type type) const { return m_counts[type]; }
+    int totalCount() const { return m_events.size(); }
+
+    // 已处理历元的时间范围（时间轴的范围）
+    bool hasEpochs() const { return m_epochCount > 0; }
+    qint64 firstTimeMs() const { return m_firstTimeMs; }
+    qint64 lastTimeMs() const { return m_lastTimeMs; }
+
+    // 实测耗时：每个历元所有检测器合计
+    qint64 epochCount() const { return m_epochCount; }
+    double averageCostUs() const { return m_epochCount > 0 ? m_totalCostNs / 1000.0 / m_epochCount : 0.0; }
+    double maxCostUs() const { return m_maxCostNs / 1000.0; }
+    qint64 overBudgetCount() const { return m_overBudget; }
+
+private:
+    Q_DISABLE_COPY(AnomalyMonitor)
+
+    std::vector<std::unique_ptr<AnomalyDetector>> m_detectors;
+    QVector<AnomalyEvent> m_events;
+    int m_counts[AnomalyEvent::TypeCount];
+    qint64 m_epochCount;
+    qint64 m_firstTimeMs;
+    qint64 m_lastTimeMs;
+    qint64 m_totalCostNs;
+    qint64 m_maxCostNs;
+    qint64 m_overBudget;
+};
+
+#endif // ANOMALYDETECTOR_H
@@ -0,0 +1,112 @@
+#include "anomalytimeline.h"
+#include <QPainter>
+#include <QHelpEvent>
+#include <QToolTip>
+#include <QStringList>
+
+static const qint64 kDayMs = 24 * 3600 * 1000;
+// 悬停时显示说明的最大像素距离
+static const int kHoverDistance = 3;
+// 悬停说明最多列出的事件数
+static const int kMaxTooltipEvents = 8;
+
+AnomalyTimeline::AnomalyTimeline(QWidget *parent)
+    : QWidget(parent)
+    , m_monitor(nullptr)
+{
+    setMinimumWidth(240);
+    setFixedHeight(16);
+    setToolTip("异常时间轴");
+}
+
+void AnomalyTimeline::setMonitor(const AnomalyMonitor *monitor)
+{
+    m_monitor = monitor;
+    update();
+}
+
+QColor AnomalyTimeline::colorFor(AnomalyEvent::Type type)
+{
+    switch (type) {
+    case AnomalyEvent::PositionJump: return QColor(231, 76, 60);
+    case AnomalyEvent::FixDegraded: return QColor(230, 126, 34);
+    case AnomalyEvent::SignalDrop: return QColor(142, 68, 173);
+    case AnomalyEvent::TimeGap: return QColor(52, 152, 219);
+    case AnomalyEvent::ChecksumBurst: return QColor(127, 140, 141);
+    default: return QColor(44, 62, 80);
+    }
+}
+
+double AnomalyTimeline::xForTime(qint64 timeMs) const
+{
+    // 没有日期时跨过UTC零点的时间补上一天
+    const qint64 first = m_monitor->firstTimeMs();
+    qint64 last = m_monitor->lastTimeMs();
+    if (last < first && first < kDayMs) last += kDayMs;
+    if (timeMs < first && first < kDayMs) timeMs += kDayMs;
+
+    const double span = qMax<qint64>(1, last - first);
+    return (timeMs - first) / span * (width() - 1);
+}
+
+void AnomalyTimeline::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event)
+
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(236, 240, 241));
+    painter.setPen(QColor(189, 195, 199));
+    painter.drawRect(rect().adjusted(0, 0, -1, -1));
+
+    if (!m_monitor || !m_monitor->hasEpochs()) {
+        return;
+    }
+
+    // 同一像素列、同一类型的事件只画一次
+    int lastX[AnomalyEvent::TypeCount];
+    for (int i = 0; i < AnomalyEvent::TypeCount; ++i) {
+        lastX[i] = -1;
+    }
+
+    const int laneHeight = qMax(1, (height() - 2) / AnomalyEvent::TypeCount);
+    for (const AnomalyEvent &anomaly : m_monitor->events()) {
+        const int x = int(xForTime(anomaly.timeMs));
+        if (x == lastX[anomaly.type]) {
+            continue;
+        }
+        lastX[anomaly.type] = x;
+
+        // 每种类型一条横道，便于区分重叠的事件
+        const int top = 1 + anomaly.type * laneHeight;
+        painter.fillRect(QRect(x, top, 2, laneHeight), colorFor(anomaly.type));
+    }
+}
+
+bool AnomalyTimeline::event(QEvent *event)
+{
+    if (event->type() != QEvent::ToolTip || !m_monitor || !m_monitor->hasEpochs()) {
+        return QWidget::event(event);
+    }
+
+    QHelpEvent *helpEvent = static_cast<QHelpEvent *>(event);
+    QStringList lines;
+    for (const AnomalyEvent &anomaly : m_monitor->events()) {
+        if (qAbs(xForTime(anomaly.timeMs) - helpEvent->pos().x()) <= kHoverDistance) {
+            if (lines.size() == kMaxTooltipEvents) {
+                lines.append("...");
+                break;
+            }
+            lines.append(anomaly.description());
+        }
+    }
+
+    if (lines.isEmpty()) {
+        QToolTip::showText(helpEvent->globalPos(),
+                           QString("%1 - %2 UTC").arg(AnomalyEvent::formatTime(m_monitor->firstTimeMs()),
+                                                      AnomalyEvent::formatTime(m_monitor->lastTimeMs())),
+                           this);
+    } else {
+        QToolTip::showText(helpEvent->globalPos(), lines.join("\n"), this);
+    }
+    return true;
+}
@@ -0,0 +1,31 @@
+#ifndef ANOMALYTIMELINE_H
+#define ANOMALYTIMELINE_H
+
+#include <QWidget>
+#include "anomalydetector.h"
+
+// 回放时间轴：从第一个到最后一个历元，按事件时间标注异常（不同类型不同颜色），
+// 鼠标悬停显示附近事件的说明。
+class AnomalyTimeline : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit AnomalyTimeline(QWidget *parent = nullptr);
+
+    // 异常监测由主窗口维护，这里只读取显示
+    void setMonitor(const AnomalyMonitor *monitor);
+
+    static QColor colorFor(AnomalyEvent::Type type);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    bool event(QEvent *event) override;
+
+private:
+    double xForTime(qint64 timeMs) const;
+
+    const AnomalyMonitor *m_monitor;
+};
+
+#endif // ANOMALYTIMELINE_H
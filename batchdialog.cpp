@@ -0,0 +1,237 @@
+#include "batchdialog.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QCloseEvent>
+
+// 表格列
+enum BatchColumn {
+    FileColumn,
+    SizeColumn,
+    SentenceColumn,
+    ChecksumColumn,
+    EpochColumn,
+    FixColumn,
+    UsedColumn,
+    SnrColumn,
+    ElapsedColumn,
+    NoteColumn,
+    ColumnCount
+};
+
+// 所有系统合并的平均信噪比
+static double meanSnr(const SignalStatistics &signal)
+{
+    SnrAccumulator all;
+    for (const SnrAccumulator &acc : signal.systemStatistics()) {
+        all.merge(acc);
+    }
+    return all.mean;
+}
+
+BatchDialog::BatchDialog(QWidget *parent)
+    : QDialog(parent)
+    , m_processor(new BatchProcessor(this))
+{
+    setWindowTitle("📚 批量分析");
+    resize(960, 560);
+    setupUI();
+
+    connect(m_processor, &BatchProcessor::fileFinished, this, &BatchDialog::onFileFinished);
+    connect(m_processor, &BatchProcessor::progress, this, &BatchDialog::onProgress);
+    connect(m_processor, &BatchProcessor::finished, this, &BatchDialog::onFinished);
+}
+
+void BatchDialog::setupUI()
+{
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(8, 8, 8, 8);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    m_addDirectoryButton = new QPushButton("📁 添加目录...", this);
+    m_addFilesButton = new QPushButton("📄 添加文件...", this);
+    m_startButton = new QPushButton("▶️ 开始分析", this);
+    m_cancelButton = new QPushButton("✖ 取消", this);
+    m_startButton->setEnabled(false);
+    m_cancelButton->setEnabled(false);
+    buttonLayout->addWidget(m_addDirectoryButton);
+    buttonLayout->addWidget(m_addFilesButton);
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(m_startButton);
+    buttonLayout->addWidget(m_cancelButton);
+    mainLayout->addLayout(buttonLayout);
+
+    m_inputLabel = new QLabel("未选择文件", this);
+    m_inputLabel->setStyleSheet("QLabel { font-size: 9pt; color: #2c3e50; }");
+    m_inputLabel->setWordWrap(true);
+    mainLayout->addWidget(m_inputLabel);
+
+    m_table = new QTableWidget(0, ColumnCount, this);
+    m_table->setHorizontalHeaderLabels(QStringList() << "文件" << "大小(KB)" << "语句" << "校验和错误"
+                                       << "历元" << "定位可用率" << "平均使用卫星" << "平均信噪比"
+                                       << "耗时(ms)" << "备注");
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_table->verticalHeader()->setVisible(false);
+    m_table->horizontalHeader()->setSectionResizeMode(FileColumn, QHeaderView::Stretch);
+    mainLayout->addWidget(m_table);
+
+    m_progressBar = new QProgressBar(this);
+    m_progressBar->setValue(0);
+    mainLayout->addWidget(m_progressBar);
+
+    connect(m_addDirectoryButton, &QPushButton::clicked, this, &BatchDialog::onAddDirectory);
+    connect(m_addFilesButton, &QPushButton::clicked, this, &BatchDialog::onAddFiles);
+    connect(m_startButton, &QPushButton::clicked, this, &BatchDialog::onStart);
+    connect(m_cancelButton, &QPushButton::clicked, this, &BatchDialog::onCancel);
+}
+
+void BatchDialog::onAddDirectory()
+{
+    QString directory = QFileDialog::getExistingDirectory(this, "📁 选择日志目录");
+    if (directory.isEmpty()) {
+        return;
+    }
+    m_inputs.append(directory);
+    m_inputLabel->setText(QString("输入: %1").arg(m_inputs.join("; ")));
+    m_startButton->setEnabled(true);
+}
+
+void BatchDialog::onAddFiles()
+{
+    QStringList files = QFileDialog::getOpenFileNames(
+        this,
+        "📄 选择NMEA数据文件",
+        "",
+        "NMEA文件 (*.nmea *.txt);;文本文件 (*.txt);;所有文件 (*.*)"
+    );
+    if (files.isEmpty()) {
+        return;
+    }
+    m_inputs.append(files);
+    m_inputLabel->setText(QString("输入: %1").arg(m_inputs.join("; ")));
+    m_startButton->setEnabled(true);
+}
+
+void BatchDialog::onStart()
+{
+    const QStringList files = BatchProcessor::expandInputs(m_inputs);
+    if (files.isEmpty() || !m_processor->start(files)) {
+        return;
+    }
+
+    m_table->setRowCount(0);
+    m_progressBar->setRange(0, files.size());
+    m_progressBar->setValue(0);
+    m_startButton->setEnabled(false);
+    m_addDirectoryButton->setEnabled(false);
+    m_addFilesButton->setEnabled(false);
+    m_cancelButton->setEnabled(true);
+    m_inputLabel->setText(QString("正在分析 %1 个文件...").arg(files.size()));
+}
+
+void BatchDialog::onCancel()
+{
+    m_processor->cancel();
+    m_cancelButton->setEnabled(false);
+}
+
+void BatchDialog::setRow(int row, const LogSummary &summary, const QString &note)
+{
+    QStringList values;
+    values << summary.fileName
+           << QString()
+           << QString::number(summary.sentences)
+           << QString::number(summary.checksumErrors)
+           << QString::number(summary.epochs)
+           << QString("%1%").arg(summary.fixAvailability() * 100.0, 0, 'f', 1)
+           << QString::number(summary.meanUsed, 'f', 1)
+           << QString::number(meanSnr(summary.signal), 'f', 1)
+           << QString::number(summary.elapsedMs, 'f', 0)
+           << note;
+
+    for (int column = 0; column < ColumnCount; ++column) {
+        QTableWidgetItem *item = m_table->item(row, column);
+        if (!item) {
+            item = new QTableWidgetItem();
+            m_table->setItem(row, column, item);
+        }
+        if (column != SizeColumn) {
+            item->setText(values[column]);
+        }
+        if (column != FileColumn && column != NoteColumn) {
+            item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        }
+    }
+}
+
+void BatchDialog::onFileFinished(const BatchResult &result)
+{
+    // 文件行按完成顺序追加，合计行在 onFinished 中加在最后
+    const int row = m_table->rowCount();
+    m_table->insertRow(row);
+
+    QString note;
+    if (!result.summary.ok) {
+        note = "无法打开";
+    } else if (result.cached) {
+        note = "缓存";
+    }
+    setRow(row, result.summary, note);
+    m_table->item(row, FileColumn)->setText(QFileInfo(result.path).fileName());
+    m_table->item(row, FileColumn)->setToolTip(result.path);
+    m_table->item(row, SizeColumn)->setText(QString::number((result.size + 1023) / 1024));
+}
+
+void BatchDialog::onProgress(int done, int total)
+{
+    m_progressBar->setRange(0, total);
+    m_progressBar->setValue(done);
+}
+
+void BatchDialog::refreshTotal()
+{
+    const QVector<BatchResult> results = m_processor->results();
+    if (results.isEmpty()) {
+        return;
+    }
+
+    qint64 totalSize = 0;
+    for (const BatchResult &result : results) {
+        totalSize += result.size;
+    }
+
+    const int row = m_table->rowCount();
+    m_table->insertRow(row);
+    setRow(row, BatchProcessor::merge(results), QString());
+    m_table->item(row, SizeColumn)->setText(QString::number((totalSize + 1023) / 1024));
+
+    QFont font = m_table->font();
+    font.setBold(true);
+    for (int column = 0; column < ColumnCount; ++column) {
+        m_table->item(row, column)->setFont(font);
+    }
+}
+
+void BatchDialog::onFinished(bool cancelled)
+{
+    refreshTotal();
+
+    m_startButton->setEnabled(!m_inputs.isEmpty());
+    m_addDirectoryButton->setEnabled(true);
+    m_addFilesButton->setEnabled(true);
+    m_cancelButton->setEnabled(false);
+    m_inputLabel->setText(QString("%1: %2 个文件%3")
+                          .arg(cancelled ? "已取消" : "分析完成")
+                          .arg(m_processor->results().size())
+                          .arg(cancelled ? "（部分）" : ""));
+}
+
+void BatchDialog::closeEvent(QCloseEvent *event)
+{
+    // 关闭窗口时停止调度剩余文件；正在分析的文件完成后结果照常进入缓存
+    m_processor->cancel();
+    QDialog::closeEvent(event);
+}
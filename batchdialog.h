@@ -0,0 +1,51 @@
+#ifndef BATCHDIALOG_H
+#define BATCHDIALOG_H
+
+#include <QDialog>
+#include <QLabel>
+#include <QTableWidget>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QStringList>
+#include "batchprocessor.h"
+
+// 批量分析窗口：选择目录或多个文件，在线程池上并行分析，
+// 表格列出每个文件的汇总，最后一行为合计。
+// 窗口由主窗口保留，关闭后再打开时缓存仍然有效，未变化的文件不会重新分析。
+class BatchDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit BatchDialog(QWidget *parent = nullptr);
+
+protected:
+    void closeEvent(QCloseEvent *event) override;
+
+private slots:
+    void onAddDirectory();
+    void onAddFiles();
+    void onStart();
+    void onCancel();
+    void onFileFinished(const BatchResult &result);
+    void onProgress(int done, int total);
+    void onFinished(bool cancelled);
+
+private:
+    void setupUI();
+    void setRow(int row, const LogSummary &summary, const QString &note);
+    void refreshTotal();
+
+    BatchProcessor *m_processor;
+    QStringList m_inputs;
+
+    QLabel *m_inputLabel;
+    QTableWidget *m_table;
+    QProgressBar *m_progressBar;
+    QPushButton *m_addDirectoryButton;
+    QPushButton *m_addFilesButton;
+    QPushButton *m_startButton;
+    QPushButton *m_cancelButton;
+};
+
+#endif // BATCHDIALOG_H
@@ -0,0 +1,201 @@
+#include "batchprocessor.h"
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QSemaphore>
+#include <QRunnable>
+#include <QThread>
+#include <QDebug>
+#include <atomic>
+#include <algorithm>
+
+// 默认内存预算（MB）；读入后每个字符占两个字节，实际内存约为文件大小的两到三倍
+static const int kDefaultMemoryBudgetMb = 512;
+
+// 一次批处理中各任务共享的状态
+struct BatchState {
+    std::atomic<bool> cancelled;
+    QSemaphore memory;       // 每个单位 1 MB
+
+    explicit BatchState(int budgetMb) : cancelled(false), memory(budgetMb) {}
+};
+
+BatchProcessor::BatchProcessor(QObject *parent)
+    : QObject(parent)
+    , m_memoryBudgetMb(kDefaultMemoryBudgetMb)
+    , m_retainResults(true)
+    , m_pending(0)
+    , m_total(0)
+{
+    m_pool.setMaxThreadCount(QThread::idealThreadCount());
+}
+
+BatchProcessor::~BatchProcessor()
+{
+    // 任务会回调本对象，必须等它们结束
+    cancel();
+    m_pool.waitForDone();
+}
+
+QStringList BatchProcessor::expandInputs(const QStringList &inputs)
+{
+    const QStringList nmeaFilters = {"*.nmea", "*.txt"};
+
+    QStringList files;
+    for (const QString &input : inputs) {
+        QFileInfo info(input);
+        if (info.isDir()) {
+            QDirIterator it(info.absoluteFilePath(), nmeaFilters, QDir::Files, QDirIterator::Subdirectories);
+            while (it.hasNext()) {
+                files.append(it.next());
+            }
+        } else if (info.fileName().contains('*') || info.fileName().contains('?')) {
+            const QFileInfoList matches = QDir(info.path()).entryInfoList(QStringList() << info.fileName(),
+                                                                          QDir::Files, QDir::Name);
+            for (const QFileInfo &match : matches) {
+                files.append(match.absoluteFilePath());
+            }
+        } else {
+            // 不存在的文件也保留，结果中标记为无法打开
+            files.append(info.absoluteFilePath());
+        }
+    }
+
+    files.removeDuplicates();
+    return files;
+}
+
+void BatchProcessor::setThreadCount(int threads)
+{
+    m_pool.setMaxThreadCount(threads > 0 ? threads : QThread::idealThreadCount());
+}
+
+void BatchProcessor::setMemoryBudgetMb(int megabytes)
+{
+    m_memoryBudgetMb = qMax(1, megabytes);
+}
+
+bool BatchProcessor::start(const QStringList &files)
+{
+    if (isRunning()) {
+        return false;
+    }
+
+    m_results.clear();
+    m_state = QSharedPointer<BatchState>::create(m_memoryBudgetMb);
+    m_total = 0;
+
+    // 缓存命中的直接完成，其余按文件大小从大到小调度
+    QVector<BatchResult> cached;
+    QVector<BatchResult> queued;
+    for (const QString &file : files) {
+        QFileInfo info(file);
+        BatchResult result;
+        result.path = info.absoluteFilePath();
+        result.size = info.size();
+        result.modified = info.lastModified();
+
+        auto it = m_cache.constFind(result.path);
+        if (info.isFile() && it != m_cache.constEnd()
+            && it->size == result.size && it->modified == result.modified) {
+            result = it.value();
+            result.cached = true;
+            cached.append(result);
+        } else {
+            queued.append(result);
+        }
+    }
+    std::stable_sort(queued.begin(), queued.end(), [](const BatchResult &a, const BatchResult &b) {
+        return a.size > b.size;
+    });
+
+    m_total = cached.size() + queued.size();
+    m_pending = m_total;
+
+    // 结果一律经事件循环送出，调用方在 start() 之后连接信号或进入事件循环都不会错过
+    for (const BatchResult &result : cached) {
+        QMetaObject::invokeMethod(this, [this, result]() { onTaskFinished(result); }, Qt::QueuedConnection);
+    }
+    if (m_total == 0) {
+        QMetaObject::invokeMethod(this, [this]() { emit finished(false); }, Qt::QueuedConnection);
+        return true;
+    }
+
+    const QSharedPointer<BatchState> state = m_state;
+    const int budget = m_memoryBudgetMb;
+    for (const BatchResult &pending : queued) {
+        m_pool.start(QRunnable::create([this, state, budget, pending]() {
+            BatchResult result = pending;
+            if (!state->cancelled.load(std::memory_order_relaxed)) {
+                // 超过预算的文件占用全部预算，单独运行
+                const int units = int(qBound<qint64>(1, (pending.size + (1 << 20) - 1) >> 20, budget));
+                state->memory.acquire(units);
+                if (!state->cancelled.load(std::memory_order_relaxed)) {
+                    LogAnalyzer analyzer;
+                    result.summary = analyzer.analyze(pending.path);
+                }
+                state->memory.release(units);
+            }
+            QMetaObject::invokeMethod(this, [this, result]() { onTaskFinished(result); }, Qt::QueuedConnection);
+        }));
+    }
+
+    qDebug() << "批量分析:" << m_total << "个文件，缓存命中" << cached.size()
+             << "，线程数" << m_pool.maxThreadCount();
+    return true;
+}
+
+void BatchProcessor::cancel()
+{
+    if (m_state) {
+        m_state->cancelled.store(true, std::memory_order_relaxed);
+    }
+}
+
+void BatchProcessor::onTaskFinished(const BatchResult &result)
+{
+    const bool cancelled = m_state && m_state->cancelled.load(std::memory_order_relaxed);
+
+    // 取消后跳过的文件没有分析结果，不记录也不缓存
+    if (!cancelled || result.cached || !result.summary.fileName.isEmpty()) {
+        if (m_retainResults) {
+            m_results.insert(result.path, result);
+            if (!result.cached && result.summary.ok) {
+                m_cache.insert(result.path, result);
+            }
+        }
+        emit fileFinished(result);
+    }
+
+    --m_pending;
+    emit progress(m_total - m_pending, m_total);
+    if (m_pending == 0) {
+        emit finished(cancelled);
+    }
+}
+
+QVector<BatchResult> BatchProcessor::results() const
+{
+    QVector<BatchResult> sorted;
+    sorted.reserve(m_results.size());
+    for (const BatchResult &result : m_results) {
+        sorted.append(result);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const BatchResult &a, const BatchResult &b) {
+        return a.path < b.path;
+    });
+    return sorted;
+}
+
+LogSummary BatchProcessor::merge(const QVector<BatchResult> &results)
+{
+    LogSummary total;
+    total.fileName = QString("合计 (%1 个文件)").arg(results.size());
+    total.ok = true;
+    for (const BatchResult &result : results) {
+        if (result.summary.ok) {
+            total.merge(result.summary);
+        }
+    }
+    return total;
+}
@@ -0,0 +1,79 @@
+#ifndef BATCHPROCESSOR_H
+#define BATCHPROCESSOR_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QDateTime>
+#include <QHash>
+#include <QVector>
+#include <QThreadPool>
+#include <QSharedPointer>
+#include "loganalyzer.h"
+
+// 一个文件的批量分析结果
+struct BatchResult {
+    QString path;            // 绝对路径
+    qint64 size;
+    QDateTime modified;
+    bool cached;             // 来自缓存（路径、大小、修改时间都没有变化）
+    LogSummary summary;
+
+    BatchResult() : size(0), cached(false) {}
+};
+
+struct BatchState;
+
+// 多文件批量分析：每个文件一个任务，在线程池上并行处理（默认每个核一个线程）。
+// 大文件优先调度，避免最后剩下一个大文件单线程运行。
+// FileManager 会把整个文件读入内存，所以同时处理的文件总大小受内存预算限制，
+// 超过预算的单个文件独占预算运行。
+// 结果按路径、大小和修改时间缓存，再次处理未变化的文件时直接返回。
+class BatchProcessor : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit BatchProcessor(QObject *parent = nullptr);
+    ~BatchProcessor();
+
+    // 展开输入：目录（递归查找 *.nmea/*.txt）、通配符（logs/*.nmea）或普通文件
+    static QStringList expandInputs(const QStringList &inputs);
+
+    void setThreadCount(int threads);
+    // 同时读入内存的文件总大小上限（MB）
+    void setMemoryBudgetMb(int megabytes);
+    // 是否保存结果（results() 和缓存）；只通过 fileFinished 逐个处理结果时关闭，内存不随文件数增长
+    void setRetainResults(bool retain) { m_retainResults = retain; }
+
+    // 正在处理时返回 false
+    bool start(const QStringList &files);
+    void cancel();
+    bool isRunning() const { return m_pending > 0; }
+
+    // 本次批处理已完成的结果，按路径排序
+    QVector<BatchResult> results() const;
+    // 所有文件合并后的汇总
+    static LogSummary merge(const QVector<BatchResult> &results);
+
+    void clearCache() { m_cache.clear(); }
+
+signals:
+    void fileFinished(const BatchResult &result);
+    void progress(int done, int total);
+    void finished(bool cancelled);
+
+private:
+    void onTaskFinished(const BatchResult &result);
+
+    QThreadPool m_pool;
+    QSharedPointer<BatchState> m_state;
+    int m_memoryBudgetMb;
+    bool m_retainResults;
+    int m_pending;
+    int m_total;
+    QHash<QString, BatchResult> m_results;
+    QHash<QString, BatchResult> m_cache;
+};
+
+#endif // BATCHPROCESSOR_H
@@ -0,0 +1,205 @@
+#include "broadcastserver.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QDebug>
+
+// 每个客户端的默认队列上限（字节）
+static const qint64 kDefaultQueueLimit = 256 * 1024;
+// 套接字发送缓冲中积压超过这个大小后，新数据留在客户端队列中
+static const qint64 kSocketBacklog = 64 * 1024;
+
+BroadcastServer::BroadcastServer(QObject *parent)
+    : QObject(parent)
+    , m_tcpServer(nullptr)
+    , m_localServer(nullptr)
+    , m_tcpPort(0)
+    , m_queueLimit(kDefaultQueueLimit)
+    , m_dropPolicy(DropOldest)
+    , m_clientCount(0)
+    , m_sentBytes(0)
+    , m_droppedBytes(0)
+    , m_queueHighWater(0)
+{
+}
+
+BroadcastServer::~BroadcastServer()
+{
+    close();
+}
+
+bool BroadcastServer::listen(quint16 tcpPort, const QString &localName, QString *errorMessage)
+{
+    close();
+
+    if (tcpPort > 0) {
+        m_tcpServer = new QTcpServer(this);
+        connect(m_tcpServer, &QTcpServer::newConnection, this, &BroadcastServer::onNewTcpConnection);
+        if (!m_tcpServer->listen(QHostAddress::Any, tcpPort)) {
+            if (errorMessage) {
+                *errorMessage = QString("无法监听TCP端口 %1: %2").arg(tcpPort).arg(m_tcpServer->errorString());
+            }
+            close();
+            return false;
+        }
+        m_tcpPort = m_tcpServer->serverPort();
+    }
+
+    if (!localName.isEmpty()) {
+        // 上次异常退出留下的 Unix 套接字文件会导致监听失败
+        QLocalServer::removeServer(localName);
+        m_localServer = new QLocalServer(this);
+        m_localServer->setSocketOptions(QLocalServer::WorldAccessOption);
+        connect(m_localServer, &QLocalServer::newConnection, this, &BroadcastServer::onNewLocalConnection);
+        if (!m_localServer->listen(localName)) {
+            if (errorMessage) {
+                *errorMessage = QString("无法监听本地套接字 %1: %2").arg(localName).arg(m_localServer->errorString());
+            }
+            close();
+            return false;
+        }
+        m_localName = m_localServer->fullServerName();
+    }
+
+    qDebug() << "转发服务: TCP" << m_tcpPort << "本地" << m_localName;
+    return true;
+}
+
+void BroadcastServer::close()
+{
+    const QList<QIODevice *> devices = m_clients.keys();
+    for (QIODevice *device : devices) {
+        removeClient(device);
+    }
+    if (m_tcpServer) {
+        m_tcpServer->close();
+        delete m_tcpServer;
+        m_tcpServer = nullptr;
+    }
+    if (m_localServer) {
+        m_localServer->close();
+        delete m_localServer;
+        m_localServer = nullptr;
+    }
+    m_tcpPort = 0;
+    m_localName.clear();
+}
+
+void BroadcastServer::publish(const QByteArray &sentences)
+{
+    QList<QIODevice *> lagging;
+
+    for (auto it = m_clients.begin(); it != m_clients.end(); ++it) {
+        QIODevice *device = it.key();
+        Client &client = it.value();
+
+        // 引用同一块数据，不拷贝
+        client.queue.enqueue(sentences);
+        client.queuedBytes += sentences.size();
+        flush(device, client);
+
+        // 统计只在转发线程中更新
+        const qint64 waiting = client.queuedBytes + device->bytesToWrite();
+        if (waiting > m_queueHighWater.load(std::memory_order_relaxed)) {
+            m_queueHighWater.store(waiting, std::memory_order_relaxed);
+        }
+
+        if (client.queuedBytes <= m_queueLimit) {
+            continue;
+        }
+        if (m_dropPolicy == Disconnect) {
+            m_droppedBytes.fetch_add(client.queuedBytes, std::memory_order_relaxed);
+            lagging.append(device);
+            continue;
+        }
+        while (client.queuedBytes > m_queueLimit && !client.queue.isEmpty()) {
+            const qint64 size = client.queue.dequeue().size();
+            client.queuedBytes -= size;
+            m_droppedBytes.fetch_add(size, std::memory_order_relaxed);
+        }
+    }
+
+    // 遍历结束后再移除，避免迭代器失效
+    for (QIODevice *device : lagging) {
+        qDebug() << "转发客户端跟不上，断开";
+        removeClient(device);
+    }
+}
+
+void BroadcastServer::flush(QIODevice *device, Client &client)
+{
+    while (!client.queue.isEmpty() && device->bytesToWrite() < kSocketBacklog) {
+        const QByteArray data = client.queue.dequeue();
+        client.queuedBytes -= data.size();
+        if (device->write(data) < 0) {
+            break;
+        }
+        m_sentBytes.fetch_add(data.size(), std::memory_order_relaxed);
+    }
+}
+
+void BroadcastServer::onNewTcpConnection()
+{
+    while (QTcpSocket *socket = m_tcpServer->nextPendingConnection()) {
+        qDebug() << "转发客户端连接:" << socket->peerAddress().toString() << socket->peerPort();
+        connect(socket, &QTcpSocket::disconnected, this, &BroadcastServer::onClientDisconnected);
+        addClient(socket);
+    }
+}
+
+void BroadcastServer::onNewLocalConnection()
+{
+    while (QLocalSocket *socket = m_localServer->nextPendingConnection()) {
+        qDebug() << "转发本地客户端连接";
+        connect(socket, &QLocalSocket::disconnected, this, &BroadcastServer::onClientDisconnected);
+        addClient(socket);
+    }
+}
+
+void BroadcastServer::addClient(QIODevice *device)
+{
+    connect(device, &QIODevice::bytesWritten, this, &BroadcastServer::onBytesWritten);
+    connect(device, &QIODevice::readyRead, this, &BroadcastServer::onReadyRead);
+    m_clients.insert(device, Client());
+    m_clientCount.store(m_clients.size(), std::memory_order_relaxed);
+}
+
+void BroadcastServer::removeClient(QIODevice *device)
+{
+    if (!m_clients.remove(device)) {
+        return;
+    }
+    m_clientCount.store(m_clients.size(), std::memory_order_relaxed);
+
+    device->disconnect(this);
+    if (QTcpSocket *socket = qobject_cast<QTcpSocket *>(device)) {
+        socket->abort();
+    } else if (QLocalSocket *socket = qobject_cast<QLocalSocket *>(device)) {
+        socket->abort();
+    }
+    device->deleteLater();
+}
+
+void BroadcastServer::onBytesWritten()
+{
+    QIODevice *device = qobject_cast<QIODevice *>(sender());
+    auto it = m_clients.find(device);
+    if (it != m_clients.end()) {
+        flush(device, it.value());
+    }
+}
+
+void BroadcastServer::onReadyRead()
+{
+    // 下游只接收，发来的数据直接丢弃，避免读缓冲增长
+    QIODevice *device = qobject_cast<QIODevice *>(sender());
+    if (device) {
+        device->readAll();
+    }
+}
+
+void BroadcastServer::onClientDisconnected()
+{
+    removeClient(qobject_cast<QIODevice *>(sender()));
+}
@@ -0,0 +1,89 @@
+#ifndef BROADCASTSERVER_H
+#define BROADCASTSERVER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QQueue>
+#include <QString>
+#include <atomic>
+
+class QIODevice;
+class QTcpServer;
+class QLocalServer;
+
+// 把接收到的 NMEA 语句转发给多个下游程序（记录器、地图显示等），
+// 串口只能打开一次，其他程序通过 TCP 或本地套接字（Unix 域套接字 / Windows 命名管道）连接。
+//
+// 每次发布的数据是若干完整语句（含 CRLF），QByteArray 隐式共享，所有客户端引用同一块内存。
+// 每个客户端有自己的有界队列：套接字发送缓冲积压到一定程度后新数据留在队列中，
+// 队列满时按策略丢弃最旧的数据或断开客户端，慢客户端不会拖慢解析或其他客户端。
+// 服务器应运行在单独的线程中，publish() 通过排队连接调用。
+class BroadcastServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum DropPolicy {
+        DropOldest,      // 丢弃队列中最旧的数据（整批语句，不会截断语句）
+        Disconnect       // 断开跟不上的客户端
+    };
+
+    explicit BroadcastServer(QObject *parent = nullptr);
+    ~BroadcastServer();
+
+    // tcpPort 为 0 时不监听 TCP，localName 为空时不监听本地套接字
+    bool listen(quint16 tcpPort, const QString &localName, QString *errorMessage = nullptr);
+    void close();
+
+    void setQueueLimit(qint64 bytes) { m_queueLimit = bytes; }
+    void setDropPolicy(DropPolicy policy) { m_dropPolicy = policy; }
+
+    quint16 tcpPort() const { return m_tcpPort; }
+    QString localName() const { return m_localName; }
+
+    // 统计（原子量，任何线程可读）
+    int clientCount() const { return m_clientCount.load(std::memory_order_relaxed); }
+    qint64 sentBytes() const { return m_sentBytes.load(std::memory_order_relaxed); }
+    qint64 droppedBytes() const { return m_droppedBytes.load(std::memory_order_relaxed); }
+    // 单个客户端等待发送的最多字节（队列 + 套接字发送缓冲）
+    qint64 queueHighWater() const { return m_queueHighWater.load(std::memory_order_relaxed); }
+
+public slots:
+    void publish(const QByteArray &sentences);
+
+private slots:
+    void onNewTcpConnection();
+    void onNewLocalConnection();
+    void onBytesWritten();
+    void onReadyRead();
+    void onClientDisconnected();
+
+private:
+    struct Client {
+        QQueue<QByteArray> queue;
+        qint64 queuedBytes;
+
+        Client() : queuedBytes(0) {}
+    };
+
+    void addClient(QIODevice *device);
+    void removeClient(QIODevice *device);
+    void flush(QIODevice *device, Client &client);
+
+    QTcpServer *m_tcpServer;
+    QLocalServer *m_localServer;
+    quint16 m_tcpPort;
+    QString m_localName;
+    QHash<QIODevice *, Client> m_clients;
+
+    qint64 m_queueLimit;
+    DropPolicy m_dropPolicy;
+
+    std::atomic<int> m_clientCount;
+    std::atomic<qint64> m_sentBytes;
+    std::atomic<qint64> m_droppedBytes;
+    std::atomic<qint64> m_queueHighWater;
+};
+
+#endif // BROADCASTSERVER_H
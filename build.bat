@@ -7,9 +7,16 @@ if exist release rmdir /s /q release
 if exist Makefile del Makefile
 if exist Makefile.Debug del Makefile.Debug
 if exist Makefile.Release del Makefile.Release
+if exist Makefile.satellite_app del Makefile.satellite_app*
+if exist core\debug rmdir /s /q core\debug
+if exist core\release rmdir /s /q core\release
+if exist cli\debug rmdir /s /q cli\debug
+if exist cli\release rmdir /s /q cli\release
+if exist generator\debug rmdir /s /q generator\debug
+if exist generator\release rmdir /s /q generator\release
 
-REM 运行qmake
-qmake satellite_app.pro
+REM 运行qmake（顶层工程：nmeacore 静态库、图形界面、命令行工具、数据生成器）
+qmake AI-serial-NEMA.pro
 
 REM 编译
 make
@@ -10,10 +10,10 @@ fi
 
 # 清理之前的编译文件
 echo "清理之前的编译文件..."
-rm -f Makefile Makefile.Debug Makefile.Release
-rm -rf debug release
+rm -f Makefile Makefile.* core/Makefile* cli/Makefile* generator/Makefile* soak/Makefile* tests/Makefile* tests/*/Makefile*
+rm -rf debug release core/debug core/release cli/debug cli/release generator/debug generator/release soak/debug soak/release tests/*/debug tests/*/release
 
-# 生成Makefile
+# 生成Makefile（顶层工程：nmeacore 静态库、图形界面、命令行工具、数据生成器、串口浸泡测试）
 echo "正在生成Makefile..."
 qmake AI-serial-NEMA.pro
 if [ $? -ne 0 ]; then
@@ -30,4 +30,7 @@ if [ $? -ne 0 ]; then
 fi
 
 echo "编译完成！"
-echo "可执行文件位置: debug/AI-serial-NEMA"
+echo "可执行文件位置: debug/SatelliteApp"
+echo "命令行工具位置: cli/nmea-inspect"
+echo "数据生成器位置: generator/nmea-generate"
+echo "串口浸泡测试位置: soak/nmea-soak"
@@ -1,8 +1,14 @@
 #include "chartmanager.h"
 #include <QDebug>
 
+// 每个像素宽度允许的点数预算（选层之后还会按像素去重）
+static const int kPointsPerPixel = 4;
+
 ChartManager::ChartManager(QObject *parent)
     : QObject(parent)
+    , m_historyRows(0)
+    , m_trajectoryAutoFit(true)
+    , m_updatingTrajectoryAxes(false)
 {
     setupSNRChart();
     setupRadarChart();
@@ -75,27 +81,40 @@ void ChartManager::setupTrajectoryChart()
 {
     m_trajectoryChart = new QChart();
     m_trajectoryChart->setTitle("运动轨迹图");
-    m_trajectoryChart->setAnimationOptions(QChart::SeriesAnimations);
+    // 轨迹点数可能很大，关闭动画
+    m_trajectoryChart->setAnimationOptions(QChart::NoAnimation);
     
-    m_trajectorySeries = new QSplineSeries();
+    m_trajectorySeries = new QLineSeries();
     m_trajectorySeries->setName("轨迹");
     m_trajectorySeries->setColor(QColor(75, 192, 192)); // 青色
+    m_trajectorySeries->setPen(QPen(QColor(75, 192, 192), 3));
     m_trajectoryChart->addSeries(m_trajectorySeries);
     
     // 设置坐标轴
-    QValueAxis *trajAxisX = new QValueAxis();
-    trajAxisX->setTitleText("经度 (°)");
-    m_trajectoryChart->addAxis(trajAxisX, Qt::AlignBottom);
-    m_trajectorySeries->attachAxis(trajAxisX);
+    m_trajectoryAxisX = new QValueAxis();
+    m_trajectoryAxisX->setTitleText("经度 (°)");
+    m_trajectoryChart->addAxis(m_trajectoryAxisX, Qt::AlignBottom);
+    m_trajectorySeries->attachAxis(m_trajectoryAxisX);
     
-    QValueAxis *trajAxisY = new QValueAxis();
-    trajAxisY->setTitleText("纬度 (°)");
-    m_trajectoryChart->addAxis(trajAxisY, Qt::AlignLeft);
-    m_trajectorySeries->attachAxis(trajAxisY);
+    m_trajectoryAxisY = new QValueAxis();
+    m_trajectoryAxisY->setTitleText("纬度 (°)");
+    m_trajectoryChart->addAxis(m_trajectoryAxisY, Qt::AlignLeft);
+    m_trajectorySeries->attachAxis(m_trajectoryAxisY);
     
     m_trajectoryChartView = new QChartView(m_trajectoryChart);
     m_trajectoryChartView->setRenderHint(QPainter::Antialiasing);
     m_trajectoryChartView->setMinimumHeight(200);
+    // 框选放大，右键缩小
+    m_trajectoryChartView->setRubberBand(QChartView::RectangleRubberBand);
+    
+    // 缩放/平移后重新取视口内的点；多次变化合并为一次刷新
+    m_trajectoryRefreshTimer = new QTimer(this);
+    m_trajectoryRefreshTimer->setSingleShot(true);
+    m_trajectoryRefreshTimer->setInterval(30);
+    connect(m_trajectoryRefreshTimer, &QTimer::timeout, this, &ChartManager::refreshTrajectoryViewport);
+    connect(m_trajectoryAxisX, &QValueAxis::rangeChanged, this, &ChartManager::onTrajectoryRangeChanged);
+    connect(m_trajectoryAxisY, &QValueAxis::rangeChanged, this, &ChartManager::onTrajectoryRangeChanged);
+    connect(m_trajectoryChart, &QChart::plotAreaChanged, this, &ChartManager::scheduleTrajectoryRefresh);
 }
 
 void ChartManager::updateSNRChart(const QList<SatelliteInfo> &satellites)
@@ -171,62 +190,109 @@ void ChartManager::updateRadarChart(const QList<SatelliteInfo> &satellites)
     m_radarSeries->setPen(QPen(QColor(54, 162, 235), 2));
 }
 
-void ChartManager::updateTrajectoryChart(const QList<GNSSData> &dataHistory)
+void ChartManager::setHistory(const EpochHistoryPtr &history)
+{
+    m_history = history;
+    m_historyRows = 0;
+    m_trackLod.clear();
+    m_trajectoryAutoFit = true;
+    m_trajectorySeries->clear();
+    
+    updateTrajectoryChart();
+}
+
+void ChartManager::updateTrajectoryChart()
 {
-    if (dataHistory.isEmpty()) {
+    if (!m_history) {
         return;
     }
     
-    // 清空现有数据
-    m_trajectorySeries->clear();
+    const qint64 rows = m_history->size();
+    if (rows <= m_historyRows) {
+        return;
+    }
     
-    // 添加轨迹点
-    double minLon = 180, maxLon = -180;
-    double minLat = 90, maxLat = -90;
-    bool hasValidData = false;
-    
-    for (const GNSSData &data : dataHistory) {
-        if (data.latitude != 0.0 && data.longitude != 0.0) {
-            m_trajectorySeries->append(data.longitude, data.latitude);
-            hasValidData = true;
-            
-            // 计算边界
-            minLon = qMin(minLon, data.longitude);
-            maxLon = qMax(maxLon, data.longitude);
-            minLat = qMin(minLat, data.latitude);
-            maxLat = qMax(maxLat, data.latitude);
+    // 按数据块直接读取经纬度列，只处理新增的历元
+    const int firstChunk = EpochHistory::chunkOf(m_historyRows);
+    for (int chunk = firstChunk; chunk < EpochHistory::chunkCount(rows); ++chunk) {
+        const ColumnSpan<double> latitudes = m_history->column(&EpochHistory::Chunk::latitude, chunk, rows);
+        const ColumnSpan<double> longitudes = m_history->column(&EpochHistory::Chunk::longitude, chunk, rows);
+        const int first = chunk == firstChunk ? EpochHistory::offsetOf(m_historyRows) : 0;
+        for (int i = first; i < latitudes.size; ++i) {
+            if (latitudes[i] != 0.0 && longitudes[i] != 0.0) {
+                m_trackLod.append(QPointF(longitudes[i], latitudes[i]));
+            }
         }
     }
+    m_historyRows = rows;
     
-    // 自动调整坐标轴范围
-    if (hasValidData && m_trajectorySeries->count() > 0) {
-        double lonRange = maxLon - minLon;
-        double latRange = maxLat - minLat;
-        
-        // 如果范围太小，设置最小范围
-        if (lonRange < 0.0001) {
-            lonRange = 0.0001; // 最小0.0001度范围
-        }
-        if (latRange < 0.0001) {
-            latRange = 0.0001; // 最小0.0001度范围
-        }
-        
-        // 添加一些边距
-        double lonMargin = lonRange * 0.5; // 增加边距到50%
-        double latMargin = latRange * 0.5;
-        
-        QValueAxis *axisX = qobject_cast<QValueAxis*>(m_trajectoryChart->axes(Qt::Horizontal).first());
-        QValueAxis *axisY = qobject_cast<QValueAxis*>(m_trajectoryChart->axes(Qt::Vertical).first());
-        
-        if (axisX) {
-            axisX->setRange(minLon - lonMargin, maxLon + lonMargin);
-        }
-        if (axisY) {
-            axisY->setRange(minLat - latMargin, maxLat + latMargin);
-        }
-        
-        // 设置轨迹线样式
-        m_trajectorySeries->setPen(QPen(QColor(75, 192, 192), 3));
-        m_trajectorySeries->setPointsVisible(true);
+    scheduleTrajectoryRefresh();
+}
+
+void ChartManager::resetTrajectoryZoom()
+{
+    m_trajectoryAutoFit = true;
+    scheduleTrajectoryRefresh();
+}
+
+void ChartManager::scheduleTrajectoryRefresh()
+{
+    if (!m_trajectoryRefreshTimer->isActive()) {
+        m_trajectoryRefreshTimer->start();
+    }
+}
+
+void ChartManager::onTrajectoryRangeChanged()
+{
+    if (m_updatingTrajectoryAxes) {
+        return;
+    }
+    
+    // 用户缩放或平移：保持当前视口，不再自动调整
+    m_trajectoryAutoFit = false;
+    scheduleTrajectoryRefresh();
+}
+
+void ChartManager::fitTrajectoryAxes()
+{
+    const QRectF bounds = m_trackLod.bounds();
+    double lonRange = bounds.width();
+    double latRange = bounds.height();
+    
+    // 如果范围太小，设置最小范围
+    if (lonRange < 0.0001) {
+        lonRange = 0.0001; // 最小0.0001度范围
     }
+    if (latRange < 0.0001) {
+        latRange = 0.0001; // 最小0.0001度范围
+    }
+    
+    // 添加一些边距
+    double lonMargin = lonRange * 0.5; // 增加边距到50%
+    double latMargin = latRange * 0.5;
+    
+    m_updatingTrajectoryAxes = true;
+    m_trajectoryAxisX->setRange(bounds.left() - lonMargin, bounds.right() + lonMargin);
+    m_trajectoryAxisY->setRange(bounds.top() - latMargin, bounds.bottom() + latMargin);
+    m_updatingTrajectoryAxes = false;
+}
+
+void ChartManager::refreshTrajectoryViewport()
+{
+    if (m_trackLod.isEmpty()) {
+        m_trajectorySeries->clear();
+        return;
+    }
+    
+    if (m_trajectoryAutoFit) {
+        fitTrajectoryAxes();
+    }
+    
+    // 只取当前视口内的点，点数与绘图区像素宽度相当
+    const QRectF viewport(QPointF(m_trajectoryAxisX->min(), m_trajectoryAxisY->min()),
+                          QPointF(m_trajectoryAxisX->max(), m_trajectoryAxisY->max()));
+    const QSizeF plotSize = m_trajectoryChart->plotArea().size();
+    const int maxPoints = qMax(256, int(plotSize.width()) * kPointsPerPixel);
+    
+    m_trajectorySeries->replace(m_trackLod.visiblePoints(viewport, plotSize, maxPoints));
 }
@@ -7,10 +7,13 @@
 #include <QBarSeries>
 #include <QBarSet>
 #include <QScatterSeries>
-#include <QSplineSeries>
+#include <QLineSeries>
 #include <QValueAxis>
 #include <QCategoryAxis>
-#include "gnssdata.h"
+#include <QTimer>
+#include "satellitedata.h"
+#include "epochhistory.h"
+#include "tracklod.h"
 
 QT_CHARTS_USE_NAMESPACE
 
@@ -29,12 +32,24 @@ public:
     // 更新图表数据
     void updateSNRChart(const QList<SatelliteInfo> &satellites);
     void updateRadarChart(const QList<SatelliteInfo> &satellites);
-    void updateTrajectoryChart(const QList<GNSSData> &dataHistory);
+    
+    // 轨迹从历元历史读取；设置新的历史会清空已有轨迹
+    void setHistory(const EpochHistoryPtr &history);
+    // 把历史中新增的历元加入轨迹（只读取上次之后追加的部分）
+    void updateTrajectoryChart();
+    // 恢复自动缩放到完整轨迹
+    void resetTrajectoryZoom();
+
+private slots:
+    void onTrajectoryRangeChanged();
+    void refreshTrajectoryViewport();
 
 private:
     void setupSNRChart();
     void setupRadarChart();
     void setupTrajectoryChart();
+    void scheduleTrajectoryRefresh();
+    void fitTrajectoryAxes();
     
     // 信噪比柱状图
     QChartView *m_snrChartView;
@@ -50,7 +65,17 @@ private:
     // 运动轨迹图
     QChartView *m_trajectoryChartView;
     QChart *m_trajectoryChart;
-    QSplineSeries *m_trajectorySeries;
+    QLineSeries *m_trajectorySeries;
+    QValueAxis *m_trajectoryAxisX;
+    QValueAxis *m_trajectoryAxisY;
+
+    // 多分辨率轨迹存储，序列中只放当前视口内按屏幕分辨率抽稀后的点
+    EpochHistoryPtr m_history;
+    qint64 m_historyRows;          // 已读入轨迹的历元数
+    TrackLod m_trackLod;
+    QTimer *m_trajectoryRefreshTimer;
+    bool m_trajectoryAutoFit;      // 用户缩放/平移后不再自动调整坐标轴
+    bool m_updatingTrajectoryAxes; // 区分程序设置坐标轴和用户操作
 };
 
 #endif // CHARTMANAGER_H
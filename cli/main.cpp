@@ -0,0 +1,237 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
+#include <QJsonDocument>
+#include <QStringList>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <cstdio>
+#include <memory>
+#include "batchprocessor.h"
+#include "receiversource.h"
+#include "networksource.h"
+#include "nmeaframer.h"
+#include "epochring.h"
+
+// 从网络数据源接收一段时间（或一定数量的语句）后输出汇总
+static int inspectSource(QCoreApplication &app, const ReceiverSource &source, int seconds,
+                         qint64 maxSentences, bool json, QTextStream &out, QTextStream &err)
+{
+    std::unique_ptr<NetworkSource> network(source.createNetworkSource());
+    NMEAFramer framer;
+    LogAnalyzer analyzer;
+    analyzer.beginStream(source.toUrl());
+
+    QObject::connect(network.get(), &NetworkSource::bytesReceived, [&](const QByteArray &bytes) {
+        for (const QString &sentence : framer.append(bytes)) {
+            analyzer.addSentence(sentence);
+            if (maxSentences > 0 && framer.sentenceCount() >= maxSentences) {
+                app.quit();
+                break;
+            }
+        }
+    });
+    QObject::connect(network.get(), &NetworkSource::errorOccurred, [&](const QString &message) {
+        err << source.toUrl() << ": " << message << '\n';
+        err.flush();
+    });
+
+    network->openPort();
+    if (seconds > 0) {
+        QTimer::singleShot(seconds * 1000, &app, &QCoreApplication::quit);
+    }
+    app.exec();
+    network->closePort();
+
+    LogSummary summary = analyzer.finishStream();
+    summary.ok = summary.sentences > 0;
+    if (json) {
+        out << QJsonDocument(summary.toJson()).toJson(QJsonDocument::Compact) << '\n';
+    } else {
+        out << summary.toText();
+        out << QString("  分帧丢弃: %1  跳过字节: %2\n").arg(framer.droppedSentences()).arg(framer.skippedBytes());
+    }
+    return summary.ok ? 0 : 1;
+}
+
+// 读取 NMEA Inspector 写入共享内存的历元，每个历元输出一行，附带发布到读取的延迟
+static int followRing(const QString &key, int seconds, bool json, QTextStream &out, QTextStream &err)
+{
+    EpochRingReader reader(key);
+    QString error;
+    if (!reader.attach(&error)) {
+        err << error << '\n';
+        return 1;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    qint64 epochs = 0;
+    SharedEpoch epoch;
+    while (seconds <= 0 || timer.elapsed() < seconds * 1000LL) {
+        if (!reader.waitForNext(epoch, 200)) {
+            continue;
+        }
+        ++epochs;
+        const double latencyUs = (EpochRingReader::nowNs() - epoch.publishedNs) / 1000.0;
+        if (json) {
+            QJsonObject object;
+            object["sequence"] = double(epoch.sequence);
+            object["utcTimeMs"] = double(epoch.utcTimeMs);
+            object["latitude"] = epoch.latitude;
+            object["longitude"] = epoch.longitude;
+            object["altitude"] = epoch.altitude;
+            object["fixQuality"] = epoch.fixQuality;
+            object["satellitesUsed"] = epoch.usedSatelliteCount;
+            object["satellites"] = epoch.satelliteTableSize;
+            object["hdop"] = epoch.hdop;
+            object["latencyUs"] = latencyUs;
+            out << QJsonDocument(object).toJson(QJsonDocument::Compact) << '\n';
+        } else {
+            out << QString("#%1  %2, %3  %4 m  质量 %5  卫星 %6/%7  HDOP %8  延迟 %9 us\n")
+                       .arg(epoch.sequence)
+                       .arg(epoch.latitude, 0, 'f', 7).arg(epoch.longitude, 0, 'f', 7)
+                       .arg(epoch.altitude, 0, 'f', 1)
+                       .arg(epoch.fixQuality)
+                       .arg(epoch.usedSatelliteCount).arg(epoch.satelliteTableSize)
+                       .arg(epoch.hdop, 0, 'f', 1)
+                       .arg(latencyUs, 0, 'f', 1);
+        }
+        out.flush();
+    }
+
+    err << QString("共读取 %1 个历元，因落后跳过 %2 个\n").arg(epochs).arg(reader.missed());
+    return epochs > 0 ? 0 : 1;
+}
+
+// nmea-inspect：不启动图形界面，批量分析 NMEA 日志。
+//
+//     nmea-inspect log1.nmea log2.nmea
+//     nmea-inspect --summary drive_tests/ 'logs/*.nmea'
+//     find logs -name '*.nmea' | nmea-inspect --json > summary.jsonl
+//     nmea-inspect --source tcp://127.0.0.1:10110 --seconds 30
+//     nmea-inspect --ring nmea-inspector-epochs-1
+//
+// 输入可以是文件、目录（递归查找 *.nmea/*.txt）或通配符；没有给出输入时从标准输入
+// 逐行读取。文件在线程池上并行分析，每个文件分析完立即输出（按完成顺序），
+// --sorted 时等全部完成后按路径排序输出。JSON 输出每个文件一行
+// （JSON Lines），便于用 jq 等工具继续处理。有文件无法打开时返回 1。
+// --source 从网络数据源（tcp://、tcp-listen://、udp://）实时接收，没有收到语句时返回 1。
+// --ring 读取图形界面写入共享内存的历元（“🧩 共享内存”），没有读到历元时返回 1。
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("nmea-inspect");
+    app.setApplicationVersion("1.0.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("NMEA 日志分析：语句组成、历元、定位可用率、卫星数、信噪比和校验和错误");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption jsonOption(QStringList() << "j" << "json", "每个文件输出一行 JSON");
+    QCommandLineOption summaryOption(QStringList() << "s" << "summary", "最后输出所有文件的合计");
+    QCommandLineOption sortedOption(QStringList() << "sorted", "全部分析完后按路径排序输出（结果保存在内存中）");
+    QCommandLineOption jobsOption(QStringList() << "jobs", "并行线程数（默认每个核一个）", "n", "0");
+    QCommandLineOption memoryOption(QStringList() << "memory", "同时读入内存的文件总大小上限", "MB", "512");
+    QCommandLineOption sourceOption(QStringList() << "source", "从网络数据源接收：tcp://主机:端口、tcp-listen://:端口、udp://:端口", "url");
+    QCommandLineOption secondsOption(QStringList() << "seconds", "接收时长（秒，0 表示不限）", "s", "60");
+    QCommandLineOption sentencesOption(QStringList() << "sentences", "收到指定条数的语句后结束", "n", "0");
+    QCommandLineOption ringOption(QStringList() << "ring", "读取共享内存中的历元（图形界面中开启“共享内存”）", "key");
+    parser.addOption(jsonOption);
+    parser.addOption(summaryOption);
+    parser.addOption(sortedOption);
+    parser.addOption(jobsOption);
+    parser.addOption(memoryOption);
+    parser.addOption(sourceOption);
+    parser.addOption(secondsOption);
+    parser.addOption(sentencesOption);
+    parser.addOption(ringOption);
+    parser.addPositionalArgument("inputs", "NMEA 日志文件、目录或通配符（省略时从标准输入读取）", "[inputs...]");
+    parser.process(app);
+
+    const bool json = parser.isSet(jsonOption);
+    QTextStream out(stdout);
+    out.setCodec("UTF-8");
+    QTextStream err(stderr);
+    err.setCodec("UTF-8");
+
+    if (parser.isSet(ringOption)) {
+        return followRing(parser.value(ringOption), parser.value(secondsOption).toInt(), json, out, err);
+    }
+
+    if (parser.isSet(sourceOption)) {
+        ReceiverSource source;
+        if (!ReceiverSource::fromUrl(parser.value(sourceOption), source) || !source.isNetwork()) {
+            err << "无法识别的网络数据源: " << parser.value(sourceOption) << '\n';
+            return 2;
+        }
+        return inspectSource(app, source, parser.value(secondsOption).toInt(),
+                             parser.value(sentencesOption).toLongLong(), json, out, err);
+    }
+
+    QStringList inputs = parser.positionalArguments();
+    if (inputs.isEmpty()) {
+        QTextStream in(stdin);
+        QString line;
+        while (in.readLineInto(&line)) {
+            line = line.trimmed();
+            if (!line.isEmpty()) {
+                inputs.append(line);
+            }
+        }
+    }
+
+    // 默认每个文件分析完立即输出并刷新，结果不保存，几千个文件也不会积累在内存里；
+    // 合计只累加一份 LogSummary
+    const bool sorted = parser.isSet(sortedOption);
+    int failures = 0;
+    int fileCount = 0;
+    LogSummary total;
+    total.ok = true;
+    auto printResult = [&](const BatchResult &result) {
+        if (!result.summary.ok) {
+            ++failures;
+            err << "无法打开文件: " << result.path << '\n';
+            err.flush();
+        } else {
+            total.merge(result.summary);
+        }
+        ++fileCount;
+
+        if (json) {
+            out << QJsonDocument(result.summary.toJson()).toJson(QJsonDocument::Compact) << '\n';
+        } else {
+            out << result.summary.toText() << '\n';
+        }
+        out.flush();
+    };
+
+    BatchProcessor processor;
+    processor.setThreadCount(parser.value(jobsOption).toInt());
+    processor.setMemoryBudgetMb(parser.value(memoryOption).toInt());
+    processor.setRetainResults(sorted);
+    if (!sorted) {
+        QObject::connect(&processor, &BatchProcessor::fileFinished, printResult);
+    }
+    QObject::connect(&processor, &BatchProcessor::finished, &app, &QCoreApplication::quit);
+    processor.start(BatchProcessor::expandInputs(inputs));
+    app.exec();
+
+    if (sorted) {
+        for (const BatchResult &result : processor.results()) {
+            printResult(result);
+        }
+    }
+
+    if (parser.isSet(summaryOption)) {
+        total.fileName = QString("合计 (%1 个文件)").arg(fileCount);
+        if (json) {
+            out << QJsonDocument(total.toJson()).toJson(QJsonDocument::Compact) << '\n';
+        } else {
+            out << total.toText() << '\n';
+        }
+    }
+
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,14 @@
+# 命令行日志分析工具，不依赖图形界面（网络数据源需要 QtNetwork）
+QT = core network
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+TARGET = nmea-inspect
+TEMPLATE = app
+
+# 解析器和日志分析在 nmeacore 静态库中
+include(../core/nmeacore.pri)
+
+# 源文件
+SOURCES += \
+    main.cpp
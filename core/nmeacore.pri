@@ -0,0 +1,24 @@
+# 链接 nmeacore 静态库：在使用方的 .pro 中 include(core/nmeacore.pri)
+# 头文件仍在仓库根目录；库的输出目录与 nmeacore.pro 的 DESTDIR 一致
+INCLUDEPATH += $$PWD/..
+DEPENDPATH += $$PWD/..
+
+NMEACORE_OUT = $$shadowed($$PWD)
+CONFIG(debug, debug|release) {
+    NMEACORE_OUT = $$NMEACORE_OUT/debug
+} else {
+    NMEACORE_OUT = $$NMEACORE_OUT/release
+}
+
+LIBS += -L$$NMEACORE_OUT -lnmeacore
+
+# 库更新后重新链接
+win32-msvc* {
+    PRE_TARGETDEPS += $$NMEACORE_OUT/nmeacore.lib
+} else {
+    PRE_TARGETDEPS += $$NMEACORE_OUT/libnmeacore.a
+}
+
+# 串口部分只有用到 SerialManager 时才会被链接进来，
+# 这种情况下使用方自己加上 QT += serialport
+QT *= core
@@ -0,0 +1,86 @@
+# nmeacore：解析器、文件/串口输入、历元历史和统计分析的静态库
+# 不依赖 QtWidgets/QtCharts，图形界面、命令行工具和基准测试共用
+QT = core serialport network
+
+CONFIG += c++17 staticlib
+
+TARGET = nmeacore
+TEMPLATE = lib
+
+# 发布版去掉逐行调试输出，批量处理时影响很大
+CONFIG(release, debug|release): DEFINES += QT_NO_DEBUG_OUTPUT
+
+# 源文件
+SOURCES += \
+    ../nmeaparser.cpp \
+    ../sentenceschema.cpp \
+    ../nmeaframer.cpp \
+    ../nmeagenerator.cpp \
+    ../pseudoterminal.cpp \
+    ../pacedwriter.cpp \
+    ../satellitedata.cpp \
+    ../filemanager.cpp \
+    ../serialmanager.cpp \
+    ../networksource.cpp \
+    ../broadcastserver.cpp \
+    ../receiversource.cpp \
+    ../receiverpipeline.cpp \
+    ../epochhistory.cpp \
+    ../epochring.cpp \
+    ../historyquery.cpp \
+    ../historyexporter.cpp \
+    ../signalstats.cpp \
+    ../dopanalysis.cpp \
+    ../accuracystats.cpp \
+    ../localframe.cpp \
+    ../gstanalysis.cpp \
+    ../anomalydetector.cpp \
+    ../loganalyzer.cpp \
+    ../batchprocessor.cpp \
+    ../tracklod.cpp \
+    ../trackgrid.cpp
+
+# 头文件
+HEADERS += \
+    ../nmeaparser.h \
+    ../sentenceschema.h \
+    ../nmeaframer.h \
+    ../nmeagenerator.h \
+    ../pseudoterminal.h \
+    ../pacedwriter.h \
+    ../satellitedata.h \
+    ../filemanager.h \
+    ../serialmanager.h \
+    ../networksource.h \
+    ../broadcastserver.h \
+    ../receiversource.h \
+    ../receiverpipeline.h \
+    ../epochhistory.h \
+    ../epochring.h \
+    ../historyquery.h \
+    ../historyexporter.h \
+    ../signalstats.h \
+    ../dopanalysis.h \
+    ../accuracystats.h \
+    ../localframe.h \
+    ../gstanalysis.h \
+    ../anomalydetector.h \
+    ../loganalyzer.h \
+    ../batchprocessor.h \
+    ../tracklod.h \
+    ../trackgrid.h \
+    ../gnssdata.h
+
+# 编译配置：调试版和发布版都生成，使用方按自己的配置链接对应的库
+CONFIG += debug_and_release build_all
+CONFIG(debug, debug|release) {
+    DESTDIR = debug
+    OBJECTS_DIR = debug/obj
+    MOC_DIR = debug/moc
+}
+
+CONFIG(release, debug|release) {
+    DESTDIR = release
+    OBJECTS_DIR = release/obj
+    MOC_DIR = release/moc
+}
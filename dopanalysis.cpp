@@ -0,0 +1,268 @@
+#include "dopanalysis.h"
+#include "nmeaparser.h"
+#include <QtMath>
+#include <limits>
+
+static const double kDegToRad = M_PI / 180.0;
+
+void DopSeries::clear()
+{
+    gdop.clear();
+    pdop.clear();
+    hdop.clear();
+    vdop.clear();
+    tdop.clear();
+}
+
+void DopSeries::appendInvalid(int count)
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const int size = pdop.size() + count;
+    gdop.resize(size);
+    pdop.resize(size);
+    hdop.resize(size);
+    vdop.resize(size);
+    tdop.resize(size);
+    for (int i = size - count; i < size; ++i) {
+        gdop[i] = pdop[i] = hdop[i] = vdop[i] = tdop[i] = nan;
+    }
+}
+
+DopBatch::DopBatch()
+{
+}
+
+void DopBatch::clear()
+{
+    m_east.clear();
+    m_north.clear();
+    m_up.clear();
+    m_epochEnd.clear();
+}
+
+void DopBatch::beginEpoch()
+{
+    m_epochEnd.append(m_east.size());
+}
+
+void DopBatch::addLineOfSight(double azimuthDeg, double elevationDeg)
+{
+    const double azimuth = azimuthDeg * kDegToRad;
+    const double elevation = elevationDeg * kDegToRad;
+    const double cosElevation = qCos(elevation);
+    m_east.append(cosElevation * qSin(azimuth));
+    m_north.append(cosElevation * qCos(azimuth));
+    m_up.append(qSin(elevation));
+    m_epochEnd.last() = m_east.size();
+}
+
+// 3x3 行列式
+static inline double det3(double p, double q, double r,
+                          double s, double t, double u,
+                          double v, double w, double x)
+{
+    return p * (t * x - u * w) - q * (s * x - u * v) + r * (s * w - t * v);
+}
+
+void DopBatch::compute(DopSeries &output) const
+{
+    const int epochs = epochCount();
+    if (epochs == 0) {
+        return;
+    }
+
+    // 第一步：每个历元的法方程矩阵 N = G^T G，G 的行为 (e, n, u, 1)。
+    // N 对称，只保存上三角 10 个元素，每个元素一列
+    QVector<double> n00(epochs), n01(epochs), n02(epochs), n03(epochs);
+    QVector<double> n11(epochs), n12(epochs), n13(epochs);
+    QVector<double> n22(epochs), n23(epochs), n33(epochs);
+
+    const double *east = m_east.constData();
+    const double *north = m_north.constData();
+    const double *up = m_up.constData();
+    int begin = 0;
+    for (int epoch = 0; epoch < epochs; ++epoch) {
+        const int end = m_epochEnd[epoch];
+        double ee = 0, en = 0, eu = 0, e1 = 0, nn = 0, nu = 0, n1 = 0, uu = 0, u1 = 0;
+        for (int i = begin; i < end; ++i) {
+            ee += east[i] * east[i];
+            en += east[i] * north[i];
+            eu += east[i] * up[i];
+            e1 += east[i];
+            nn += north[i] * north[i];
+            nu += north[i] * up[i];
+            n1 += north[i];
+            uu += up[i] * up[i];
+            u1 += up[i];
+        }
+        n00[epoch] = ee; n01[epoch] = en; n02[epoch] = eu; n03[epoch] = e1;
+        n11[epoch] = nn; n12[epoch] = nu; n13[epoch] = n1;
+        n22[epoch] = uu; n23[epoch] = u1;
+        n33[epoch] = end - begin;
+        begin = end;
+    }
+
+    // 第二步：逐历元求 N^-1 的对角元（余子式 / 行列式），
+    // 循环体没有分支，无效历元最后统一置为 NaN
+    const int offset = output.size();
+    output.appendInvalid(epochs);
+    float *gdop = output.gdop.data() + offset;
+    float *pdop = output.pdop.data() + offset;
+    float *hdop = output.hdop.data() + offset;
+    float *vdop = output.vdop.data() + offset;
+    float *tdop = output.tdop.data() + offset;
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+
+    for (int i = 0; i < epochs; ++i) {
+        const double a = n00[i], b = n01[i], c = n02[i], d = n03[i];
+        const double e = n11[i], f = n12[i], g = n13[i];
+        const double h = n22[i], k = n23[i];
+        const double m = n33[i];
+
+        // 对角余子式
+        const double c00 = det3(e, f, g, f, h, k, g, k, m);
+        const double c11 = det3(a, c, d, c, h, k, d, k, m);
+        const double c22 = det3(a, b, d, b, e, g, d, g, m);
+        const double c33 = det3(a, b, c, b, e, f, c, f, h);
+
+        // 按第一行展开的行列式
+        const double m01 = det3(b, f, g, c, h, k, d, k, m);
+        const double m02 = det3(b, e, g, c, f, k, d, g, m);
+        const double m03 = det3(b, e, f, c, f, h, d, g, k);
+        const double det = a * c00 - b * m01 + c * m02 - d * m03;
+
+        // 卫星少于 4 颗或几何退化（行列式相对卫星数过小）视为无效
+        const bool valid = m >= 4.0 && det > 1e-10 * m * m * m * m;
+        const double inverse = valid ? 1.0 / det : 0.0;
+        const double qe = c00 * inverse;
+        const double qn = c11 * inverse;
+        const double qu = c22 * inverse;
+        const double qt = c33 * inverse;
+
+        gdop[i] = valid ? float(qSqrt(qe + qn + qu + qt)) : nan;
+        pdop[i] = valid ? float(qSqrt(qe + qn + qu)) : nan;
+        hdop[i] = valid ? float(qSqrt(qe + qn)) : nan;
+        vdop[i] = valid ? float(qSqrt(qu)) : nan;
+        tdop[i] = valid ? float(qSqrt(qt)) : nan;
+    }
+}
+
+DopAnalysis::DopAnalysis()
+    : m_firstTimeMs(0)
+    , m_hasFirstTime(false)
+    , m_pendingCount(0)
+{
+}
+
+void DopAnalysis::clear()
+{
+    m_times.clear();
+    m_firstTimeMs = 0;
+    m_hasFirstTime = false;
+    m_reported.clear();
+    m_computed.clear();
+    m_systemSeries.clear();
+    m_pendingCombined.clear();
+    m_pendingSystems.clear();
+    m_pendingCount = 0;
+}
+
+void DopAnalysis::addEpoch(const SatelliteData &data)
+{
+    if (!m_hasFirstTime) {
+        m_firstTimeMs = data.utcTimeMs;
+        m_hasFirstTime = true;
+    }
+    m_times.append((data.utcTimeMs - m_firstTimeMs) / 1000.0);
+
+    // 接收机报告值（0 表示没有报告）
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    m_reported.gdop.append(nan);
+    m_reported.pdop.append(data.pdop > 0.0 ? float(data.pdop) : nan);
+    m_reported.hdop.append(data.hdop > 0.0 ? float(data.hdop) : nan);
+    m_reported.vdop.append(data.vdop > 0.0 ? float(data.vdop) : nan);
+    m_reported.tdop.append(nan);
+
+    // 所有已出现过的系统都开始一个新历元，保证各批次的历元对齐
+    m_pendingCombined.beginEpoch();
+    for (auto it = m_pendingSystems.begin(); it != m_pendingSystems.end(); ++it) {
+        it.value().beginEpoch();
+    }
+
+    for (const SatelliteInfo &satellite : data.satellites) {
+        // 只使用 GSA 列出的、方位仰角有效的卫星
+        if (!satellite.used || satellite.elevation < 0 || satellite.elevation > 90
+            || (satellite.elevation == 0 && satellite.azimuth == 0)) {
+            continue;
+        }
+
+        m_pendingCombined.addLineOfSight(satellite.azimuth, satellite.elevation);
+
+        auto it = m_pendingSystems.find(satellite.system);
+        if (it == m_pendingSystems.end()) {
+            // 新出现的系统：补齐本批次中之前的空历元
+            it = m_pendingSystems.insert(satellite.system, DopBatch());
+            for (int i = 0; i <= m_pendingCount; ++i) {
+                it.value().beginEpoch();
+            }
+        }
+        it.value().addLineOfSight(satellite.azimuth, satellite.elevation);
+    }
+
+    ++m_pendingCount;
+    if (m_pendingCount >= BatchEpochs) {
+        flush();
+    }
+}
+
+void DopAnalysis::flush()
+{
+    if (m_pendingCount == 0) {
+        return;
+    }
+
+    const int solved = m_computed.size();
+    m_pendingCombined.compute(m_computed);
+    m_pendingCombined.clear();
+
+    for (auto it = m_pendingSystems.begin(); it != m_pendingSystems.end(); ++it) {
+        DopSeries &series = m_systemSeries[it.key()];
+        // 该系统出现之前的历元为 NaN
+        if (series.size() < solved) {
+            series.appendInvalid(solved - series.size());
+        }
+        it.value().compute(series);
+    }
+    m_pendingSystems.clear();
+    m_pendingCount = 0;
+
+    // 本批次没有出现的系统同样补齐
+    for (auto it = m_systemSeries.begin(); it != m_systemSeries.end(); ++it) {
+        if (it.value().size() < m_computed.size()) {
+            it.value().appendInvalid(m_computed.size() - it.value().size());
+        }
+    }
+}
+
+int DopAnalysis::reprocess(const QStringList &lines)
+{
+    clear();
+
+    NMEAParser parser;
+    QObject::connect(&parser, &NMEAParser::epochCompleted, [this](const SatelliteData &data) {
+        addEpoch(data);
+    });
+    for (const QString &line : lines) {
+        parser.parseNMEASentence(line);
+    }
+    parser.flushEpoch();
+    flush();
+    return size();
+}
+
+const DopSeries &DopAnalysis::systemSeries(const QString &system) const
+{
+    static const DopSeries empty;
+    auto it = m_systemSeries.constFind(system);
+    return it == m_systemSeries.constEnd() ? empty : it.value();
+}
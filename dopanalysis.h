@@ -0,0 +1,89 @@
+#ifndef DOPANALYSIS_H
+#define DOPANALYSIS_H
+
+#include <QVector>
+#include <QMap>
+#include <QStringList>
+#include "satellitedata.h"
+
+// 一组 DOP 时间序列（按列存放），无效值为 NaN
+struct DopSeries {
+    QVector<float> gdop;
+    QVector<float> pdop;
+    QVector<float> hdop;
+    QVector<float> vdop;
+    QVector<float> tdop;
+
+    int size() const { return pdop.size(); }
+    void clear();
+    void appendInvalid(int count);
+};
+
+// 批量几何内核：一次收集多个历元的视线方向（ENU 单位向量，按列存放），
+// 然后对整批历元构造 4x4 法方程矩阵 G^T G 并求逆矩阵的对角元。
+// 求逆对每个历元是同样的一串无分支运算，逐列遍历时编译器可以向量化。
+// 单一接收机钟差模型：每个历元一个 4 维状态（东、北、天、钟差）。
+class DopBatch
+{
+public:
+    DopBatch();
+
+    void clear();
+    // 开始一个新历元，之后的视线方向都属于这个历元
+    void beginEpoch();
+    void addLineOfSight(double azimuthDeg, double elevationDeg);
+
+    int epochCount() const { return m_epochEnd.size(); }
+
+    // 求解整批历元并追加到 output；卫星少于 4 颗或几何退化的历元为 NaN
+    void compute(DopSeries &output) const;
+
+private:
+    QVector<double> m_east;
+    QVector<double> m_north;
+    QVector<double> m_up;
+    QVector<int> m_epochEnd;   // 每个历元最后一颗卫星之后的位置
+};
+
+// 按历元独立计算 DOP 并与接收机报告值对比。
+// addEpoch 只缓存几何（O(卫星数)），flush 时整批求解，
+// 合成解使用所有 GSA 列出的卫星，另外按卫星系统分别求解。
+class DopAnalysis
+{
+public:
+    enum { BatchEpochs = 4096 };
+
+    DopAnalysis();
+
+    void clear();
+    void addEpoch(const SatelliteData &data);
+    void flush();
+
+    // 离线重新处理整个日志（加载文件时）：清空后逐历元缓存，按 BatchEpochs 整批求解，返回历元数
+    int reprocess(const QStringList &lines);
+
+    int size() const { return m_times.size(); }
+    // 相对第一个历元的秒数
+    const QVector<double> &times() const { return m_times; }
+    const DopSeries &computed() const { return m_computed; }
+    const DopSeries &reported() const { return m_reported; }
+
+    QStringList systems() const { return m_systemSeries.keys(); }
+    const DopSeries &systemSeries(const QString &system) const;
+
+private:
+    QVector<double> m_times;
+    qint64 m_firstTimeMs;
+    bool m_hasFirstTime;
+
+    DopSeries m_reported;
+    DopSeries m_computed;
+    QMap<QString, DopSeries> m_systemSeries;
+
+    // 尚未求解的历元
+    DopBatch m_pendingCombined;
+    QMap<QString, DopBatch> m_pendingSystems;
+    int m_pendingCount;
+};
+
+#endif // DOPANALYSIS_H
@@ -0,0 +1,244 @@
+#include "dopview.h"
+#include <QVBoxLayout>
+#include <QtMath>
+
+// 每条曲线最多送给图表的点数（按桶保留最小值和最大值）
+static const int kMaxChartPoints = 2000;
+
+// 合并刷新的间隔：高频数据时每秒最多求解、重绘几次
+static const int kRefreshIntervalMs = 250;
+
+// 计算值与报告值之差，[begin, end) 按 bucket 个历元分桶后每桶保留最小、最大两个点
+static QVector<QPointF> discrepancyPoints(const QVector<double> &times,
+                                          const QVector<float> &computed,
+                                          const QVector<float> &reported,
+                                          int begin, int end, int bucket,
+                                          double &minValue, double &maxValue)
+{
+    QVector<QPointF> points;
+    points.reserve(qMin(end - begin, 2 * ((end - begin) / bucket + 1)));
+
+    for (int first = begin; first < end; first += bucket) {
+        const int last = qMin(end, first + bucket);
+        int minIndex = -1;
+        int maxIndex = -1;
+        for (int i = first; i < last; ++i) {
+            const float delta = computed[i] - reported[i];
+            if (qIsNaN(delta)) {
+                continue;
+            }
+            if (minIndex < 0 || delta < computed[minIndex] - reported[minIndex]) minIndex = i;
+            if (maxIndex < 0 || delta > computed[maxIndex] - reported[maxIndex]) maxIndex = i;
+        }
+        if (minIndex < 0) {
+            continue;
+        }
+
+        const int left = qMin(minIndex, maxIndex);
+        const int right = qMax(minIndex, maxIndex);
+        points.append(QPointF(times[left], computed[left] - reported[left]));
+        if (right != left) {
+            points.append(QPointF(times[right], computed[right] - reported[right]));
+        }
+        minValue = qMin(minValue, double(computed[minIndex] - reported[minIndex]));
+        maxValue = qMax(maxValue, double(computed[maxIndex] - reported[maxIndex]));
+    }
+    return points;
+}
+
+DopView::DopView(QWidget *parent)
+    : QWidget(parent)
+    , m_analysis(nullptr)
+    , m_refreshTimer(new QTimer(this))
+    , m_stale(false)
+    , m_bucketSize(1)
+    , m_plotted(0)
+    , m_minValue(0.0)
+    , m_maxValue(0.0)
+{
+    setWindowTitle("📐 DOP校验");
+    setupUI();
+
+    m_refreshTimer->setSingleShot(true);
+    m_refreshTimer->setInterval(kRefreshIntervalMs);
+    connect(m_refreshTimer, &QTimer::timeout, this, &DopView::refresh);
+}
+
+void DopView::setupUI()
+{
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(8, 8, 8, 8);
+
+    m_summaryLabel = new QLabel("等待GSA/GSV数据...", this);
+    m_summaryLabel->setStyleSheet("QLabel { font-size: 9pt; color: #2c3e50; }");
+    m_summaryLabel->setWordWrap(true);
+    mainLayout->addWidget(m_summaryLabel);
+
+    m_chart = new QChart();
+    m_chart->setTitle("DOP 差值 (计算值 - 接收机报告值)");
+    m_chart->setAnimationOptions(QChart::NoAnimation);
+
+    m_pdopSeries = new QLineSeries();
+    m_pdopSeries->setName("ΔPDOP");
+    m_pdopSeries->setColor(QColor(231, 76, 60));
+    m_hdopSeries = new QLineSeries();
+    m_hdopSeries->setName("ΔHDOP");
+    m_hdopSeries->setColor(QColor(52, 152, 219));
+    m_vdopSeries = new QLineSeries();
+    m_vdopSeries->setName("ΔVDOP");
+    m_vdopSeries->setColor(QColor(39, 174, 96));
+    m_chart->addSeries(m_pdopSeries);
+    m_chart->addSeries(m_hdopSeries);
+    m_chart->addSeries(m_vdopSeries);
+
+    m_axisX = new QValueAxis();
+    m_axisX->setTitleText("时间 (秒)");
+    m_axisX->setLabelFormat("%.0f");
+    m_chart->addAxis(m_axisX, Qt::AlignBottom);
+    m_axisY = new QValueAxis();
+    m_axisY->setTitleText("差值");
+    m_chart->addAxis(m_axisY, Qt::AlignLeft);
+    for (QLineSeries *series : {m_pdopSeries, m_hdopSeries, m_vdopSeries}) {
+        series->attachAxis(m_axisX);
+        series->attachAxis(m_axisY);
+    }
+
+    m_chartView = new QChartView(m_chart, this);
+    m_chartView->setRenderHint(QPainter::Antialiasing);
+    mainLayout->addWidget(m_chartView, 1);
+}
+
+void DopView::setAnalysis(DopAnalysis *analysis)
+{
+    m_analysis = analysis;
+    reload();
+}
+
+void DopView::epochsAdded()
+{
+    if (!m_refreshTimer->isActive()) {
+        m_refreshTimer->start();
+    }
+}
+
+void DopView::reload()
+{
+    m_plotted = 0;
+    m_bucketSize = 1;
+    m_pdopSeries->clear();
+    m_hdopSeries->clear();
+    m_vdopSeries->clear();
+    m_refreshTimer->stop();
+    refresh();
+}
+
+void DopView::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    if (m_stale) {
+        refresh();
+    }
+}
+
+void DopView::refresh()
+{
+    if (!m_analysis) {
+        return;
+    }
+    // 隐藏时不求解也不绘制，重新显示时一次补齐
+    if (!isVisible()) {
+        m_stale = true;
+        return;
+    }
+    m_stale = false;
+
+    // 缓存的历元在显示前统一批量求解
+    m_analysis->flush();
+    refreshSummary();
+
+    // 抽稀后的点数超过上限时加大桶重建，否则只追加新增的完整桶
+    const int count = m_analysis->size();
+    if (count < m_plotted || m_pdopSeries->count() > 2 * kMaxChartPoints) {
+        rebuildChart();
+    } else {
+        appendChart();
+    }
+}
+
+void DopView::refreshSummary()
+{
+    const int last = m_analysis->size() - 1;
+    if (last < 0) {
+        m_summaryLabel->setText("等待GSA/GSV数据...");
+        return;
+    }
+
+    auto format = [](float value) {
+        return qIsNaN(value) ? QString("-") : QString::number(value, 'f', 2);
+    };
+
+    const DopSeries &computed = m_analysis->computed();
+    const DopSeries &reported = m_analysis->reported();
+    QString text = QString("合成解  PDOP %1 / 报告 %2    HDOP %3 / 报告 %4    VDOP %5 / 报告 %6")
+                   .arg(format(computed.pdop[last])).arg(format(reported.pdop[last]))
+                   .arg(format(computed.hdop[last])).arg(format(reported.hdop[last]))
+                   .arg(format(computed.vdop[last])).arg(format(reported.vdop[last]));
+
+    QStringList systemTexts;
+    for (const QString &system : m_analysis->systems()) {
+        const DopSeries &series = m_analysis->systemSeries(system);
+        if (last < series.size()) {
+            systemTexts.append(QString("%1 PDOP %2").arg(system).arg(format(series.pdop[last])));
+        }
+    }
+    if (!systemTexts.isEmpty()) {
+        text += "\n各系统单独解:  " + systemTexts.join("    ");
+    }
+    m_summaryLabel->setText(text);
+}
+
+void DopView::rebuildChart()
+{
+    const int count = m_analysis->size();
+    m_bucketSize = qMax(1, (count * 2 + kMaxChartPoints - 1) / kMaxChartPoints);
+    m_plotted = 0;
+    m_minValue = 0.0;
+    m_maxValue = 0.0;
+    m_pdopSeries->clear();
+    m_hdopSeries->clear();
+    m_vdopSeries->clear();
+    appendChart();
+}
+
+void DopView::appendChart()
+{
+    const QVector<double> &times = m_analysis->times();
+    const DopSeries &computed = m_analysis->computed();
+    const DopSeries &reported = m_analysis->reported();
+
+    // 只画完整的桶，最后不满一桶的历元等下次刷新
+    const int count = qMin(times.size(), computed.size());
+    const int end = count / m_bucketSize * m_bucketSize;
+    if (end <= m_plotted) {
+        return;
+    }
+
+    m_pdopSeries->append(discrepancyPoints(times, computed.pdop, reported.pdop, m_plotted, end,
+                                           m_bucketSize, m_minValue, m_maxValue).toList());
+    m_hdopSeries->append(discrepancyPoints(times, computed.hdop, reported.hdop, m_plotted, end,
+                                           m_bucketSize, m_minValue, m_maxValue).toList());
+    m_vdopSeries->append(discrepancyPoints(times, computed.vdop, reported.vdop, m_plotted, end,
+                                           m_bucketSize, m_minValue, m_maxValue).toList());
+    m_plotted = end;
+    updateAxes();
+}
+
+void DopView::updateAxes()
+{
+    const QVector<double> &times = m_analysis->times();
+    if (!times.isEmpty()) {
+        m_axisX->setRange(times.first(), qMax(times.last(), times.first() + 1.0));
+    }
+    const double margin = qMax(0.1, (m_maxValue - m_minValue) * 0.1);
+    m_axisY->setRange(m_minValue - margin, m_maxValue + margin);
+}
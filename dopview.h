@@ -0,0 +1,68 @@
+#ifndef DOPVIEW_H
+#define DOPVIEW_H
+
+#include <QWidget>
+#include <QLabel>
+#include <QChart>
+#include <QChartView>
+#include <QLineSeries>
+#include <QValueAxis>
+#include <QTimer>
+#include "satellitedata.h"
+#include "dopanalysis.h"
+
+QT_CHARTS_USE_NAMESPACE
+
+// DOP 校验视图：用 GSA 卫星的方位仰角独立计算的 DOP 与接收机报告值之差的时间序列，
+// 以及最新历元合成解和各卫星系统单独解的 PDOP。
+// 按完整历元驱动：新历元只启动合并定时器，到期后整批求解并只追加新增的点。
+class DopView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit DopView(QWidget *parent = nullptr);
+
+    // DOP 分析由主窗口维护，这里只读取显示
+    void setAnalysis(DopAnalysis *analysis);
+
+    // 分析中追加了新历元（主窗口每个完整历元调用一次）
+    void epochsAdded();
+    // 分析被清空或整体重新处理后从头重建图表
+    void reload();
+
+protected:
+    void showEvent(QShowEvent *event) override;
+
+private slots:
+    void refresh();
+
+private:
+    void setupUI();
+    void rebuildChart();
+    void appendChart();
+    void updateAxes();
+    void refreshSummary();
+
+    DopAnalysis *m_analysis;
+    QTimer *m_refreshTimer;
+    bool m_stale;
+
+    // 图表按桶抽稀：每桶 m_bucketSize 个历元保留最小、最大两个点，
+    // 已画到第 m_plotted 个历元（只包含完整的桶）
+    int m_bucketSize;
+    int m_plotted;
+    double m_minValue;
+    double m_maxValue;
+
+    QLabel *m_summaryLabel;
+    QChartView *m_chartView;
+    QChart *m_chart;
+    QLineSeries *m_pdopSeries;
+    QLineSeries *m_hdopSeries;
+    QLineSeries *m_vdopSeries;
+    QValueAxis *m_axisX;
+    QValueAxis *m_axisY;
+};
+
+#endif // DOPVIEW_H
@@ -0,0 +1,149 @@
+#include "epochhistory.h"
+#include <QDebug>
+#include <limits>
+
+EpochHistory::Row::Row()
+    : timeMs(0), latitude(0.0), longitude(0.0), altitude(0.0),
+      hdop(0.0f), pdop(0.0f), vdop(0.0f), speed(0.0f), course(0.0f),
+      fixQuality(0), satellitesUsed(0)
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    gstRms = gstMajor = gstMinor = gstOrientation = nan;
+    gstSigmaLat = gstSigmaLon = gstSigmaAlt = nan;
+}
+
+EpochHistory::EpochHistory()
+    : m_chunks(new std::atomic<Chunk *>[MaxChunks])
+    , m_size(0)
+{
+    for (int i = 0; i < MaxChunks; ++i) {
+        m_chunks[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+EpochHistory::~EpochHistory()
+{
+    for (int i = 0; i < MaxChunks; ++i) {
+        Chunk *chunk = m_chunks[i].load(std::memory_order_relaxed);
+        if (!chunk) {
+            break;
+        }
+        delete chunk;
+    }
+}
+
+EpochHistory::Row EpochHistory::rowFromData(const SatelliteData &data)
+{
+    Row row;
+    row.timeMs = data.utcTimeMs;
+    row.latitude = data.latitude;
+    row.longitude = data.longitude;
+    row.altitude = data.altitude;
+    row.hdop = float(data.hdop);
+    row.pdop = float(data.pdop);
+    row.vdop = float(data.vdop);
+    row.speed = float(data.speed);
+    row.course = float(data.course);
+    row.fixQuality = quint8(qBound(0, data.fixQuality, 255));
+    row.satellitesUsed = quint8(qBound(0, data.usedSatelliteCount, 255));
+    if (data.hasGst) {
+        row.gstRms = float(data.gstRms);
+        row.gstMajor = float(data.gstMajor);
+        row.gstMinor = float(data.gstMinor);
+        row.gstOrientation = float(data.gstOrientation);
+        row.gstSigmaLat = float(data.gstSigmaLat);
+        row.gstSigmaLon = float(data.gstSigmaLon);
+        row.gstSigmaAlt = float(data.gstSigmaAlt);
+    }
+    return row;
+}
+
+bool EpochHistory::append(const Row &row)
+{
+    // 只有写者修改 m_size，这里用 relaxed 读取即可
+    const qint64 index = m_size.load(std::memory_order_relaxed);
+    const int chunkIndex = chunkOf(index);
+    if (chunkIndex >= MaxChunks) {
+        qDebug() << "历元历史已满:" << index;
+        return false;
+    }
+
+    Chunk *chunk = m_chunks[chunkIndex].load(std::memory_order_relaxed);
+    if (!chunk) {
+        chunk = new Chunk;
+        m_chunks[chunkIndex].store(chunk, std::memory_order_release);
+    }
+
+    const int offset = offsetOf(index);
+    chunk->timeMs[offset] = row.timeMs;
+    chunk->latitude[offset] = row.latitude;
+    chunk->longitude[offset] = row.longitude;
+    chunk->altitude[offset] = row.altitude;
+    chunk->hdop[offset] = row.hdop;
+    chunk->pdop[offset] = row.pdop;
+    chunk->vdop[offset] = row.vdop;
+    chunk->speed[offset] = row.speed;
+    chunk->course[offset] = row.course;
+    chunk->fixQuality[offset] = row.fixQuality;
+    chunk->satellitesUsed[offset] = row.satellitesUsed;
+    chunk->gstRms[offset] = row.gstRms;
+    chunk->gstMajor[offset] = row.gstMajor;
+    chunk->gstMinor[offset] = row.gstMinor;
+    chunk->gstOrientation[offset] = row.gstOrientation;
+    chunk->gstSigmaLat[offset] = row.gstSigmaLat;
+    chunk->gstSigmaLon[offset] = row.gstSigmaLon;
+    chunk->gstSigmaAlt[offset] = row.gstSigmaAlt;
+
+    // 更新块的区间摘要
+    ChunkSummary &summary = chunk->summary;
+    if (offset == 0) {
+        summary.minTimeMs = summary.maxTimeMs = row.timeMs;
+        summary.timeSorted = true;
+        summary.fixQualityMask = fixQualityBit(row.fixQuality);
+        summary.minHdop = summary.maxHdop = row.hdop;
+        summary.minSatellitesUsed = summary.maxSatellitesUsed = row.satellitesUsed;
+    } else {
+        summary.timeSorted = summary.timeSorted && row.timeMs >= chunk->timeMs[offset - 1];
+        summary.minTimeMs = qMin(summary.minTimeMs, row.timeMs);
+        summary.maxTimeMs = qMax(summary.maxTimeMs, row.timeMs);
+        summary.fixQualityMask |= fixQualityBit(row.fixQuality);
+        summary.minHdop = qMin(summary.minHdop, row.hdop);
+        summary.maxHdop = qMax(summary.maxHdop, row.hdop);
+        summary.minSatellitesUsed = qMin(summary.minSatellitesUsed, row.satellitesUsed);
+        summary.maxSatellitesUsed = qMax(summary.maxSatellitesUsed, row.satellitesUsed);
+    }
+
+    // 整行写完后再发布，读者看到新的行数时该行数据已经完整
+    m_size.store(index + 1, std::memory_order_release);
+    return true;
+}
+
+EpochHistory::Row EpochHistory::row(qint64 index) const
+{
+    Row row;
+    const Chunk *chunk = m_chunks[chunkOf(index)].load(std::memory_order_acquire);
+    if (!chunk) {
+        return row;
+    }
+
+    const int offset = offsetOf(index);
+    row.timeMs = chunk->timeMs[offset];
+    row.latitude = chunk->latitude[offset];
+    row.longitude = chunk->longitude[offset];
+    row.altitude = chunk->altitude[offset];
+    row.hdop = chunk->hdop[offset];
+    row.pdop = chunk->pdop[offset];
+    row.vdop = chunk->vdop[offset];
+    row.speed = chunk->speed[offset];
+    row.course = chunk->course[offset];
+    row.fixQuality = chunk->fixQuality[offset];
+    row.satellitesUsed = chunk->satellitesUsed[offset];
+    row.gstRms = chunk->gstRms[offset];
+    row.gstMajor = chunk->gstMajor[offset];
+    row.gstMinor = chunk->gstMinor[offset];
+    row.gstOrientation = chunk->gstOrientation[offset];
+    row.gstSigmaLat = chunk->gstSigmaLat[offset];
+    row.gstSigmaLon = chunk->gstSigmaLon[offset];
+    row.gstSigmaAlt = chunk->gstSigmaAlt[offset];
+    return row;
+}
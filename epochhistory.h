@@ -0,0 +1,154 @@
+#ifndef EPOCHHISTORY_H
+#define EPOCHHISTORY_H
+
+#include <QtGlobal>
+#include <QSharedPointer>
+#include <atomic>
+#include <memory>
+#include "satellitedata.h"
+
+// 一段连续列数据的只读视图，直接指向历史存储，不拷贝
+template <typename T>
+struct ColumnSpan {
+    const T *data;
+    int size;
+
+    ColumnSpan() : data(nullptr), size(0) {}
+    ColumnSpan(const T *d, int s) : data(d), size(s) {}
+
+    const T &operator[](int index) const { return data[index]; }
+    const T *begin() const { return data; }
+    const T *end() const { return data + size; }
+    bool isEmpty() const { return size == 0; }
+};
+
+// 历元历史：按列存储、只追加。
+// 数据按 4096 行分块，块内每一列是一段连续数组；块目录大小固定，
+// 追加时已有数据不会移动，读者拿到的列指针一直有效。
+//
+// 并发约定：单写者、多读者。写者写完一行的所有列之后，以 release 语义发布行数；
+// 读者先以 acquire 语义读取 size()，之后访问 [0, size) 内的数据不需要加锁。
+// 历史不支持清空：开始新的回放时创建新的 EpochHistory，旧读者持有的
+// EpochHistoryPtr 仍可安全读取旧数据。
+class EpochHistory
+{
+public:
+    enum {
+        ChunkShift = 12,
+        ChunkRows = 1 << ChunkShift,   // 每块 4096 个历元
+        MaxChunks = 1 << 15            // 最多约 1.3 亿个历元
+    };
+
+    // 数据块的区间摘要（zone map），查询时据此整块跳过
+    struct ChunkSummary {
+        qint64 minTimeMs;
+        qint64 maxTimeMs;
+        bool timeSorted;               // 块内时间是否单调不减（可以二分查找）
+        quint32 fixQualityMask;        // 出现过的定位质量，第 n 位表示质量 n（大于 31 的记在第 31 位）
+        float minHdop;
+        float maxHdop;
+        quint8 minSatellitesUsed;
+        quint8 maxSatellitesUsed;
+    };
+
+    static quint32 fixQualityBit(int fixQuality) { return 1u << qBound(0, fixQuality, 31); }
+
+    // 一个数据块：每一列一个定长数组
+    struct Chunk {
+        ChunkSummary summary;          // 写者追加时更新，块写满之后才对读者有效
+        qint64 timeMs[ChunkRows];      // UTC 毫秒（有日期时为 Unix 时间，否则为当天毫秒数）
+        double latitude[ChunkRows];
+        double longitude[ChunkRows];
+        double altitude[ChunkRows];
+        float hdop[ChunkRows];
+        float pdop[ChunkRows];
+        float vdop[ChunkRows];
+        float speed[ChunkRows];        // m/s
+        float course[ChunkRows];       // 度
+        quint8 fixQuality[ChunkRows];  // GGA 定位质量
+        quint8 satellitesUsed[ChunkRows];
+        // GST 误差估计（米，没有 GST 时为 NaN）
+        float gstRms[ChunkRows];
+        float gstMajor[ChunkRows];
+        float gstMinor[ChunkRows];
+        float gstOrientation[ChunkRows];   // 度
+        float gstSigmaLat[ChunkRows];
+        float gstSigmaLon[ChunkRows];
+        float gstSigmaAlt[ChunkRows];
+    };
+
+    // 一行（一个历元）的数据，用于追加和随机读取
+    struct Row {
+        qint64 timeMs;
+        double latitude;
+        double longitude;
+        double altitude;
+        float hdop;
+        float pdop;
+        float vdop;
+        float speed;
+        float course;
+        quint8 fixQuality;
+        quint8 satellitesUsed;
+        float gstRms;
+        float gstMajor;
+        float gstMinor;
+        float gstOrientation;
+        float gstSigmaLat;
+        float gstSigmaLon;
+        float gstSigmaAlt;
+
+        Row();
+    };
+
+    EpochHistory();
+    ~EpochHistory();
+
+    static Row rowFromData(const SatelliteData &data);
+
+    // 写者接口（只能在一个线程中调用），容量用尽时返回 false
+    bool append(const Row &row);
+
+    // 读者接口
+    qint64 size() const { return m_size.load(std::memory_order_acquire); }
+    bool isEmpty() const { return size() == 0; }
+
+    // rows 为读者此前从 size() 取得的行数
+    static int chunkCount(qint64 rows) { return int((rows + ChunkRows - 1) >> ChunkShift); }
+    static int chunkRows(int chunkIndex, qint64 rows)
+    {
+        return int(qMin<qint64>(ChunkRows, rows - (qint64(chunkIndex) << ChunkShift)));
+    }
+    static int chunkOf(qint64 index) { return int(index >> ChunkShift); }
+    static int offsetOf(qint64 index) { return int(index & (ChunkRows - 1)); }
+
+    // 某一列在某个数据块中的连续数据，例如
+    // history->column(&EpochHistory::Chunk::latitude, chunk, rows)
+    template <typename T>
+    ColumnSpan<T> column(T (Chunk::*member)[ChunkRows], int chunkIndex, qint64 rows) const
+    {
+        const Chunk *chunk = m_chunks[chunkIndex].load(std::memory_order_acquire);
+        return ColumnSpan<T>(chunk->*member, chunkRows(chunkIndex, rows));
+    }
+
+    Row row(qint64 index) const;
+
+    // 已写满的数据块的区间摘要；块在 rows 行内尚未写满时返回 nullptr（读者需要逐行判断）
+    const ChunkSummary *summary(int chunkIndex, qint64 rows) const
+    {
+        if (chunkRows(chunkIndex, rows) < ChunkRows) {
+            return nullptr;
+        }
+        return &m_chunks[chunkIndex].load(std::memory_order_acquire)->summary;
+    }
+
+private:
+    Q_DISABLE_COPY(EpochHistory)
+
+    std::unique_ptr<std::atomic<Chunk *>[]> m_chunks;
+    std::atomic<qint64> m_size;
+};
+
+typedef QSharedPointer<EpochHistory> EpochHistoryPtr;
+
+#endif // EPOCHHISTORY_H
@@ -0,0 +1,331 @@
+#include "epochring.h"
+#include <QSharedMemory>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QDebug>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+// 等待新历元时先自旋的次数，之后改为短暂睡眠
+static const int kSpinCount = 1000;
+static const unsigned long kPollIntervalUs = 50;
+
+static qint64 ringSize(quint32 slotCount)
+{
+    return qint64(sizeof(EpochRingHeader)) + qint64(slotCount) * qint64(sizeof(EpochRingSlot));
+}
+
+QString EpochRingWriter::nativeKey(const QString &key)
+{
+#if defined(Q_OS_WIN)
+    return key;
+#elif defined(QT_POSIX_IPC)
+    return "/" + key;
+#else
+    // System V 用 ftok(路径, 'Q') 得到键，路径必须是存在的文件
+    return QDir::tempPath() + "/" + key;
+#endif
+}
+
+EpochRingWriter::EpochRingWriter(const QString &key, int slotCount)
+    : m_key(key)
+    , m_slotCount(qMax(2, slotCount))
+    , m_memory(nullptr)
+    , m_header(nullptr)
+    , m_slots(nullptr)
+    , m_published(0)
+{
+}
+
+EpochRingWriter::~EpochRingWriter()
+{
+    close();
+}
+
+bool EpochRingWriter::create(QString *errorMessage)
+{
+    close();
+
+    const int size = int(ringSize(quint32(m_slotCount)));
+    m_memory = new QSharedMemory;
+    m_memory->setNativeKey(nativeKey(m_key));
+    bool ok = m_memory->create(size);
+    if (!ok && m_memory->error() == QSharedMemory::AlreadyExists) {
+        // 上次异常退出留下的共享内存：附加后分离即可释放（没有其他进程在用时），然后重新创建
+        if (m_memory->attach()) {
+            m_memory->detach();
+        }
+        ok = m_memory->create(size);
+    }
+    if (!ok) {
+        if (errorMessage) {
+            *errorMessage = QString("无法创建共享内存 %1: %2").arg(m_memory->nativeKey()).arg(m_memory->errorString());
+        }
+        delete m_memory;
+        m_memory = nullptr;
+        return false;
+    }
+
+    char *base = static_cast<char *>(m_memory->data());
+    std::memset(base, 0, size_t(size));
+    m_header = reinterpret_cast<EpochRingHeader *>(base);
+    m_slots = reinterpret_cast<EpochRingSlot *>(base + sizeof(EpochRingHeader));
+    m_header->version = EpochRingHeader::Version;
+    m_header->slotCount = quint32(m_slotCount);
+    m_header->slotSize = quint32(sizeof(EpochRingSlot));
+    m_header->published.store(0, std::memory_order_relaxed);
+    // magic 最后写入，读者看到 magic 时其他字段已经有效
+    std::atomic_thread_fence(std::memory_order_release);
+    m_header->magic = EpochRingHeader::Magic;
+    m_published = 0;
+
+    qDebug() << "历元共享内存:" << m_memory->nativeKey() << m_slotCount << "个槽," << size << "字节";
+    return true;
+}
+
+void EpochRingWriter::close()
+{
+    if (m_memory) {
+        m_memory->detach();
+        delete m_memory;
+        m_memory = nullptr;
+    }
+    m_header = nullptr;
+    m_slots = nullptr;
+}
+
+bool EpochRingWriter::isOpen() const
+{
+    return m_memory != nullptr;
+}
+
+void EpochRingWriter::publish(const SatelliteData &data)
+{
+    if (!m_header) {
+        return;
+    }
+
+    const quint64 n = m_published + 1;
+    EpochRingSlot &slot = m_slots[(n - 1) % quint64(m_slotCount)];
+
+    // 奇数 seq 表示正在写，读者看到后会重读
+    slot.seq.store(2 * n - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    fillEpoch(data, slot.epoch);
+    slot.epoch.sequence = n;
+    slot.epoch.publishedNs = EpochRingReader::nowNs();
+
+    slot.seq.store(2 * n, std::memory_order_release);
+    m_header->published.store(n, std::memory_order_release);
+    m_published = n;
+}
+
+void EpochRingWriter::fillEpoch(const SatelliteData &data, SharedEpoch &epoch)
+{
+    epoch.utcTimeMs = data.utcTimeMs;
+    epoch.latitude = data.latitude;
+    epoch.longitude = data.longitude;
+    epoch.altitude = data.altitude;
+    epoch.speed = data.speed;
+    epoch.course = data.course;
+    epoch.hdop = data.hdop;
+    epoch.pdop = data.pdop;
+    epoch.vdop = data.vdop;
+    epoch.hasGst = data.hasGst ? 1 : 0;
+    epoch.gstRms = data.gstRms;
+    epoch.gstMajor = data.gstMajor;
+    epoch.gstMinor = data.gstMinor;
+    epoch.gstOrientation = data.gstOrientation;
+    epoch.gstSigmaLat = data.gstSigmaLat;
+    epoch.gstSigmaLon = data.gstSigmaLon;
+    epoch.gstSigmaAlt = data.gstSigmaAlt;
+    epoch.fixQuality = data.fixQuality;
+    epoch.satelliteCount = data.satelliteCount;
+    epoch.usedSatelliteCount = data.usedSatelliteCount;
+    epoch.checksumErrors = data.checksumErrors;
+
+    const int count = qMin(data.satellites.size(), int(SharedEpoch::MaxSatellites));
+    for (int i = 0; i < count; ++i) {
+        const SatelliteInfo &info = data.satellites.at(i);
+        SharedSatellite &sat = epoch.satellites[i];
+        sat.prn = qint16(info.id);
+        sat.elevation = qint16(info.elevation);
+        sat.azimuth = qint16(info.azimuth);
+        sat.snr = qint16(info.snr);
+        const QByteArray system = info.system.toLatin1().left(int(sizeof(sat.system)) - 1);
+        std::memset(sat.system, 0, sizeof(sat.system));
+        std::memcpy(sat.system, system.constData(), size_t(system.size()));
+        sat.used = info.used ? 1 : 0;
+    }
+    epoch.satelliteTableSize = count;
+}
+
+EpochRingReader::EpochRingReader(const QString &key)
+    : m_key(key)
+    , m_memory(nullptr)
+    , m_header(nullptr)
+    , m_slots(nullptr)
+    , m_next(1)
+    , m_missed(0)
+{
+}
+
+EpochRingReader::~EpochRingReader()
+{
+    detach();
+}
+
+bool EpochRingReader::attach(QString *errorMessage)
+{
+    detach();
+
+    m_memory = new QSharedMemory;
+    m_memory->setNativeKey(EpochRingWriter::nativeKey(m_key));
+    QString error;
+    if (!m_memory->attach(QSharedMemory::ReadOnly)) {
+        error = QString("无法附加共享内存 %1: %2").arg(m_memory->nativeKey()).arg(m_memory->errorString());
+    } else {
+        const char *base = static_cast<const char *>(m_memory->constData());
+        const EpochRingHeader *header = reinterpret_cast<const EpochRingHeader *>(base);
+        if (m_memory->size() < int(sizeof(EpochRingHeader)) || header->magic != EpochRingHeader::Magic) {
+            error = QString("共享内存 %1 不是历元环或尚未初始化").arg(m_key);
+        } else if (header->version != EpochRingHeader::Version || header->slotSize != sizeof(EpochRingSlot)) {
+            error = QString("共享内存 %1 的版本或布局不一致").arg(m_key);
+        } else if (m_memory->size() < ringSize(header->slotCount)) {
+            error = QString("共享内存 %1 大小不足").arg(m_key);
+        } else {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            m_header = header;
+            m_slots = reinterpret_cast<const EpochRingSlot *>(base + sizeof(EpochRingHeader));
+        }
+    }
+
+    if (!m_header) {
+        if (errorMessage) {
+            *errorMessage = error;
+        }
+        detach();
+        return false;
+    }
+
+    // 从下一个新历元开始读
+    m_next = published() + 1;
+    m_missed = 0;
+    return true;
+}
+
+void EpochRingReader::detach()
+{
+    if (m_memory) {
+        m_memory->detach();
+        delete m_memory;
+        m_memory = nullptr;
+    }
+    m_header = nullptr;
+    m_slots = nullptr;
+}
+
+bool EpochRingReader::isAttached() const
+{
+    return m_header != nullptr;
+}
+
+quint64 EpochRingReader::published() const
+{
+    return m_header ? m_header->published.load(std::memory_order_acquire) : 0;
+}
+
+int EpochRingReader::read(quint64 n, SharedEpoch &epoch) const
+{
+    const EpochRingSlot &slot = m_slots[(n - 1) % m_header->slotCount];
+    const quint64 expected = 2 * n;
+
+    const quint64 before = slot.seq.load(std::memory_order_acquire);
+    if (before < expected) {
+        return 0;
+    }
+    if (before > expected) {
+        return -1;
+    }
+
+    std::memcpy(&epoch, &slot.epoch, sizeof(SharedEpoch));
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    // 拷贝期间写者进入了这个槽，数据可能不完整
+    const quint64 after = slot.seq.load(std::memory_order_relaxed);
+    return after == expected ? 1 : -1;
+}
+
+bool EpochRingReader::next(SharedEpoch &epoch)
+{
+    if (!m_header) {
+        return false;
+    }
+
+    for (;;) {
+        const quint64 newest = published();
+        if (m_next > newest) {
+            return false;
+        }
+
+        // 落后太多时跳到环中最早的历元
+        const quint64 oldest = newest > m_header->slotCount ? newest - m_header->slotCount + 1 : 1;
+        if (m_next < oldest) {
+            m_missed += oldest - m_next;
+            m_next = oldest;
+        }
+
+        const int result = read(m_next, epoch);
+        if (result > 0) {
+            ++m_next;
+            return true;
+        }
+        if (result == 0) {
+            return false;
+        }
+        // 读的过程中被覆盖，跳过这个历元
+        ++m_missed;
+        ++m_next;
+    }
+}
+
+bool EpochRingReader::waitForNext(SharedEpoch &epoch, int timeoutMs)
+{
+    QElapsedTimer timer;
+    timer.start();
+    for (int spin = 0; ; ++spin) {
+        if (next(epoch)) {
+            return true;
+        }
+        if (timer.elapsed() >= timeoutMs) {
+            return false;
+        }
+        if (spin < kSpinCount) {
+            std::this_thread::yield();
+        } else {
+            QThread::usleep(kPollIntervalUs);
+        }
+    }
+}
+
+bool EpochRingReader::latest(SharedEpoch &epoch)
+{
+    const quint64 newest = published();
+    if (newest == 0) {
+        return false;
+    }
+    if (m_next < newest) {
+        m_missed += newest - m_next;
+        m_next = newest;
+    }
+    return next(epoch);
+}
+
+qint64 EpochRingReader::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,158 @@
+#ifndef EPOCHRING_H
+#define EPOCHRING_H
+
+#include <QtGlobal>
+#include <QString>
+#include <atomic>
+#include <type_traits>
+#include "satellitedata.h"
+
+class QSharedMemory;
+
+// 历元共享内存环：本机其他进程直接读取解析好的历元，不需要套接字，也不需要再解析 NMEA。
+//
+// 共享内存的系统名称由 nativeKey() 给出，不经过 Qt 的散列，其他程序可以直接按名称打开：
+//     POSIX 共享内存（Qt 以 posix_ipc 配置）：shm_open("/<key>")，例如 /nmea-inspector-epochs-1
+//     System V（Qt 5 在 Linux 上的默认实现）：shmget(ftok("<临时目录>/<key>", 'Q'))，键文件由写者创建
+//     Windows：OpenFileMapping("<key>")
+//
+// 内存布局（全部为 POD，读者可以用任何语言按同样的布局读取）：
+//     EpochRingHeader | EpochRingSlot[slotCount]
+// 第 n 个历元（从 1 开始）写入第 (n - 1) % slotCount 个槽。
+//
+// 并发约定：单写者、多读者，seqlock 方式。写第 n 个历元时，写者先把槽的 seq 置为 2n-1，
+// 写完数据后以 release 语义置为 2n，再发布 published = n。读者以 acquire 语义读 seq，
+// 等于 2n 时拷贝数据，拷贝后再读一次 seq，不变说明拷贝期间没有被覆盖，否则丢弃重读。
+// 写者从不等待读者，读者落后超过 slotCount 个历元时跳过被覆盖的历元并计数。
+
+// 共享内存中的一颗卫星
+struct SharedSatellite {
+    qint16 prn;
+    qint16 elevation;           // 度
+    qint16 azimuth;             // 度
+    qint16 snr;                 // dB
+    char system[4];             // "GPS"、"BDS"、"GLN"、"GAL" 等，以 0 结尾
+    quint8 used;                // 是否用于定位
+    quint8 reserved[3];
+};
+
+// 共享内存中的一个历元快照
+struct SharedEpoch {
+    enum { MaxSatellites = 128 };
+
+    quint64 sequence;           // 历元序号，从 1 开始
+    qint64 publishedNs;         // 发布时刻（steady_clock 纳秒，本机进程之间可比较，用于测量延迟）
+    qint64 utcTimeMs;           // UTC 毫秒（有日期时为 Unix 时间，否则为当天毫秒数）
+    double latitude;            // 度
+    double longitude;           // 度
+    double altitude;            // 米
+    double speed;               // m/s
+    double course;              // 度
+    double hdop;
+    double pdop;
+    double vdop;
+    // GST 误差估计（米，hasGst 为 0 时无效）
+    double gstRms;
+    double gstMajor;
+    double gstMinor;
+    double gstOrientation;      // 度
+    double gstSigmaLat;
+    double gstSigmaLon;
+    double gstSigmaAlt;
+    qint32 fixQuality;          // GGA 定位质量
+    qint32 satelliteCount;      // 可见卫星数
+    qint32 usedSatelliteCount;
+    qint32 checksumErrors;
+    quint8 hasGst;
+    quint8 reserved[3];
+    qint32 satelliteTableSize;  // satellites 中有效的项数
+    SharedSatellite satellites[MaxSatellites];
+};
+
+struct EpochRingHeader {
+    enum : quint32 {
+        Magic = 0x4e4d4552,     // "NMER"
+        Version = 1
+    };
+
+    quint32 magic;
+    quint32 version;
+    quint32 slotCount;
+    quint32 slotSize;           // sizeof(EpochRingSlot)，读者据此检查布局是否一致
+    std::atomic<quint64> published;   // 已发布的历元数
+};
+
+struct EpochRingSlot {
+    std::atomic<quint64> seq;
+    SharedEpoch epoch;
+};
+
+static_assert(std::is_trivially_copyable<SharedEpoch>::value, "SharedEpoch 必须是 POD");
+static_assert(std::atomic<quint64>::is_always_lock_free, "共享内存中的原子量必须无锁");
+
+// 写者：由产生历元的线程独占使用
+class EpochRingWriter
+{
+public:
+    explicit EpochRingWriter(const QString &key, int slotCount = 256);
+    ~EpochRingWriter();
+
+    bool create(QString *errorMessage = nullptr);
+    void close();
+    bool isOpen() const;
+
+    QString key() const { return m_key; }
+    quint64 published() const { return m_published; }
+
+    void publish(const SatelliteData &data);
+
+    static void fillEpoch(const SatelliteData &data, SharedEpoch &epoch);
+    // 共享内存在系统中的名称（见文件开头的说明）
+    static QString nativeKey(const QString &key);
+
+private:
+    QString m_key;
+    int m_slotCount;
+    QSharedMemory *m_memory;
+    EpochRingHeader *m_header;
+    EpochRingSlot *m_slots;
+    quint64 m_published;
+};
+
+// 读者：附加到写者创建的共享内存，只读
+class EpochRingReader
+{
+public:
+    explicit EpochRingReader(const QString &key);
+    ~EpochRingReader();
+
+    bool attach(QString *errorMessage = nullptr);
+    void detach();
+    bool isAttached() const;
+
+    // 读下一个历元，没有新历元时返回 false
+    bool next(SharedEpoch &epoch);
+    // 等待下一个历元：先短暂自旋，之后每 50 微秒检查一次
+    bool waitForNext(SharedEpoch &epoch, int timeoutMs);
+    // 跳到最新的历元
+    bool latest(SharedEpoch &epoch);
+
+    quint64 published() const;
+    // 因为落后被覆盖而跳过的历元数
+    quint64 missed() const { return m_missed; }
+
+    static qint64 nowNs();
+
+private:
+    // 读取第 n 个历元：1 成功，0 尚未写完，-1 已被覆盖
+    int read(quint64 n, SharedEpoch &epoch) const;
+
+    QString m_key;
+    QSharedMemory *m_memory;
+    const EpochRingHeader *m_header;
+    const EpochRingSlot *m_slots;
+    quint64 m_next;
+    quint64 m_missed;
+};
+
+#endif // EPOCHRING_H
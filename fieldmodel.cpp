@@ -0,0 +1,227 @@
+#include "fieldmodel.h"
+#include <QBrush>
+
+FieldModel::FieldModel(QObject *parent)
+    : QAbstractItemModel(parent)
+    , m_styledRows(false)
+    , m_valueAlignment(Qt::AlignLeft | Qt::AlignVCenter)
+    , m_headerFont("Arial", 10, QFont::Bold)
+    , m_subHeaderFont("Arial", 9, QFont::Bold)
+    , m_normalFont("Arial", 9)
+    , m_highlightFont("Arial", 9, QFont::Bold)
+{
+}
+
+void FieldModel::setHeaderLabels(const QStringList &labels)
+{
+    m_headerLabels = labels;
+    emit headerDataChanged(Qt::Horizontal, 0, columnCount() - 1);
+}
+
+void FieldModel::setRows(const QVector<FieldRow> &rows)
+{
+    applyRows(QModelIndex(), m_nodes, rows);
+}
+
+void FieldModel::setChildRows(const QString &parentKey, const QVector<FieldRow> &rows)
+{
+    for (int i = 0; i < m_nodes.size(); ++i) {
+        if (m_nodes[i].row.key == parentKey) {
+            applyRows(createIndex(i, 0, quintptr(0)), m_nodes[i].children, rows);
+            return;
+        }
+    }
+}
+
+template <typename Item>
+void FieldModel::applyRows(const QModelIndex &parent, QVector<Item> &current, const QVector<FieldRow> &next)
+{
+    // 找出 key 相同的公共前缀和公共后缀，中间部分做一次删除 + 一次插入
+    const int common = qMin(current.size(), next.size());
+    int prefix = 0;
+    while (prefix < common && rowOf(current[prefix]).key == next[prefix].key) {
+        ++prefix;
+    }
+    int suffix = 0;
+    while (suffix < common - prefix
+           && rowOf(current[current.size() - 1 - suffix]).key == next[next.size() - 1 - suffix].key) {
+        ++suffix;
+    }
+
+    for (int i = 0; i < prefix; ++i) {
+        updateRow(parent, i, rowOf(current[i]), next[i]);
+    }
+
+    const int removeCount = current.size() - prefix - suffix;
+    if (removeCount > 0) {
+        beginRemoveRows(parent, prefix, prefix + removeCount - 1);
+        current.remove(prefix, removeCount);
+        endRemoveRows();
+    }
+
+    const int insertCount = next.size() - prefix - suffix;
+    if (insertCount > 0) {
+        beginInsertRows(parent, prefix, prefix + insertCount - 1);
+        current.insert(prefix, insertCount, Item());
+        for (int i = 0; i < insertCount; ++i) {
+            current[prefix + i] = makeItem(next[prefix + i], static_cast<const Item *>(nullptr));
+        }
+        endInsertRows();
+    }
+
+    for (int i = 0; i < suffix; ++i) {
+        const int row = current.size() - suffix + i;
+        updateRow(parent, row, rowOf(current[row]), next[next.size() - suffix + i]);
+    }
+}
+
+void FieldModel::updateRow(const QModelIndex &parent, int row, FieldRow &current, const FieldRow &next)
+{
+    const bool kindChanged = current.kind != next.kind;
+    const bool nameChanged = kindChanged || current.name != next.name;
+    const bool valueChanged = kindChanged || current.value != next.value;
+    if (!nameChanged && !valueChanged) {
+        return;
+    }
+
+    current = next;
+    const int first = nameChanged ? 0 : 1;
+    const int last = valueChanged ? 1 : 0;
+    emit dataChanged(index(row, first, parent), index(row, last, parent));
+}
+
+const FieldRow *FieldModel::rowAt(const QModelIndex &index) const
+{
+    if (!index.isValid()) {
+        return nullptr;
+    }
+
+    // internalId 为 0 表示顶层行，否则为父行号 + 1
+    const quintptr parentId = index.internalId();
+    if (parentId == 0) {
+        return index.row() < m_nodes.size() ? &m_nodes[index.row()].row : nullptr;
+    }
+
+    const int parentRow = int(parentId - 1);
+    if (parentRow >= m_nodes.size() || index.row() >= m_nodes[parentRow].children.size()) {
+        return nullptr;
+    }
+    return &m_nodes[parentRow].children[index.row()];
+}
+
+QModelIndex FieldModel::index(int row, int column, const QModelIndex &parent) const
+{
+    if (row < 0 || column < 0 || column >= columnCount()) {
+        return QModelIndex();
+    }
+
+    if (!parent.isValid()) {
+        return row < m_nodes.size() ? createIndex(row, column, quintptr(0)) : QModelIndex();
+    }
+
+    // 只支持两级
+    if (parent.internalId() != 0 || parent.row() >= m_nodes.size()
+        || row >= m_nodes[parent.row()].children.size()) {
+        return QModelIndex();
+    }
+    return createIndex(row, column, quintptr(parent.row() + 1));
+}
+
+QModelIndex FieldModel::parent(const QModelIndex &child) const
+{
+    if (!child.isValid() || child.internalId() == 0) {
+        return QModelIndex();
+    }
+    return createIndex(int(child.internalId() - 1), 0, quintptr(0));
+}
+
+int FieldModel::rowCount(const QModelIndex &parent) const
+{
+    if (!parent.isValid()) {
+        return m_nodes.size();
+    }
+    if (parent.internalId() != 0 || parent.column() != 0 || parent.row() >= m_nodes.size()) {
+        return 0;
+    }
+    return m_nodes[parent.row()].children.size();
+}
+
+int FieldModel::columnCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent)
+    return 2;
+}
+
+QVariant FieldModel::data(const QModelIndex &index, int role) const
+{
+    const FieldRow *row = rowAt(index);
+    if (!row) {
+        return QVariant();
+    }
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return index.column() == 0 ? row->name : row->value;
+    case Qt::TextAlignmentRole:
+        if (index.column() == 1) {
+            return int(m_valueAlignment);
+        }
+        return QVariant();
+    default:
+        break;
+    }
+
+    if (!m_styledRows) {
+        return QVariant();
+    }
+
+    // 不同类型行的样式
+    switch (role) {
+    case Qt::BackgroundRole:
+        switch (row->kind) {
+        case FieldRow::Header:
+        case FieldRow::SubHeader:
+            return QBrush(QColor(173, 216, 230)); // 浅蓝色背景
+        case FieldRow::Spacer:
+            return QBrush(QColor(236, 240, 241)); // 浅灰色背景
+        default:
+            return QBrush(QColor(255, 255, 255));
+        }
+    case Qt::ForegroundRole:
+        switch (row->kind) {
+        case FieldRow::Header:
+        case FieldRow::SubHeader:
+            return QBrush(QColor(25, 25, 112));
+        case FieldRow::Highlight:
+            if (index.column() == 1) {
+                return QBrush(QColor(39, 174, 96)); // 重要数据绿色显示
+            }
+            return QBrush(QColor(44, 62, 80));
+        default:
+            return QBrush(QColor(44, 62, 80));
+        }
+    case Qt::FontRole:
+        switch (row->kind) {
+        case FieldRow::Header:
+            return m_headerFont;
+        case FieldRow::SubHeader:
+            return m_subHeaderFont;
+        case FieldRow::Highlight:
+            return index.column() == 1 ? m_highlightFont : m_normalFont;
+        case FieldRow::Spacer:
+            return QVariant();
+        default:
+            return m_normalFont;
+        }
+    default:
+        return QVariant();
+    }
+}
+
+QVariant FieldModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole && section < m_headerLabels.size()) {
+        return m_headerLabels[section];
+    }
+    return QAbstractItemModel::headerData(section, orientation, role);
+}
@@ -0,0 +1,87 @@
+#ifndef FIELDMODEL_H
+#define FIELDMODEL_H
+
+#include <QAbstractItemModel>
+#include <QVector>
+#include <QStringList>
+#include <QFont>
+#include <QColor>
+
+// 字段行：key 用于在两次更新之间对齐同一行（例如 "GPS:12" 表示 GPS 12 号卫星）
+struct FieldRow {
+    enum Kind {
+        Normal,        // 普通数据行
+        Highlight,     // 重要数据（卫星数、精度因子）
+        Header,        // 分类标题行 "=== xxx ==="
+        SubHeader,     // 子系统标题行 "--- xxx ---"
+        Spacer         // 空行分隔
+    };
+
+    QString key;
+    QString name;
+    QString value;
+    Kind kind;
+
+    FieldRow() : kind(Normal) {}
+    FieldRow(const QString &k, const QString &n, const QString &v, Kind t = Normal)
+        : key(k), name(n), value(v), kind(t) {}
+};
+
+// 两级字段模型：表格只使用顶层行，树形视图在顶层分组下挂子行。
+// 更新时按 key 对齐新旧行，只对值发生变化的单元格发出 dataChanged，
+// 行集合变化时只插入/删除差异部分，视图不会被整体重置。
+class FieldModel : public QAbstractItemModel
+{
+    Q_OBJECT
+
+public:
+    explicit FieldModel(QObject *parent = nullptr);
+
+    void setHeaderLabels(const QStringList &labels);
+    void setStyledRows(bool styled) { m_styledRows = styled; }
+    void setValueAlignment(Qt::Alignment alignment) { m_valueAlignment = alignment; }
+
+    // 更新顶层行
+    void setRows(const QVector<FieldRow> &rows);
+    // 更新某个顶层行下的子行
+    void setChildRows(const QString &parentKey, const QVector<FieldRow> &rows);
+
+    const FieldRow *rowAt(const QModelIndex &index) const;
+
+    QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex &child) const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    struct Node {
+        FieldRow row;
+        QVector<FieldRow> children;
+    };
+
+    static FieldRow &rowOf(FieldRow &row) { return row; }
+    static const FieldRow &rowOf(const FieldRow &row) { return row; }
+    static FieldRow &rowOf(Node &node) { return node.row; }
+    static const FieldRow &rowOf(const Node &node) { return node.row; }
+    static Node makeItem(const FieldRow &row, const Node *) { Node node; node.row = row; return node; }
+    static FieldRow makeItem(const FieldRow &row, const FieldRow *) { return row; }
+
+    template <typename Item>
+    void applyRows(const QModelIndex &parent, QVector<Item> &current, const QVector<FieldRow> &next);
+    void updateRow(const QModelIndex &parent, int row, FieldRow &current, const FieldRow &next);
+
+    QVector<Node> m_nodes;
+    QStringList m_headerLabels;
+    bool m_styledRows;
+    Qt::Alignment m_valueAlignment;
+
+    // 预先创建的字体和颜色，data() 中直接返回
+    QFont m_headerFont;
+    QFont m_subHeaderFont;
+    QFont m_normalFont;
+    QFont m_highlightFont;
+};
+
+#endif // FIELDMODEL_H
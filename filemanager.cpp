@@ -11,6 +11,12 @@ FileManager::FileManager(QObject *parent)
     , m_parser(new NMEAParser(this))
 {
     connect(m_parser, &NMEAParser::dataParsed, this, &FileManager::dataParsed);
+    connect(m_parser, &NMEAParser::epochCompleted, this, &FileManager::epochCompleted);
+}
+
+void FileManager::setCaptureFields(bool capture)
+{
+    m_parser->setCaptureFields(capture);
 }
 
 bool FileManager::loadFile(const QString &fileName)
@@ -24,6 +30,7 @@ bool FileManager::loadFile(const QString &fileName)
     m_nmeaLines.clear();
     m_currentLine = 0;
     m_fileName = fileName;
+    m_parser->reset();
     
     QTextStream stream(&file);
     stream.setCodec("UTF-8");
@@ -47,6 +54,8 @@ bool FileManager::loadFile(const QString &fileName)
 void FileManager::processNextLine()
 {
     if (m_currentLine >= m_nmeaLines.size()) {
+        // 最后一个历元没有后续时间可以触发，结束时主动发出
+        m_parser->flushEpoch();
         emit replayFinished();
         return;
     }
@@ -22,13 +22,18 @@ public:
     // 处理下一行数据
     void processNextLine();
     
+    // 解析时记录每条语句的字段（供消息视图显示）
+    void setCaptureFields(bool capture);
+    
     // 获取文件信息
     QString getFileName() const { return m_fileName; }
     int getTotalLines() const { return m_nmeaLines.size(); }
     int getCurrentLine() const { return m_currentLine; }
+    const QStringList &getLines() const { return m_nmeaLines; }
 
 signals:
     void dataParsed(const SatelliteData &data);
+    void epochCompleted(const SatelliteData &data);
     void fileLoaded(const QString &fileName);
     void replayFinished();
     void nmeaDataReceived(const QString &line);
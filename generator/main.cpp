@@ -0,0 +1,171 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QTimer>
+#include "nmeagenerator.h"
+#include "pseudoterminal.h"
+#include "pacedwriter.h"
+#include "broadcastserver.h"
+
+// nmea-generate：合成高频多系统 NMEA 数据，作为压力测试和性能测试的数据源。
+//
+//     nmea-generate --rate 100 --systems GP,GL,GA,GB,GQ --satellites 150 --pty --link /tmp/ttyNMEA0 --baud 921600
+//     nmea-generate --rate 20 --corrupt 0.01 --output drive.nmea --seconds 600
+//     nmea-generate --rate 50 --tcp 10110
+//
+// --pty 创建伪终端，在图形界面中添加接收机 /tmp/ttyNMEA0（或打印出的 /dev/pts/N）即可像真实串口一样接收。
+// --baud 按波特率限制写入伪终端的字节速率（每字节 10 位），超出带宽的历元被丢弃并计数。
+// 不指定输出时默认使用伪终端。同样的参数和 --seed 生成完全相同的数据。
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("nmea-generate");
+    app.setApplicationVersion("1.0.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("合成多系统 NMEA 数据（GGA/RMC/GSA/GSV/ZDA），输出到伪终端、文件或 TCP");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption rateOption(QStringList() << "rate", "历元频率（1-100 Hz）", "Hz", "10");
+    QCommandLineOption satellitesOption(QStringList() << "satellites", "可见卫星总数（每个系统最多 36 颗）", "n", "40");
+    QCommandLineOption systemsOption(QStringList() << "systems", "卫星系统 GP,GL,GA,GB,GQ", "list", "GP,GL,GA,GB");
+    QCommandLineOption corruptOption(QStringList() << "corrupt", "每条语句被破坏的概率", "p", "0");
+    QCommandLineOption seedOption(QStringList() << "seed", "随机种子", "n", "1");
+    QCommandLineOption secondsOption(QStringList() << "seconds", "运行时长（秒，0 表示不限）", "s", "0");
+    QCommandLineOption epochsOption(QStringList() << "epochs", "生成指定个数的历元后结束", "n", "0");
+    QCommandLineOption ptyOption(QStringList() << "pty", "输出到伪终端（仅 Linux/Unix）");
+    QCommandLineOption linkOption(QStringList() << "link", "为伪终端从设备创建符号链接", "path");
+    QCommandLineOption baudOption(QStringList() << "baud", "按波特率限制伪终端的写入速率（0 表示不限）", "baud", "0");
+    QCommandLineOption outputOption(QStringList() << "o" << "output", "输出到文件（- 表示标准输出）", "file");
+    QCommandLineOption tcpOption(QStringList() << "tcp", "在 TCP 端口上转发给所有连接的客户端", "port");
+    parser.addOption(rateOption);
+    parser.addOption(satellitesOption);
+    parser.addOption(systemsOption);
+    parser.addOption(corruptOption);
+    parser.addOption(seedOption);
+    parser.addOption(secondsOption);
+    parser.addOption(epochsOption);
+    parser.addOption(ptyOption);
+    parser.addOption(linkOption);
+    parser.addOption(baudOption);
+    parser.addOption(outputOption);
+    parser.addOption(tcpOption);
+    parser.process(app);
+
+    QTextStream err(stderr);
+    err.setCodec("UTF-8");
+
+    GeneratorConfig config;
+    config.rateHz = qBound(1.0, parser.value(rateOption).toDouble(), 100.0);
+    config.satellites = parser.value(satellitesOption).toInt();
+    config.talkers = parser.value(systemsOption).split(',', Qt::SkipEmptyParts);
+    config.corruptRate = qBound(0.0, parser.value(corruptOption).toDouble(), 1.0);
+    config.seed = parser.value(seedOption).toUInt();
+    config.start = QDateTime::currentDateTimeUtc();
+    NMEAGenerator generator(config);
+
+    const bool usePty = parser.isSet(ptyOption) || parser.isSet(linkOption)
+                        || (!parser.isSet(outputOption) && !parser.isSet(tcpOption));
+
+    // 输出：伪终端、文件/标准输出、TCP，可以同时使用
+    PseudoTerminal pty;
+    QFile file;
+    BroadcastServer server;
+    QString error;
+
+    if (usePty) {
+        if (!pty.open(&error)) {
+            err << error << '\n';
+            return 1;
+        }
+        if (parser.isSet(linkOption) && !pty.createLink(parser.value(linkOption), &error)) {
+            err << error << '\n';
+            return 1;
+        }
+        err << "伪终端: " << (parser.isSet(linkOption) ? parser.value(linkOption) : pty.slavePath()) << '\n';
+    }
+    if (parser.isSet(outputOption)) {
+        const QString path = parser.value(outputOption);
+        bool ok = false;
+        if (path == "-") {
+            ok = file.open(stdout, QIODevice::WriteOnly);
+        } else {
+            file.setFileName(path);
+            ok = file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        }
+        if (!ok) {
+            err << "无法打开输出文件: " << path << '\n';
+            return 1;
+        }
+    }
+    if (parser.isSet(tcpOption)) {
+        if (!server.listen(quint16(parser.value(tcpOption).toUInt()), QString(), &error)) {
+            err << error << '\n';
+            return 1;
+        }
+        err << "TCP 端口: " << server.tcpPort() << '\n';
+    }
+
+    err << QString("%1 Hz，%2 颗卫星，破坏概率 %3\n").arg(config.rateHz).arg(generator.satelliteCount()).arg(config.corruptRate);
+    err.flush();
+
+    // 伪终端按波特率限速（每字节 10 位），每毫秒检查一次
+    PacedWriter writer(&pty, parser.value(baudOption).toDouble() / 10.0);
+    qint64 totalBytes = 0;
+
+    const qint64 maxEpochs = parser.value(epochsOption).toLongLong();
+    const qint64 maxMs = parser.value(secondsOption).toLongLong() * 1000;
+    QElapsedTimer clock;
+    clock.start();
+
+    QTimer timer;
+    timer.setTimerType(Qt::PreciseTimer);
+    timer.setInterval(1);
+    QObject::connect(&timer, &QTimer::timeout, [&]() {
+        const qint64 nowNs = clock.nsecsElapsed();
+
+        // 按时钟补齐到期的历元，定时器抖动不影响平均频率
+        const qint64 due = qint64(nowNs / 1e9 * config.rateHz) + 1;
+        while (generator.epochCount() < due && (maxEpochs <= 0 || generator.epochCount() < maxEpochs)) {
+            const QByteArray epoch = generator.nextEpoch();
+            totalBytes += epoch.size();
+            if (file.isOpen()) {
+                file.write(epoch);
+                file.flush();
+            }
+            if (server.tcpPort() > 0) {
+                server.publish(epoch);
+            }
+            if (pty.isOpen()) {
+                writer.enqueue(epoch);
+            }
+        }
+
+        if (pty.isOpen()) {
+            writer.flush(nowNs);
+        }
+
+        const bool epochsDone = maxEpochs > 0 && generator.epochCount() >= maxEpochs && writer.backlog() == 0;
+        if (epochsDone || (maxMs > 0 && clock.elapsed() >= maxMs)) {
+            app.quit();
+        }
+    });
+    timer.start();
+    app.exec();
+
+    const double seconds = clock.elapsed() / 1000.0;
+    err << QString("历元 %1，语句 %2，%3 字节（%4 字节/秒）\n")
+               .arg(generator.epochCount()).arg(generator.sentenceCount()).arg(totalBytes)
+               .arg(seconds > 0 ? totalBytes / seconds : 0.0, 0, 'f', 0);
+    err << QString("破坏语句 %1（改字符 %2，截断 %3，插入字节 %4）\n")
+               .arg(generator.corruptedCount())
+               .arg(generator.corruptedCount(NMEAGenerator::FlipCharacter))
+               .arg(generator.corruptedCount(NMEAGenerator::Truncate))
+               .arg(generator.corruptedCount(NMEAGenerator::InsertGarbage));
+    if (pty.isOpen()) {
+        err << QString("伪终端写入 %1 字节，带宽不足丢弃 %2 个历元\n").arg(writer.writtenBytes()).arg(writer.droppedBlocks());
+    }
+    return 0;
+}
@@ -0,0 +1,14 @@
+# NMEA 数据生成器：合成高频多系统数据，写入伪终端、文件或 TCP，用作压力测试的数据源
+QT = core network
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+TARGET = nmea-generate
+TEMPLATE = app
+
+# 生成器、伪终端和转发服务器在 nmeacore 静态库中
+include(../core/nmeacore.pri)
+
+# 源文件
+SOURCES += \
+    main.cpp
@@ -0,0 +1,165 @@
+#include "gstanalysis.h"
+#include <QtMath>
+
+GstAnalysis::GstAnalysis()
+    : m_samples(WindowEpochs)
+{
+    clear();
+}
+
+void GstAnalysis::clear()
+{
+    m_frame.reset();
+    m_next = 0;
+    m_count = 0;
+    m_sinceRecompute = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        m_sum[axis] = 0.0;
+        m_sumSquares[axis] = 0.0;
+        m_sumVariance[axis] = 0.0;
+    }
+    m_sumEastNorth = 0.0;
+    m_latestRms = 0.0;
+    m_latestMajor = 0.0;
+    m_latestMinor = 0.0;
+    m_latestOrientation = 0.0;
+}
+
+void GstAnalysis::addEpoch(const SatelliteData &data)
+{
+    // 只有同时有定位和 GST 的历元才能比较
+    if (!data.hasGst || data.fixQuality <= 0 || (data.latitude == 0.0 && data.longitude == 0.0)) {
+        return;
+    }
+
+    // 坐标原点取第一个定位点，离散程度相对窗口均值计算，与原点无关
+    if (!m_frame.isValid()) {
+        m_frame.setOrigin(data.latitude, data.longitude, data.altitude);
+    }
+
+    Sample sample;
+    m_frame.toEnu(data.latitude, data.longitude, data.altitude, sample.east, sample.north, sample.up);
+    sample.varianceEast = data.gstSigmaLon * data.gstSigmaLon;
+    sample.varianceNorth = data.gstSigmaLat * data.gstSigmaLat;
+    sample.varianceUp = data.gstSigmaAlt * data.gstSigmaAlt;
+
+    if (m_count == WindowEpochs) {
+        addToSums(m_samples[m_next], -1.0);
+    } else {
+        ++m_count;
+    }
+    m_samples[m_next] = sample;
+    m_next = (m_next + 1) % WindowEpochs;
+
+    if (++m_sinceRecompute >= WindowEpochs) {
+        recomputeSums();
+    } else {
+        addToSums(sample, 1.0);
+    }
+
+    m_latestRms = data.gstRms;
+    m_latestMajor = data.gstMajor;
+    m_latestMinor = data.gstMinor;
+    m_latestOrientation = data.gstOrientation;
+}
+
+void GstAnalysis::addToSums(const Sample &sample, double sign)
+{
+    m_sum[0] += sign * sample.east;
+    m_sum[1] += sign * sample.north;
+    m_sum[2] += sign * sample.up;
+    m_sumSquares[0] += sign * sample.east * sample.east;
+    m_sumSquares[1] += sign * sample.north * sample.north;
+    m_sumSquares[2] += sign * sample.up * sample.up;
+    m_sumEastNorth += sign * sample.east * sample.north;
+    m_sumVariance[0] += sign * sample.varianceEast;
+    m_sumVariance[1] += sign * sample.varianceNorth;
+    m_sumVariance[2] += sign * sample.varianceUp;
+}
+
+void GstAnalysis::recomputeSums()
+{
+    for (int axis = 0; axis < 3; ++axis) {
+        m_sum[axis] = 0.0;
+        m_sumSquares[axis] = 0.0;
+        m_sumVariance[axis] = 0.0;
+    }
+    m_sumEastNorth = 0.0;
+
+    // 窗口未满时只有前 m_count 个有效
+    for (int i = 0; i < m_count; ++i) {
+        addToSums(m_samples[i], 1.0);
+    }
+    m_sinceRecompute = 0;
+}
+
+GstSummary GstAnalysis::summary() const
+{
+    GstSummary result;
+    result.count = m_count;
+    result.latestRms = m_latestRms;
+    result.latestMajor = m_latestMajor;
+    result.latestMinor = m_latestMinor;
+    result.latestOrientation = m_latestOrientation;
+    if (m_count == 0) {
+        return result;
+    }
+
+    const double n = m_count;
+    double variance[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        const double mean = m_sum[axis] / n;
+        variance[axis] = qMax(0.0, m_sumSquares[axis] / n - mean * mean);
+    }
+    const double covariance = m_sumEastNorth / n - (m_sum[0] / n) * (m_sum[1] / n);
+
+    result.observedSigmaEast = qSqrt(variance[0]);
+    result.observedSigmaNorth = qSqrt(variance[1]);
+    result.observedSigmaUp = qSqrt(variance[2]);
+    result.reportedSigmaEast = qSqrt(qMax(0.0, m_sumVariance[0] / n));
+    result.reportedSigmaNorth = qSqrt(qMax(0.0, m_sumVariance[1] / n));
+    result.reportedSigmaUp = qSqrt(qMax(0.0, m_sumVariance[2] / n));
+
+    auto ratio = [](double observed, double reported) {
+        return reported > 0.0 ? observed / reported : 0.0;
+    };
+    result.ratioEast = ratio(result.observedSigmaEast, result.reportedSigmaEast);
+    result.ratioNorth = ratio(result.observedSigmaNorth, result.reportedSigmaNorth);
+    result.ratioUp = ratio(result.observedSigmaUp, result.reportedSigmaUp);
+
+    // 2x2 协方差矩阵的特征值即椭圆半轴的平方
+    const double halfTrace = (variance[0] + variance[1]) / 2.0;
+    const double halfDiff = (variance[0] - variance[1]) / 2.0;
+    const double radius = qSqrt(halfDiff * halfDiff + covariance * covariance);
+    result.observedMajor = qSqrt(qMax(0.0, halfTrace + radius));
+    result.observedMinor = qSqrt(qMax(0.0, halfTrace - radius));
+
+    // 半长轴相对东向逆时针的角度，换算成相对真北顺时针，取 [0, 180)
+    const double fromEast = qRadiansToDegrees(0.5 * qAtan2(2.0 * covariance, variance[0] - variance[1]));
+    double bearing = 90.0 - fromEast;
+    if (bearing < 0.0) bearing += 180.0;
+    if (bearing >= 180.0) bearing -= 180.0;
+    result.observedOrientation = bearing;
+
+    return result;
+}
+
+QVector<QPointF> GstAnalysis::scatter() const
+{
+    QVector<QPointF> points;
+    if (m_count == 0) {
+        return points;
+    }
+
+    const double meanEast = m_sum[0] / m_count;
+    const double meanNorth = m_sum[1] / m_count;
+    points.reserve(m_count);
+
+    // 窗口未满时从 0 开始，满了以后从最旧的位置开始
+    const int first = m_count < WindowEpochs ? 0 : m_next;
+    for (int i = 0; i < m_count; ++i) {
+        const Sample &sample = m_samples[(first + i) % WindowEpochs];
+        points.append(QPointF(sample.east - meanEast, sample.north - meanNorth));
+    }
+    return points;
+}
@@ -0,0 +1,99 @@
+#ifndef GSTANALYSIS_H
+#define GSTANALYSIS_H
+
+#include <QVector>
+#include <QPointF>
+#include "satellitedata.h"
+#include "localframe.h"
+
+// 接收机 GST 报告的误差与实际定位离散程度的对比结果（米）
+struct GstSummary
+{
+    int count;                    // 窗口内同时有定位和 GST 的历元数
+
+    // 实际离散程度：窗口内定位点相对窗口均值的标准差
+    double observedSigmaEast;
+    double observedSigmaNorth;
+    double observedSigmaUp;
+    // 实际离散的协方差椭圆（1σ）
+    double observedMajor;
+    double observedMinor;
+    double observedOrientation;   // 半长轴方向 (度，相对真北顺时针)
+
+    // 接收机报告的误差：窗口内 σ 的均方根
+    double reportedSigmaEast;
+    double reportedSigmaNorth;
+    double reportedSigmaUp;
+
+    // 实际 / 报告，大于 1 表示接收机低估了误差
+    double ratioEast;
+    double ratioNorth;
+    double ratioUp;
+
+    // 最新历元的报告椭圆
+    double latestRms;
+    double latestMajor;
+    double latestMinor;
+    double latestOrientation;
+
+    GstSummary() : count(0),
+                   observedSigmaEast(0), observedSigmaNorth(0), observedSigmaUp(0),
+                   observedMajor(0), observedMinor(0), observedOrientation(0),
+                   reportedSigmaEast(0), reportedSigmaNorth(0), reportedSigmaUp(0),
+                   ratioEast(0), ratioNorth(0), ratioUp(0),
+                   latestRms(0), latestMajor(0), latestMinor(0), latestOrientation(0) {}
+};
+
+// GST 误差椭圆分析。
+// 最近 WindowEpochs 个历元的 ENU 坐标和报告的 σ 保存在环形缓冲区中，
+// 同时维护滑动和（一阶、二阶和交叉项），新历元进入时加上、移出的历元减去，每个历元 O(1)。
+// 为了避免长时间累加的舍入误差，每绕环形缓冲区一圈从缓冲区重新求一次和。
+class GstAnalysis
+{
+public:
+    enum { WindowEpochs = 300 };
+
+    GstAnalysis();
+
+    void clear();
+    void addEpoch(const SatelliteData &data);
+
+    GstSummary summary() const;
+
+    // 窗口内定位点相对窗口均值的东、北偏移，按时间顺序
+    QVector<QPointF> scatter() const;
+
+private:
+    struct Sample {
+        double east;
+        double north;
+        double up;
+        double varianceEast;    // 报告的 σ²
+        double varianceNorth;
+        double varianceUp;
+    };
+
+    void addToSums(const Sample &sample, double sign);
+    void recomputeSums();
+
+    LocalFrame m_frame;
+
+    QVector<Sample> m_samples;    // 环形缓冲区
+    int m_next;                   // 下一个写入位置
+    int m_count;
+    int m_sinceRecompute;
+
+    // 滑动和：0 东 1 北 2 天
+    double m_sum[3];
+    double m_sumSquares[3];
+    double m_sumEastNorth;
+    double m_sumVariance[3];
+
+    // 最新一个 GST
+    double m_latestRms;
+    double m_latestMajor;
+    double m_latestMinor;
+    double m_latestOrientation;
+};
+
+#endif // GSTANALYSIS_H
@@ -0,0 +1,166 @@
+#include "gstview.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QVBoxLayout>
+#include <QtMath>
+
+// 绘图区边距
+static const int kPlotMargin = 24;
+
+GstView::GstView(QWidget *parent)
+    : QWidget(parent)
+    , m_analysis(nullptr)
+{
+    setWindowTitle("🎯 误差椭圆");
+    setMinimumSize(300, 300);
+
+    m_labelFont = font();
+    m_labelFont.setPointSize(8);
+
+    setupUI();
+}
+
+void GstView::setupUI()
+{
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(8, 8, 8, 8);
+
+    m_summaryLabel = new QLabel("等待GST数据...", this);
+    m_summaryLabel->setStyleSheet("QLabel { font-size: 9pt; color: #2c3e50; }");
+    m_summaryLabel->setWordWrap(true);
+    mainLayout->addWidget(m_summaryLabel);
+
+    // 标签下方的空间用于绘制散点图
+    mainLayout->addStretch(1);
+}
+
+void GstView::setAnalysis(const GstAnalysis *analysis)
+{
+    m_analysis = analysis;
+}
+
+void GstView::updateData(const SatelliteData &data)
+{
+    Q_UNUSED(data)
+    if (!m_analysis) {
+        return;
+    }
+
+    m_summary = m_analysis->summary();
+    m_points = m_analysis->scatter();
+    refreshSummary();
+    update();
+}
+
+void GstView::refreshSummary()
+{
+    if (m_summary.count == 0) {
+        m_summaryLabel->setText("等待GST数据...");
+        return;
+    }
+
+    auto meters = [](double value) { return QString::number(value, 'f', 3); };
+    auto ratio = [](double value) {
+        return value > 0.0 ? QString::number(value, 'f', 2) : QString("-");
+    };
+
+    QString text = QString("报告椭圆  半长轴 %1 m  半短轴 %2 m  方向 %3°    伪距RMS %4 m\n")
+                   .arg(meters(m_summary.latestMajor)).arg(meters(m_summary.latestMinor))
+                   .arg(m_summary.latestOrientation, 0, 'f', 1).arg(meters(m_summary.latestRms));
+    text += QString("实际离散 (%1 历元)  半长轴 %2 m  半短轴 %3 m  方向 %4°\n")
+            .arg(m_summary.count)
+            .arg(meters(m_summary.observedMajor)).arg(meters(m_summary.observedMinor))
+            .arg(m_summary.observedOrientation, 0, 'f', 1);
+    text += QString("实际σ / 报告σ   东 %1 / %2 = %3    北 %4 / %5 = %6    天 %7 / %8 = %9")
+            .arg(meters(m_summary.observedSigmaEast)).arg(meters(m_summary.reportedSigmaEast))
+            .arg(ratio(m_summary.ratioEast))
+            .arg(meters(m_summary.observedSigmaNorth)).arg(meters(m_summary.reportedSigmaNorth))
+            .arg(ratio(m_summary.ratioNorth))
+            .arg(meters(m_summary.observedSigmaUp)).arg(meters(m_summary.reportedSigmaUp))
+            .arg(ratio(m_summary.ratioUp));
+    m_summaryLabel->setText(text);
+}
+
+void GstView::drawEllipse(QPainter &painter, const QPointF &center, double scale,
+                          double major, double minor, double orientation)
+{
+    // 屏幕坐标 y 向下，未旋转时半长轴指向正北；rotate 为屏幕上的顺时针，与方位角方向一致
+    painter.save();
+    painter.translate(center);
+    painter.rotate(orientation);
+    painter.drawEllipse(QRectF(-minor * scale, -major * scale, 2.0 * minor * scale, 2.0 * major * scale));
+    painter.restore();
+}
+
+void GstView::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event)
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.fillRect(rect(), Qt::white);
+
+    const QRect plotRect = rect().adjusted(kPlotMargin, m_summaryLabel->geometry().bottom() + kPlotMargin,
+                                           -kPlotMargin, -kPlotMargin);
+    if (plotRect.width() <= 0 || plotRect.height() <= 0 || m_summary.count == 0) {
+        return;
+    }
+
+    // 量程取散点、报告椭圆和实际椭圆中最大的那个，留出余量
+    double extent = qMax(m_summary.latestMajor, m_summary.observedMajor) * 1.5;
+    for (const QPointF &point : m_points) {
+        extent = qMax(extent, qMax(qAbs(point.x()), qAbs(point.y())));
+    }
+    extent = qMax(extent * 1.1, 0.01);
+
+    const double radius = qMin(plotRect.width(), plotRect.height()) / 2.0;
+    const double scale = radius / extent;
+    const QPointF center = QRectF(plotRect).center();
+
+    // 刻度圈：取 1-2-5 序列中不超过量程一半的最大值
+    double step = qPow(10.0, qFloor(std::log10(extent / 2.0)));
+    if (step * 5.0 <= extent / 2.0) step *= 5.0;
+    else if (step * 2.0 <= extent / 2.0) step *= 2.0;
+
+    painter.setFont(m_labelFont);
+    painter.setPen(QPen(QColor(220, 221, 225), 1));
+    painter.drawLine(QPointF(center.x() - radius, center.y()), QPointF(center.x() + radius, center.y()));
+    painter.drawLine(QPointF(center.x(), center.y() - radius), QPointF(center.x(), center.y() + radius));
+    for (double ring = step; ring <= extent; ring += step) {
+        painter.setPen(QPen(QColor(220, 221, 225), 1));
+        painter.drawEllipse(center, ring * scale, ring * scale);
+        painter.setPen(QColor(127, 140, 141));
+        painter.drawText(QPointF(center.x() + ring * scale + 2, center.y() - 2),
+                         QString("%1 m").arg(ring, 0, 'g', 3));
+    }
+    painter.setPen(QColor(127, 140, 141));
+    painter.drawText(QPointF(center.x() + 4, center.y() - radius + 10), "N");
+    painter.drawText(QPointF(center.x() + radius - 10, center.y() - 4), "E");
+
+    // 散点：越新的点越不透明
+    painter.setPen(Qt::NoPen);
+    const int pointCount = m_points.size();
+    for (int i = 0; i < pointCount; ++i) {
+        const int alpha = 60 + 195 * (i + 1) / pointCount;
+        painter.setBrush(QColor(52, 152, 219, alpha));
+        const QPointF screen(center.x() + m_points[i].x() * scale, center.y() - m_points[i].y() * scale);
+        painter.drawEllipse(screen, 2.0, 2.0);
+    }
+    painter.setBrush(Qt::NoBrush);
+
+    // 报告椭圆（实线）和实际椭圆（虚线）
+    painter.setPen(QPen(QColor(231, 76, 60), 2));
+    drawEllipse(painter, center, scale, m_summary.latestMajor, m_summary.latestMinor, m_summary.latestOrientation);
+    painter.setPen(QPen(QColor(39, 174, 96), 2, Qt::DashLine));
+    drawEllipse(painter, center, scale, m_summary.observedMajor, m_summary.observedMinor, m_summary.observedOrientation);
+
+    // 图例
+    const QPointF legend(plotRect.left(), plotRect.top() + 4);
+    painter.setPen(QPen(QColor(231, 76, 60), 2));
+    painter.drawLine(legend, legend + QPointF(20, 0));
+    painter.setPen(QPen(QColor(39, 174, 96), 2, Qt::DashLine));
+    painter.drawLine(legend + QPointF(0, 14), legend + QPointF(20, 14));
+    painter.setPen(QColor(44, 62, 80));
+    painter.drawText(legend + QPointF(24, 4), "接收机报告 1σ");
+    painter.drawText(legend + QPointF(24, 18), "实际离散 1σ");
+}
@@ -0,0 +1,46 @@
+#ifndef GSTVIEW_H
+#define GSTVIEW_H
+
+#include <QWidget>
+#include <QLabel>
+#include <QVector>
+#include <QPointF>
+#include <QFont>
+#include "satellitedata.h"
+#include "gstanalysis.h"
+
+// GST 误差椭圆视图：最近窗口内的定位散点（相对窗口均值），
+// 接收机报告的 1σ 误差椭圆（实线）和散点实际的 1σ 协方差椭圆（虚线）。
+class GstView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit GstView(QWidget *parent = nullptr);
+
+    // GST 分析由主窗口维护，这里只读取显示
+    void setAnalysis(const GstAnalysis *analysis);
+
+    void updateData(const SatelliteData &data);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    void setupUI();
+    void refreshSummary();
+
+    static void drawEllipse(QPainter &painter, const QPointF &center, double scale,
+                            double major, double minor, double orientation);
+
+    const GstAnalysis *m_analysis;
+
+    // 绘制用的快照，只在数据更新时从分析中取出
+    GstSummary m_summary;
+    QVector<QPointF> m_points;
+
+    QLabel *m_summaryLabel;
+    QFont m_labelFont;
+};
+
+#endif // GSTVIEW_H
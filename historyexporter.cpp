@@ -0,0 +1,386 @@
+#include "historyexporter.h"
+#include <QFileInfo>
+#include <QDebug>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+
+ExportBuffer::ExportBuffer(QFile *file)
+    : m_file(file)
+    , m_buffer(Capacity)
+    , m_used(0)
+    , m_ok(true)
+{
+}
+
+void ExportBuffer::reserve(size_t length)
+{
+    if (m_used + length > m_buffer.size()) {
+        flush();
+    }
+}
+
+void ExportBuffer::append(const char *text)
+{
+    append(text, std::strlen(text));
+}
+
+void ExportBuffer::append(const char *text, size_t length)
+{
+    if (length > m_buffer.size()) {
+        // 超过缓冲区的内容直接写出
+        flush();
+        m_ok = m_ok && m_file->write(text, qint64(length)) == qint64(length);
+        return;
+    }
+    reserve(length);
+    std::memcpy(m_buffer.data() + m_used, text, length);
+    m_used += length;
+}
+
+void ExportBuffer::append(char c)
+{
+    reserve(1);
+    m_buffer[m_used++] = c;
+}
+
+void ExportBuffer::appendInt(qint64 value)
+{
+    reserve(24);
+    char *begin = m_buffer.data() + m_used;
+    const std::to_chars_result result = std::to_chars(begin, begin + 24, value);
+    m_used += size_t(result.ptr - begin);
+}
+
+void ExportBuffer::appendFixed(double value, int precision)
+{
+    // 无效值（NaN）不输出任何字符
+    if (std::isnan(value)) {
+        return;
+    }
+
+    reserve(64);
+    char *begin = m_buffer.data() + m_used;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    const std::to_chars_result result = std::to_chars(begin, begin + 64, value, std::chars_format::fixed, precision);
+    m_used += size_t(result.ptr - begin);
+#else
+    // 旧的标准库（如 MinGW 8）只支持整数 to_chars
+    const int length = std::snprintf(begin, 64, "%.*f", precision, value);
+    m_used += size_t(qBound(0, length, 63));
+#endif
+}
+
+void ExportBuffer::appendTime(qint64 timeMs)
+{
+    static const qint64 kDayMs = 24 * 3600 * 1000;
+
+    qint64 days = timeMs / kDayMs;
+    qint64 msOfDay = timeMs % kDayMs;
+    if (msOfDay < 0) {
+        msOfDay += kDayMs;
+        --days;
+    }
+
+    char text[32];
+    char *p = text;
+    auto put2 = [&p](int value) {
+        *p++ = char('0' + value / 10);
+        *p++ = char('0' + value % 10);
+    };
+
+    if (timeMs >= kDayMs) {
+        // Unix 天数转公历日期（Howard Hinnant 的 civil_from_days）
+        const qint64 z = days + 719468;
+        const qint64 era = z / 146097;
+        const qint64 doe = z - era * 146097;
+        const qint64 yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const qint64 doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const qint64 mp = (5 * doy + 2) / 153;
+        const int day = int(doy - (153 * mp + 2) / 5 + 1);
+        const int month = int(mp < 10 ? mp + 3 : mp - 9);
+        const int year = int(yoe + era * 400 + (month <= 2 ? 1 : 0));
+
+        put2(year / 100);
+        put2(year % 100);
+        *p++ = '-';
+        put2(month);
+        *p++ = '-';
+        put2(day);
+        *p++ = 'T';
+    }
+
+    const int ms = int(msOfDay % 1000);
+    const int seconds = int(msOfDay / 1000);
+    put2(seconds / 3600);
+    *p++ = ':';
+    put2(seconds / 60 % 60);
+    *p++ = ':';
+    put2(seconds % 60);
+    *p++ = '.';
+    *p++ = char('0' + ms / 100);
+    put2(ms % 100);
+    if (timeMs >= kDayMs) {
+        *p++ = 'Z';
+    }
+    append(text, size_t(p - text));
+}
+
+bool ExportBuffer::flush()
+{
+    if (m_used > 0) {
+        m_ok = m_ok && m_file->write(m_buffer.data(), qint64(m_used)) == qint64(m_used);
+        m_used = 0;
+    }
+    return m_ok;
+}
+
+HistoryExporter::HistoryExporter(const EpochHistoryPtr &history, const QString &fileName, Format format,
+                                 QObject *parent)
+    : QObject(parent)
+    , m_history(history)
+    , m_fileName(fileName)
+    , m_format(format)
+    , m_rows(0)
+    , m_written(0)
+    , m_cancelled(false)
+{
+}
+
+HistoryExporter::Format HistoryExporter::formatForFile(const QString &fileName)
+{
+    const QString suffix = QFileInfo(fileName).suffix().toLower();
+    if (suffix == "geojson" || suffix == "json") {
+        return GeoJson;
+    }
+    if (suffix == "kml") {
+        return Kml;
+    }
+    if (suffix == "gpx") {
+        return Gpx;
+    }
+    return Csv;
+}
+
+// GGA 定位质量对应的 GPX fix 类型（GPX 没有 RTK，差分类都记为 dgps）
+static const char *gpxFixType(quint8 fixQuality)
+{
+    switch (fixQuality) {
+    case 2:
+    case 4:
+    case 5:
+        return "dgps";
+    case 3:
+        return "pps";
+    default:
+        return "3d";
+    }
+}
+
+bool HistoryExporter::hasFix(quint8 fixQuality, double latitude, double longitude)
+{
+    return fixQuality > 0 && (latitude != 0.0 || longitude != 0.0);
+}
+
+void HistoryExporter::run()
+{
+    QFile file(m_fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        emit finished(false, file.errorString());
+        return;
+    }
+
+    m_rows = m_history ? m_history->size() : 0;
+    m_written = 0;
+    ExportBuffer out(&file);
+    writeHeader(out);
+
+    const int chunks = EpochHistory::chunkCount(m_rows);
+    qint64 done = 0;
+    for (int chunk = 0; chunk < chunks && out.isOk(); ++chunk) {
+        if (m_cancelled.load(std::memory_order_relaxed)) {
+            file.close();
+            file.remove();
+            emit finished(false, "已取消");
+            return;
+        }
+
+        const int rows = EpochHistory::chunkRows(chunk, m_rows);
+        writeRows(out, chunk, 0, rows);
+        done += rows;
+        emit progress(done, m_rows);
+    }
+
+    writeFooter(out);
+    if (!out.flush()) {
+        const QString error = file.errorString();
+        file.close();
+        file.remove();
+        emit finished(false, error);
+        return;
+    }
+
+    file.close();
+    qDebug() << "历元历史导出完成:" << m_fileName << "行数:" << m_rows;
+    emit finished(true, QString());
+}
+
+bool HistoryExporter::writeHeader(ExportBuffer &out)
+{
+    switch (m_format) {
+    case Csv:
+        out.append("time,latitude,longitude,altitude,fix_quality,satellites_used,hdop,pdop,vdop,"
+                   "speed_mps,course_deg,gst_rms,gst_major,gst_minor,gst_orientation,"
+                   "gst_sigma_lat,gst_sigma_lon,gst_sigma_alt\n");
+        break;
+    case GeoJson:
+        out.append("{\"type\":\"FeatureCollection\",\"features\":[{\"type\":\"Feature\","
+                   "\"properties\":{\"name\":\"NMEA track\"},"
+                   "\"geometry\":{\"type\":\"LineString\",\"coordinates\":[\n");
+        break;
+    case Kml:
+        out.append("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                   "<kml xmlns=\"http://www.opengis.net/kml/2.2\">\n<Document>\n"
+                   "<Placemark><name>NMEA track</name><LineString><altitudeMode>absolute</altitudeMode>"
+                   "<coordinates>\n");
+        break;
+    case Gpx:
+        out.append("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                   "<gpx version=\"1.1\" creator=\"SatelliteApp\" xmlns=\"http://www.topografix.com/GPX/1/1\">\n"
+                   "<trk><name>NMEA track</name><trkseg>\n");
+        break;
+    }
+    return out.isOk();
+}
+
+void HistoryExporter::writeRows(ExportBuffer &out, int chunkIndex, int begin, int end)
+{
+    const ColumnSpan<qint64> times = m_history->column(&EpochHistory::Chunk::timeMs, chunkIndex, m_rows);
+    const ColumnSpan<double> latitudes = m_history->column(&EpochHistory::Chunk::latitude, chunkIndex, m_rows);
+    const ColumnSpan<double> longitudes = m_history->column(&EpochHistory::Chunk::longitude, chunkIndex, m_rows);
+    const ColumnSpan<double> altitudes = m_history->column(&EpochHistory::Chunk::altitude, chunkIndex, m_rows);
+    const ColumnSpan<quint8> fixes = m_history->column(&EpochHistory::Chunk::fixQuality, chunkIndex, m_rows);
+    const ColumnSpan<quint8> satellites = m_history->column(&EpochHistory::Chunk::satellitesUsed, chunkIndex, m_rows);
+    const ColumnSpan<float> hdops = m_history->column(&EpochHistory::Chunk::hdop, chunkIndex, m_rows);
+    const ColumnSpan<float> pdops = m_history->column(&EpochHistory::Chunk::pdop, chunkIndex, m_rows);
+    const ColumnSpan<float> vdops = m_history->column(&EpochHistory::Chunk::vdop, chunkIndex, m_rows);
+
+    if (m_format == Csv) {
+        const ColumnSpan<float> speeds = m_history->column(&EpochHistory::Chunk::speed, chunkIndex, m_rows);
+        const ColumnSpan<float> courses = m_history->column(&EpochHistory::Chunk::course, chunkIndex, m_rows);
+        const ColumnSpan<float> gst[] = {
+            m_history->column(&EpochHistory::Chunk::gstRms, chunkIndex, m_rows),
+            m_history->column(&EpochHistory::Chunk::gstMajor, chunkIndex, m_rows),
+            m_history->column(&EpochHistory::Chunk::gstMinor, chunkIndex, m_rows),
+            m_history->column(&EpochHistory::Chunk::gstOrientation, chunkIndex, m_rows),
+            m_history->column(&EpochHistory::Chunk::gstSigmaLat, chunkIndex, m_rows),
+            m_history->column(&EpochHistory::Chunk::gstSigmaLon, chunkIndex, m_rows),
+            m_history->column(&EpochHistory::Chunk::gstSigmaAlt, chunkIndex, m_rows)
+        };
+
+        for (int i = begin; i < end; ++i) {
+            out.appendTime(times[i]);
+            out.append(',');
+            out.appendFixed(latitudes[i], 8);
+            out.append(',');
+            out.appendFixed(longitudes[i], 8);
+            out.append(',');
+            out.appendFixed(altitudes[i], 3);
+            out.append(',');
+            out.appendInt(fixes[i]);
+            out.append(',');
+            out.appendInt(satellites[i]);
+            out.append(',');
+            out.appendFixed(hdops[i], 2);
+            out.append(',');
+            out.appendFixed(pdops[i], 2);
+            out.append(',');
+            out.appendFixed(vdops[i], 2);
+            out.append(',');
+            out.appendFixed(speeds[i], 3);
+            out.append(',');
+            out.appendFixed(courses[i], 2);
+            for (const ColumnSpan<float> &column : gst) {
+                out.append(',');
+                out.appendFixed(column[i], 3);
+            }
+            out.append('\n');
+        }
+        return;
+    }
+
+    // 轨迹格式只输出有效定位
+    for (int i = begin; i < end; ++i) {
+        if (!hasFix(fixes[i], latitudes[i], longitudes[i])) {
+            continue;
+        }
+
+        switch (m_format) {
+        case GeoJson:
+            out.append(m_written > 0 ? ",[" : "[");
+            out.appendFixed(longitudes[i], 8);
+            out.append(',');
+            out.appendFixed(latitudes[i], 8);
+            out.append(',');
+            out.appendFixed(altitudes[i], 3);
+            out.append("]\n");
+            break;
+        case Kml:
+            out.appendFixed(longitudes[i], 8);
+            out.append(',');
+            out.appendFixed(latitudes[i], 8);
+            out.append(',');
+            out.appendFixed(altitudes[i], 3);
+            out.append('\n');
+            break;
+        case Gpx:
+            out.append("<trkpt lat=\"");
+            out.appendFixed(latitudes[i], 8);
+            out.append("\" lon=\"");
+            out.appendFixed(longitudes[i], 8);
+            out.append("\"><ele>");
+            out.appendFixed(altitudes[i], 3);
+            out.append("</ele>");
+            // GPX 时间必须带日期，只有当天时间的历元不输出
+            if (times[i] >= qint64(24) * 3600 * 1000) {
+                out.append("<time>");
+                out.appendTime(times[i]);
+                out.append("</time>");
+            }
+            out.append("<fix>");
+            out.append(gpxFixType(fixes[i]));
+            out.append("</fix><sat>");
+            out.appendInt(satellites[i]);
+            out.append("</sat><hdop>");
+            out.appendFixed(hdops[i], 2);
+            out.append("</hdop><vdop>");
+            out.appendFixed(vdops[i], 2);
+            out.append("</vdop><pdop>");
+            out.appendFixed(pdops[i], 2);
+            out.append("</pdop></trkpt>\n");
+            break;
+        default:
+            break;
+        }
+        ++m_written;
+    }
+}
+
+bool HistoryExporter::writeFooter(ExportBuffer &out)
+{
+    switch (m_format) {
+    case Csv:
+        break;
+    case GeoJson:
+        out.append("]}}]}\n");
+        break;
+    case Kml:
+        out.append("</coordinates></LineString></Placemark>\n</Document>\n</kml>\n");
+        break;
+    case Gpx:
+        out.append("</trkseg></trk>\n</gpx>\n");
+        break;
+    }
+    return out.isOk();
+}
@@ -0,0 +1,85 @@
+#ifndef HISTORYEXPORTER_H
+#define HISTORYEXPORTER_H
+
+#include <QObject>
+#include <QString>
+#include <QFile>
+#include <atomic>
+#include <vector>
+#include "epochhistory.h"
+
+// 带 1MB 缓冲区的顺序写入，数字直接格式化到缓冲区中，不经过 QString
+class ExportBuffer
+{
+public:
+    enum { Capacity = 1 << 20 };
+
+    explicit ExportBuffer(QFile *file);
+
+    void append(const char *text);
+    void append(const char *text, size_t length);
+    void append(char c);
+    void appendInt(qint64 value);
+    void appendFixed(double value, int precision);
+    // 有日期时输出 ISO 8601（YYYY-MM-DDTHH:MM:SS.sssZ），否则输出当天时间 HH:MM:SS.sss
+    void appendTime(qint64 timeMs);
+
+    bool flush();
+    bool isOk() const { return m_ok; }
+
+private:
+    void reserve(size_t length);
+
+    QFile *m_file;
+    std::vector<char> m_buffer;
+    size_t m_used;
+    bool m_ok;
+};
+
+// 在工作线程中把历元历史流式导出为 CSV / GeoJSON / KML / GPX。
+// 创建后 moveToThread，在线程中调用 run()；导出开始时取一次历史行数，
+// 回放继续追加的历元不影响导出。进度按数据块报告，cancel() 可以从任意线程调用。
+class HistoryExporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Format {
+        Csv,
+        GeoJson,
+        Kml,
+        Gpx
+    };
+
+    HistoryExporter(const EpochHistoryPtr &history, const QString &fileName, Format format,
+                    QObject *parent = nullptr);
+
+    // 按文件后缀判断格式，未知后缀按 CSV 处理
+    static Format formatForFile(const QString &fileName);
+
+    void cancel() { m_cancelled.store(true, std::memory_order_relaxed); }
+
+public slots:
+    void run();
+
+signals:
+    void progress(qint64 rows, qint64 total);
+    // 成功时 message 为空
+    void finished(bool ok, const QString &message);
+
+private:
+    bool writeHeader(ExportBuffer &out);
+    void writeRows(ExportBuffer &out, int chunkIndex, int begin, int end);
+    bool writeFooter(ExportBuffer &out);
+
+    static bool hasFix(quint8 fixQuality, double latitude, double longitude);
+
+    EpochHistoryPtr m_history;
+    QString m_fileName;
+    Format m_format;
+    qint64 m_rows;
+    qint64 m_written;        // 已写出的轨迹点（GeoJSON 需要据此加逗号）
+    std::atomic<bool> m_cancelled;
+};
+
+#endif // HISTORYEXPORTER_H
@@ -0,0 +1,145 @@
+#include "historyquery.h"
+#include <algorithm>
+
+HistoryQuery::HistoryQuery(const EpochHistoryPtr &history)
+    : m_history(history)
+    , m_rows(0)
+    , m_matchedRows(0)
+    , m_fromMs(std::numeric_limits<qint64>::min())
+    , m_toMs(std::numeric_limits<qint64>::max())
+    , m_fixMask(0xFFFFFFFFu)
+    , m_maxHdop(std::numeric_limits<float>::infinity())
+    , m_minSatellitesUsed(0)
+{
+}
+
+void HistoryQuery::setTimeRange(qint64 fromMs, qint64 toMs)
+{
+    m_fromMs = fromMs;
+    m_toMs = toMs;
+}
+
+void HistoryQuery::setFixQualities(quint32 mask)
+{
+    m_fixMask = mask;
+}
+
+void HistoryQuery::setMaxHdop(float hdop)
+{
+    m_maxHdop = hdop;
+}
+
+void HistoryQuery::setMinSatellitesUsed(int count)
+{
+    m_minSatellitesUsed = count;
+}
+
+bool HistoryQuery::timeCovers(const EpochHistory::ChunkSummary &summary) const
+{
+    return summary.minTimeMs >= m_fromMs && summary.maxTimeMs <= m_toMs;
+}
+
+bool HistoryQuery::timeDisjoint(const EpochHistory::ChunkSummary &summary) const
+{
+    return summary.maxTimeMs < m_fromMs || summary.minTimeMs > m_toMs;
+}
+
+bool HistoryQuery::otherConditionsHold(const EpochHistory::ChunkSummary &summary) const
+{
+    // 块内出现的所有定位质量都允许，且最差的 HDOP/卫星数也满足
+    return (summary.fixQualityMask & ~m_fixMask) == 0
+        && summary.maxHdop <= m_maxHdop
+        && summary.minSatellitesUsed >= m_minSatellitesUsed;
+}
+
+bool HistoryQuery::otherConditionsExcluded(const EpochHistory::ChunkSummary &summary) const
+{
+    return (summary.fixQualityMask & m_fixMask) == 0
+        || summary.minHdop > m_maxHdop
+        || summary.maxSatellitesUsed < m_minSatellitesUsed;
+}
+
+QVector<HistoryRange> HistoryQuery::run()
+{
+    QVector<HistoryRange> ranges;
+    m_matchedRows = 0;
+    m_rows = m_history ? m_history->size() : 0;
+
+    const int chunks = EpochHistory::chunkCount(m_rows);
+    for (int chunkIndex = 0; chunkIndex < chunks; ++chunkIndex) {
+        const int rows = EpochHistory::chunkRows(chunkIndex, m_rows);
+        const EpochHistory::ChunkSummary *summary = m_history->summary(chunkIndex, m_rows);
+        if (!summary) {
+            // 最后一个未写满的块没有可用的摘要，逐行判断
+            scanChunk(chunkIndex, 0, rows, true, true, ranges);
+            continue;
+        }
+
+        if (timeDisjoint(*summary) || otherConditionsExcluded(*summary)) {
+            continue;
+        }
+
+        int begin = 0;
+        int end = rows;
+        bool checkTime = !timeCovers(*summary);
+        if (checkTime && summary->timeSorted) {
+            // 块内时间有序：二分查找得到时间范围内的连续行
+            const ColumnSpan<qint64> times = m_history->column(&EpochHistory::Chunk::timeMs, chunkIndex, m_rows);
+            begin = int(std::lower_bound(times.begin(), times.end(), m_fromMs) - times.begin());
+            end = int(std::upper_bound(times.begin() + begin, times.end(), m_toMs) - times.begin());
+            checkTime = false;
+        }
+        if (begin >= end) {
+            continue;
+        }
+
+        const bool checkOthers = !otherConditionsHold(*summary);
+        if (!checkTime && !checkOthers) {
+            appendRange(ranges, (qint64(chunkIndex) << EpochHistory::ChunkShift) + begin,
+                        (qint64(chunkIndex) << EpochHistory::ChunkShift) + end);
+        } else {
+            scanChunk(chunkIndex, begin, end, checkTime, checkOthers, ranges);
+        }
+    }
+    return ranges;
+}
+
+void HistoryQuery::scanChunk(int chunkIndex, int begin, int end, bool checkTime, bool checkOthers,
+                             QVector<HistoryRange> &ranges)
+{
+    const ColumnSpan<qint64> times = m_history->column(&EpochHistory::Chunk::timeMs, chunkIndex, m_rows);
+    const ColumnSpan<quint8> fixes = m_history->column(&EpochHistory::Chunk::fixQuality, chunkIndex, m_rows);
+    const ColumnSpan<float> hdops = m_history->column(&EpochHistory::Chunk::hdop, chunkIndex, m_rows);
+    const ColumnSpan<quint8> satellites = m_history->column(&EpochHistory::Chunk::satellitesUsed, chunkIndex, m_rows);
+    const qint64 base = qint64(chunkIndex) << EpochHistory::ChunkShift;
+
+    // 连续满足条件的行合并成一段
+    int runStart = -1;
+    for (int i = begin; i < end; ++i) {
+        bool match = true;
+        if (checkTime) {
+            match = times[i] >= m_fromMs && times[i] <= m_toMs;
+        }
+        if (match && checkOthers) {
+            match = (EpochHistory::fixQualityBit(fixes[i]) & m_fixMask) != 0
+                 && hdops[i] <= m_maxHdop
+                 && satellites[i] >= m_minSatellitesUsed;
+        }
+
+        if (match && runStart < 0) {
+            runStart = i;
+        } else if (!match && runStart >= 0) {
+            appendRange(ranges, base + runStart, base + i);
+            runStart = -1;
+        }
+    }
+    if (runStart >= 0) {
+        appendRange(ranges, base + runStart, base + end);
+    }
+}
+
+void HistoryQuery::appendRange(QVector<HistoryRange> &ranges, qint64 begin, qint64 end)
+{
+    ranges.append(HistoryRange(begin, end));
+    m_matchedRows += end - begin;
+}
@@ -0,0 +1,80 @@
+#ifndef HISTORYQUERY_H
+#define HISTORYQUERY_H
+
+#include <QVector>
+#include <limits>
+#include "epochhistory.h"
+
+// 查询结果中的一段连续行 [begin, end)，不跨数据块，可以直接取各列的 ColumnSpan
+struct HistoryRange {
+    qint64 begin;
+    qint64 end;
+
+    HistoryRange() : begin(0), end(0) {}
+    HistoryRange(qint64 b, qint64 e) : begin(b), end(e) {}
+
+    qint64 size() const { return end - begin; }
+};
+
+// 历元历史的条件查询，例如“08:45:51 到 08:50:00 之间 RTK 固定解的历元”：
+//
+//     HistoryQuery query(history);
+//     query.setTimeRange(from, to);
+//     query.setFixQualities(EpochHistory::fixQualityBit(4));
+//     for (const HistoryRange &range : query.run()) {
+//         ColumnSpan<double> lat = query.column(&EpochHistory::Chunk::latitude, range);
+//         ...
+//     }
+//
+// 已写满的数据块先用区间摘要判断：与条件不相交的整块跳过，整块都满足的非时间条件不再逐行判断，
+// 块内时间有序时用二分查找确定时间范围。只有剩下的行才逐行判断。
+// 查询开始时取一次历史的行数，之后追加的历元不在结果中。
+class HistoryQuery
+{
+public:
+    explicit HistoryQuery(const EpochHistoryPtr &history);
+
+    // 时间范围 [fromMs, toMs]，单位与历史的 timeMs 列相同
+    void setTimeRange(qint64 fromMs, qint64 toMs);
+    // 允许的定位质量，EpochHistory::fixQualityBit 的组合
+    void setFixQualities(quint32 mask);
+    void setMaxHdop(float hdop);
+    void setMinSatellitesUsed(int count);
+
+    QVector<HistoryRange> run();
+
+    // 运行时取得的行数和结果总行数
+    qint64 snapshotRows() const { return m_rows; }
+    qint64 matchedRows() const { return m_matchedRows; }
+
+    template <typename T>
+    ColumnSpan<T> column(T (EpochHistory::Chunk::*member)[EpochHistory::ChunkRows],
+                         const HistoryRange &range) const
+    {
+        const int chunkIndex = EpochHistory::chunkOf(range.begin);
+        const ColumnSpan<T> chunk = m_history->column(member, chunkIndex, m_rows);
+        return ColumnSpan<T>(chunk.data + EpochHistory::offsetOf(range.begin), int(range.size()));
+    }
+
+private:
+    bool timeCovers(const EpochHistory::ChunkSummary &summary) const;
+    bool timeDisjoint(const EpochHistory::ChunkSummary &summary) const;
+    bool otherConditionsHold(const EpochHistory::ChunkSummary &summary) const;
+    bool otherConditionsExcluded(const EpochHistory::ChunkSummary &summary) const;
+
+    void scanChunk(int chunkIndex, int begin, int end, bool checkTime, bool checkOthers,
+                   QVector<HistoryRange> &ranges);
+    void appendRange(QVector<HistoryRange> &ranges, qint64 begin, qint64 end);
+
+    EpochHistoryPtr m_history;
+    qint64 m_rows;
+    qint64 m_matchedRows;
+
+    qint64 m_fromMs;
+    qint64 m_toMs;
+    quint32 m_fixMask;
+    float m_maxHdop;
+    int m_minSatellitesUsed;
+};
+
+#endif // HISTORYQUERY_H
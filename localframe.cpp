@@ -0,0 +1,45 @@
+#include "localframe.h"
+#include <QtMath>
+
+// WGS84 椭球
+static const double kSemiMajorAxis = 6378137.0;
+static const double kEccentricitySquared = 6.69437999014e-3;
+
+LocalFrame::LocalFrame()
+    : m_valid(false)
+    , m_latitude(0.0)
+    , m_longitude(0.0)
+    , m_altitude(0.0)
+    , m_metersPerDegreeLat(0.0)
+    , m_metersPerDegreeLon(0.0)
+{
+}
+
+void LocalFrame::setOrigin(double latitude, double longitude, double altitude)
+{
+    m_latitude = latitude;
+    m_longitude = longitude;
+    m_altitude = altitude;
+    m_valid = true;
+
+    // 原点处的曲率半径，换算成每度对应的米数
+    const double sinLat = qSin(qDegreesToRadians(latitude));
+    const double cosLat = qCos(qDegreesToRadians(latitude));
+    const double w = 1.0 - kEccentricitySquared * sinLat * sinLat;
+    const double meridian = kSemiMajorAxis * (1.0 - kEccentricitySquared) / (w * qSqrt(w));
+    const double primeVertical = kSemiMajorAxis / qSqrt(w);
+    m_metersPerDegreeLat = qDegreesToRadians(meridian + altitude);
+    m_metersPerDegreeLon = qDegreesToRadians((primeVertical + altitude) * cosLat);
+}
+
+void LocalFrame::toEnu(double latitude, double longitude, double altitude,
+                       double &east, double &north, double &up) const
+{
+    double deltaLon = longitude - m_longitude;
+    if (deltaLon > 180.0) deltaLon -= 360.0;
+    else if (deltaLon < -180.0) deltaLon += 360.0;
+
+    east = deltaLon * m_metersPerDegreeLon;
+    north = (latitude - m_latitude) * m_metersPerDegreeLat;
+    up = altitude - m_altitude;
+}
@@ -0,0 +1,32 @@
+#ifndef LOCALFRAME_H
+#define LOCALFRAME_H
+
+// 局部东北天（ENU）坐标系。
+// 原点处的子午圈、卯酉圈曲率半径在设置原点时计算一次，
+// 之后每个点的转换只需要乘法（局部切平面近似，适用于几公里以内的范围）。
+class LocalFrame
+{
+public:
+    LocalFrame();
+
+    void setOrigin(double latitude, double longitude, double altitude);
+    void reset() { m_valid = false; }
+    bool isValid() const { return m_valid; }
+
+    double originLatitude() const { return m_latitude; }
+    double originLongitude() const { return m_longitude; }
+    double originAltitude() const { return m_altitude; }
+
+    void toEnu(double latitude, double longitude, double altitude,
+               double &east, double &north, double &up) const;
+
+private:
+    bool m_valid;
+    double m_latitude;
+    double m_longitude;
+    double m_altitude;
+    double m_metersPerDegreeLat;
+    double m_metersPerDegreeLon;
+};
+
+#endif // LOCALFRAME_H
@@ -0,0 +1,288 @@
+#include "loganalyzer.h"
+#include "filemanager.h"
+#include "nmeaparser.h"
+#include <QFileInfo>
+#include <QDateTime>
+#include <QTime>
+#include <QStringList>
+
+static const qint64 kDayMs = 24 * 3600 * 1000;
+
+static QString formatTime(qint64 timeMs)
+{
+    if (timeMs >= kDayMs) {
+        return QDateTime::fromMSecsSinceEpoch(timeMs, Qt::UTC).toString(Qt::ISODateWithMs);
+    }
+    return QTime::fromMSecsSinceStartOfDay(int(timeMs)).toString("hh:mm:ss.zzz");
+}
+
+void LogSummary::merge(const LogSummary &other)
+{
+    sentences += other.sentences;
+    checksumErrors += other.checksumErrors;
+    for (auto it = other.sentenceMix.constBegin(); it != other.sentenceMix.constEnd(); ++it) {
+        sentenceMix[it.key()] += it.value();
+    }
+    for (auto it = other.talkerMix.constBegin(); it != other.talkerMix.constEnd(); ++it) {
+        talkerMix[it.key()] += it.value();
+    }
+
+    if (other.epochs > 0) {
+        firstTimeMs = epochs > 0 ? qMin(firstTimeMs, other.firstTimeMs) : other.firstTimeMs;
+        lastTimeMs = epochs > 0 ? qMax(lastTimeMs, other.lastTimeMs) : other.lastTimeMs;
+
+        // 平均卫星数按历元数加权
+        const qint64 mergedEpochs = epochs + other.epochs;
+        meanVisible = (meanVisible * epochs + other.meanVisible * other.epochs) / mergedEpochs;
+        meanUsed = (meanUsed * epochs + other.meanUsed * other.epochs) / mergedEpochs;
+        epochs = mergedEpochs;
+    }
+    fixEpochs += other.fixEpochs;
+    for (auto it = other.fixQualities.constBegin(); it != other.fixQualities.constEnd(); ++it) {
+        fixQualities[it.key()] += it.value();
+    }
+    maxVisible = qMax(maxVisible, other.maxVisible);
+    maxUsed = qMax(maxUsed, other.maxUsed);
+
+    signal.merge(other.signal);
+    elapsedMs += other.elapsedMs;
+}
+
+QString LogSummary::toText() const
+{
+    QStringList lines;
+    lines.append(QString("文件: %1").arg(fileName));
+    if (!ok) {
+        lines.append("  无法打开文件");
+        return lines.join('\n') + '\n';
+    }
+
+    lines.append(QString("  语句: %1  校验和错误: %2").arg(sentences).arg(checksumErrors));
+
+    QStringList mix;
+    for (auto it = sentenceMix.constBegin(); it != sentenceMix.constEnd(); ++it) {
+        mix.append(QString("%1=%2").arg(it.key()).arg(it.value()));
+    }
+    lines.append(QString("  语句组成: %1").arg(mix.join(' ')));
+
+    QStringList talkers;
+    for (auto it = talkerMix.constBegin(); it != talkerMix.constEnd(); ++it) {
+        talkers.append(QString("%1=%2").arg(it.key()).arg(it.value()));
+    }
+    lines.append(QString("  Talker: %1").arg(talkers.join(' ')));
+
+    lines.append(QString("  历元: %1  时间: %2 - %3")
+                 .arg(epochs).arg(epochs > 0 ? formatTime(firstTimeMs) : "-")
+                 .arg(epochs > 0 ? formatTime(lastTimeMs) : "-"));
+
+    QStringList fixes;
+    for (auto it = fixQualities.constBegin(); it != fixQualities.constEnd(); ++it) {
+        fixes.append(QString("%1=%2").arg(NMEAParser::getFixTypeString(it.key())).arg(it.value()));
+    }
+    lines.append(QString("  定位可用率: %1%  (%2)").arg(fixAvailability() * 100.0, 0, 'f', 2).arg(fixes.join(' ')));
+
+    lines.append(QString("  卫星数: 可见 平均 %1 最大 %2  使用 平均 %3 最大 %4")
+                 .arg(meanVisible, 0, 'f', 1).arg(maxVisible).arg(meanUsed, 0, 'f', 1).arg(maxUsed));
+
+    for (const QString &system : signal.sortedSystems()) {
+        const SnrAccumulator &acc = signal.systemStatistics()[system];
+        lines.append(QString("  信噪比 %1: 样本 %2 平均 %3 标准差 %4 最小 %5 中位数 %6 最大 %7 dB-Hz")
+                     .arg(system, -5).arg(acc.count).arg(acc.mean, 0, 'f', 1)
+                     .arg(acc.standardDeviation(), 0, 'f', 1).arg(acc.minimum)
+                     .arg(acc.percentile(0.5)).arg(acc.maximum));
+    }
+
+    lines.append(QString("  耗时: %1 ms").arg(elapsedMs, 0, 'f', 1));
+    return lines.join('\n') + '\n';
+}
+
+QJsonObject LogSummary::toJson() const
+{
+    QJsonObject object;
+    object["file"] = fileName;
+    object["ok"] = ok;
+    if (!ok) {
+        return object;
+    }
+
+    object["sentences"] = double(sentences);
+    object["checksum_errors"] = double(checksumErrors);
+
+    QJsonObject mix;
+    for (auto it = sentenceMix.constBegin(); it != sentenceMix.constEnd(); ++it) {
+        mix[it.key()] = double(it.value());
+    }
+    object["sentence_mix"] = mix;
+
+    QJsonObject talkers;
+    for (auto it = talkerMix.constBegin(); it != talkerMix.constEnd(); ++it) {
+        talkers[it.key()] = double(it.value());
+    }
+    object["talker_mix"] = talkers;
+
+    object["epochs"] = double(epochs);
+    if (epochs > 0) {
+        object["first_time"] = formatTime(firstTimeMs);
+        object["last_time"] = formatTime(lastTimeMs);
+    }
+    object["fix_epochs"] = double(fixEpochs);
+    object["fix_availability"] = fixAvailability();
+
+    QJsonObject fixes;
+    for (auto it = fixQualities.constBegin(); it != fixQualities.constEnd(); ++it) {
+        fixes[QString::number(it.key())] = double(it.value());
+    }
+    object["fix_quality"] = fixes;
+
+    QJsonObject satellites;
+    satellites["mean_visible"] = meanVisible;
+    satellites["max_visible"] = maxVisible;
+    satellites["mean_used"] = meanUsed;
+    satellites["max_used"] = maxUsed;
+    object["satellites"] = satellites;
+
+    QJsonObject snr;
+    for (const QString &system : signal.sortedSystems()) {
+        const SnrAccumulator &acc = signal.systemStatistics()[system];
+        QJsonObject stats;
+        stats["samples"] = double(acc.count);
+        stats["mean"] = acc.mean;
+        stats["stddev"] = acc.standardDeviation();
+        stats["min"] = acc.minimum;
+        stats["p50"] = acc.percentile(0.5);
+        stats["p95"] = acc.percentile(0.95);
+        stats["max"] = acc.maximum;
+        snr[system] = stats;
+    }
+    object["snr"] = snr;
+    object["elapsed_ms"] = elapsedMs;
+    return object;
+}
+
+LogAnalyzer::LogAnalyzer(QObject *parent)
+    : QObject(parent)
+    , m_streamParser(nullptr)
+    , m_sumVisible(0)
+    , m_sumUsed(0)
+{
+}
+
+void LogAnalyzer::begin(const QString &name)
+{
+    m_timer.start();
+    m_summary = LogSummary();
+    m_summary.fileName = name;
+    m_sumVisible = 0;
+    m_sumUsed = 0;
+}
+
+void LogAnalyzer::finish()
+{
+    if (m_summary.epochs > 0) {
+        m_summary.meanVisible = double(m_sumVisible) / m_summary.epochs;
+        m_summary.meanUsed = double(m_sumUsed) / m_summary.epochs;
+    }
+    m_summary.elapsedMs = m_timer.nsecsElapsed() / 1e6;
+}
+
+LogSummary LogAnalyzer::analyze(const QString &fileName)
+{
+    begin(fileName);
+
+    FileManager fileManager;
+    connect(&fileManager, &FileManager::nmeaDataReceived, this, &LogAnalyzer::onLine);
+    connect(&fileManager, &FileManager::epochCompleted, this, &LogAnalyzer::onEpoch);
+
+    if (!QFileInfo(fileName).isFile() || !fileManager.loadFile(fileName)) {
+        // 空文件也能打开，只是没有语句
+        m_summary.ok = QFileInfo(fileName).isFile();
+        finish();
+        return m_summary;
+    }
+    m_summary.ok = true;
+
+    // 不经过回放定时器，直接处理所有行；最后一次调用发出最后一个历元
+    const int total = fileManager.getTotalLines();
+    while (fileManager.getCurrentLine() < total) {
+        fileManager.processNextLine();
+    }
+    fileManager.processNextLine();
+
+    finish();
+    return m_summary;
+}
+
+void LogAnalyzer::beginStream(const QString &name)
+{
+    begin(name);
+    m_summary.ok = true;
+
+    delete m_streamParser;
+    m_streamParser = new NMEAParser(this);
+    connect(m_streamParser, &NMEAParser::epochCompleted, this, &LogAnalyzer::onEpoch);
+}
+
+void LogAnalyzer::addSentence(const QString &sentence)
+{
+    if (!m_streamParser) {
+        return;
+    }
+    onLine(sentence);
+    m_streamParser->parseNMEASentence(sentence);
+}
+
+LogSummary LogAnalyzer::finishStream()
+{
+    if (m_streamParser) {
+        m_streamParser->flushEpoch();
+        delete m_streamParser;
+        m_streamParser = nullptr;
+    }
+    finish();
+    return m_summary;
+}
+
+void LogAnalyzer::onLine(const QString &line)
+{
+    ++m_summary.sentences;
+    if (!NMEAParser::isChecksumValid(line)) {
+        ++m_summary.checksumErrors;
+    }
+
+    // 地址字段：GPGGA -> talker GP、类型 GGA；专有语句（$P...）整体作为类型
+    int comma = line.indexOf(',');
+    if (comma < 0) {
+        comma = line.indexOf('*');
+    }
+    const QString address = line.mid(1, comma - 1);
+    if (address.startsWith('P') || address.length() < 5) {
+        m_summary.talkerMix["P"]++;
+        m_summary.sentenceMix[address]++;
+    } else {
+        m_summary.talkerMix[address.left(2)]++;
+        m_summary.sentenceMix[address.mid(2)]++;
+    }
+}
+
+void LogAnalyzer::onEpoch(const SatelliteData &data)
+{
+    if (m_summary.epochs == 0) {
+        m_summary.firstTimeMs = data.utcTimeMs;
+    }
+    m_summary.lastTimeMs = data.utcTimeMs;
+    ++m_summary.epochs;
+
+    m_summary.fixQualities[data.fixQuality]++;
+    if (data.fixQuality > 0) {
+        ++m_summary.fixEpochs;
+    }
+
+    // 可见卫星为GSV列出的卫星（包括未跟踪的）
+    const int visible = data.satellites.size();
+    m_sumVisible += visible;
+    m_sumUsed += data.usedSatelliteCount;
+    m_summary.maxVisible = qMax(m_summary.maxVisible, visible);
+    m_summary.maxUsed = qMax(m_summary.maxUsed, data.usedSatelliteCount);
+
+    m_summary.signal.addEpoch(data.satellites);
+}
@@ -0,0 +1,83 @@
+#ifndef LOGANALYZER_H
+#define LOGANALYZER_H
+
+#include <QObject>
+#include <QString>
+#include <QMap>
+#include <QJsonObject>
+#include <QElapsedTimer>
+#include "satellitedata.h"
+#include "signalstats.h"
+
+class NMEAParser;
+
+// 一个 NMEA 日志文件的汇总
+struct LogSummary {
+    QString fileName;
+    bool ok;                          // 文件能否打开
+    qint64 sentences;                 // 有效格式的语句数
+    qint64 checksumErrors;
+    QMap<QString, qint64> sentenceMix;   // 语句类型（GGA/RMC/GSV...，不含talker）-> 条数
+    QMap<QString, qint64> talkerMix;     // talker（GP/GN/BD...）-> 条数
+
+    qint64 epochs;
+    qint64 fixEpochs;                 // 定位质量 > 0 的历元
+    QMap<int, qint64> fixQualities;   // 定位质量 -> 历元数
+    qint64 firstTimeMs;
+    qint64 lastTimeMs;
+
+    // 每历元卫星数
+    double meanVisible;
+    double meanUsed;
+    int maxVisible;
+    int maxUsed;
+
+    SignalStatistics signal;
+    double elapsedMs;                 // 分析耗时
+
+    LogSummary() : ok(false), sentences(0), checksumErrors(0), epochs(0), fixEpochs(0),
+                   firstTimeMs(0), lastTimeMs(0), meanVisible(0.0), meanUsed(0.0),
+                   maxVisible(0), maxUsed(0), elapsedMs(0.0) {}
+
+    double fixAvailability() const { return epochs > 0 ? double(fixEpochs) / epochs : 0.0; }
+
+    // 合并另一个文件的汇总（批量分析的合计）
+    void merge(const LogSummary &other);
+
+    QString toText() const;
+    QJsonObject toJson() const;
+};
+
+// 不依赖界面的日志分析：通过 FileManager 读取文件、NMEAParser 划分历元，
+// 一次性处理完整个文件（不经过回放定时器），汇总语句组成、定位可用率、卫星数和信噪比。
+// 也可以逐条送入实时数据源（串口、网络）的语句，结束时取汇总。
+class LogAnalyzer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit LogAnalyzer(QObject *parent = nullptr);
+
+    LogSummary analyze(const QString &fileName);
+
+    // 实时数据源
+    void beginStream(const QString &name);
+    void addSentence(const QString &sentence);
+    LogSummary finishStream();
+
+private slots:
+    void onLine(const QString &line);
+    void onEpoch(const SatelliteData &data);
+
+private:
+    void begin(const QString &name);
+    void finish();
+
+    LogSummary m_summary;
+    QElapsedTimer m_timer;
+    NMEAParser *m_streamParser;
+    qint64 m_sumVisible;
+    qint64 m_sumUsed;
+};
+
+#endif // LOGANALYZER_H
@@ -4,8 +4,18 @@
 #include "messageview.h"
 #include "satelliteview.h"
 #include "snrview.h"
+#include "waterfallview.h"
+#include "dopview.h"
+#include "gstview.h"
+#include "receiverview.h"
 #include "nmeaparser.h"
 #include "filemanager.h"
+#include "viewhub.h"
+#include "historyquery.h"
+#include "historyexporter.h"
+#include "anomalytimeline.h"
+#include "batchdialog.h"
+#include "chartmanager.h"
 #include <QApplication>
 #include <QMessageBox>
 #include <QFileDialog>
@@ -17,11 +27,20 @@
 #include <QSplitter>
 #include <QDebug>
 #include <QTabWidget>
+#include <QInputDialog>
+#include <QElapsedTimer>
+#include <QTime>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , m_isReplaying(false)
     , m_isIntegratedLayout(true)
+    , m_dopFromFile(false)
+    , m_accuracyStartRow(0)
+    , m_accuracyPassIntervalMs(0)
+    , m_exportThread(nullptr)
+    , m_exporter(nullptr)
+    , m_batchDialog(nullptr)
 {
     setWindowTitle("🛰️ 卫星应用软件 - GNSS数据可视化平台");
     setMinimumSize(1200, 800);
@@ -36,6 +55,11 @@ MainWindow::MainWindow(QWidget *parent)
     // 创建核心组件
     m_parser = new NMEAParser(this);
     m_fileManager = new FileManager(this);
+    // 消息视图按语句登记表显示每条语句的字段
+    m_parser->setCaptureFields(true);
+    m_fileManager->setCaptureFields(true);
+    m_history = EpochHistoryPtr::create();
+    m_accuracyPassTimer.start();
     
     // 创建视图（集成到主界面）
     qDebug() << "创建NMEAView...";
@@ -48,8 +72,34 @@ MainWindow::MainWindow(QWidget *parent)
     m_satelliteView = new SatelliteView(this);
     qDebug() << "创建SNRView...";
     m_snrView = new SNRView(this);
+    m_waterfallView = new WaterfallView(this);
+    m_dopView = new DopView(this);
+    m_gstView = new GstView(this);
+    m_receiverView = new ReceiverView(this);
+    // 运动轨迹从历元历史读取
+    m_chartManager = new ChartManager(this);
+    m_chartManager->setHistory(m_history);
     qDebug() << "所有视图创建完成";
     
+    // 消息视图显示主窗口维护的信号统计
+    m_messageView->setSignalStatistics(&m_signalStatistics);
+    m_dopView->setAnalysis(&m_dopAnalysis);
+    m_messageView->setAccuracyStatistics(&m_accuracyStatistics);
+    m_gstView->setAnalysis(&m_gstAnalysis);
+    
+    // 接收机在各自的线程中解析，只有主视图显示的接收机把历元送到这里
+    m_receiverManager = new ReceiverManager(this);
+    m_receiverView->setManager(m_receiverManager);
+    
+    // 所有视图通过订阅中心接收数据，隐藏或零尺寸的视图重新可见时再刷新
+    m_viewHub = new ViewHub(this);
+    m_viewHub->subscribe(m_nmeaView, [this](const SatelliteData &data) { m_nmeaView->updateData(data); });
+    m_viewHub->subscribe(m_basicView, [this](const SatelliteData &data) { m_basicView->updateData(data); });
+    m_viewHub->subscribe(m_messageView, [this](const SatelliteData &data) { m_messageView->updateData(data); });
+    m_viewHub->subscribe(m_satelliteView, [this](const SatelliteData &data) { m_satelliteView->updateData(data); });
+    m_viewHub->subscribe(m_snrView, [this](const SatelliteData &data) { m_snrView->updateData(data); });
+    m_viewHub->subscribe(m_gstView, [this](const SatelliteData &data) { m_gstView->updateData(data); });
+    
     // 设置视图为无边框，集成到主界面
     m_nmeaView->setWindowFlags(Qt::Widget);
     m_basicView->setWindowFlags(Qt::Widget);
@@ -142,6 +192,36 @@ void MainWindow::setupMenuBar()
     // 添加分隔符
     m_replayMenu->addSeparator();
     
+    m_exportStatsAction = new QAction("📈 导出信号统计(&E)...", this);
+    m_exportStatsAction->setToolTip("将每颗卫星的信噪比统计导出为CSV");
+    m_replayMenu->addAction(m_exportStatsAction);
+    
+    m_replayMenu->addSeparator();
+    
+    m_setReferenceAction = new QAction("🎯 设置精度参考点...", this);
+    m_setReferenceAction->setToolTip("静态测试：定位误差相对已知参考点计算");
+    m_replayMenu->addAction(m_setReferenceAction);
+    
+    m_meanReferenceAction = new QAction("📍 以平均位置为基准", this);
+    m_meanReferenceAction->setToolTip("定位误差相对所有定位的平均位置计算");
+    m_replayMenu->addAction(m_meanReferenceAction);
+    
+    m_replayMenu->addSeparator();
+    
+    m_queryHistoryAction = new QAction("🔎 查询历元历史(&Q)...", this);
+    m_queryHistoryAction->setToolTip("按UTC时间段和定位质量统计历元");
+    m_replayMenu->addAction(m_queryHistoryAction);
+    
+    m_exportHistoryAction = new QAction("💾 导出历元历史(&X)...", this);
+    m_exportHistoryAction->setToolTip("在后台将历元历史导出为CSV、GeoJSON、KML或GPX");
+    m_replayMenu->addAction(m_exportHistoryAction);
+    
+    m_replayMenu->addSeparator();
+    
+    m_batchAction = new QAction("📚 批量分析(&B)...", this);
+    m_batchAction->setToolTip("并行分析一个目录或多个日志文件，汇总语句、定位可用率和信噪比");
+    m_replayMenu->addAction(m_batchAction);
+    
     // 添加帮助菜单
     QMenu *helpMenu = m_menuBar->addMenu("❓ 帮助(&H)");
     QAction *aboutAction = new QAction("ℹ️ 关于", this);
@@ -212,7 +292,25 @@ void MainWindow::setupStatusBar()
     m_timeLabel = new QLabel(QDateTime::currentDateTime().toString("🕐 yyyy-MM-dd hh:mm:ss"));
     m_timeLabel->setStyleSheet("QLabel { color: #7f8c8d; font-weight: bold; }");
     
+    // 导出进度和取消按钮，只在导出时显示
+    m_exportProgressBar = new QProgressBar();
+    m_exportProgressBar->setVisible(false);
+    m_exportProgressBar->setMinimumWidth(160);
+    m_exportProgressBar->setFormat("💾 导出 %p%");
+    m_cancelExportButton = new QPushButton("取消导出");
+    m_cancelExportButton->setVisible(false);
+    
+    // 异常计数和时间轴
+    m_anomalyLabel = new QLabel();
+    m_anomalyTimeline = new AnomalyTimeline();
+    m_anomalyTimeline->setMonitor(&m_anomalyMonitor);
+    updateAnomalyLabel();
+    
     m_statusBar->addWidget(m_statusLabel);
+    m_statusBar->addPermanentWidget(m_anomalyLabel);
+    m_statusBar->addPermanentWidget(m_anomalyTimeline);
+    m_statusBar->addPermanentWidget(m_exportProgressBar);
+    m_statusBar->addPermanentWidget(m_cancelExportButton);
     m_statusBar->addPermanentWidget(m_progressBar);
     m_statusBar->addPermanentWidget(m_timeLabel);
     
@@ -229,6 +327,13 @@ void MainWindow::connectSignals()
     // 菜单动作
     connect(m_startAction, &QAction::triggered, this, &MainWindow::onStartReplay);
     connect(m_stopAction, &QAction::triggered, this, &MainWindow::onStopReplay);
+    connect(m_exportStatsAction, &QAction::triggered, this, &MainWindow::onExportSignalStatistics);
+    connect(m_setReferenceAction, &QAction::triggered, this, &MainWindow::onSetAccuracyReference);
+    connect(m_meanReferenceAction, &QAction::triggered, this, &MainWindow::onUseMeanPosition);
+    connect(m_queryHistoryAction, &QAction::triggered, this, &MainWindow::onQueryHistory);
+    connect(m_exportHistoryAction, &QAction::triggered, this, &MainWindow::onExportHistory);
+    connect(m_batchAction, &QAction::triggered, this, &MainWindow::onBatchAnalysis);
+    connect(m_cancelExportButton, &QPushButton::clicked, this, &MainWindow::onCancelExport);
     
     // 工具栏动作
     connect(m_nmeaViewAction, &QAction::triggered, this, &MainWindow::onShowNMEAView);
@@ -243,10 +348,16 @@ void MainWindow::connectSignals()
     // 数据更新信号
     connect(m_parser, &NMEAParser::dataParsed, this, &MainWindow::onDataUpdated);
     connect(m_fileManager, &FileManager::dataParsed, this, &MainWindow::onDataUpdated);
+    connect(m_parser, &NMEAParser::epochCompleted, this, &MainWindow::onEpochCompleted);
+    connect(m_fileManager, &FileManager::epochCompleted, this, &MainWindow::onEpochCompleted);
     
     // 连接文件管理器信号
     connect(m_fileManager, &FileManager::replayFinished, this, &MainWindow::onStopReplay);
     connect(m_fileManager, &FileManager::nmeaDataReceived, m_nmeaView, &NMEAView::addNMEALine);
+    
+    // 多接收机
+    connect(m_receiverView, &ReceiverView::showReceiver, this, &MainWindow::onShowReceiver);
+    connect(m_receiverManager, &ReceiverManager::epochCompleted, this, &MainWindow::onReceiverEpoch);
 }
 
 void MainWindow::onStartReplay()
@@ -260,6 +371,14 @@ void MainWindow::onStartReplay()
     
     if (!fileName.isEmpty()) {
         if (m_fileManager->loadFile(fileName)) {
+            // 新文件的历元与之前的历史无关；主视图回到文件回放
+            m_receiverManager->setActiveReceiver(-1);
+            m_history = EpochHistoryPtr::create();
+            resetAnalysis();
+            // DOP 对整个文件离线批量求解，不等回放
+            m_dopAnalysis.reprocess(m_fileManager->getLines());
+            m_dopFromFile = true;
+            m_dopView->reload();
             m_isReplaying = true;
             m_startAction->setEnabled(false);
             m_stopAction->setEnabled(true);
@@ -290,12 +409,8 @@ void MainWindow::onDataUpdated(const SatelliteData &data)
              << "纬度:" << data.latitude << "经度:" << data.longitude
              << "卫星列表大小:" << data.satellites.size();
     
-    // 更新所有视图
-    m_nmeaView->updateData(data);
-    m_basicView->updateData(data);
-    m_messageView->updateData(data);
-    m_satelliteView->updateData(data);
-    m_snrView->updateData(data);
+    // 更新视图：只有当前可见的视图立即刷新，其余标记为过期
+    m_viewHub->publish(data);
     
     // 更新状态栏
     QString statusText = QString("🛰️ 数据更新 - 卫星数: %1 | 定位: %2").arg(data.satelliteCount).arg(data.fixType);
@@ -308,6 +423,376 @@ void MainWindow::onDataUpdated(const SatelliteData &data)
     }
 }
 
+void MainWindow::onEpochCompleted(const SatelliteData &data)
+{
+    // 完整的历元写入历史；轨迹样本无论星位视图是否可见都要记录
+    m_history->append(EpochHistory::rowFromData(data));
+    m_satelliteView->recordTrackSamples(data);
+    analyzeEpoch(data);
+}
+
+void MainWindow::analyzeEpoch(const SatelliteData &data)
+{
+    m_signalStatistics.addEpoch(data.satellites);
+    if (!m_dopFromFile) {
+        // DOP 视图按完整历元合并刷新，不随每条语句重算
+        m_dopAnalysis.addEpoch(data);
+        m_dopView->epochsAdded();
+    }
+    m_accuracyStatistics.addEpoch(data);
+    if (m_accuracyPassTimer.hasExpired(m_accuracyPassIntervalMs)) {
+        runAccuracyMeanPass();
+    }
+    m_gstAnalysis.addEpoch(data);
+    // 有新事件时更新计数，另外每 100 个历元更新一次提示中的检测耗时
+    if (m_anomalyMonitor.addEpoch(data) > 0 || m_anomalyMonitor.epochCount() % 100 == 0) {
+        updateAnomalyLabel();
+    }
+    m_anomalyTimeline->update();
+    
+    // 瀑布图无论是否可见都要记录
+    m_waterfallView->recordEpoch(data);
+    // 轨迹只读入历史中新增的历元，图表按定时器合并刷新
+    m_chartManager->updateTrajectoryChart();
+}
+
+void MainWindow::onExportSignalStatistics()
+{
+    if (m_signalStatistics.epochCount() == 0) {
+        QMessageBox::information(this, "📈 导出信号统计", "还没有可统计的数据");
+        return;
+    }
+    
+    QString fileName = QFileDialog::getSaveFileName(
+        this,
+        "📈 导出信号统计",
+        "signal_statistics.csv",
+        "CSV文件 (*.csv);;所有文件 (*.*)"
+    );
+    if (fileName.isEmpty()) {
+        return;
+    }
+    
+    QString errorMessage;
+    if (m_signalStatistics.exportCsv(fileName, &errorMessage)) {
+        m_statusLabel->setText(QString("📈 信号统计已导出: %1").arg(QFileInfo(fileName).fileName()));
+    } else {
+        QMessageBox::critical(this, "❌ 错误", QString("无法导出信号统计: %1").arg(errorMessage));
+    }
+}
+
+void MainWindow::onSetAccuracyReference()
+{
+    bool ok = false;
+    QString text = QInputDialog::getText(
+        this,
+        "🎯 设置精度参考点",
+        "参考点坐标（纬度, 经度, 海拔米）：",
+        QLineEdit::Normal,
+        QString(),
+        &ok
+    );
+    if (!ok || text.trimmed().isEmpty()) {
+        return;
+    }
+    
+    QStringList parts = text.split(',', Qt::SkipEmptyParts);
+    bool okLat = false, okLon = false, okAlt = true;
+    double latitude = parts.value(0).trimmed().toDouble(&okLat);
+    double longitude = parts.value(1).trimmed().toDouble(&okLon);
+    double altitude = parts.size() > 2 ? parts[2].trimmed().toDouble(&okAlt) : 0.0;
+    if (!okLat || !okLon || !okAlt || qAbs(latitude) > 90.0 || qAbs(longitude) > 180.0) {
+        QMessageBox::warning(this, "⚠️ 格式错误", "请输入：纬度, 经度, 海拔（例如 39.9087, 116.3975, 50）");
+        return;
+    }
+    
+    m_accuracyStatistics.setReference(latitude, longitude, altitude);
+    rebuildAccuracyStatistics();
+}
+
+void MainWindow::onUseMeanPosition()
+{
+    m_accuracyStatistics.clearReference();
+    rebuildAccuracyStatistics();
+}
+
+void MainWindow::onQueryHistory()
+{
+    if (m_history->isEmpty()) {
+        QMessageBox::information(this, "🔎 查询历元历史", "还没有历元数据");
+        return;
+    }
+    
+    bool ok = false;
+    QString text = QInputDialog::getText(
+        this,
+        "🔎 查询历元历史",
+        "UTC时间段和定位质量（开始, 结束[, 定位质量]）：",
+        QLineEdit::Normal,
+        QString(),
+        &ok
+    );
+    if (!ok || text.trimmed().isEmpty()) {
+        return;
+    }
+    
+    QStringList parts = text.split(',', Qt::SkipEmptyParts);
+    QTime from = QTime::fromString(parts.value(0).trimmed(), "HH:mm:ss");
+    QTime to = QTime::fromString(parts.value(1).trimmed(), "HH:mm:ss");
+    bool okFix = true;
+    int fixQuality = parts.size() > 2 ? parts[2].trimmed().toInt(&okFix) : -1;
+    if (!from.isValid() || !to.isValid() || !okFix) {
+        QMessageBox::warning(this, "⚠️ 格式错误", "请输入：开始, 结束, 定位质量（例如 08:45:51, 08:50:00, 4）");
+        return;
+    }
+    
+    // 有日期时 timeMs 为 Unix 毫秒，时间段按第一个历元所在的UTC日期换算
+    const qint64 dayMs = 24 * 3600 * 1000;
+    const qint64 firstMs = m_history->row(0).timeMs;
+    const qint64 dayStart = firstMs >= dayMs ? firstMs - firstMs % dayMs : 0;
+    
+    HistoryQuery query(m_history);
+    query.setTimeRange(dayStart + from.msecsSinceStartOfDay(), dayStart + to.msecsSinceStartOfDay() + 999);
+    if (fixQuality >= 0) {
+        query.setFixQualities(EpochHistory::fixQualityBit(fixQuality));
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    const QVector<HistoryRange> ranges = query.run();
+    
+    // 结果直接读取列数据，计算平均位置
+    double sumLat = 0.0, sumLon = 0.0, sumAlt = 0.0;
+    for (const HistoryRange &range : ranges) {
+        const ColumnSpan<double> latitudes = query.column(&EpochHistory::Chunk::latitude, range);
+        const ColumnSpan<double> longitudes = query.column(&EpochHistory::Chunk::longitude, range);
+        const ColumnSpan<double> altitudes = query.column(&EpochHistory::Chunk::altitude, range);
+        for (int i = 0; i < latitudes.size; ++i) {
+            sumLat += latitudes[i];
+            sumLon += longitudes[i];
+            sumAlt += altitudes[i];
+        }
+    }
+    const qint64 elapsedUs = timer.nsecsElapsed() / 1000;
+    
+    QString result = QString("共 %1 个历元，匹配 %2 个（%3 段），耗时 %4 ms")
+                     .arg(query.snapshotRows()).arg(query.matchedRows()).arg(ranges.size())
+                     .arg(elapsedUs / 1000.0, 0, 'f', 2);
+    if (query.matchedRows() > 0) {
+        const double count = double(query.matchedRows());
+        result += QString("\n平均位置: %1, %2, %3 m")
+                  .arg(sumLat / count, 0, 'f', 7).arg(sumLon / count, 0, 'f', 7).arg(sumAlt / count, 0, 'f', 2);
+    }
+    QMessageBox::information(this, "🔎 查询历元历史", result);
+}
+
+void MainWindow::onExportHistory()
+{
+    if (m_exportThread) {
+        QMessageBox::information(this, "💾 导出历元历史", "已有导出任务正在进行");
+        return;
+    }
+    if (m_history->isEmpty()) {
+        QMessageBox::information(this, "💾 导出历元历史", "还没有历元数据");
+        return;
+    }
+    
+    QString fileName = QFileDialog::getSaveFileName(
+        this,
+        "💾 导出历元历史",
+        "history.csv",
+        "CSV文件 (*.csv);;GeoJSON文件 (*.geojson);;KML文件 (*.kml);;GPX文件 (*.gpx)"
+    );
+    if (fileName.isEmpty()) {
+        return;
+    }
+    
+    // 导出器持有历史的共享指针，开始新的回放不影响正在进行的导出
+    m_exportFileName = fileName;
+    m_exportThread = new QThread(this);
+    m_exporter = new HistoryExporter(m_history, fileName, HistoryExporter::formatForFile(fileName));
+    m_exporter->moveToThread(m_exportThread);
+    
+    connect(m_exportThread, &QThread::started, m_exporter, &HistoryExporter::run);
+    connect(m_exporter, &HistoryExporter::progress, this, &MainWindow::onExportProgress);
+    connect(m_exporter, &HistoryExporter::finished, this, &MainWindow::onExportFinished);
+    connect(m_exportThread, &QThread::finished, m_exporter, &QObject::deleteLater);
+    connect(m_exportThread, &QThread::finished, m_exportThread, &QObject::deleteLater);
+    
+    m_exportProgressBar->setValue(0);
+    m_exportProgressBar->setVisible(true);
+    m_cancelExportButton->setEnabled(true);
+    m_cancelExportButton->setVisible(true);
+    m_exportHistoryAction->setEnabled(false);
+    m_statusLabel->setText(QString("💾 正在导出: %1").arg(QFileInfo(fileName).fileName()));
+    
+    m_exportThread->start();
+}
+
+void MainWindow::onExportProgress(qint64 rows, qint64 total)
+{
+    m_exportProgressBar->setValue(total > 0 ? int(rows * 100 / total) : 100);
+}
+
+void MainWindow::onExportFinished(bool ok, const QString &message)
+{
+    // 关闭窗口时已经等待导出线程结束
+    if (!m_exportThread) {
+        return;
+    }
+    m_exportThread->quit();
+    m_exportThread = nullptr;
+    m_exporter = nullptr;
+    
+    m_exportProgressBar->setVisible(false);
+    m_cancelExportButton->setVisible(false);
+    m_exportHistoryAction->setEnabled(true);
+    
+    if (ok) {
+        m_statusLabel->setText(QString("💾 历元历史已导出: %1").arg(QFileInfo(m_exportFileName).fileName()));
+    } else {
+        m_statusLabel->setText(QString("⚠️ 导出未完成: %1").arg(message));
+    }
+}
+
+void MainWindow::onCancelExport()
+{
+    if (m_exporter) {
+        m_exporter->cancel();
+        m_cancelExportButton->setEnabled(false);
+    }
+}
+
+void MainWindow::resetAnalysis()
+{
+    m_signalStatistics.clear();
+    m_dopAnalysis.clear();
+    m_dopFromFile = false;
+    m_dopView->reload();
+    m_accuracyStatistics.clear();
+    m_accuracyStartRow = m_history->size();
+    m_gstAnalysis.clear();
+    m_anomalyMonitor.clear();
+    updateAnomalyLabel();
+    m_waterfallView->clearHistory();
+    m_satelliteView->clearTracks();
+    m_chartManager->setHistory(m_history);
+}
+
+void MainWindow::onShowReceiver(int id)
+{
+    if (id == m_receiverManager->activeReceiver()) {
+        return;
+    }
+    if (m_isReplaying) {
+        onStopReplay();
+    }
+
+    // 接收机的历史由它自己的线程写入，主窗口只读取（查询、导出）；
+    // 统计从切换时刻开始重新累计
+    m_receiverManager->setActiveReceiver(id);
+    const ReceiverPipeline *pipeline = m_receiverManager->receiver(id);
+    m_history = pipeline ? pipeline->history() : EpochHistoryPtr::create();
+    resetAnalysis();
+    m_statusLabel->setText(pipeline ? QString("📡 主视图显示接收机 #%1: %2").arg(id).arg(pipeline->source().displayName())
+                                    : QString("📁 主视图显示文件回放"));
+}
+
+void MainWindow::onReceiverEpoch(int id, const SatelliteData &data)
+{
+    // 切换之前已经排队的历元丢弃
+    if (id != m_receiverManager->activeReceiver()) {
+        return;
+    }
+    m_satelliteView->recordTrackSamples(data);
+    m_viewHub->publish(data);
+    analyzeEpoch(data);
+}
+
+void MainWindow::onBatchAnalysis()
+{
+    // 批量分析在自己的线程池上运行，不影响当前回放
+    if (!m_batchDialog) {
+        m_batchDialog = new BatchDialog(this);
+    }
+    m_batchDialog->show();
+    m_batchDialog->raise();
+    m_batchDialog->activateWindow();
+}
+
+void MainWindow::updateAnomalyLabel()
+{
+    const int total = m_anomalyMonitor.totalCount();
+    m_anomalyLabel->setText(QString("⚠️ 异常: %1").arg(total));
+    m_anomalyLabel->setStyleSheet(total > 0 ? "QLabel { color: #c0392b; font-weight: bold; }"
+                                            : "QLabel { color: #7f8c8d; }");
+    
+    QStringList lines;
+    for (int type = 0; type < AnomalyEvent::TypeCount; ++type) {
+        lines.append(QString("%1: %2").arg(AnomalyEvent::typeName(AnomalyEvent::Type(type)))
+                     .arg(m_anomalyMonitor.count(AnomalyEvent::Type(type))));
+    }
+    lines.append(QString("检测耗时: 平均 %1 µs，最大 %2 µs，超过 %3 µs 预算 %4 次")
+                 .arg(m_anomalyMonitor.averageCostUs(), 0, 'f', 1)
+                 .arg(m_anomalyMonitor.maxCostUs(), 0, 'f', 1)
+                 .arg(AnomalyMonitor::EpochBudgetNs / 1000)
+                 .arg(m_anomalyMonitor.overBudgetCount()));
+    m_anomalyLabel->setToolTip(lines.join("\n"));
+}
+
+// 历元历史中从 firstRow 开始的有效定位（只读取需要的四列）
+template <typename Visitor>
+static void visitHistoryFixes(const EpochHistory &history, qint64 firstRow, Visitor visit)
+{
+    const qint64 rows = history.size();
+    for (int chunk = int(firstRow >> EpochHistory::ChunkShift); chunk < EpochHistory::chunkCount(rows); ++chunk) {
+        const ColumnSpan<double> latitudes = history.column(&EpochHistory::Chunk::latitude, chunk, rows);
+        const ColumnSpan<double> longitudes = history.column(&EpochHistory::Chunk::longitude, chunk, rows);
+        const ColumnSpan<double> altitudes = history.column(&EpochHistory::Chunk::altitude, chunk, rows);
+        const ColumnSpan<quint8> fixQualities = history.column(&EpochHistory::Chunk::fixQuality, chunk, rows);
+        const int begin = int(qMax<qint64>(0, firstRow - (qint64(chunk) << EpochHistory::ChunkShift)));
+        for (int i = begin; i < latitudes.size; ++i) {
+            if (fixQualities[i] > 0 && (latitudes[i] != 0.0 || longitudes[i] != 0.0)) {
+                visit(latitudes[i], longitudes[i], altitudes[i], fixQualities[i]);
+            }
+        }
+    }
+}
+
+void MainWindow::rebuildAccuracyStatistics()
+{
+    // 基准变化后从历元历史重新统计
+    m_accuracyStatistics.clear();
+    m_accuracyStartRow = 0;
+    visitHistoryFixes(*m_history, 0, [this](double latitude, double longitude, double altitude, int fixQuality) {
+        m_accuracyStatistics.addFix(latitude, longitude, altitude, fixQuality);
+    });
+    runAccuracyMeanPass();
+    
+    if (m_viewHub->hasData()) {
+        m_messageView->updateData(m_viewHub->latest());
+    }
+    m_statusLabel->setText(m_accuracyStatistics.hasReference() ? "🎯 定位精度相对参考点计算"
+                                                               : "📍 定位精度相对平均位置计算");
+}
+
+void MainWindow::runAccuracyMeanPass()
+{
+    // 平均位置模式下 CEP 和垂直分位数相对最终的平均位置，从历史再统计一遍。
+    // 耗时与历史长度成正比，间隔取耗时的 20 倍（至少 2 秒），占用不超过 5%
+    m_accuracyPassTimer.restart();
+    if (!m_accuracyStatistics.needsMeanPass()) {
+        return;
+    }
+    QElapsedTimer cost;
+    cost.start();
+    m_accuracyStatistics.beginMeanPass();
+    visitHistoryFixes(*m_history, m_accuracyStartRow, [this](double latitude, double longitude, double altitude, int fixQuality) {
+        m_accuracyStatistics.addMeanPassFix(latitude, longitude, altitude, fixQuality);
+    });
+    m_accuracyPassIntervalMs = qMax<qint64>(2000, cost.elapsed() * 20);
+}
+
 void MainWindow::onShowNMEAView()
 {
     if (m_nmeaView->isVisible()) {
@@ -473,6 +958,18 @@ void MainWindow::closeEvent(QCloseEvent *event)
         settings.setValue("rightSplitterSizes", m_rightSplitter->saveState());
     }
     
+    // 关闭所有接收机的串口并结束处理线程
+    m_receiverManager->removeAll();
+    
+    // 关闭前结束正在进行的导出
+    if (m_exportThread) {
+        m_exporter->cancel();
+        m_exportThread->quit();
+        m_exportThread->wait();
+        m_exportThread = nullptr;
+        m_exporter = nullptr;
+    }
+    
     QMainWindow::closeEvent(event);
 }
 
@@ -497,6 +994,11 @@ void MainWindow::setupMainLayout()
     // 创建消息视图标签页
     m_tabWidget = new QTabWidget(this);
     m_tabWidget->addTab(m_messageView, "📋 NMEA消息详情");
+    m_tabWidget->addTab(m_waterfallView, "🌊 信噪比瀑布图");
+    m_tabWidget->addTab(m_dopView, "📐 DOP校验");
+    m_tabWidget->addTab(m_gstView, "🎯 误差椭圆");
+    m_tabWidget->addTab(m_chartManager->getTrajectoryChartView(), "🗺️ 运动轨迹");
+    m_tabWidget->addTab(m_receiverView, "📡 多接收机");
     
     // 添加到主分割器
     m_mainSplitter->addWidget(m_leftSplitter);
@@ -13,15 +13,34 @@
 #include <QSplitter>
 #include <QTabWidget>
 #include <QCloseEvent>
+#include <QPushButton>
+#include <QThread>
+#include <QElapsedTimer>
 #include "satellitedata.h"
+#include "epochhistory.h"
+#include "signalstats.h"
+#include "dopanalysis.h"
+#include "accuracystats.h"
+#include "gstanalysis.h"
+#include "anomalydetector.h"
 
 class NMEAView;
 class BasicView;
 class MessageView;
 class SatelliteView;
 class SNRView;
+class WaterfallView;
+class DopView;
+class GstView;
+class ReceiverView;
+class ReceiverManager;
 class NMEAParser;
 class FileManager;
+class ViewHub;
+class HistoryExporter;
+class AnomalyTimeline;
+class BatchDialog;
+class ChartManager;
 
 class MainWindow : public QMainWindow
 {
@@ -35,6 +54,18 @@ private slots:
     void onStartReplay();
     void onStopReplay();
     void onDataUpdated(const SatelliteData &data);
+    void onEpochCompleted(const SatelliteData &data);
+    void onExportSignalStatistics();
+    void onSetAccuracyReference();
+    void onUseMeanPosition();
+    void onQueryHistory();
+    void onExportHistory();
+    void onExportProgress(qint64 rows, qint64 total);
+    void onExportFinished(bool ok, const QString &message);
+    void onCancelExport();
+    void onBatchAnalysis();
+    void onShowReceiver(int id);
+    void onReceiverEpoch(int id, const SatelliteData &data);
     void onShowNMEAView();
     void onShowBasicView();
     void onShowMessageView();
@@ -53,6 +84,13 @@ private:
     void setupMainLayout();
     void connectSignals();
     void restoreWindowState();
+    void rebuildAccuracyStatistics();
+    void runAccuracyMeanPass();
+    void updateAnomalyLabel();
+    // 切换数据源（新文件、另一台接收机）时清空统计
+    void resetAnalysis();
+    // 一个完整历元的统计分析（不包括写入历史）
+    void analyzeEpoch(const SatelliteData &data);
     
     // UI组件
     QMenuBar *m_menuBar;
@@ -63,6 +101,12 @@ private:
     QMenu *m_replayMenu;
     QAction *m_startAction;
     QAction *m_stopAction;
+    QAction *m_exportStatsAction;
+    QAction *m_setReferenceAction;
+    QAction *m_meanReferenceAction;
+    QAction *m_queryHistoryAction;
+    QAction *m_exportHistoryAction;
+    QAction *m_batchAction;
     
     // 工具栏动作
     QAction *m_nmeaViewAction;
@@ -78,6 +122,10 @@ private:
     QLabel *m_statusLabel;
     QProgressBar *m_progressBar;
     QLabel *m_timeLabel;
+    QProgressBar *m_exportProgressBar;
+    QPushButton *m_cancelExportButton;
+    QLabel *m_anomalyLabel;
+    AnomalyTimeline *m_anomalyTimeline;
     
     // 视图窗口（集成到主界面）
     NMEAView *m_nmeaView;
@@ -85,6 +133,14 @@ private:
     MessageView *m_messageView;
     SatelliteView *m_satelliteView;
     SNRView *m_snrView;
+    WaterfallView *m_waterfallView;
+    DopView *m_dopView;
+    GstView *m_gstView;
+    ReceiverView *m_receiverView;
+    ChartManager *m_chartManager;
+    
+    // 视图订阅中心（隐藏的视图不做更新）
+    ViewHub *m_viewHub;
     
     // 主界面布局组件
     QTabWidget *m_tabWidget;
@@ -97,6 +153,39 @@ private:
     NMEAParser *m_parser;
     FileManager *m_fileManager;
     
+    // 历元历史（图表、统计和导出都从这里读取）
+    EpochHistoryPtr m_history;
+    
+    // 每颗卫星/每个系统的信噪比统计
+    SignalStatistics m_signalStatistics;
+    
+    // 独立计算的DOP与接收机报告值的对比
+    DopAnalysis m_dopAnalysis;
+    bool m_dopFromFile;     // DOP 分析已由加载文件时的离线批处理完成，回放的历元不再重复加入
+    
+    // 静态测试的定位精度统计；平均位置模式下定期从历史（m_accuracyStartRow 起）再统计一遍
+    AccuracyStatistics m_accuracyStatistics;
+    qint64 m_accuracyStartRow;
+    QElapsedTimer m_accuracyPassTimer;
+    qint64 m_accuracyPassIntervalMs;
+    
+    // GST报告误差与实际离散的对比
+    GstAnalysis m_gstAnalysis;
+    
+    // 位置跳变、定位质量下降、干扰、时间不连续、校验和错误的在线检测
+    AnomalyMonitor m_anomalyMonitor;
+    
+    // 后台导出（同一时间只有一个导出任务）
+    QThread *m_exportThread;
+    HistoryExporter *m_exporter;
+    QString m_exportFileName;
+    
+    // 多台接收机，每台一个处理线程；主视图显示文件回放或其中一台
+    ReceiverManager *m_receiverManager;
+    
+    // 批量分析窗口（第一次打开时创建，保留分析结果缓存）
+    BatchDialog *m_batchDialog;
+    
     // 定时器
     QTimer *m_replayTimer;
     bool m_isReplaying;
@@ -1,11 +1,15 @@
 #include "messageview.h"
 #include <QHeaderView>
-#include <QTreeWidgetItem>
 #include <QMap>
 #include <QDebug>
+#include "nmeaparser.h"
 
 MessageView::MessageView(QWidget *parent)
     : QWidget(parent)
+    , m_signalStatistics(nullptr)
+    , m_accuracyStatistics(nullptr)
+    , m_tableType("全部信息")
+    , m_tableRowCount(0)
 {
     setWindowTitle("📋 消息视图 - NMEA字段详情");
     setMinimumSize(900, 700);
@@ -29,18 +33,20 @@ void MessageView::setupUI()
     m_treeGroup->setStyleSheet("QGroupBox { font-weight: bold; font-size: 11pt; }");
     QVBoxLayout *treeLayout = new QVBoxLayout(m_treeGroup);
     treeLayout->setContentsMargins(8, 8, 8, 8);
-    m_treeWidget = new QTreeWidget();
-    m_treeWidget->setStyleSheet("QTreeWidget { font-size: 9pt; }");
-    treeLayout->addWidget(m_treeWidget);
+    m_treeView = new QTreeView();
+    m_treeModel = new FieldModel(this);
+    m_treeView->setModel(m_treeModel);
+    treeLayout->addWidget(m_treeView);
     
     // 右侧表格视图
     m_tableGroup = new QGroupBox("📊 字段详情");
     m_tableGroup->setStyleSheet("QGroupBox { font-weight: bold; font-size: 11pt; }");
     QVBoxLayout *tableLayout = new QVBoxLayout(m_tableGroup);
     tableLayout->setContentsMargins(8, 8, 8, 8);
-    m_tableWidget = new QTableWidget();
-    m_tableWidget->setStyleSheet("QTableWidget { font-size: 9pt; }");
-    tableLayout->addWidget(m_tableWidget);
+    m_tableView = new QTableView();
+    m_tableModel = new FieldModel(this);
+    m_tableView->setModel(m_tableModel);
+    tableLayout->addWidget(m_tableView);
     
     m_splitter->addWidget(m_treeGroup);
     m_splitter->addWidget(m_tableGroup);
@@ -50,196 +56,308 @@ void MessageView::setupUI()
     mainLayout->setContentsMargins(10, 10, 10, 10);
     mainLayout->addWidget(m_splitter);
     
-    setupTreeWidget();
-    setupTableWidget();
+    setupTreeView();
+    setupTableView();
     
     // 连接信号
-    connect(m_treeWidget, &QTreeWidget::itemClicked, this, &MessageView::onTreeItemClicked);
+    connect(m_treeView, &QTreeView::clicked, this, &MessageView::onTreeItemClicked);
 }
 
-void MessageView::setupTreeWidget()
+void MessageView::setupTreeView()
 {
-    m_treeWidget->setHeaderLabel("📋 NMEA消息类型");
-    
-    // 创建根节点
-    QTreeWidgetItem *rootItem = new QTreeWidgetItem(m_treeWidget);
-    rootItem->setText(0, "🛰️ NMEA");
-    rootItem->setExpanded(true);
-    
-    // GGA消息
-    QTreeWidgetItem *ggaItem = new QTreeWidgetItem(rootItem);
-    ggaItem->setText(0, "📍 GGA - 定位数据");
-    
-    // GLL消息
-    QTreeWidgetItem *gllItem = new QTreeWidgetItem(rootItem);
-    gllItem->setText(0, "🌐 GLL - 地理位置");
-    
-    // GSA消息
-    QTreeWidgetItem *gsaItem = new QTreeWidgetItem(rootItem);
-    gsaItem->setText(0, "🎯 GSA - 精度因子");
-    
-    QTreeWidgetItem *gsaGpsItem = new QTreeWidgetItem(gsaItem);
-    gsaGpsItem->setText(0, "🛰️ GPS");
-    
-    QTreeWidgetItem *gsaBdsItem = new QTreeWidgetItem(gsaItem);
-    gsaBdsItem->setText(0, "🛰️ BDS");
-    
-    QTreeWidgetItem *gsaGlnItem = new QTreeWidgetItem(gsaItem);
-    gsaGlnItem->setText(0, "🛰️ GLN");
-    
-    // GSV消息
-    QTreeWidgetItem *gsvItem = new QTreeWidgetItem(rootItem);
-    gsvItem->setText(0, "📡 GSV - 卫星信息");
-    
-    QTreeWidgetItem *gsvGpsItem = new QTreeWidgetItem(gsvItem);
-    gsvGpsItem->setText(0, "🛰️ GPS");
-    
-    QTreeWidgetItem *gsvBdsItem = new QTreeWidgetItem(gsvItem);
-    gsvBdsItem->setText(0, "🛰️ BDS");
-    
-    QTreeWidgetItem *gsvGlnItem = new QTreeWidgetItem(gsvItem);
-    gsvGlnItem->setText(0, "🛰️ GLN");
-    
-    // RMC消息
-    QTreeWidgetItem *rmcItem = new QTreeWidgetItem(rootItem);
-    rmcItem->setText(0, "🚀 RMC - 推荐最小数据");
-    
-    // VTG消息
-    QTreeWidgetItem *vtgItem = new QTreeWidgetItem(rootItem);
-    vtgItem->setText(0, "🧭 VTG - 航向速度");
-    
-    // ZDA消息
-    QTreeWidgetItem *zdaItem = new QTreeWidgetItem(rootItem);
-    zdaItem->setText(0, "🕐 ZDA - 时间日期");
+    m_treeView->setStyleSheet("QTreeView { font-size: 9pt; }");
+    m_treeView->setUniformRowHeights(true);
+    m_treeModel->setHeaderLabels({"📋 NMEA消息类型", ""});
+    m_treeModel->setValueAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    
+    // 分组节点固定不变，数据更新时只刷新各分组下字段的值
+    m_treeModel->setRows({
+        FieldRow("all", "📋 全部信息", ""),
+        FieldRow("basic", "📍 基本信息", ""),
+        FieldRow("position", "🗺️ 位置信息", ""),
+        FieldRow("satellite", "🛰️ 卫星信息", ""),
+        FieldRow("quality", "📊 质量信息", ""),
+        FieldRow("stats", "📈 信号统计", ""),
+        FieldRow("accuracy", "🎯 定位精度", ""),
+        FieldRow("sentences", "🧾 语句字段", "")
+    });
+    updateTreeData();
     
-    m_treeWidget->expandAll();
+    // 展开所有节点
+    m_treeView->expandAll();
 }
 
-void MessageView::setupTableWidget()
+void MessageView::setupTableView()
 {
-    m_tableWidget->setColumnCount(2);
-    m_tableWidget->setHorizontalHeaderLabels({"📋 字段名称", "📊 字段值"});
-    m_tableWidget->horizontalHeader()->setStretchLastSection(true);
-    m_tableWidget->setAlternatingRowColors(true);
-    m_tableWidget->setSelectionBehavior(QAbstractItemView::SelectRows);
-    m_tableWidget->setStyleSheet("QTableWidget { gridline-color: #bdc3c7; }");
+    m_tableModel->setHeaderLabels({"📋 字段名称", "📊 字段值"});
+    m_tableModel->setStyledRows(true);
+    m_tableView->horizontalHeader()->setStretchLastSection(true);
+    m_tableView->verticalHeader()->setDefaultSectionSize(m_tableView->verticalHeader()->minimumSectionSize() + 12);
+    m_tableView->setAlternatingRowColors(true);
+    m_tableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_tableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    
+    // 设置表格样式（只设置一次）
+    m_tableView->setStyleSheet(
+        "QTableView { "
+        "    font-size: 9pt; "
+        "    gridline-color: #bdc3c7; "
+        "    background-color: #f8f9fa; "
+        "    alternate-background-color: #ecf0f1; "
+        "    selection-background-color: #3498db; "
+        "    selection-color: #ecf0f1; "
+        "} "
+        "QTableView::item { "
+        "    padding: 5px; "
+        "    border: none; "
+        "} "
+        "QTableView::item:selected { "
+        "    background-color: #3498db; "
+        "    color: #ecf0f1; "
+        "} "
+        "QHeaderView::section { "
+        "    background-color: #2c3e50; "
+        "    color: #ecf0f1; "
+        "    padding: 8px; "
+        "    font-weight: bold; "
+        "    border: 1px solid #34495e; "
+        "}"
+    );
+    
+    updateTableData(m_tableType);
 }
 
 void MessageView::updateData(const SatelliteData &data)
 {
     m_currentData = data;
     
-    // 调试信息
-    qDebug() << "MessageView::updateData - 卫星数:" << data.satelliteCount 
-             << "纬度:" << data.latitude << "经度:" << data.longitude;
-    
     // 更新树形控件显示
     updateTreeData();
     
-    // 显示全部信息到表格
-    updateTableData("全部信息");
-    
-    // 强制刷新视图
-    m_treeWidget->update();
-    m_tableWidget->update();
+    // 刷新当前选中分类的表格（模型只通知发生变化的单元格）
+    updateTableData(m_tableType, m_tableSystem);
+}
+
+void MessageView::setSignalStatistics(const SignalStatistics *statistics)
+{
+    m_signalStatistics = statistics;
+    updateTreeData();
+    updateTableData(m_tableType, m_tableSystem);
+}
+
+void MessageView::setAccuracyStatistics(const AccuracyStatistics *statistics)
+{
+    m_accuracyStatistics = statistics;
+    updateTreeData();
+    updateTableData(m_tableType, m_tableSystem);
+}
+
+QString MessageView::accuracyGroupName(int fixQuality)
+{
+    return fixQuality < 0 ? QString("全部定位") : NMEAParser::getFixTypeString(fixQuality);
 }
 
 void MessageView::updateTreeData()
 {
-    // 清空现有数据
-    m_treeWidget->clear();
-    
-    // 创建根节点
-    QTreeWidgetItem *basicInfo = new QTreeWidgetItem(m_treeWidget);
-    basicInfo->setText(0, "📍 基本信息");
-    
-    QTreeWidgetItem *positionInfo = new QTreeWidgetItem(m_treeWidget);
-    positionInfo->setText(0, "🗺️ 位置信息");
-    
-    QTreeWidgetItem *satelliteInfo = new QTreeWidgetItem(m_treeWidget);
-    satelliteInfo->setText(0, "🛰️ 卫星信息");
-    
-    QTreeWidgetItem *qualityInfo = new QTreeWidgetItem(m_treeWidget);
-    qualityInfo->setText(0, "📊 质量信息");
-    
     // 添加基本信息
-    addTreeItem(basicInfo, "时间", m_currentData.time);
-    addTreeItem(basicInfo, "日期", m_currentData.date);
-    addTreeItem(basicInfo, "定位类型", m_currentData.fixType);
+    m_treeModel->setChildRows("basic", {
+        FieldRow("时间", "时间", m_currentData.time),
+        FieldRow("日期", "日期", m_currentData.date),
+        FieldRow("定位类型", "定位类型", m_currentData.fixType)
+    });
     
     // 添加位置信息
-    addTreeItem(positionInfo, "纬度", QString::number(m_currentData.latitude, 'f', 6) + "°");
-    addTreeItem(positionInfo, "经度", QString::number(m_currentData.longitude, 'f', 6) + "°");
-    addTreeItem(positionInfo, "海拔", QString::number(m_currentData.altitude, 'f', 2) + " m");
-    addTreeItem(positionInfo, "速度", QString::number(m_currentData.speed, 'f', 2) + " m/s");
-    addTreeItem(positionInfo, "航向", QString::number(m_currentData.course, 'f', 1) + "°");
+    m_treeModel->setChildRows("position", {
+        FieldRow("纬度", "纬度", QString::number(m_currentData.latitude, 'f', 6) + "°"),
+        FieldRow("经度", "经度", QString::number(m_currentData.longitude, 'f', 6) + "°"),
+        FieldRow("海拔", "海拔", QString::number(m_currentData.altitude, 'f', 2) + " m"),
+        FieldRow("速度", "速度", QString::number(m_currentData.speed, 'f', 2) + " m/s"),
+        FieldRow("航向", "航向", QString::number(m_currentData.course, 'f', 1) + "°")
+    });
     
     // 添加卫星信息
-    addTreeItem(satelliteInfo, "可见卫星数", QString::number(m_currentData.satelliteCount));
-    addTreeItem(satelliteInfo, "使用卫星数", QString::number(m_currentData.usedSatelliteCount));
+    m_treeModel->setChildRows("satellite", {
+        FieldRow("可见卫星数", "可见卫星数", QString::number(m_currentData.satelliteCount)),
+        FieldRow("使用卫星数", "使用卫星数", QString::number(m_currentData.usedSatelliteCount))
+    });
     
     // 添加质量信息
-    addTreeItem(qualityInfo, "PDOP", QString::number(m_currentData.pdop, 'f', 2));
-    addTreeItem(qualityInfo, "HDOP", QString::number(m_currentData.hdop, 'f', 2));
-    addTreeItem(qualityInfo, "VDOP", QString::number(m_currentData.vdop, 'f', 2));
-    
-    // 展开所有节点
-    m_treeWidget->expandAll();
+    m_treeModel->setChildRows("quality", {
+        FieldRow("PDOP", "PDOP", QString::number(m_currentData.pdop, 'f', 2)),
+        FieldRow("HDOP", "HDOP", QString::number(m_currentData.hdop, 'f', 2)),
+        FieldRow("VDOP", "VDOP", QString::number(m_currentData.vdop, 'f', 2))
+    });
+    
+    // 添加信号统计（每个系统的平均信噪比）
+    QVector<FieldRow> statsRows;
+    if (m_signalStatistics) {
+        for (const QString &systemName : m_signalStatistics->sortedSystems()) {
+            const SnrAccumulator &acc = m_signalStatistics->systemStatistics()[systemName];
+            statsRows.append(FieldRow(systemName, systemName, QString::number(acc.mean, 'f', 1) + " dB"));
+        }
+    }
+    m_treeModel->setChildRows("stats", statsRows);
+    
+    // 添加定位精度（每种定位质量的CEP50）
+    QVector<FieldRow> accuracyRows;
+    if (m_accuracyStatistics) {
+        for (int fixQuality : m_accuracyStatistics->fixQualities()) {
+            const AccuracyResult result = m_accuracyStatistics->result(fixQuality);
+            const QString name = accuracyGroupName(fixQuality);
+            accuracyRows.append(FieldRow(name, name, QString("CEP50 %1 m").arg(result.cep50, 0, 'f', 3)));
+        }
+    }
+    m_treeModel->setChildRows("accuracy", accuracyRows);
+    
+    // 添加语句字段（每条语句的字段数）
+    QVector<FieldRow> sentenceRows;
+    QMap<QString, int> sentenceFieldCount;
+    for (const NMEAField &field : m_currentData.nmeaFields) {
+        if (sentenceFieldCount[field.sentence]++ == 0) {
+            sentenceRows.append(FieldRow(field.sentence, field.sentence, QString()));
+        }
+    }
+    for (FieldRow &row : sentenceRows) {
+        row.value = QString("%1 个字段").arg(sentenceFieldCount.value(row.key));
+    }
+    m_treeModel->setChildRows("sentences", sentenceRows);
 }
 
-void MessageView::addTreeItem(QTreeWidgetItem *parent, const QString &name, const QString &value)
+void MessageView::addAccuracyRows(QVector<FieldRow> &fields, const QString &group) const
 {
-    QTreeWidgetItem *item = new QTreeWidgetItem(parent);
-    item->setText(0, name);
-    item->setText(1, value);
-    item->setTextAlignment(1, Qt::AlignRight);
+    if (!m_accuracyStatistics) {
+        return;
+    }
+    
+    auto meters = [](double value) {
+        return QString::number(value, 'f', 3) + " m";
+    };
+    
+    fields.append(FieldRow("accuracy:reference", "误差基准",
+                           m_accuracyStatistics->hasReference() ? "参考点" : "平均位置"));
+    for (int fixQuality : m_accuracyStatistics->fixQualities()) {
+        const QString name = accuracyGroupName(fixQuality);
+        if (!group.isEmpty() && group != name) {
+            continue;
+        }
+        
+        const AccuracyResult result = m_accuracyStatistics->result(fixQuality);
+        const QString key = QString("accuracy:%1:").arg(fixQuality);
+        fields.append(FieldRow(key + "header", "--- " + name + " ---", "", FieldRow::SubHeader));
+        fields.append(FieldRow(key + "count", "定位次数", QString::number(result.count), FieldRow::Highlight));
+        fields.append(FieldRow(key + "cep50", "CEP50", meters(result.cep50), FieldRow::Highlight));
+        fields.append(FieldRow(key + "cep95", "CEP95", meters(result.cep95), FieldRow::Highlight));
+        fields.append(FieldRow(key + "drms2", "2DRMS", meters(result.drms2), FieldRow::Highlight));
+        fields.append(FieldRow(key + "vertical95", "垂直误差95%", meters(result.vertical95)));
+        fields.append(FieldRow(key + "mean", "平均偏移 E/N/U",
+                               QString("%1 / %2 / %3 m").arg(result.meanEast, 0, 'f', 3)
+                                                       .arg(result.meanNorth, 0, 'f', 3)
+                                                       .arg(result.meanUp, 0, 'f', 3)));
+        fields.append(FieldRow(key + "sigma", "标准差 E/N/U",
+                               QString("%1 / %2 / %3 m").arg(result.sigmaEast, 0, 'f', 3)
+                                                       .arg(result.sigmaNorth, 0, 'f', 3)
+                                                       .arg(result.sigmaUp, 0, 'f', 3)));
+    }
 }
 
-void MessageView::onTreeItemClicked(QTreeWidgetItem *item, int column)
+void MessageView::addStatisticsRows(QVector<FieldRow> &fields, const QString &system) const
 {
-    Q_UNUSED(column)
-    
-    if (!item) return;
-    
-    QString itemText = item->text(0);
-    QTreeWidgetItem *parent = item->parent();
+    if (!m_signalStatistics) {
+        return;
+    }
     
-    if (parent) {
-        QString parentText = parent->text(0);
-        updateTableData(parentText, itemText);
+    auto format = [](const SnrAccumulator &acc) {
+        return QString("样本:%1 最小:%2 最大:%3 均值:%4 标准差:%5 P10/P50/P90:%6/%7/%8 dB")
+                .arg(acc.count)
+                .arg(acc.minimum)
+                .arg(acc.maximum)
+                .arg(acc.mean, 0, 'f', 1)
+                .arg(acc.standardDeviation(), 0, 'f', 1)
+                .arg(acc.percentile(0.1))
+                .arg(acc.percentile(0.5))
+                .arg(acc.percentile(0.9));
+    };
+    
+    fields.append(FieldRow("stats:epochs", "统计历元数", QString::number(m_signalStatistics->epochCount()),
+                           FieldRow::Highlight));
+    for (const QString &systemName : m_signalStatistics->sortedSystems()) {
+        if (!system.isEmpty() && system != systemName) {
+            continue;
+        }
+        
+        fields.append(FieldRow("stats:subheader:" + systemName, "--- " + systemName + "系统 ---", "",
+                               FieldRow::SubHeader));
+        fields.append(FieldRow("stats:" + systemName, systemName + "全部卫星",
+                               format(m_signalStatistics->systemStatistics()[systemName]), FieldRow::Highlight));
+        for (const SignalStatistics::PrnKey &key : m_signalStatistics->sortedPrns(systemName)) {
+            fields.append(FieldRow(QString("stats:%1:%2").arg(systemName).arg(key.second),
+                                   QString("卫星%1").arg(key.second),
+                                   format(m_signalStatistics->prnStatistics()[key])));
+        }
+    }
+}
+
+void MessageView::onTreeItemClicked(const QModelIndex &index)
+{
+    const FieldRow *row = m_treeModel->rowAt(index.sibling(index.row(), 0));
+    if (!row) return;
+    
+    QModelIndex parentIndex = index.parent();
+    if (parentIndex.isValid()) {
+        const FieldRow *parentRow = m_treeModel->rowAt(parentIndex);
+        m_tableType = parentRow ? parentRow->name : QString();
+        m_tableSystem = row->name;
     } else {
-        updateTableData(itemText);
+        m_tableType = row->key == "all" ? QString("全部信息") : row->name;
+        m_tableSystem.clear();
     }
+    updateTableData(m_tableType, m_tableSystem);
 }
 
 void MessageView::updateTableData(const QString &messageType, const QString &system)
 {
-    m_tableWidget->clearContents();
-    m_tableWidget->setRowCount(0);
-    
-    QList<NMEAField> fields;
+    QVector<FieldRow> fields;
+    int spacerCount = 0;
+    
+    // 行的 key 在多次更新之间保持稳定，模型据此只刷新变化的单元格
+    auto addField = [&fields](const QString &name, const QString &value, const QString &key = QString()) {
+        // 为重要数据添加特殊颜色
+        bool important = name.contains("卫星") || name.contains("PDOP") ||
+                         name.contains("HDOP") || name.contains("VDOP");
+        fields.append(FieldRow(key.isEmpty() ? name : key, name, value,
+                               important ? FieldRow::Highlight : FieldRow::Normal));
+    };
+    auto addHeader = [&fields](const QString &title) {
+        fields.append(FieldRow("header:" + title, "=== " + title + " ===", "", FieldRow::Header));
+    };
+    auto addSubHeader = [&fields](const QString &title) {
+        fields.append(FieldRow("subheader:" + title, "--- " + title + " ---", "", FieldRow::SubHeader));
+    };
+    auto addSpacer = [&fields, &spacerCount]() {
+        fields.append(FieldRow(QString("spacer:%1").arg(spacerCount++), "", "", FieldRow::Spacer));
+    };
     
     if (messageType == "全部信息") {
         // 基本信息
-        fields.append(NMEAField("=== 基本信息 ===", ""));
-        fields.append(NMEAField("时间", m_currentData.time));
-        fields.append(NMEAField("日期", m_currentData.date));
-        fields.append(NMEAField("定位类型", m_currentData.fixType));
-        fields.append(NMEAField("", "")); // 空行分隔
+        addHeader("基本信息");
+        addField("时间", m_currentData.time);
+        addField("日期", m_currentData.date);
+        addField("定位类型", m_currentData.fixType);
+        addSpacer();
         
         // 位置信息
-        fields.append(NMEAField("=== 位置信息 ===", ""));
-        fields.append(NMEAField("纬度", QString::number(m_currentData.latitude, 'f', 6) + "°"));
-        fields.append(NMEAField("经度", QString::number(m_currentData.longitude, 'f', 6) + "°"));
-        fields.append(NMEAField("海拔", QString::number(m_currentData.altitude, 'f', 2) + " m"));
-        fields.append(NMEAField("速度", QString::number(m_currentData.speed, 'f', 2) + " m/s"));
-        fields.append(NMEAField("航向", QString::number(m_currentData.course, 'f', 1) + "°"));
-        fields.append(NMEAField("", "")); // 空行分隔
+        addHeader("位置信息");
+        addField("纬度", QString::number(m_currentData.latitude, 'f', 6) + "°");
+        addField("经度", QString::number(m_currentData.longitude, 'f', 6) + "°");
+        addField("海拔", QString::number(m_currentData.altitude, 'f', 2) + " m");
+        addField("速度", QString::number(m_currentData.speed, 'f', 2) + " m/s");
+        addField("航向", QString::number(m_currentData.course, 'f', 1) + "°");
+        addSpacer();
         
         // 卫星信息
-        fields.append(NMEAField("=== 卫星信息 ===", ""));
-        fields.append(NMEAField("可见卫星数", QString::number(m_currentData.satelliteCount)));
-        fields.append(NMEAField("使用卫星数", QString::number(m_currentData.usedSatelliteCount)));
+        addHeader("卫星信息");
+        addField("可见卫星数", QString::number(m_currentData.satelliteCount));
+        addField("使用卫星数", QString::number(m_currentData.usedSatelliteCount));
         
         // 按系统分组显示卫星 - 按优先级排序
         QMap<QString, int> systemCount;
@@ -257,8 +375,8 @@ void MessageView::updateTableData(const QString &messageType, const QString &sys
             if (systemCount.contains(systemName)) {
                 int totalCount = systemCount[systemName];
                 int usedCount = systemUsedCount.value(systemName, 0);
-                fields.append(NMEAField(systemName + "卫星总数", QString::number(totalCount)));
-                fields.append(NMEAField(systemName + "使用卫星", QString::number(usedCount)));
+                addField(systemName + "卫星总数", QString::number(totalCount));
+                addField(systemName + "使用卫星", QString::number(usedCount));
             }
         }
         
@@ -268,22 +386,22 @@ void MessageView::updateTableData(const QString &messageType, const QString &sys
             if (!systemOrder.contains(systemName)) {
                 int totalCount = it.value();
                 int usedCount = systemUsedCount.value(systemName, 0);
-                fields.append(NMEAField(systemName + "卫星总数", QString::number(totalCount)));
-                fields.append(NMEAField(systemName + "使用卫星", QString::number(usedCount)));
+                addField(systemName + "卫星总数", QString::number(totalCount));
+                addField(systemName + "使用卫星", QString::number(usedCount));
             }
         }
-        fields.append(NMEAField("", "")); // 空行分隔
+        addSpacer();
         
         // 质量信息
-        fields.append(NMEAField("=== 质量信息 ===", ""));
-        fields.append(NMEAField("PDOP", QString::number(m_currentData.pdop, 'f', 2)));
-        fields.append(NMEAField("HDOP", QString::number(m_currentData.hdop, 'f', 2)));
-        fields.append(NMEAField("VDOP", QString::number(m_currentData.vdop, 'f', 2)));
-        fields.append(NMEAField("", "")); // 空行分隔
+        addHeader("质量信息");
+        addField("PDOP", QString::number(m_currentData.pdop, 'f', 2));
+        addField("HDOP", QString::number(m_currentData.hdop, 'f', 2));
+        addField("VDOP", QString::number(m_currentData.vdop, 'f', 2));
+        addSpacer();
         
         // 详细卫星信息
         if (!m_currentData.satellites.isEmpty()) {
-            fields.append(NMEAField("=== 详细卫星信息 ===", ""));
+            addHeader("详细卫星信息");
             
             // 按系统分组显示详细卫星信息
             QMap<QString, QList<SatelliteInfo>> systemSatellites;
@@ -295,7 +413,7 @@ void MessageView::updateTableData(const QString &messageType, const QString &sys
                 QString systemName = it.key();
                 const QList<SatelliteInfo> &sats = it.value();
                 
-                fields.append(NMEAField("--- " + systemName + "系统 ---", ""));
+                addSubHeader(systemName + "系统");
                 
                 for (const SatelliteInfo &sat : sats) {
                     QString satInfo = QString("ID:%1 仰角:%2° 方位角:%3° 信噪比:%4dB %5")
@@ -304,26 +422,26 @@ void MessageView::updateTableData(const QString &messageType, const QString &sys
                                     .arg(sat.azimuth)
                                     .arg(sat.snr)
                                     .arg(sat.used ? "(使用中)" : "(未使用)");
-                    fields.append(NMEAField(QString("卫星%1").arg(sat.id), satInfo));
+                    addField(QString("卫星%1").arg(sat.id), satInfo, systemName + ":" + QString::number(sat.id));
                 }
             }
         }
     }
     else if (messageType == "📍 基本信息") {
-        fields.append(NMEAField("时间", m_currentData.time));
-        fields.append(NMEAField("日期", m_currentData.date));
-        fields.append(NMEAField("定位类型", m_currentData.fixType));
+        addField("时间", m_currentData.time);
+        addField("日期", m_currentData.date);
+        addField("定位类型", m_currentData.fixType);
     }
     else if (messageType == "🗺️ 位置信息") {
-        fields.append(NMEAField("纬度", QString::number(m_currentData.latitude, 'f', 6) + "°"));
-        fields.append(NMEAField("经度", QString::number(m_currentData.longitude, 'f', 6) + "°"));
-        fields.append(NMEAField("海拔", QString::number(m_currentData.altitude, 'f', 2) + " m"));
-        fields.append(NMEAField("速度", QString::number(m_currentData.speed, 'f', 2) + " m/s"));
-        fields.append(NMEAField("航向", QString::number(m_currentData.course, 'f', 1) + "°"));
+        addField("纬度", QString::number(m_currentData.latitude, 'f', 6) + "°");
+        addField("经度", QString::number(m_currentData.longitude, 'f', 6) + "°");
+        addField("海拔", QString::number(m_currentData.altitude, 'f', 2) + " m");
+        addField("速度", QString::number(m_currentData.speed, 'f', 2) + " m/s");
+        addField("航向", QString::number(m_currentData.course, 'f', 1) + "°");
     }
     else if (messageType == "🛰️ 卫星信息") {
-        fields.append(NMEAField("可见卫星数", QString::number(m_currentData.satelliteCount)));
-        fields.append(NMEAField("使用卫星数", QString::number(m_currentData.usedSatelliteCount)));
+        addField("可见卫星数", QString::number(m_currentData.satelliteCount));
+        addField("使用卫星数", QString::number(m_currentData.usedSatelliteCount));
         
         // 按系统分组显示卫星
         QMap<QString, int> systemCount;
@@ -332,41 +450,74 @@ void MessageView::updateTableData(const QString &messageType, const QString &sys
         }
         
         for (auto it = systemCount.begin(); it != systemCount.end(); ++it) {
-            fields.append(NMEAField(it.key() + "卫星数", QString::number(it.value())));
+            addField(it.key() + "卫星数", QString::number(it.value()));
         }
     }
     else if (messageType == "📊 质量信息") {
-        fields.append(NMEAField("PDOP", QString::number(m_currentData.pdop, 'f', 2)));
-        fields.append(NMEAField("HDOP", QString::number(m_currentData.hdop, 'f', 2)));
-        fields.append(NMEAField("VDOP", QString::number(m_currentData.vdop, 'f', 2)));
+        addField("PDOP", QString::number(m_currentData.pdop, 'f', 2));
+        addField("HDOP", QString::number(m_currentData.hdop, 'f', 2));
+        addField("VDOP", QString::number(m_currentData.vdop, 'f', 2));
+        if (m_currentData.hasGst) {
+            addField("伪距RMS", QString::number(m_currentData.gstRms, 'f', 3) + " m");
+            addField("误差椭圆半长轴", QString::number(m_currentData.gstMajor, 'f', 3) + " m");
+            addField("误差椭圆半短轴", QString::number(m_currentData.gstMinor, 'f', 3) + " m");
+            addField("误差椭圆方向", QString::number(m_currentData.gstOrientation, 'f', 1) + "°");
+            addField("纬度误差σ", QString::number(m_currentData.gstSigmaLat, 'f', 3) + " m");
+            addField("经度误差σ", QString::number(m_currentData.gstSigmaLon, 'f', 3) + " m");
+            addField("高度误差σ", QString::number(m_currentData.gstSigmaAlt, 'f', 3) + " m");
+        }
+    }
+    else if (messageType == "📈 信号统计") {
+        addStatisticsRows(fields, system);
+    }
+    else if (messageType == "🎯 定位精度") {
+        addAccuracyRows(fields, system);
+    }
+    else if (messageType == "🧾 语句字段") {
+        // 字段名称、单位和说明来自语句登记表；选中某条语句时只显示这条
+        QString currentSentence;
+        int fieldIndex = 0;
+        for (const NMEAField &field : m_currentData.nmeaFields) {
+            if (!system.isEmpty() && field.sentence != system) {
+                continue;
+            }
+            if (field.sentence != currentSentence) {
+                currentSentence = field.sentence;
+                fieldIndex = 0;
+                addSubHeader(currentSentence);
+            }
+            const QString value = field.description.isEmpty() ? field.value
+                                                               : QString("%1    （%2）").arg(field.value, field.description);
+            addField(field.name, value, QString("%1:%2").arg(currentSentence).arg(fieldIndex++));
+        }
     }
     else if (messageType == "GGA") {
-        fields.append(NMEAField("时间", m_currentData.time));
-        fields.append(NMEAField("纬度", QString::number(m_currentData.latitude, 'f', 6) + "°"));
-        fields.append(NMEAField("经度", QString::number(m_currentData.longitude, 'f', 6) + "°"));
-        fields.append(NMEAField("定位质量", m_currentData.fixType));
-        fields.append(NMEAField("卫星数", QString::number(m_currentData.satelliteCount)));
-        fields.append(NMEAField("HDOP", QString::number(m_currentData.hdop, 'f', 2)));
-        fields.append(NMEAField("海拔", QString::number(m_currentData.altitude, 'f', 2) + " m"));
+        addField("时间", m_currentData.time);
+        addField("纬度", QString::number(m_currentData.latitude, 'f', 6) + "°");
+        addField("经度", QString::number(m_currentData.longitude, 'f', 6) + "°");
+        addField("定位质量", m_currentData.fixType);
+        addField("卫星数", QString::number(m_currentData.satelliteCount));
+        addField("HDOP", QString::number(m_currentData.hdop, 'f', 2));
+        addField("海拔", QString::number(m_currentData.altitude, 'f', 2) + " m");
     }
     else if (messageType == "GSA") {
-        fields.append(NMEAField("模式", "自动"));
-        fields.append(NMEAField("定位类型", m_currentData.fixType));
-        fields.append(NMEAField("使用卫星数", QString::number(m_currentData.usedSatelliteCount)));
-        fields.append(NMEAField("PDOP", QString::number(m_currentData.pdop, 'f', 2)));
-        fields.append(NMEAField("HDOP", QString::number(m_currentData.hdop, 'f', 2)));
-        fields.append(NMEAField("VDOP", QString::number(m_currentData.vdop, 'f', 2)));
+        addField("模式", "自动");
+        addField("定位类型", m_currentData.fixType);
+        addField("使用卫星数", QString::number(m_currentData.usedSatelliteCount));
+        addField("PDOP", QString::number(m_currentData.pdop, 'f', 2));
+        addField("HDOP", QString::number(m_currentData.hdop, 'f', 2));
+        addField("VDOP", QString::number(m_currentData.vdop, 'f', 2));
         
         // 添加使用的卫星ID
         for (int i = 0; i < m_currentData.satellites.size() && i < 12; ++i) {
             const SatelliteInfo &sat = m_currentData.satellites[i];
             if (sat.used) {
-                fields.append(NMEAField(QString("SVID%1").arg(i+1), QString::number(sat.id)));
+                addField(QString("SVID%1").arg(i+1), QString::number(sat.id));
             }
         }
     }
     else if (messageType == "GSV") {
-        fields.append(NMEAField("可见卫星数", QString::number(m_currentData.satelliteCount)));
+        addField("可见卫星数", QString::number(m_currentData.satelliteCount));
         
         // 按系统分组显示卫星信息
         QMap<QString, QList<SatelliteInfo>> systemSatellites;
@@ -377,111 +528,40 @@ void MessageView::updateTableData(const QString &messageType, const QString &sys
         for (auto it = systemSatellites.begin(); it != systemSatellites.end(); ++it) {
             QString systemName = it.key();
             if (system.isEmpty() || system == systemName) {
-                fields.append(NMEAField(systemName + "卫星数", QString::number(it.value().size())));
+                addField(systemName + "卫星数", QString::number(it.value().size()));
                 
                 for (const SatelliteInfo &sat : it.value()) {
                     QString satInfo = QString("ID:%1 仰角:%2° 方位角:%3° 信噪比:%4dB")
                                     .arg(sat.id).arg(sat.elevation).arg(sat.azimuth).arg(sat.snr);
-                    fields.append(NMEAField(QString("卫星%1").arg(sat.id), satInfo));
+                    addField(QString("卫星%1").arg(sat.id), satInfo, systemName + ":" + QString::number(sat.id));
                 }
             }
         }
     }
     else if (messageType == "RMC") {
-        fields.append(NMEAField("时间", m_currentData.time));
-        fields.append(NMEAField("日期", m_currentData.date));
-        fields.append(NMEAField("状态", m_currentData.fixType));
-        fields.append(NMEAField("纬度", QString::number(m_currentData.latitude, 'f', 6) + "°"));
-        fields.append(NMEAField("经度", QString::number(m_currentData.longitude, 'f', 6) + "°"));
-        fields.append(NMEAField("速度", QString::number(m_currentData.speed, 'f', 2) + " m/s"));
-        fields.append(NMEAField("航向", QString::number(m_currentData.course, 'f', 1) + "°"));
+        addField("时间", m_currentData.time);
+        addField("日期", m_currentData.date);
+        addField("状态", m_currentData.fixType);
+        addField("纬度", QString::number(m_currentData.latitude, 'f', 6) + "°");
+        addField("经度", QString::number(m_currentData.longitude, 'f', 6) + "°");
+        addField("速度", QString::number(m_currentData.speed, 'f', 2) + " m/s");
+        addField("航向", QString::number(m_currentData.course, 'f', 1) + "°");
     }
     else if (messageType == "VTG") {
-        fields.append(NMEAField("航向", QString::number(m_currentData.course, 'f', 1) + "°"));
-        fields.append(NMEAField("速度", QString::number(m_currentData.speed, 'f', 2) + " m/s"));
+        addField("航向", QString::number(m_currentData.course, 'f', 1) + "°");
+        addField("速度", QString::number(m_currentData.speed, 'f', 2) + " m/s");
     }
     else if (messageType == "ZDA") {
-        fields.append(NMEAField("时间", m_currentData.time));
-        fields.append(NMEAField("日期", m_currentData.date));
+        addField("时间", m_currentData.time);
+        addField("日期", m_currentData.date);
     }
     
-    // 更新表格
-    m_tableWidget->setRowCount(fields.size());
-    for (int i = 0; i < fields.size(); ++i) {
-        const NMEAField &field = fields[i];
-        
-        QTableWidgetItem *idItem = new QTableWidgetItem(field.name);
-        QTableWidgetItem *valueItem = new QTableWidgetItem(field.value);
-        
-        // 设置不同类型行的样式
-        if (field.name.startsWith("===")) {
-            // 分类标题行 - 浅蓝色背景，深色文字
-            idItem->setBackground(QColor(173, 216, 230));
-            idItem->setForeground(QColor(25, 25, 112));
-            idItem->setFont(QFont("Arial", 10, QFont::Bold));
-            valueItem->setBackground(QColor(173, 216, 230));
-            valueItem->setForeground(QColor(25, 25, 112));
-            valueItem->setFont(QFont("Arial", 10, QFont::Bold));
-        } else if (field.name.startsWith("---")) {
-            // 子系统标题行 - 浅蓝色背景，深色文字
-            idItem->setBackground(QColor(173, 216, 230));
-            idItem->setForeground(QColor(25, 25, 112));
-            idItem->setFont(QFont("Arial", 9, QFont::Bold));
-            valueItem->setBackground(QColor(173, 216, 230));
-            valueItem->setForeground(QColor(25, 25, 112));
-            valueItem->setFont(QFont("Arial", 9, QFont::Bold));
-        } else if (field.name.isEmpty()) {
-            // 空行分隔 - 浅灰色背景，深色文字
-            idItem->setBackground(QColor(236, 240, 241));
-            idItem->setForeground(QColor(44, 62, 80));
-            valueItem->setBackground(QColor(236, 240, 241));
-            valueItem->setForeground(QColor(44, 62, 80));
-        } else {
-            // 普通数据行 - 白色背景，深色文字
-            idItem->setBackground(QColor(255, 255, 255));
-            idItem->setForeground(QColor(44, 62, 80));
-            idItem->setFont(QFont("Arial", 9));
-            valueItem->setBackground(QColor(255, 255, 255));
-            valueItem->setForeground(QColor(44, 62, 80));
-            valueItem->setFont(QFont("Arial", 9));
-            
-            // 为重要数据添加特殊颜色
-            if (field.name.contains("卫星") || field.name.contains("PDOP") || 
-                field.name.contains("HDOP") || field.name.contains("VDOP")) {
-                valueItem->setForeground(QColor(39, 174, 96));
-                valueItem->setFont(QFont("Arial", 9, QFont::Bold));
-            }
-        }
-        
-        m_tableWidget->setItem(i, 0, idItem);
-        m_tableWidget->setItem(i, 1, valueItem);
-    }
-    
-    m_tableWidget->resizeColumnsToContents();
+    // 按 key 对齐新旧行，只刷新变化的单元格
+    m_tableModel->setRows(fields);
     
-    // 设置表格样式
-    m_tableWidget->setStyleSheet(
-        "QTableWidget { "
-        "    gridline-color: #bdc3c7; "
-        "    background-color: #f8f9fa; "
-        "    alternate-background-color: #ecf0f1; "
-        "    selection-background-color: #3498db; "
-        "    selection-color: #ecf0f1; "
-        "} "
-        "QTableWidget::item { "
-        "    padding: 5px; "
-        "    border: none; "
-        "} "
-        "QTableWidget::item:selected { "
-        "    background-color: #3498db; "
-        "    color: #ecf0f1; "
-        "} "
-        "QHeaderView::section { "
-        "    background-color: #2c3e50; "
-        "    color: #ecf0f1; "
-        "    padding: 8px; "
-        "    font-weight: bold; "
-        "    border: 1px solid #34495e; "
-        "}"
-    );
+    // 行数变化时才重新计算列宽，值变化不触发重新测量
+    if (fields.size() != m_tableRowCount) {
+        m_tableRowCount = fields.size();
+        m_tableView->resizeColumnToContents(0);
+    }
 }
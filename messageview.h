@@ -4,12 +4,15 @@
 #include <QWidget>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
-#include <QTreeWidget>
-#include <QTableWidget>
+#include <QTreeView>
+#include <QTableView>
 #include <QSplitter>
 #include <QGroupBox>
 #include <QMap>
 #include "satellitedata.h"
+#include "fieldmodel.h"
+#include "signalstats.h"
+#include "accuracystats.h"
 
 class MessageView : public QWidget
 {
@@ -17,29 +20,44 @@ class MessageView : public QWidget
 
 public:
     explicit MessageView(QWidget *parent = nullptr);
-    
+
     void updateData(const SatelliteData &data);
+    
+    // 信号统计由主窗口维护，这里只读取显示
+    void setSignalStatistics(const SignalStatistics *statistics);
+    void setAccuracyStatistics(const AccuracyStatistics *statistics);
 
 private slots:
-    void onTreeItemClicked(QTreeWidgetItem *item, int column);
+    void onTreeItemClicked(const QModelIndex &index);
 
 private:
     void setupUI();
-    void setupTreeWidget();
-    void setupTableWidget();
+    void setupTreeView();
+    void setupTableView();
     void updateTableData(const QString &messageType, const QString &system = "");
     void updateTreeData();
-    void addTreeItem(QTreeWidgetItem *parent, const QString &name, const QString &value);
-    
+    void addStatisticsRows(QVector<FieldRow> &fields, const QString &system) const;
+    void addAccuracyRows(QVector<FieldRow> &fields, const QString &group) const;
+    static QString accuracyGroupName(int fixQuality);
+
     // UI组件
     QSplitter *m_splitter;
     QGroupBox *m_treeGroup;
     QGroupBox *m_tableGroup;
-    QTreeWidget *m_treeWidget;
-    QTableWidget *m_tableWidget;
-    
+    QTreeView *m_treeView;
+    QTableView *m_tableView;
+    FieldModel *m_treeModel;
+    FieldModel *m_tableModel;
+
     // 数据存储
     SatelliteData m_currentData;
+    const SignalStatistics *m_signalStatistics;
+    const AccuracyStatistics *m_accuracyStatistics;
+
+    // 当前表格显示的分类（数据更新时保持用户的选择）
+    QString m_tableType;
+    QString m_tableSystem;
+    int m_tableRowCount;
 };
 
 #endif // MESSAGEVIEW_H
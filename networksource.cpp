@@ -0,0 +1,206 @@
+#include "networksource.h"
+#include <QTcpSocket>
+#include <QTcpServer>
+#include <QUdpSocket>
+#include <QDebug>
+
+// 默认重连间隔（毫秒）
+static const int kInitialReconnectMs = 500;
+static const int kMaximumReconnectMs = 30000;
+
+NetworkSource::NetworkSource(Mode mode, const QString &host, quint16 port, QObject *parent)
+    : QObject(parent)
+    , m_mode(mode)
+    , m_host(host)
+    , m_port(port)
+    , m_open(false)
+    , m_closing(false)
+    , m_socket(nullptr)
+    , m_server(nullptr)
+    , m_udp(nullptr)
+    , m_initialInterval(kInitialReconnectMs)
+    , m_maximumInterval(kMaximumReconnectMs)
+    , m_interval(kInitialReconnectMs)
+{
+    m_reconnectTimer = new QTimer(this);
+    m_reconnectTimer->setSingleShot(true);
+    connect(m_reconnectTimer, &QTimer::timeout, this, &NetworkSource::reconnect);
+}
+
+NetworkSource::~NetworkSource()
+{
+    m_closing = true;
+}
+
+void NetworkSource::setReconnectInterval(int initialMs, int maximumMs)
+{
+    m_initialInterval = qMax(1, initialMs);
+    m_maximumInterval = qMax(m_initialInterval, maximumMs);
+    m_interval = m_initialInterval;
+}
+
+bool NetworkSource::openPort()
+{
+    closePort();
+    m_closing = false;
+
+    // 服务端和 UDP 未指定地址时监听所有网卡
+    const QHostAddress address = m_host.isEmpty() ? QHostAddress(QHostAddress::Any) : QHostAddress(m_host);
+
+    switch (m_mode) {
+    case TcpClient:
+        m_socket = new QTcpSocket(this);
+        connect(m_socket, &QTcpSocket::connected, this, &NetworkSource::onConnected);
+        connect(m_socket, &QTcpSocket::disconnected, this, &NetworkSource::onDisconnected);
+        connect(m_socket, &QTcpSocket::readyRead, this, &NetworkSource::onReadyRead);
+        connect(m_socket, &QAbstractSocket::errorOccurred, this, &NetworkSource::onSocketError);
+        // 连接是异步的，结果由 connected/errorOccurred 通知
+        m_socket->connectToHost(m_host, m_port);
+        return true;
+
+    case TcpServer:
+        m_server = new QTcpServer(this);
+        connect(m_server, &QTcpServer::newConnection, this, &NetworkSource::onNewConnection);
+        if (!m_server->listen(address, m_port)) {
+            emit errorOccurred(QString("无法监听端口 %1: %2").arg(m_port).arg(m_server->errorString()));
+            scheduleReconnect();
+            return false;
+        }
+        qDebug() << "TCP监听:" << m_server->serverAddress().toString() << m_server->serverPort();
+        m_interval = m_initialInterval;
+        setOpen(true);
+        return true;
+
+    case Udp:
+        m_udp = new QUdpSocket(this);
+        connect(m_udp, &QUdpSocket::readyRead, this, &NetworkSource::onDatagrams);
+        if (!m_udp->bind(address, m_port, QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint)) {
+            emit errorOccurred(QString("无法绑定UDP端口 %1: %2").arg(m_port).arg(m_udp->errorString()));
+            scheduleReconnect();
+            return false;
+        }
+        m_interval = m_initialInterval;
+        setOpen(true);
+        return true;
+    }
+    return false;
+}
+
+void NetworkSource::closePort()
+{
+    m_closing = true;
+    m_reconnectTimer->stop();
+
+    if (m_socket) {
+        m_socket->disconnect(this);
+        m_socket->abort();
+        m_socket->deleteLater();
+        m_socket = nullptr;
+    }
+    if (m_server) {
+        m_server->close();
+        m_server->deleteLater();
+        m_server = nullptr;
+    }
+    if (m_udp) {
+        m_udp->close();
+        m_udp->deleteLater();
+        m_udp = nullptr;
+    }
+    setOpen(false);
+}
+
+void NetworkSource::setOpen(bool open)
+{
+    if (m_open != open) {
+        m_open = open;
+        emit portStatusChanged(open);
+    }
+}
+
+void NetworkSource::scheduleReconnect()
+{
+    if (m_closing || m_reconnectTimer->isActive()) {
+        return;
+    }
+    qDebug() << "网络数据源" << m_host << m_port << m_interval << "毫秒后重连";
+    m_reconnectTimer->start(m_interval);
+    m_interval = qMin(m_interval * 2, m_maximumInterval);
+}
+
+void NetworkSource::reconnect()
+{
+    // 退避间隔在连接（监听、绑定）成功时才恢复
+    openPort();
+}
+
+void NetworkSource::onConnected()
+{
+    m_interval = m_initialInterval;
+    setOpen(true);
+}
+
+void NetworkSource::onDisconnected()
+{
+    // 服务端的连接断开后继续监听，客户端按退避间隔重连
+    if (m_mode == TcpServer) {
+        if (m_socket == sender()) {
+            m_socket->deleteLater();
+            m_socket = nullptr;
+        }
+        return;
+    }
+    setOpen(false);
+    scheduleReconnect();
+}
+
+void NetworkSource::onSocketError()
+{
+    QTcpSocket *socket = qobject_cast<QTcpSocket *>(sender());
+    if (!socket || socket->error() == QAbstractSocket::RemoteHostClosedError) {
+        // 正常断开由 disconnected 处理
+        return;
+    }
+    emit errorOccurred(socket->errorString());
+    if (m_mode == TcpClient) {
+        setOpen(false);
+        scheduleReconnect();
+    }
+}
+
+void NetworkSource::onReadyRead()
+{
+    QTcpSocket *socket = qobject_cast<QTcpSocket *>(sender());
+    if (socket && socket == m_socket) {
+        emit bytesReceived(socket->readAll());
+    }
+}
+
+void NetworkSource::onNewConnection()
+{
+    while (QTcpSocket *client = m_server->nextPendingConnection()) {
+        if (m_socket) {
+            qDebug() << "新连接替换旧连接:" << m_socket->peerAddress().toString();
+            m_socket->disconnect(this);
+            m_socket->abort();
+            m_socket->deleteLater();
+        }
+        m_socket = client;
+        connect(m_socket, &QTcpSocket::readyRead, this, &NetworkSource::onReadyRead);
+        connect(m_socket, &QTcpSocket::disconnected, this, &NetworkSource::onDisconnected);
+        connect(m_socket, &QAbstractSocket::errorOccurred, this, &NetworkSource::onSocketError);
+        qDebug() << "接受连接:" << m_socket->peerAddress().toString() << m_socket->peerPort();
+    }
+}
+
+void NetworkSource::onDatagrams()
+{
+    while (m_udp->hasPendingDatagrams()) {
+        QByteArray datagram(int(m_udp->pendingDatagramSize()), Qt::Uninitialized);
+        const qint64 size = m_udp->readDatagram(datagram.data(), datagram.size());
+        if (size > 0) {
+            datagram.truncate(int(size));
+            emit bytesReceived(datagram);
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef NETWORKSOURCE_H
+#define NETWORKSOURCE_H
+
+#include <QObject>
+#include <QString>
+#include <QHostAddress>
+#include <QTimer>
+
+class QTcpSocket;
+class QTcpServer;
+class QUdpSocket;
+
+// 网络 NMEA 数据源，与 SerialManager 的信号一致，可以直接接到同一条分帧、解析流水线。
+//   TcpClient：连接接收机或转发服务（如 NTRIP 转发的 NMEA），断开后按退避间隔重连
+//   TcpServer：监听端口，接收机或转发程序主动连入；同一时间只接收一个连接，
+//              新连接替换旧连接（接收机重连时旧连接可能还没有超时，两路数据交错会破坏分帧）
+//   Udp：绑定端口接收数据报（广播或单播）
+class NetworkSource : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Mode {
+        TcpClient,
+        TcpServer,
+        Udp
+    };
+
+    NetworkSource(Mode mode, const QString &host, quint16 port, QObject *parent = nullptr);
+    ~NetworkSource();
+
+    bool openPort();
+    void closePort();
+    bool isPortOpen() const { return m_open; }
+
+    Mode mode() const { return m_mode; }
+    QString host() const { return m_host; }
+    quint16 port() const { return m_port; }
+
+    // 重连退避：每次失败间隔加倍，直到最大值；连接成功后恢复初始值
+    void setReconnectInterval(int initialMs, int maximumMs);
+
+signals:
+    void bytesReceived(const QByteArray &data);
+    void portStatusChanged(bool isOpen);
+    void errorOccurred(const QString &error);
+
+private slots:
+    void onConnected();
+    void onDisconnected();
+    void onSocketError();
+    void onReadyRead();
+    void onNewConnection();
+    void onDatagrams();
+    void reconnect();
+
+private:
+    void scheduleReconnect();
+    void setOpen(bool open);
+
+    Mode m_mode;
+    QString m_host;
+    quint16 m_port;
+    bool m_open;
+    bool m_closing;
+
+    QTcpSocket *m_socket;          // 客户端连接，或服务端接受的连接
+    QTcpServer *m_server;
+    QUdpSocket *m_udp;
+
+    QTimer *m_reconnectTimer;
+    int m_initialInterval;
+    int m_maximumInterval;
+    int m_interval;
+};
+
+#endif // NETWORKSOURCE_H
@@ -0,0 +1,125 @@
+#include "nmeaframer.h"
+#include <QVector>
+
+NMEAFramer::NMEAFramer(int maxSentenceLength)
+    : m_maxLength(maxSentenceLength)
+    , m_inSentence(false)
+    , m_lineEndPending(false)
+    , m_sentences(0)
+    , m_dropped(0)
+    , m_skipped(0)
+{
+    m_buffer.reserve(maxSentenceLength);
+}
+
+QStringList NMEAFramer::append(const QByteArray &bytes, QByteArray *raw)
+{
+    QStringList sentences;
+    const char *data = bytes.constData();
+    const int size = bytes.size();
+
+    // 原始字节：从上一块延续过来的语句单独保存，本块内开始的语句只记录范围
+    QByteArray carried;
+    QVector<Range> ranges;
+    int sentenceStart = -1;
+    int carriedEnd = -1;
+
+    // 上一块以行尾结束时，本块开头的行尾属于那条语句，同样转发
+    if (raw && m_lineEndPending) {
+        ranges.append({0, 0});
+    }
+
+    for (int i = 0; i < size; ++i) {
+        const char c = data[i];
+
+        if (c == '$' || c == '!') {
+            // 上一条语句没有行尾就开始了新语句：上一条被截断
+            if (m_inSentence && m_buffer.size() > 1) {
+                ++m_dropped;
+            }
+            m_buffer.clear();
+            m_buffer.append(c);
+            m_inSentence = true;
+            sentenceStart = i;
+            continue;
+        }
+
+        if (!m_inSentence) {
+            // 语句之间的行尾不算跳过；紧跟在语句后面的行尾一起转发
+            if (c != '\r' && c != '\n') {
+                ++m_skipped;
+            } else if (raw && !ranges.isEmpty() && ranges.last().end == i) {
+                ranges.last().end = i + 1;
+            } else if (raw && ranges.isEmpty() && !carried.isEmpty() && carried.size() < m_maxLength + 2) {
+                carried.append(c);
+                carriedEnd = i + 1;
+            }
+            continue;
+        }
+
+        if (c == '\r' || c == '\n') {
+            if (m_buffer.size() > 1) {
+                sentences.append(QString::fromLatin1(m_buffer));
+                ++m_sentences;
+                if (raw) {
+                    if (sentenceStart >= 0) {
+                        ranges.append({sentenceStart, i + 1});
+                    } else {
+                        carried = m_buffer;
+                        carried.append(c);
+                        carriedEnd = i + 1;
+                    }
+                }
+            }
+            m_buffer.clear();
+            m_inSentence = false;
+            continue;
+        }
+
+        // 不可打印字符（波特率不匹配、线路噪声）或超长：丢弃当前语句
+        if (uchar(c) < 0x20 || uchar(c) > 0x7e || m_buffer.size() >= m_maxLength) {
+            ++m_dropped;
+            m_buffer.clear();
+            m_inSentence = false;
+            continue;
+        }
+
+        m_buffer.append(c);
+    }
+
+    m_lineEndPending = raw && !m_inSentence
+                       && (ranges.isEmpty() ? carriedEnd == size : ranges.last().end == size);
+
+    if (raw) {
+        raw->clear();
+        bool contiguous = carried.isEmpty();
+        for (int i = 1; contiguous && i < ranges.size(); ++i) {
+            contiguous = ranges[i].begin == ranges[i - 1].end;
+        }
+        if (contiguous && !ranges.isEmpty()) {
+            const int begin = ranges.first().begin;
+            const int end = ranges.last().end;
+            *raw = (begin == 0 && end == size) ? bytes : bytes.mid(begin, end - begin);
+        } else if (!carried.isEmpty() || !ranges.isEmpty()) {
+            // 跨块的语句或中间有被丢弃的字节：只拼接完整语句
+            int total = carried.size();
+            for (const Range &range : ranges) {
+                total += range.end - range.begin;
+            }
+            raw->reserve(total);
+            raw->append(carried);
+            for (const Range &range : ranges) {
+                raw->append(data + range.begin, range.end - range.begin);
+            }
+        }
+    }
+
+    return sentences;
+}
+
+void NMEAFramer::reset()
+{
+    m_buffer.clear();
+    m_inSentence = false;
+    m_lineEndPending = false;
+}
@@ -0,0 +1,46 @@
+#ifndef NMEAFRAMER_H
+#define NMEAFRAMER_H
+
+#include <QByteArray>
+#include <QStringList>
+
+// 把串口、网络收到的字节流切分成 NMEA 语句。
+// 数据块的边界与语句无关：不完整的语句留在缓冲区里等待后续数据。
+// 语句以 '$' 或 '!' 开始、以 CR/LF 结束；遇到不可打印字符、过长的语句或
+// 语句中间出现新的 '$' 时丢弃当前语句并重新同步。
+class NMEAFramer
+{
+public:
+    // NMEA 0183 规定最长 82 个字符，专有语句常常更长
+    explicit NMEAFramer(int maxSentenceLength = 256);
+
+    // 追加收到的字节，返回其中完整的语句（不含行尾）。
+    // raw 不为空时同时给出这些语句的原始字节（含行尾，用于原样转发）：
+    // 语句在输入中连续且没有跨块时直接引用输入的一段，整块都是完整语句时不复制
+    QStringList append(const QByteArray &bytes, QByteArray *raw = nullptr);
+
+    // 清空缓冲（重新连接数据源时）
+    void reset();
+
+    // 统计：被丢弃的语句（损坏、过长、被截断）和语句之外被跳过的字节
+    qint64 sentenceCount() const { return m_sentences; }
+    qint64 droppedSentences() const { return m_dropped; }
+    qint64 skippedBytes() const { return m_skipped; }
+
+private:
+    // 本块中完整语句的原始字节范围 [begin, end)，end 包含紧随的行尾
+    struct Range {
+        int begin;
+        int end;
+    };
+
+    QByteArray m_buffer;
+    int m_maxLength;
+    bool m_inSentence;
+    bool m_lineEndPending;      // 上一块的原始字节以语句的行尾结束（CR 和 LF 可能分在两块里）
+    qint64 m_sentences;
+    qint64 m_dropped;
+    qint64 m_skipped;
+};
+
+#endif // NMEAFRAMER_H
@@ -0,0 +1,286 @@
+#include "nmeagenerator.h"
+#include <QMap>
+#include <QtMath>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+// 各卫星系统的 talker、卫星号范围和 NMEA 4.10 系统编号
+struct TalkerInfo {
+    const char *talker;
+    int firstPrn;
+    int count;
+    int systemId;
+};
+
+static const TalkerInfo kTalkers[] = {
+    {"GP", 1, 64, 1},       // GPS 1-32，SBAS 33-64
+    {"GL", 65, 32, 2},      // GLONASS
+    {"GA", 1, 36, 3},       // Galileo
+    {"GB", 1, 63, 4},       // 北斗
+    {"GQ", 1, 10, 5}        // QZSS
+};
+
+static const int kMaxSatellites = 200;
+// 每条 GSV 语句 4 颗卫星，每条 GSA 语句 12 颗卫星
+static const int kSatellitesPerGsv = 4;
+// NMEA 0183 的 GSV 最多 9 条，所以每个系统最多报告 36 颗可见卫星
+static const int kMaxGsvMessages = 9;
+static const int kMaxVisiblePerTalker = kMaxGsvMessages * kSatellitesPerGsv;
+static const int kSatellitesPerGsa = 12;
+static const double kEarthRadius = 6378137.0;
+static const double kKnotsPerMps = 1.943844;
+
+static const TalkerInfo *talkerInfo(const QByteArray &talker)
+{
+    for (const TalkerInfo &info : kTalkers) {
+        if (talker == info.talker) {
+            return &info;
+        }
+    }
+    return nullptr;
+}
+
+static QByteArray format(const char *pattern, ...)
+{
+    char buffer[128];
+    va_list args;
+    va_start(args, pattern);
+    const int length = std::vsnprintf(buffer, sizeof(buffer), pattern, args);
+    va_end(args);
+    return QByteArray(buffer, qBound(0, length, int(sizeof(buffer)) - 1));
+}
+
+// 秒的小数部分截断到百分之一秒：按浮点格式化会把 59.995 进位成 "60.00"
+static QByteArray formatTime(qint64 msecsOfDay)
+{
+    const int hours = int(msecsOfDay / 3600000);
+    const int minutes = int(msecsOfDay / 60000 % 60);
+    const int seconds = int(msecsOfDay / 1000 % 60);
+    const int centiseconds = int(msecsOfDay % 1000 / 10);
+    return format("%02d%02d%02d.%02d", hours, minutes, seconds, centiseconds);
+}
+
+static QByteArray formatCoordinate(double degrees, int degreeDigits, char positive, char negative)
+{
+    const double value = qAbs(degrees);
+    const int whole = int(value);
+    const double minutes = (value - whole) * 60.0;
+    return format(degreeDigits == 2 ? "%02d%08.5f,%c" : "%03d%08.5f,%c", whole, minutes,
+                  degrees >= 0 ? positive : negative);
+}
+
+GeneratorConfig::GeneratorConfig()
+    : rateHz(10.0)
+    , satellites(40)
+    , talkers({"GP", "GL", "GA", "GB"})
+    , corruptRate(0.0)
+    , latitude(39.9042)
+    , longitude(116.4074)
+    , altitude(50.0)
+    , speed(10.0)
+    , radius(200.0)
+    , seed(1)
+    , start(QDateTime(QDate(2025, 1, 1), QTime(0, 0), Qt::UTC))
+{
+}
+
+NMEAGenerator::NMEAGenerator(const GeneratorConfig &config)
+    : m_config(config)
+    , m_random(config.seed)
+    , m_epoch(0)
+    , m_sentences(0)
+{
+    std::memset(m_corrupted, 0, sizeof(m_corrupted));
+    m_config.rateHz = qBound(0.1, m_config.rateHz, 100.0);
+
+    for (const QString &talker : m_config.talkers) {
+        const QByteArray name = talker.toLatin1().toUpper();
+        if (talkerInfo(name) && !m_talkers.contains(name)) {
+            m_talkers.append(name);
+        }
+    }
+    if (m_talkers.isEmpty()) {
+        m_talkers.append("GP");
+    }
+
+    // 按系统轮流分配卫星，直到数量足够或所有系统都已满
+    const int total = qBound(1, m_config.satellites, maxSatellites(m_config.talkers));
+    QVector<int> assigned(m_talkers.size(), 0);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    while (m_satellites.size() < total) {
+        for (int i = 0; i < m_talkers.size() && m_satellites.size() < total; ++i) {
+            const TalkerInfo *info = talkerInfo(m_talkers[i]);
+            if (assigned[i] >= qMin(info->count, kMaxVisiblePerTalker)) {
+                continue;
+            }
+            Satellite sat;
+            sat.talker = m_talkers[i];
+            sat.prn = info->firstPrn + assigned[i]++;
+            sat.azimuth0 = uniform(m_random) * 360.0;
+            sat.azimuthRate = (uniform(m_random) - 0.5) * 0.02;
+            sat.elevationPhase = uniform(m_random) * 2.0 * M_PI;
+            sat.elevationRate = 2.0 * M_PI / (3600.0 * (4.0 + 8.0 * uniform(m_random)));
+            sat.snrOffset = (uniform(m_random) - 0.5) * 6.0;
+            sat.elevation = 0;
+            sat.azimuth = 0;
+            sat.snr = 0;
+            sat.used = false;
+            m_satellites.append(sat);
+        }
+    }
+}
+
+int NMEAGenerator::maxSatellites(const QStringList &talkers)
+{
+    int count = 0;
+    QList<QByteArray> seen;
+    for (const QString &talker : talkers) {
+        const QByteArray name = talker.toLatin1().toUpper();
+        const TalkerInfo *info = talkerInfo(name);
+        if (info && !seen.contains(name)) {
+            seen.append(name);
+            count += qMin(info->count, kMaxVisiblePerTalker);
+        }
+    }
+    return qMin(qMax(count, 1), kMaxSatellites);
+}
+
+QByteArray NMEAGenerator::sentence(const QByteArray &body)
+{
+    quint8 checksum = 0;
+    for (char ch : body) {
+        checksum ^= quint8(ch);
+    }
+    return "$" + body + format("*%02X\r\n", checksum);
+}
+
+void NMEAGenerator::append(QByteArray &out, const QByteArray &body)
+{
+    QByteArray line = sentence(body);
+    ++m_sentences;
+
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    if (m_config.corruptRate > 0.0 && uniform(m_random) < m_config.corruptRate) {
+        const int star = line.indexOf('*');
+        std::uniform_int_distribution<int> position(1, qMax(1, star - 1));
+        const Corruption kind = Corruption(std::uniform_int_distribution<int>(0, CorruptionKinds - 1)(m_random));
+        switch (kind) {
+        case FlipCharacter: {
+            // 异或 1 后仍是可打印字符，只有校验和能发现
+            const int index = position(m_random);
+            line[index] = char(line[index] ^ 0x01);
+            break;
+        }
+        case Truncate:
+            line.truncate(position(m_random));
+            break;
+        case InsertGarbage:
+            line.insert(position(m_random), QByteArray("\x01\x80\xff", 3));
+            break;
+        case CorruptionKinds:
+            break;
+        }
+        ++m_corrupted[kind];
+    }
+    out += line;
+}
+
+void NMEAGenerator::updateSatellites(double seconds)
+{
+    std::normal_distribution<double> noise(0.0, 1.5);
+    QMap<QByteArray, int> usedPerTalker;
+    for (Satellite &sat : m_satellites) {
+        const double wave = 0.5 + 0.5 * qSin(sat.elevationPhase + sat.elevationRate * seconds);
+        const double elevation = 5.0 + 80.0 * wave;
+        sat.elevation = qRound(elevation);
+        sat.azimuth = int(std::fmod(sat.azimuth0 + sat.azimuthRate * seconds + 360.0, 360.0));
+        sat.snr = qBound(0, qRound(20.0 + 28.0 * qSin(qDegreesToRadians(elevation)) + sat.snrOffset + noise(m_random)), 55);
+        sat.used = elevation >= 15.0 && usedPerTalker[sat.talker]++ < 2 * kSatellitesPerGsa;
+    }
+}
+
+QByteArray NMEAGenerator::nextEpoch()
+{
+    const double seconds = m_epoch / m_config.rateHz;
+    const QDateTime utc = m_config.start.addMSecs(qint64(seconds * 1000.0 + 0.5));
+    ++m_epoch;
+
+    updateSatellites(seconds);
+
+    // 圆周运动
+    const double angle = m_config.radius > 0.0 ? m_config.speed * seconds / m_config.radius : 0.0;
+    const double east = m_config.radius * qSin(angle);
+    const double north = m_config.radius * (1.0 - qCos(angle));
+    const double latitude = m_config.latitude + qRadiansToDegrees(north / kEarthRadius);
+    const double longitude = m_config.longitude
+                             + qRadiansToDegrees(east / (kEarthRadius * qCos(qDegreesToRadians(m_config.latitude))));
+    double course = qRadiansToDegrees(std::atan2(qCos(angle), qSin(angle)));
+    if (course < 0.0) {
+        course += 360.0;
+    }
+
+    int used = 0;
+    for (const Satellite &sat : m_satellites) {
+        used += sat.used ? 1 : 0;
+    }
+    const double hdop = used > 0 ? 0.6 + 4.0 / used : 99.9;
+    const double pdop = hdop * 1.6;
+    const double vdop = qSqrt(pdop * pdop - hdop * hdop);
+
+    const QByteArray time = formatTime(utc.time().msecsSinceStartOfDay());
+    const QByteArray date = utc.date().toString("ddMMyy").toLatin1();
+    const QByteArray position = formatCoordinate(latitude, 2, 'N', 'S') + ","
+                                + formatCoordinate(longitude, 3, 'E', 'W');
+    const QByteArray talker = m_talkers.size() > 1 ? QByteArray("GN") : m_talkers.first();
+    const int fixQuality = used >= 4 ? 1 : 0;
+
+    QByteArray out;
+    out.reserve(80 * (6 + m_satellites.size() / 2));
+
+    append(out, talker + "GGA," + time + "," + position + format(",%d,%02d,%.1f,%.1f,M,-8.0,M,,", fixQuality,
+                                                                   qMin(used, 99), hdop, m_config.altitude));
+    append(out, talker + "RMC," + time + (fixQuality ? ",A," : ",V,") + position
+                    + format(",%.2f,%.1f,", m_config.speed * kKnotsPerMps, course) + date + ",,,A");
+
+    // 每个系统的 GSA（每条最多 12 颗）和 GSV（每条 4 颗）
+    for (const QByteArray &system : m_talkers) {
+        const TalkerInfo *info = talkerInfo(system);
+        QVector<const Satellite *> visible;
+        QVector<int> usedPrns;
+        for (const Satellite &sat : m_satellites) {
+            if (sat.talker == system) {
+                visible.append(&sat);
+                if (sat.used) {
+                    usedPrns.append(sat.prn);
+                }
+            }
+        }
+
+        for (int first = 0; first == 0 || first < usedPrns.size(); first += kSatellitesPerGsa) {
+            QByteArray gsa = system + "GSA,A," + (fixQuality ? "3" : "1");
+            for (int i = first; i < first + kSatellitesPerGsa; ++i) {
+                gsa += i < usedPrns.size() ? format(",%02d", usedPrns[i]) : QByteArray(",");
+            }
+            gsa += format(",%.1f,%.1f,%.1f,%d", pdop, hdop, vdop, info->systemId);
+            append(out, gsa);
+        }
+
+        const int messages = qMax(1, (visible.size() + kSatellitesPerGsv - 1) / kSatellitesPerGsv);
+        for (int message = 0; message < messages; ++message) {
+            QByteArray gsv = system + format("GSV,%d,%d,%02d", messages, message + 1, visible.size());
+            for (int i = message * kSatellitesPerGsv; i < qMin(visible.size(), (message + 1) * kSatellitesPerGsv); ++i) {
+                const Satellite *sat = visible[i];
+                gsv += format(",%02d,%02d,%03d,", sat->prn, sat->elevation, sat->azimuth);
+                if (sat->snr > 0) {
+                    gsv += format("%02d", sat->snr);
+                }
+            }
+            append(out, gsv);
+        }
+    }
+
+    append(out, talker + "ZDA," + time + "," + utc.date().toString("dd,MM,yyyy").toLatin1() + ",00,00");
+    return out;
+}
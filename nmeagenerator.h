@@ -0,0 +1,87 @@
+#ifndef NMEAGENERATOR_H
+#define NMEAGENERATOR_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QStringList>
+#include <QVector>
+#include <random>
+
+// 生成器参数
+struct GeneratorConfig {
+    double rateHz;              // 历元频率（1-100 Hz）
+    int satellites;             // 可见卫星总数（最多 200，按系统轮流分配，每个系统最多 36 颗）
+    QStringList talkers;        // 卫星系统：GP(GPS+SBAS) GL GA GB GQ
+    double corruptRate;         // 每条语句被破坏的概率（0-1）
+    double latitude;            // 起点（度）
+    double longitude;
+    double altitude;            // 米
+    double speed;               // m/s，绕起点附近的圆周运动
+    double radius;              // 圆周半径（米）
+    quint32 seed;
+    QDateTime start;            // 第一个历元的 UTC 时间
+
+    GeneratorConfig();
+};
+
+// 合成多系统 NMEA 数据：每个历元输出 GGA、RMC、各系统的 GSA/GSV 和 ZDA，校验和正确。
+// 卫星的仰角、方位角和信噪比随时间平滑变化，位置沿圆周运动，便于在图表中辨认。
+// 可以按概率破坏语句（改一个字符使校验和出错、截断、插入不可打印字节），用于测试分帧和校验。
+// 同样的参数和随机种子生成完全相同的数据。
+class NMEAGenerator
+{
+public:
+    enum Corruption {
+        FlipCharacter,          // 改一个字符，校验和错误
+        Truncate,               // 截断，没有校验和和行结束符
+        InsertGarbage,          // 插入不可打印字节
+        CorruptionKinds
+    };
+
+    explicit NMEAGenerator(const GeneratorConfig &config = GeneratorConfig());
+
+    // 下一个历元的全部语句（每条以 CRLF 结尾）
+    QByteArray nextEpoch();
+
+    const GeneratorConfig &config() const { return m_config; }
+    int satelliteCount() const { return m_satellites.size(); }
+    qint64 epochCount() const { return m_epoch; }
+    qint64 sentenceCount() const { return m_sentences; }
+    qint64 corruptedCount() const { return m_corrupted[FlipCharacter] + m_corrupted[Truncate] + m_corrupted[InsertGarbage]; }
+    qint64 corruptedCount(Corruption kind) const { return m_corrupted[kind]; }
+
+    // 加上 '$'、校验和与 CRLF
+    static QByteArray sentence(const QByteArray &body);
+
+    // 所选系统最多能容纳的卫星数（每个系统不超过 36 颗，即 GSV 不超过 NMEA 0183 允许的 9 条）
+    static int maxSatellites(const QStringList &talkers);
+
+private:
+    struct Satellite {
+        QByteArray talker;
+        int prn;
+        double azimuth0;        // 度
+        double azimuthRate;     // 度/秒
+        double elevationPhase;  // 弧度
+        double elevationRate;   // 弧度/秒
+        double snrOffset;       // dB
+        int elevation;
+        int azimuth;
+        int snr;
+        bool used;
+    };
+
+    void append(QByteArray &out, const QByteArray &body);
+    void updateSatellites(double seconds);
+
+    GeneratorConfig m_config;
+    std::mt19937 m_random;
+    QVector<Satellite> m_satellites;
+    QList<QByteArray> m_talkers;
+
+    qint64 m_epoch;
+    qint64 m_sentences;
+    qint64 m_corrupted[CorruptionKinds];
+};
+
+#endif // NMEAGENERATOR_H
@@ -3,13 +3,97 @@
 #include <QRegularExpression>
 #include <QMap>
 
+// talker 超过这么多个GSV输出间隔没有GSV时移除它的卫星（GSV 常常比定位语句输出得慢）
+static const int kGsvExpiryIntervals = 5;
+// 只收到过一组GSV、还不知道输出间隔时，超过这么多个历元移除
+static const int kGsvFirstExpiryEpochs = 100;
+
 NMEAParser::NMEAParser(QObject *parent)
     : QObject(parent)
-    , m_gsvMessageCount(0)
-    , m_gsvCurrentMessage(0)
+    , m_epochMsecs(-1)
+    , m_epochSerial(0)
+    , m_captureFields(false)
 {
 }
 
+void NMEAParser::reset()
+{
+    m_currentData = SatelliteData();
+    m_epochMsecs = -1;
+    m_epochSerial = 0;
+    m_utcDate = QDate();
+    m_gsvPending.clear();
+    m_gsvSatellites.clear();
+    m_gsvState.clear();
+    m_epochUsed.clear();
+}
+
+void NMEAParser::flushEpoch()
+{
+    if (m_epochMsecs >= 0) {
+        emit epochCompleted(m_currentData);
+        m_epochMsecs = -1;
+    }
+}
+
+int NMEAParser::parseMsecsOfDay(const QString &timeStr)
+{
+    // hhmmss 或 hhmmss.sss
+    if (timeStr.length() < 6) {
+        return -1;
+    }
+    
+    bool okHour = false, okMinute = false, okSecond = false;
+    int hour = timeStr.mid(0, 2).toInt(&okHour);
+    int minute = timeStr.mid(2, 2).toInt(&okMinute);
+    double second = timeStr.mid(4).toDouble(&okSecond);
+    if (!okHour || !okMinute || !okSecond || hour > 23 || minute > 59 || second >= 61.0) {
+        return -1;
+    }
+    return hour * 3600000 + minute * 60000 + qRound(second * 1000.0);
+}
+
+void NMEAParser::beginEpoch(const QString &timeStr)
+{
+    // 历元以UTC时间划分：时间变化说明上一个历元的语句已经全部到达
+    int msecs = parseMsecsOfDay(timeStr);
+    if (msecs < 0) {
+        return;
+    }
+    
+    if (m_epochMsecs >= 0 && msecs != m_epochMsecs) {
+        emit epochCompleted(m_currentData);
+        // 新历元的使用状态以新的GSA为准，GST只对收到它的历元有效
+        m_epochUsed.clear();
+        m_currentData.hasGst = false;
+    }
+    if (msecs != m_epochMsecs) {
+        ++m_epochSerial;
+        expireGsvTalkers();
+    }
+    m_epochMsecs = msecs;
+}
+
+void NMEAParser::updateUtcTime(const QString &timeStr)
+{
+    int msecs = parseMsecsOfDay(timeStr);
+    if (msecs < 0) {
+        return;
+    }
+    
+    QTime utcTime = QTime::fromMSecsSinceStartOfDay(msecs);
+    m_currentData.time = utcTime.toString("hh:mm:ss");
+    m_currentData.beijingTime = utcTime.addSecs(8 * 3600).toString("hh:mm:ss");
+    
+    // 有日期时使用完整的UTC时间，否则只记录当天毫秒数
+    if (m_utcDate.isValid()) {
+        m_currentData.timestamp = QDateTime(m_utcDate, utcTime, Qt::UTC);
+        m_currentData.utcTimeMs = m_currentData.timestamp.toMSecsSinceEpoch();
+    } else {
+        m_currentData.utcTimeMs = msecs;
+    }
+}
+
 bool NMEAParser::parseNMEASentence(const QString &sentence)
 {
     // 检查NMEA语句格式
@@ -17,8 +101,14 @@ bool NMEAParser::parseNMEASentence(const QString &sentence)
         return false;
     }
     
-    // 分割字段
-    QStringList fields = sentence.split(',');
+    // 校验和错误只计数，语句仍然解析（手工编辑的测试数据常常没有更新校验和），
+    // 由异常检测报告错误集中出现的时段
+    if (!isChecksumValid(sentence)) {
+        m_currentData.checksumErrors++;
+    }
+    
+    // 分割字段（去掉校验和，否则最后一个字段会带上 "*hh"）
+    QStringList fields = sentence.left(sentence.indexOf('*')).split(',');
     if (fields.size() < 3) {
         return false;
     }
@@ -28,36 +118,30 @@ bool NMEAParser::parseNMEASentence(const QString &sentence)
     
     qDebug() << "解析NMEA语句:" << sentenceType;
     
-    // 根据语句类型进行解析 - 支持多卫星系统
-    bool parseResult = false;
-    
-    // GGA语句 - 支持GPS, BDS, GLN, GAL
-    if (sentenceType.endsWith("GGA")) {
-        parseResult = parseGGA(fields);
-    }
-    // RMC语句 - 支持GPS, BDS, GLN, GAL
-    else if (sentenceType.endsWith("RMC")) {
-        parseResult = parseRMC(fields);
-    }
-    // GSV语句 - 支持GPS, BDS, GLN, GAL
-    else if (sentenceType.endsWith("GSV")) {
-        parseResult = parseGSV(fields);
-    }
-    // GSA语句 - 支持GPS, BDS, GLN, GAL
-    else if (sentenceType.endsWith("GSA")) {
-        parseResult = parseGSA(fields);
-    }
-    // GLL语句 - 支持GPS, BDS, GLN, GAL
-    else if (sentenceType.endsWith("GLL")) {
-        parseResult = parseGLL(fields);
+    // 在登记表中查找语句（标准语句按后三个字母，支持多卫星系统；专有语句按完整地址）
+    const SentenceSchema *schema = SentenceRegistry::find(sentenceType, fields[1]);
+    if (!schema) {
+        return false;
     }
-    // VTG语句 - 支持GPS, BDS, GLN, GAL
-    else if (sentenceType.endsWith("VTG")) {
-        parseResult = parseVTG(fields);
+    
+    if (m_captureFields) {
+        recordFields(*schema, fields);
     }
-    // ZDA语句 - 支持GPS, BDS, GLN, GAL
-    else if (sentenceType.endsWith("ZDA")) {
-        parseResult = parseZDA(fields);
+    
+    // 有解码函数的语句更新定位数据并发出 dataParsed；只用于显示的语句只记录字段，
+    // 随下一条解码语句的 dataParsed 一起送到视图，不单独触发视图刷新
+    bool parseResult = false;
+    switch (schema->decoder) {
+    case SentenceDecoder::GGA: parseResult = parseGGA(fields); break;
+    case SentenceDecoder::RMC: parseResult = parseRMC(fields); break;
+    case SentenceDecoder::GSV: parseResult = parseGSV(fields); break;
+    case SentenceDecoder::GSA: parseResult = parseGSA(fields); break;
+    case SentenceDecoder::GLL: parseResult = parseGLL(fields); break;
+    case SentenceDecoder::VTG: parseResult = parseVTG(fields); break;
+    case SentenceDecoder::ZDA: parseResult = parseZDA(fields); break;
+    case SentenceDecoder::GST: parseResult = parseGST(fields); break;
+    case SentenceDecoder::GNS: parseResult = parseGNS(fields); break;
+    case SentenceDecoder::None: break;
     }
     
     if (parseResult) {
@@ -123,24 +207,8 @@ bool NMEAParser::parseRMC(const QStringList &fields)
 
 bool NMEAParser::parseGSV(const QStringList &fields)
 {
-    // 获取当前语句类型以确定卫星系统
-    QString sentenceType = fields[0].mid(1); // 去掉$符号
-    QString system = getSatelliteSystem(sentenceType);
-    
-    // 调用原有的GPGSV解析函数，但需要设置系统信息
-    bool result = parseGPGSV(fields);
-    
-    // 如果解析成功，更新卫星系统信息
-    if (result) {
-        for (auto &satellite : m_tempSatellites) {
-            if (satellite.system == "UNKNOWN") {
-                satellite.system = system;
-                satellite.color = SatelliteSystemColors::getSystemColor(satellite.system);
-            }
-        }
-    }
-    
-    return result;
+    // 调用原有的GPGSV解析函数（按talker区分卫星系统）
+    return parseGPGSV(fields);
 }
 
 bool NMEAParser::parseGSA(const QStringList &fields)
@@ -175,13 +243,10 @@ bool NMEAParser::parseGPGGA(const QStringList &fields)
     }
     
     try {
-        // 解析时间
+        // 解析时间（新的时间意味着新的历元）
         QString timeStr = fields[1];
-        if (timeStr.length() >= 6) {
-            m_currentData.time = timeStr.mid(0, 2) + ":" + 
-                                timeStr.mid(2, 2) + ":" + 
-                                timeStr.mid(4, 2);
-        }
+        beginEpoch(timeStr);
+        updateUtcTime(timeStr);
         
         // 解析纬度
         m_currentData.latitude = parseCoordinate(fields[2], fields[3]);
@@ -191,6 +256,7 @@ bool NMEAParser::parseGPGGA(const QStringList &fields)
         
         // 解析定位质量
         int fixQuality = fields[6].toInt();
+        m_currentData.fixQuality = fixQuality;
         m_currentData.fixType = getFixTypeString(fixQuality);
         
         // 解析卫星数
@@ -202,13 +268,6 @@ bool NMEAParser::parseGPGGA(const QStringList &fields)
         // 解析海拔
         m_currentData.altitude = fields[9].toDouble();
         
-        // 设置时间戳
-        m_currentData.timestamp = QDateTime::currentDateTime();
-        
-        // 计算北京时间
-        QDateTime utcTime = m_currentData.timestamp;
-        m_currentData.beijingTime = utcTime.addSecs(8 * 3600).toString("hh:mm:ss");
-        
         return true;
     } catch (...) {
         qDebug() << "GPGGA解析失败";
@@ -227,19 +286,18 @@ bool NMEAParser::parseGPRMC(const QStringList &fields)
         // 解析时间
         QString timeStr = fields[1];
         QString dateStr = fields[9];
-        m_currentData.timestamp = parseDateTime(timeStr, dateStr);
-        
-        if (timeStr.length() >= 6) {
-            m_currentData.time = timeStr.mid(0, 2) + ":" + 
-                                timeStr.mid(2, 2) + ":" + 
-                                timeStr.mid(4, 2);
-        }
+        beginEpoch(timeStr);
         
         if (dateStr.length() >= 6) {
             m_currentData.date = "20" + dateStr.mid(4, 2) + ":" + 
                                dateStr.mid(2, 2) + ":" + 
                                dateStr.mid(0, 2);
+            QDate date(2000 + dateStr.mid(4, 2).toInt(), dateStr.mid(2, 2).toInt(), dateStr.mid(0, 2).toInt());
+            if (date.isValid()) {
+                m_utcDate = date;
+            }
         }
+        updateUtcTime(timeStr);
         
         // 解析状态
         QString status = fields[2];
@@ -276,13 +334,18 @@ bool NMEAParser::parseGPGSV(const QStringList &fields)
     }
     
     try {
-        m_gsvMessageCount = fields[1].toInt();
-        m_gsvCurrentMessage = fields[2].toInt();
-        
-        // 如果是第一条GSV消息，清空之前的卫星列表
-        if (m_gsvCurrentMessage == 1) {
-            m_tempSatellites.clear();
+        // 多系统接收机每个系统各发一组GSV，按talker分别接收
+        QString sentenceType = fields[0].mid(1); // 去掉$符号
+        QString talker = sentenceType.left(2);
+        QString talkerSystem = getSatelliteSystem(sentenceType);
+        int messageCount = fields[1].toInt();
+        int currentMessage = fields[2].toInt();
+        
+        // 如果是第一条GSV消息，清空该talker之前的卫星列表
+        if (currentMessage == 1) {
+            m_gsvPending[talker].clear();
         }
+        QList<SatelliteInfo> &pending = m_gsvPending[talker];
         
         // 解析卫星信息 (每4个字段为一组卫星信息)
         int satelliteCount = (fields.size() - 4) / 4;
@@ -295,9 +358,11 @@ bool NMEAParser::parseGPGSV(const QStringList &fields)
                 satellite.azimuth = fields[baseIndex + 2].toInt();
                 satellite.snr = fields[baseIndex + 3].toInt();
                 
-                // 根据卫星ID范围判断卫星系统
+                // 根据卫星ID范围判断卫星系统，无法判断时使用talker对应的系统
                 satellite.system = getSatelliteSystemByID(satellite.id);
-                satellite.color = SatelliteSystemColors::getSystemColor(satellite.system);
+                if (satellite.system == "UNKNOWN") {
+                    satellite.system = talkerSystem;
+                }
                 
                 qDebug() << "解析卫星 ID:" << satellite.id 
                          << "系统:" << satellite.system 
@@ -306,23 +371,30 @@ bool NMEAParser::parseGPGSV(const QStringList &fields)
                          << "信噪比:" << satellite.snr;
                 
                 if (satellite.id > 0) {
-                    m_tempSatellites.append(satellite);
+                    pending.append(satellite);
                 }
             }
         }
         
-        // 如果是最后一条GSV消息，更新当前数据
-        if (m_gsvCurrentMessage == m_gsvMessageCount) {
-            m_currentData.satellites = m_tempSatellites;
-            m_currentData.satelliteCount = m_tempSatellites.size();
+        // 如果是最后一条GSV消息，合并所有talker的卫星并更新当前数据
+        if (currentMessage == messageCount) {
+            m_gsvSatellites[talker] = m_gsvPending.take(talker);
+            auto state = m_gsvState.find(talker);
+            if (state == m_gsvState.end()) {
+                m_gsvState.insert(talker, {m_epochSerial, 0});
+            } else if (m_epochSerial > state->lastEpoch) {
+                state->interval = m_epochSerial - state->lastEpoch;
+                state->lastEpoch = m_epochSerial;
+            }
+            mergeSatellites();
             
             // 统计各系统卫星数量
             QMap<QString, int> systemCount;
-            for (const SatelliteInfo &sat : m_tempSatellites) {
+            for (const SatelliteInfo &sat : m_currentData.satellites) {
                 systemCount[sat.system]++;
             }
             
-            qDebug() << "GPGSV解析完成 - 总卫星数:" << m_tempSatellites.size();
+            qDebug() << "GPGSV解析完成 - 总卫星数:" << m_currentData.satellites.size();
             for (auto it = systemCount.begin(); it != systemCount.end(); ++it) {
                 qDebug() << "  " << it.key() << "系统:" << it.value() << "颗卫星";
             }
@@ -338,6 +410,43 @@ bool NMEAParser::parseGPGSV(const QStringList &fields)
     }
 }
 
+void NMEAParser::mergeSatellites()
+{
+    QList<SatelliteInfo> merged;
+    for (auto it = m_gsvSatellites.constBegin(); it != m_gsvSatellites.constEnd(); ++it) {
+        merged.append(it.value());
+    }
+    
+    m_currentData.satellites = merged;
+    m_currentData.satelliteCount = merged.size();
+    
+    // GSA可能先于GSV到达，合并后重新标记使用状态
+    applyUsedFlags();
+}
+
+void NMEAParser::expireGsvTalkers()
+{
+    // 输出间隔保留下来，talker 重新出现时不需要重新估计
+    bool expired = false;
+    for (auto it = m_gsvState.constBegin(); it != m_gsvState.constEnd(); ++it) {
+        const qint64 limit = it->interval > 0 ? kGsvExpiryIntervals * it->interval : kGsvFirstExpiryEpochs;
+        if (m_epochSerial - it->lastEpoch > limit && m_gsvSatellites.remove(it.key()) > 0) {
+            m_gsvPending.remove(it.key());
+            expired = true;
+        }
+    }
+    if (expired) {
+        mergeSatellites();
+    }
+}
+
+void NMEAParser::applyUsedFlags()
+{
+    for (auto &satellite : m_currentData.satellites) {
+        satellite.used = m_epochUsed.contains(qMakePair(satellite.system, satellite.id));
+    }
+}
+
 bool NMEAParser::parseGPGSA(const QStringList &fields)
 {
     // $GPGSA,模式,定位类型,卫星1,卫星2,...,卫星12,PDOP,HDOP,VDOP*校验和
@@ -355,23 +464,23 @@ bool NMEAParser::parseGPGSA(const QStringList &fields)
         m_currentData.hdop = fields[16].toDouble();
         m_currentData.vdop = fields[17].toDouble();
         
-        // 统计用于定位的卫星数并标记使用的卫星
-        m_currentData.usedSatelliteCount = 0;
+        // 多系统接收机每个系统各发一条GSA，卫星系统的判断规则与GSV一致
+        QString talkerSystem = getSatelliteSystem(fields[0].mid(1));
         for (int i = 3; i <= 14; i++) {
             if (!fields[i].isEmpty() && fields[i].toInt() > 0) {
-                m_currentData.usedSatelliteCount++;
-                
-                // 标记当前卫星列表中的卫星为使用状态
                 int satelliteID = fields[i].toInt();
-                for (auto &satellite : m_currentData.satellites) {
-                    if (satellite.id == satelliteID) {
-                        satellite.used = true;
-                        break;
-                    }
+                QString system = getSatelliteSystemByID(satelliteID);
+                if (system == "UNKNOWN") {
+                    system = talkerSystem;
                 }
+                m_epochUsed.insert(qMakePair(system, satelliteID));
             }
         }
         
+        // 统计用于定位的卫星数（本历元所有GSA合计）并标记使用的卫星
+        m_currentData.usedSatelliteCount = m_epochUsed.size();
+        applyUsedFlags();
+        
         return true;
     } catch (...) {
         qDebug() << "GPGSA解析失败";
@@ -387,6 +496,8 @@ bool NMEAParser::parseGPGLL(const QStringList &fields)
     }
     
     try {
+        beginEpoch(fields[5]);
+        
         // 解析纬度
         m_currentData.latitude = parseCoordinate(fields[1], fields[2]);
         
@@ -394,12 +505,7 @@ bool NMEAParser::parseGPGLL(const QStringList &fields)
         m_currentData.longitude = parseCoordinate(fields[3], fields[4]);
         
         // 解析时间
-        QString timeStr = fields[5];
-        if (timeStr.length() >= 6) {
-            m_currentData.time = timeStr.mid(0, 2) + ":" + 
-                                timeStr.mid(2, 2) + ":" + 
-                                timeStr.mid(4, 2);
-        }
+        updateUtcTime(fields[5]);
         
         return true;
     } catch (...) {
@@ -439,17 +545,18 @@ bool NMEAParser::parseGPZDA(const QStringList &fields)
     try {
         // 解析时间
         QString timeStr = fields[1];
-        if (timeStr.length() >= 6) {
-            m_currentData.time = timeStr.mid(0, 2) + ":" + 
-                                timeStr.mid(2, 2) + ":" + 
-                                timeStr.mid(4, 2);
-        }
+        beginEpoch(timeStr);
         
         // 解析日期
         QString day = fields[2];
         QString month = fields[3];
         QString year = fields[4];
         m_currentData.date = year + ":" + month + ":" + day;
+        QDate date(year.toInt(), month.toInt(), day.toInt());
+        if (date.isValid()) {
+            m_utcDate = date;
+        }
+        updateUtcTime(timeStr);
         
         return true;
     } catch (...) {
@@ -458,6 +565,142 @@ bool NMEAParser::parseGPZDA(const QStringList &fields)
     }
 }
 
+bool NMEAParser::parseGST(const QStringList &fields)
+{
+    // $GPGST,时间,RMS,半长轴,半短轴,方向,纬度误差,经度误差,高度误差*校验和
+    if (fields.size() < 9) {
+        return false;
+    }
+    
+    try {
+        beginEpoch(fields[1]);
+        
+        // 接收机没有输出的字段为空
+        bool okMajor = false, okMinor = false, okOrientation = false;
+        bool okLat = false, okLon = false, okAlt = false;
+        m_currentData.gstRms = fields[2].toDouble();
+        m_currentData.gstMajor = fields[3].toDouble(&okMajor);
+        m_currentData.gstMinor = fields[4].toDouble(&okMinor);
+        m_currentData.gstOrientation = fields[5].toDouble(&okOrientation);
+        m_currentData.gstSigmaLat = fields[6].toDouble(&okLat);
+        m_currentData.gstSigmaLon = fields[7].toDouble(&okLon);
+        m_currentData.gstSigmaAlt = fields[8].toDouble(&okAlt);
+        
+        // 至少要有纬度/经度误差才算有效的GST
+        m_currentData.hasGst = okLat && okLon;
+        if (!okMajor || !okMinor || !okOrientation) {
+            // 没有椭圆参数时按纬度/经度误差构造一个正北方向的椭圆
+            m_currentData.gstMajor = qMax(m_currentData.gstSigmaLat, m_currentData.gstSigmaLon);
+            m_currentData.gstMinor = qMin(m_currentData.gstSigmaLat, m_currentData.gstSigmaLon);
+            m_currentData.gstOrientation = m_currentData.gstSigmaLat >= m_currentData.gstSigmaLon ? 0.0 : 90.0;
+        }
+        if (!okAlt) {
+            m_currentData.gstSigmaAlt = 0.0;
+        }
+        
+        return true;
+    } catch (...) {
+        qDebug() << "GST解析失败";
+        return false;
+    }
+}
+
+bool NMEAParser::parseGNS(const QStringList &fields)
+{
+    // $GNGNS,时间,纬度,纬度半球,经度,经度半球,模式,卫星数,HDOP,海拔,大地水准面差距,差分龄期,差分站ID*校验和
+    if (fields.size() < 10) {
+        return false;
+    }
+    
+    QString timeStr = fields[1];
+    beginEpoch(timeStr);
+    updateUtcTime(timeStr);
+    
+    // 模式每个卫星系统一个字符，取最好的一个作为定位质量
+    // （RTK固定 > RTK浮点 > 差分 > 精密 > 单点 > 推算，对应 GGA 的 4/5/2/3/1/6）
+    static const QString ranking = "RFDPAE";
+    static const int qualities[] = {4, 5, 2, 3, 1, 6};
+    int best = ranking.size();
+    for (QChar mode : fields[6]) {
+        const int index = ranking.indexOf(mode);
+        if (index >= 0 && index < best) {
+            best = index;
+        }
+    }
+    const int fixQuality = best < ranking.size() ? qualities[best] : 0;
+    
+    if (!fields[2].isEmpty() && !fields[4].isEmpty()) {
+        m_currentData.latitude = parseCoordinate(fields[2], fields[3]);
+        m_currentData.longitude = parseCoordinate(fields[4], fields[5]);
+    }
+    m_currentData.fixQuality = fixQuality;
+    m_currentData.fixType = getFixTypeString(fixQuality);
+    m_currentData.satelliteCount = fields[7].toInt();
+    m_currentData.hdop = fields[8].toDouble();
+    m_currentData.altitude = fields[9].toDouble();
+    
+    return true;
+}
+
+void NMEAParser::recordFields(const SentenceSchema &schema, const QStringList &fields)
+{
+    // 同一条语句（地址相同，多条的语句再加上序号）的字段整体替换，位置保持不变
+    QString sentence = fields[0].mid(1);
+    if (schema.type[0] == 'P' && sentence == "PUBX") {
+        sentence += "," + fields[1];
+    }
+    if (schema.groupField > 0 && schema.groupField < fields.size()) {
+        sentence += "#" + fields[schema.groupField];
+    }
+    
+    QList<NMEAField> &list = m_currentData.nmeaFields;
+    int position = list.size();
+    for (int i = 0; i < list.size();) {
+        if (list[i].sentence == sentence) {
+            position = qMin(position, i);
+            list.removeAt(i);
+        } else {
+            ++i;
+        }
+    }
+    
+    QList<NMEAField> recorded;
+    for (int i = 1; i < fields.size(); ++i) {
+        int repeat = 0;
+        const FieldSchema *field = SentenceRegistry::field(schema, i - 1, &repeat);
+        if (!field) {
+            // 字段表之外的字段（新版本协议增加的字段）按序号显示
+            recorded.append(NMEAField(QString("字段%1").arg(i), fields[i], QString(), sentence));
+            continue;
+        }
+        const QString name = repeat > 0 ? QString("%1 #%2").arg(QString::fromUtf8(field->name)).arg(repeat)
+                                        : QString::fromUtf8(field->name);
+        recorded.append(NMEAField(name, SentenceRegistry::formatValue(*field, fields[i]),
+                                  QString::fromUtf8(field->description), sentence));
+    }
+    
+    for (int i = 0; i < recorded.size(); ++i) {
+        list.insert(position + i, recorded[i]);
+    }
+}
+
+bool NMEAParser::isChecksumValid(const QString &sentence)
+{
+    const int star = sentence.indexOf('*');
+    if (!sentence.startsWith('$') || star < 0 || star + 3 > sentence.length()) {
+        return false;
+    }
+    
+    int checksum = 0;
+    for (int i = 1; i < star; ++i) {
+        checksum ^= sentence[i].unicode() & 0xFF;
+    }
+    
+    bool ok = false;
+    const int expected = sentence.mid(star + 1, 2).toInt(&ok, 16);
+    return ok && expected == checksum;
+}
+
 double NMEAParser::parseCoordinate(const QString &coord, const QString &hemisphere)
 {
     if (coord.isEmpty()) {
@@ -6,7 +6,10 @@
 #include <QStringList>
 #include <QDateTime>
 #include <QMap>
+#include <QSet>
+#include <QPair>
 #include "satellitedata.h"
+#include "sentenceschema.h"
 
 class NMEAParser : public QObject
 {
@@ -20,9 +23,31 @@ public:
     
     // 获取当前数据
     SatelliteData getCurrentData() const { return m_currentData; }
+    
+    // 结束当前历元（例如回放结束），发出最后一个历元
+    void flushEpoch();
+    
+    // 清空所有状态（开始解析新的数据源）
+    void reset();
+    
+    // GGA定位质量对应的名称
+    static QString getFixTypeString(int fixType);
+    
+    // 校验 "*hh" 校验和（'$' 与 '*' 之间所有字符的异或）
+    static bool isChecksumValid(const QString &sentence);
+    
+    // 累计校验和错误的语句数
+    int checksumErrors() const { return m_currentData.checksumErrors; }
+    
+    // 是否按语句登记表把每条语句的字段记录到 nmeaFields（只有消息视图需要，默认关闭）
+    void setCaptureFields(bool capture) { m_captureFields = capture; }
+    bool captureFields() const { return m_captureFields; }
 
 signals:
     void dataParsed(const SatelliteData &data);
+    
+    // 一个历元的所有语句都已解析：收到下一个历元的时间时发出上一个历元的完整数据
+    void epochCompleted(const SatelliteData &data);
 
 private:
     // 解析不同类型的NMEA语句 - 支持多卫星系统
@@ -33,6 +58,11 @@ private:
     bool parseGLL(const QStringList &fields);
     bool parseVTG(const QStringList &fields);
     bool parseZDA(const QStringList &fields);
+    bool parseGST(const QStringList &fields);
+    bool parseGNS(const QStringList &fields);
+    
+    // 按字段表记录语句的所有字段
+    void recordFields(const SentenceSchema &schema, const QStringList &fields);
     
     // 原有的GPS解析函数
     bool parseGPGGA(const QStringList &fields);
@@ -45,18 +75,42 @@ private:
     
     // 工具函数
     double parseCoordinate(const QString &coord, const QString &hemisphere);
-    QString getFixTypeString(int fixType);
     QString getSatelliteSystem(const QString &sentenceType);
     QString getSatelliteSystemByID(int satelliteID);
     QDateTime parseDateTime(const QString &timeStr, const QString &dateStr = "");
     
+    // 历元处理
+    static int parseMsecsOfDay(const QString &timeStr);
+    void beginEpoch(const QString &timeStr);
+    void updateUtcTime(const QString &timeStr);
+    void mergeSatellites();
+    void applyUsedFlags();
+    void expireGsvTalkers();
+    
     // 数据存储
     SatelliteData m_currentData;
     
-    // GSV消息处理
-    int m_gsvMessageCount;
-    int m_gsvCurrentMessage;
-    QList<SatelliteInfo> m_tempSatellites;
+    // 当前历元（当天毫秒数，-1 表示尚未开始）和已开始的历元数
+    int m_epochMsecs;
+    qint64 m_epochSerial;
+    QDate m_utcDate;
+    
+    // GSV消息处理：按talker（GP/GL/GA/GB/BD/GQ...）分别接收，完成后合并
+    QMap<QString, QList<SatelliteInfo>> m_gsvPending;
+    QMap<QString, QList<SatelliteInfo>> m_gsvSatellites;
+    
+    // 每个talker最近一次完整GSV所在的历元和GSV的输出间隔（历元数，0 表示还不知道）。
+    // 长时间没有GSV的talker（接收机关闭了该系统或换了talker）从卫星列表中移除
+    struct GsvTalkerState {
+        qint64 lastEpoch;
+        qint64 interval;
+    };
+    QMap<QString, GsvTalkerState> m_gsvState;
+    
+    // 当前历元中GSA列出的参与定位的卫星（系统, PRN），各talker的GSA合并
+    QSet<QPair<QString, int>> m_epochUsed;
+    
+    bool m_captureFields;
 };
 
 #endif // NMEAPARSER_H
\ No newline at end of file
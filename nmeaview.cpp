@@ -1,4 +1,5 @@
 #include "nmeaview.h"
+#include "viewhub.h"
 #include <QFileDialog>
 #include <QTextStream>
 #include <QMessageBox>
@@ -91,6 +92,15 @@ void NMEAView::addNMEALine(const QString &line)
         QString timestamp = QDateTime::currentDateTime().toString("hh:mm:ss");
         QString displayLine = QString("[%1] %2").arg(timestamp, line);
         
+        // 视图不可见时只缓存最近的显示行，重新显示时一次性补上
+        if (!ViewHub::isViewActive(this)) {
+            m_pendingLines.append(displayLine);
+            if (m_pendingLines.size() > 1000) {
+                m_pendingLines.removeFirst();
+            }
+            return;
+        }
+        
         m_textEdit->append(displayLine);
         
         // 限制显示行数，避免内存占用过多
@@ -107,10 +117,52 @@ void NMEAView::addNMEALine(const QString &line)
     }
 }
 
+void NMEAView::flushPendingLines()
+{
+    if (m_pendingLines.isEmpty()) {
+        return;
+    }
+    
+    for (const QString &displayLine : m_pendingLines) {
+        m_textEdit->append(displayLine);
+    }
+    m_pendingLines.clear();
+    
+    // 限制显示行数，避免内存占用过多
+    if (m_textEdit->document()->blockCount() > 1000) {
+        QTextCursor cursor = m_textEdit->textCursor();
+        cursor.movePosition(QTextCursor::Start);
+        cursor.movePosition(QTextCursor::Down, QTextCursor::KeepAnchor,
+                            m_textEdit->document()->blockCount() - 1000);
+        cursor.removeSelectedText();
+    }
+    
+    // 自动滚动到底部
+    QScrollBar *scrollBar = m_textEdit->verticalScrollBar();
+    scrollBar->setValue(scrollBar->maximum());
+}
+
+void NMEAView::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    if (ViewHub::isViewActive(this)) {
+        flushPendingLines();
+    }
+}
+
+void NMEAView::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    if (ViewHub::isViewActive(this)) {
+        flushPendingLines();
+    }
+}
+
 void NMEAView::onClearData()
 {
     m_textEdit->clear();
     m_nmeaLines.clear();
+    m_pendingLines.clear();
 }
 
 void NMEAView::onSaveData()
@@ -21,12 +21,17 @@ public:
     void updateData(const SatelliteData &data);
     void addNMEALine(const QString &line);
 
+protected:
+    void showEvent(QShowEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
 private slots:
     void onClearData();
     void onSaveData();
 
 private:
     void setupUI();
+    void flushPendingLines();
     
     // UI组件
     QGroupBox *m_mainGroup;
@@ -38,6 +43,9 @@ private:
     
     // 数据存储
     QStringList m_nmeaLines;
+    
+    // 视图不可见期间到达的显示行（最多保留1000行）
+    QStringList m_pendingLines;
 };
 
 #endif // NMEAVIEW_H
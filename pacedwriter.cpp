@@ -0,0 +1,68 @@
+#include "pacedwriter.h"
+#include "pseudoterminal.h"
+
+// 不限速时积压上限
+static const qint64 kUnlimitedBacklog = 4 * 1024 * 1024;
+// 令牌最多积累 10 毫秒的量，定时器停顿后不会一次突发写出太多
+static const double kBurstSeconds = 0.01;
+
+PacedWriter::PacedWriter(PseudoTerminal *pty, double byteRate, double maxBacklogSeconds)
+    : m_pty(pty)
+    , m_byteRate(byteRate)
+    , m_maxBacklog(byteRate > 0.0 ? qint64(byteRate * maxBacklogSeconds) : kUnlimitedBacklog)
+    , m_tokens(0.0)
+    , m_lastNs(-1)
+    , m_offset(0)
+    , m_queued(0)
+    , m_written(0)
+    , m_dropped(0)
+{
+}
+
+bool PacedWriter::enqueue(const QByteArray &block)
+{
+    if (backlog() + block.size() > m_maxBacklog) {
+        ++m_dropped;
+        return false;
+    }
+    m_pending += block;
+    m_queued += block.size();
+    return true;
+}
+
+qint64 PacedWriter::refill(qint64 nowNs)
+{
+    if (m_byteRate <= 0.0) {
+        m_lastNs = nowNs;
+        return backlog();
+    }
+    if (m_lastNs >= 0) {
+        m_tokens = qMin(m_tokens + (nowNs - m_lastNs) / 1e9 * m_byteRate, m_byteRate * kBurstSeconds + 1.0);
+    }
+    m_lastNs = nowNs;
+    return qMin<qint64>(backlog(), qint64(m_tokens));
+}
+
+qint64 PacedWriter::write(qint64 maxBytes)
+{
+    qint64 count = 0;
+    if (maxBytes > 0) {
+        count = m_pty->write(m_pending.constData() + m_offset, qMin(maxBytes, backlog()));
+        if (count < 0) {
+            return -1;
+        }
+        m_offset += int(count);
+        m_written += count;
+        m_tokens -= count;
+
+        if (m_offset == m_pending.size()) {
+            m_pending.clear();
+            m_offset = 0;
+        } else if (m_offset > m_pending.size() / 2) {
+            m_pending.remove(0, m_offset);
+            m_offset = 0;
+        }
+    }
+    m_pty->drain();
+    return count;
+}
@@ -0,0 +1,50 @@
+#ifndef PACEDWRITER_H
+#define PACEDWRITER_H
+
+#include <QByteArray>
+
+class PseudoTerminal;
+
+// 按波特率限速写入伪终端：令牌桶限制字节速率，放不下的数据留在待写缓冲中，
+// 积压超过上限（默认 1 秒的数据）时整块丢弃，模拟串口带宽不够时接收机丢数据。
+// nmea-generate 和 nmea-soak 共用；不是线程安全的，由一个线程调用。
+class PacedWriter
+{
+public:
+    // byteRate 为每秒字节数（波特率 / 10），0 表示不限速
+    explicit PacedWriter(PseudoTerminal *pty, double byteRate = 0.0, double maxBacklogSeconds = 1.0);
+
+    // 加入一块数据（通常是一个历元）；积压会超过上限时丢弃这一块并返回 false
+    bool enqueue(const QByteArray &block);
+
+    // 按经过的时间补充令牌，返回现在最多可以写入的字节数（nowNs 为单调时钟）
+    qint64 refill(qint64 nowNs);
+    // 写入最多 maxBytes 字节并读掉伪终端回传的数据，返回写入的字节数，出错返回 -1
+    qint64 write(qint64 maxBytes);
+    // refill + write
+    qint64 flush(qint64 nowNs) { return write(refill(nowNs)); }
+
+    // 待写入的字节数
+    qint64 backlog() const { return m_pending.size() - m_offset; }
+    // 累计加入和写入的字节数：加入一块后 queuedBytes() 即这块数据结束的位置，
+    // writtenBytes() 达到这个位置时这块数据已全部写入
+    qint64 queuedBytes() const { return m_queued; }
+    qint64 writtenBytes() const { return m_written; }
+    qint64 droppedBlocks() const { return m_dropped; }
+    qint64 maxBacklog() const { return m_maxBacklog; }
+
+private:
+    PseudoTerminal *m_pty;
+    double m_byteRate;
+    qint64 m_maxBacklog;
+    double m_tokens;
+    qint64 m_lastNs;
+
+    QByteArray m_pending;
+    int m_offset;               // m_pending 中已写出的部分，积累到一半时再整体前移
+    qint64 m_queued;
+    qint64 m_written;
+    qint64 m_dropped;
+};
+
+#endif // PACEDWRITER_H
@@ -0,0 +1,165 @@
+#include "pseudoterminal.h"
+#include <QFile>
+#include <QDebug>
+
+#ifdef Q_OS_UNIX
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+PseudoTerminal::PseudoTerminal()
+    : m_master(-1)
+    , m_slave(-1)
+{
+}
+
+PseudoTerminal::~PseudoTerminal()
+{
+    close();
+}
+
+bool PseudoTerminal::open(QString *errorMessage)
+{
+    close();
+
+#ifdef Q_OS_UNIX
+    auto fail = [&](const char *step) {
+        if (errorMessage) {
+            *errorMessage = QString("创建伪终端失败（%1）: %2").arg(step).arg(QString::fromLocal8Bit(std::strerror(errno)));
+        }
+        close();
+        return false;
+    };
+
+    m_master = ::posix_openpt(O_RDWR | O_NOCTTY);
+    if (m_master < 0) {
+        return fail("posix_openpt");
+    }
+    if (::grantpt(m_master) != 0 || ::unlockpt(m_master) != 0) {
+        return fail("grantpt");
+    }
+    const char *name = ::ptsname(m_master);
+    if (!name) {
+        return fail("ptsname");
+    }
+    m_slavePath = QString::fromLocal8Bit(name);
+
+    m_slave = ::open(name, O_RDWR | O_NOCTTY);
+    if (m_slave < 0) {
+        return fail("open slave");
+    }
+
+    // 原始模式：不回显（否则写入的数据会回到主设备），不转换 CR/LF
+    struct termios settings;
+    if (::tcgetattr(m_slave, &settings) != 0) {
+        return fail("tcgetattr");
+    }
+    ::cfmakeraw(&settings);
+    if (::tcsetattr(m_slave, TCSANOW, &settings) != 0) {
+        return fail("tcsetattr");
+    }
+
+    const int flags = ::fcntl(m_master, F_GETFL);
+    if (flags < 0 || ::fcntl(m_master, F_SETFL, flags | O_NONBLOCK) != 0) {
+        return fail("fcntl");
+    }
+
+    qDebug() << "伪终端:" << m_slavePath;
+    return true;
+#else
+    if (errorMessage) {
+        *errorMessage = QString("当前平台不支持伪终端");
+    }
+    return false;
+#endif
+}
+
+void PseudoTerminal::close()
+{
+    if (!m_linkPath.isEmpty()) {
+        QFile::remove(m_linkPath);
+        m_linkPath.clear();
+    }
+#ifdef Q_OS_UNIX
+    if (m_slave >= 0) {
+        ::close(m_slave);
+    }
+    if (m_master >= 0) {
+        ::close(m_master);
+    }
+#endif
+    m_slave = -1;
+    m_master = -1;
+    m_slavePath.clear();
+}
+
+bool PseudoTerminal::createLink(const QString &linkPath, QString *errorMessage)
+{
+    if (!isOpen()) {
+        return false;
+    }
+    // 上次运行留下的链接直接替换
+    QFile::remove(linkPath);
+    if (!QFile::link(m_slavePath, linkPath)) {
+        if (errorMessage) {
+            *errorMessage = QString("无法创建链接 %1").arg(linkPath);
+        }
+        return false;
+    }
+    m_linkPath = linkPath;
+    return true;
+}
+
+qint64 PseudoTerminal::write(const char *data, qint64 size)
+{
+#ifdef Q_OS_UNIX
+    if (m_master < 0) {
+        return -1;
+    }
+    const ssize_t written = ::write(m_master, data, size_t(size));
+    if (written < 0) {
+        return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+    }
+    return written;
+#else
+    Q_UNUSED(data)
+    Q_UNUSED(size)
+    return -1;
+#endif
+}
+
+qint64 PseudoTerminal::drain()
+{
+#ifdef Q_OS_UNIX
+    if (m_master < 0) {
+        return 0;
+    }
+    char buffer[4096];
+    qint64 total = 0;
+    ssize_t count;
+    while ((count = ::read(m_master, buffer, sizeof(buffer))) > 0) {
+        total += count;
+    }
+    return total;
+#else
+    return 0;
+#endif
+}
+
+qint64 PseudoTerminal::queuedBytes() const
+{
+#ifdef Q_OS_UNIX
+    int count = 0;
+    if (m_slave < 0 || ::ioctl(m_slave, FIONREAD, &count) != 0) {
+        return -1;
+    }
+    return count;
+#else
+    return -1;
+#endif
+}
@@ -0,0 +1,40 @@
+#ifndef PSEUDOTERMINAL_H
+#define PSEUDOTERMINAL_H
+
+#include <QString>
+
+// 伪终端（pty）：写入主设备的数据从从设备读出，SerialManager 可以像打开真实串口一样打开从设备，
+// 用于在没有接收机的机器上压力测试串口路径。只支持 Linux/Unix（posix_openpt）。
+// 从设备设置为原始模式（不回显、不转换换行），主设备为非阻塞写。
+class PseudoTerminal
+{
+public:
+    PseudoTerminal();
+    ~PseudoTerminal();
+
+    bool open(QString *errorMessage = nullptr);
+    void close();
+    bool isOpen() const { return m_master >= 0; }
+
+    // 从设备路径，如 /dev/pts/3
+    QString slavePath() const { return m_slavePath; }
+    // 为从设备创建一个固定名字的符号链接（如 /tmp/ttyNMEA0），close() 时删除
+    bool createLink(const QString &linkPath, QString *errorMessage = nullptr);
+
+    // 非阻塞写入主设备，返回写入的字节数；缓冲区满时返回 0，出错返回 -1
+    qint64 write(const char *data, qint64 size);
+    // 读出并丢弃主设备上的数据（从设备方向写回的数据），避免缓冲区写满
+    qint64 drain();
+    // 从设备一侧还没被读走的字节数（内核缓冲区中排队的数据），出错返回 -1
+    qint64 queuedBytes() const;
+
+    int masterHandle() const { return m_master; }
+
+private:
+    int m_master;
+    int m_slave;               // 保持从设备打开，使原始模式设置在 SerialManager 打开之前就生效
+    QString m_slavePath;
+    QString m_linkPath;
+};
+
+#endif // PSEUDOTERMINAL_H
@@ -0,0 +1,353 @@
+#include "receiverpipeline.h"
+#include "serialmanager.h"
+#include "networksource.h"
+#include "nmeaparser.h"
+#include "broadcastserver.h"
+#include "epochring.h"
+#include <QThread>
+#include <QDebug>
+
+ReceiverPipeline::ReceiverPipeline(int id, const ReceiverSource &source)
+    : QObject(nullptr)
+    , m_id(id)
+    , m_source(source)
+    , m_history(EpochHistoryPtr::create())
+    , m_serial(nullptr)
+    , m_network(nullptr)
+    , m_parser(nullptr)
+    , m_ring(nullptr)
+    , m_bytes(0)
+    , m_sentences(0)
+    , m_dropped(0)
+    , m_checksumErrors(0)
+    , m_queuedEpochs(0)
+    , m_queuedHighWater(0)
+    , m_open(false)
+    , m_forwardEpochs(false)
+    , m_broadcast(false)
+{
+}
+
+ReceiverPipeline::~ReceiverPipeline()
+{
+    delete m_ring;
+}
+
+void ReceiverPipeline::start()
+{
+    // 数据源和解析器在流水线线程中创建，读通知也在这个线程里处理
+    m_parser = new NMEAParser(this);
+    connect(m_parser, &NMEAParser::epochCompleted, this, &ReceiverPipeline::onEpoch);
+
+    if (m_source.isNetwork()) {
+        m_network = m_source.createNetworkSource(this);
+        connect(m_network, &NetworkSource::bytesReceived, this, &ReceiverPipeline::onBytes);
+        connect(m_network, &NetworkSource::portStatusChanged, this, &ReceiverPipeline::onPortStatusChanged);
+        connect(m_network, &NetworkSource::errorOccurred, this, &ReceiverPipeline::onError);
+        m_network->openPort();
+        return;
+    }
+
+    m_serial = new SerialManager(this);
+    m_serial->setPortName(m_source.portName);
+    m_serial->setBaudRate(m_source.baudRate);
+    connect(m_serial, &SerialManager::bytesReceived, this, &ReceiverPipeline::onBytes);
+    connect(m_serial, &SerialManager::portStatusChanged, this, &ReceiverPipeline::onPortStatusChanged);
+    connect(m_serial, &SerialManager::errorOccurred, this, &ReceiverPipeline::onError);
+
+    m_serial->openPort();
+}
+
+void ReceiverPipeline::stop()
+{
+    if (m_serial) {
+        m_serial->closePort();
+        delete m_serial;
+        m_serial = nullptr;
+    }
+    if (m_network) {
+        m_network->closePort();
+        delete m_network;
+        m_network = nullptr;
+    }
+    if (m_parser) {
+        m_parser->flushEpoch();
+        delete m_parser;
+        m_parser = nullptr;
+    }
+    m_framer.reset();
+    openEpochRing(QString());
+    m_open.store(false, std::memory_order_relaxed);
+}
+
+bool ReceiverPipeline::openEpochRing(const QString &key, QString *errorMessage)
+{
+    delete m_ring;
+    m_ring = nullptr;
+    if (key.isEmpty()) {
+        return true;
+    }
+
+    m_ring = new EpochRingWriter(key);
+    if (!m_ring->create(errorMessage)) {
+        delete m_ring;
+        m_ring = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void ReceiverPipeline::onBytes(const QByteArray &bytes)
+{
+    m_bytes.fetch_add(bytes.size(), std::memory_order_relaxed);
+
+    // 只有主视图正在显示的接收机需要记录语句字段
+    m_parser->setCaptureFields(m_forwardEpochs.load(std::memory_order_relaxed));
+
+    // 转发时由分帧器直接给出完整语句的原始字节（通常就是输入本身或其中一段），
+    // 所有转发客户端共享这一块
+    const bool broadcast = m_broadcast.load(std::memory_order_relaxed);
+    QByteArray framed;
+    const QStringList sentences = m_framer.append(bytes, broadcast ? &framed : nullptr);
+    for (const QString &sentence : sentences) {
+        m_parser->parseNMEASentence(sentence);
+    }
+
+    if (!framed.isEmpty()) {
+        emit sentencesFramed(framed);
+    }
+
+    m_sentences.store(m_framer.sentenceCount(), std::memory_order_relaxed);
+    m_dropped.store(m_framer.droppedSentences(), std::memory_order_relaxed);
+    m_checksumErrors.store(m_parser->checksumErrors(), std::memory_order_relaxed);
+}
+
+void ReceiverPipeline::onEpoch(const SatelliteData &data)
+{
+    m_history->append(EpochHistory::rowFromData(data));
+    if (m_ring) {
+        m_ring->publish(data);
+    }
+    if (m_forwardEpochs.load(std::memory_order_relaxed)) {
+        // 只有本线程增加计数，最高值不需要比较交换
+        const int queued = m_queuedEpochs.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (queued > m_queuedHighWater.load(std::memory_order_relaxed)) {
+            m_queuedHighWater.store(queued, std::memory_order_relaxed);
+        }
+        emit epochCompleted(m_id, data);
+    }
+}
+
+void ReceiverPipeline::onPortStatusChanged(bool open)
+{
+    m_open.store(open, std::memory_order_relaxed);
+    emit statusChanged(m_id, open, open ? QString("已连接") : QString("已断开"));
+}
+
+void ReceiverPipeline::onError(const QString &message)
+{
+    qDebug() << "接收机" << m_id << m_source.displayName() << "错误:" << message;
+    emit statusChanged(m_id, m_open.load(std::memory_order_relaxed), message);
+}
+
+ReceiverManager::ReceiverManager(QObject *parent)
+    : QObject(parent)
+    , m_broadcastThread(nullptr)
+    , m_nextId(1)
+    , m_activeId(-1)
+{
+    qRegisterMetaType<SatelliteData>();
+}
+
+ReceiverManager::~ReceiverManager()
+{
+    // 析构时接收方可能已经不存在，不再发出 receiverRemoved
+    blockSignals(true);
+    removeAll();
+
+    if (m_broadcastThread) {
+        m_broadcastThread->quit();
+        m_broadcastThread->wait();
+        delete m_broadcastThread;
+    }
+}
+
+int ReceiverManager::addReceiver(const ReceiverSource &source)
+{
+    const int id = m_nextId++;
+
+    Entry entry;
+    entry.pipeline = new ReceiverPipeline(id, source);
+    entry.thread = new QThread();
+    entry.thread->setObjectName(QString("receiver-%1").arg(id));
+    entry.pipeline->moveToThread(entry.thread);
+
+    connect(entry.thread, &QThread::started, entry.pipeline, &ReceiverPipeline::start);
+    connect(entry.thread, &QThread::finished, entry.pipeline, &QObject::deleteLater);
+    connect(entry.pipeline, &ReceiverPipeline::epochCompleted, this, &ReceiverManager::onPipelineEpoch);
+    connect(entry.pipeline, &ReceiverPipeline::statusChanged, this, &ReceiverManager::statusChanged);
+
+    m_receivers.insert(id, entry);
+    entry.thread->start();
+
+    qDebug() << "添加接收机" << id << source.displayName();
+    emit receiverAdded(id);
+    return id;
+}
+
+void ReceiverManager::removeReceiver(int id)
+{
+    auto it = m_receivers.find(id);
+    if (it == m_receivers.end()) {
+        return;
+    }
+    stopBroadcast(id);
+    m_rings.remove(id);
+
+    const Entry entry = it.value();
+    m_receivers.erase(it);
+
+    if (m_activeId == id) {
+        m_activeId = -1;
+    }
+
+    // 串口在流水线线程中关闭，然后结束线程；流水线对象随线程结束删除
+    QMetaObject::invokeMethod(entry.pipeline, "stop", Qt::BlockingQueuedConnection);
+    entry.thread->quit();
+    entry.thread->wait();
+    delete entry.thread;
+
+    qDebug() << "移除接收机" << id;
+    emit receiverRemoved(id);
+}
+
+void ReceiverManager::removeAll()
+{
+    const QList<int> ids = m_receivers.keys();
+    for (int id : ids) {
+        removeReceiver(id);
+    }
+}
+
+void ReceiverManager::onPipelineEpoch(int id, const SatelliteData &data)
+{
+    // 流水线已经移除时历元仍可能在队列中，这时不再转发
+    auto it = m_receivers.find(id);
+    if (it == m_receivers.end()) {
+        return;
+    }
+    it->pipeline->epochDelivered();
+    emit epochCompleted(id, data);
+}
+
+const ReceiverPipeline *ReceiverManager::receiver(int id) const
+{
+    auto it = m_receivers.constFind(id);
+    return it != m_receivers.constEnd() ? it->pipeline : nullptr;
+}
+
+void ReceiverManager::setActiveReceiver(int id)
+{
+    for (auto it = m_receivers.constBegin(); it != m_receivers.constEnd(); ++it) {
+        it->pipeline->setForwardEpochs(it.key() == id);
+    }
+    m_activeId = m_receivers.contains(id) ? id : -1;
+}
+
+bool ReceiverManager::startBroadcast(int id, quint16 tcpPort, const QString &localName, QString *errorMessage)
+{
+    auto it = m_receivers.find(id);
+    if (it == m_receivers.end()) {
+        return false;
+    }
+    stopBroadcast(id);
+
+    if (!m_broadcastThread) {
+        m_broadcastThread = new QThread();
+        m_broadcastThread->setObjectName("broadcast");
+        m_broadcastThread->start();
+    }
+
+    BroadcastServer *server = new BroadcastServer();
+    server->moveToThread(m_broadcastThread);
+
+    // 监听在转发线程中进行，套接字也属于这个线程
+    bool ok = false;
+    QString error;
+    QMetaObject::invokeMethod(server, [&]() {
+        ok = server->listen(tcpPort, localName, &error);
+    }, Qt::BlockingQueuedConnection);
+
+    if (!ok) {
+        server->deleteLater();
+        if (errorMessage) {
+            *errorMessage = error;
+        }
+        return false;
+    }
+
+    connect(it->pipeline, &ReceiverPipeline::sentencesFramed, server, &BroadcastServer::publish);
+    it->pipeline->setBroadcast(true);
+    m_broadcasts.insert(id, server);
+    return true;
+}
+
+void ReceiverManager::stopBroadcast(int id)
+{
+    BroadcastServer *server = m_broadcasts.take(id);
+    if (!server) {
+        return;
+    }
+
+    auto it = m_receivers.find(id);
+    if (it != m_receivers.end()) {
+        it->pipeline->setBroadcast(false);
+        disconnect(it->pipeline, &ReceiverPipeline::sentencesFramed, server, &BroadcastServer::publish);
+    }
+
+    // 在转发线程中关闭监听和所有客户端
+    QMetaObject::invokeMethod(server, [server]() {
+        server->close();
+    }, Qt::BlockingQueuedConnection);
+    server->deleteLater();
+}
+
+bool ReceiverManager::startEpochRing(int id, const QString &key, QString *errorMessage)
+{
+    auto it = m_receivers.find(id);
+    if (it == m_receivers.end() || key.isEmpty()) {
+        return false;
+    }
+
+    // 写者属于流水线线程，与写历史的是同一个线程
+    ReceiverPipeline *pipeline = it->pipeline;
+    bool ok = false;
+    QString error;
+    QMetaObject::invokeMethod(pipeline, [&]() {
+        ok = pipeline->openEpochRing(key, &error);
+    }, Qt::BlockingQueuedConnection);
+
+    if (!ok) {
+        m_rings.remove(id);
+        if (errorMessage) {
+            *errorMessage = error;
+        }
+        return false;
+    }
+    m_rings.insert(id, key);
+    return true;
+}
+
+void ReceiverManager::stopEpochRing(int id)
+{
+    auto it = m_receivers.find(id);
+    if (it == m_receivers.end() || !m_rings.contains(id)) {
+        return;
+    }
+    m_rings.remove(id);
+
+    ReceiverPipeline *pipeline = it->pipeline;
+    QMetaObject::invokeMethod(pipeline, [pipeline]() {
+        pipeline->openEpochRing(QString());
+    }, Qt::BlockingQueuedConnection);
+}
@@ -0,0 +1,152 @@
+#ifndef RECEIVERPIPELINE_H
+#define RECEIVERPIPELINE_H
+
+#include <QObject>
+#include <QString>
+#include <QMap>
+#include <QList>
+#include <atomic>
+#include "satellitedata.h"
+#include "epochhistory.h"
+#include "nmeaframer.h"
+#include "receiversource.h"
+
+class QThread;
+class SerialManager;
+class NetworkSource;
+class NMEAParser;
+class BroadcastServer;
+class EpochRingWriter;
+
+// 一台接收机的处理流水线：串口或网络 -> 分帧 -> 解析 -> 历元 -> 历史。
+// 整条流水线运行在自己的线程中，接收机之间互不影响；
+// 历史由本线程单独写入，其他线程随时可以读取（见 EpochHistory 的并发约定）。
+// 计数使用原子量，界面线程可以直接读取。
+class ReceiverPipeline : public QObject
+{
+    Q_OBJECT
+
+public:
+    ReceiverPipeline(int id, const ReceiverSource &source);
+    ~ReceiverPipeline();
+
+    int id() const { return m_id; }
+    ReceiverSource source() const { return m_source; }
+    EpochHistoryPtr history() const { return m_history; }
+
+    qint64 byteCount() const { return m_bytes.load(std::memory_order_relaxed); }
+    qint64 sentenceCount() const { return m_sentences.load(std::memory_order_relaxed); }
+    qint64 droppedSentences() const { return m_dropped.load(std::memory_order_relaxed); }
+    qint64 checksumErrors() const { return m_checksumErrors.load(std::memory_order_relaxed); }
+    bool isOpen() const { return m_open.load(std::memory_order_relaxed); }
+
+    // 是否把每个历元发给界面（只有主视图正在显示的接收机需要）
+    void setForwardEpochs(bool forward) { m_forwardEpochs.store(forward, std::memory_order_relaxed); }
+    // 已发给界面线程、还没有被处理的历元（跨线程队列深度）及其最高值；
+    // 接收方处理完一个历元后调用 epochDelivered()
+    int queuedEpochs() const { return m_queuedEpochs.load(std::memory_order_relaxed); }
+    int queuedEpochsHighWater() const { return m_queuedHighWater.load(std::memory_order_relaxed); }
+    void epochDelivered() { m_queuedEpochs.fetch_sub(1, std::memory_order_relaxed); }
+    // 是否把分帧后的语句发给转发服务器
+    void setBroadcast(bool broadcast) { m_broadcast.store(broadcast, std::memory_order_relaxed); }
+
+    // 把每个历元写入共享内存环（在流水线线程中调用），key 为空时停止
+    bool openEpochRing(const QString &key, QString *errorMessage = nullptr);
+
+public slots:
+    // 在流水线线程中调用
+    void start();
+    void stop();
+
+signals:
+    void epochCompleted(int id, const SatelliteData &data);
+    void statusChanged(int id, bool open, const QString &message);
+    // 一次读到的完整语句的原始字节（含原来的行尾），只在开启转发时发出
+    void sentencesFramed(const QByteArray &sentences);
+
+private slots:
+    void onBytes(const QByteArray &bytes);
+    void onEpoch(const SatelliteData &data);
+    void onPortStatusChanged(bool open);
+    void onError(const QString &message);
+
+private:
+    int m_id;
+    ReceiverSource m_source;
+    EpochHistoryPtr m_history;
+
+    // 以下对象在 start() 中创建，属于流水线线程（串口和网络只有一个）
+    SerialManager *m_serial;
+    NetworkSource *m_network;
+    NMEAParser *m_parser;
+    NMEAFramer m_framer;
+    EpochRingWriter *m_ring;
+
+    std::atomic<qint64> m_bytes;
+    std::atomic<qint64> m_sentences;
+    std::atomic<qint64> m_dropped;
+    std::atomic<qint64> m_checksumErrors;
+    std::atomic<int> m_queuedEpochs;
+    std::atomic<int> m_queuedHighWater;
+    std::atomic<bool> m_open;
+    std::atomic<bool> m_forwardEpochs;
+    std::atomic<bool> m_broadcast;
+};
+
+// 管理多台接收机：每台一个线程，增加或移除接收机不影响其他接收机。
+// 只有当前选中的接收机把历元送到界面线程，其余接收机的数据只写入各自的历史。
+class ReceiverManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ReceiverManager(QObject *parent = nullptr);
+    ~ReceiverManager();
+
+    // 返回接收机编号
+    int addReceiver(const ReceiverSource &source);
+    void removeReceiver(int id);
+    void removeAll();
+
+    QList<int> receiverIds() const { return m_receivers.keys(); }
+    const ReceiverPipeline *receiver(int id) const;
+
+    // 主视图显示的接收机，-1 表示不显示任何接收机（显示文件回放）
+    void setActiveReceiver(int id);
+    int activeReceiver() const { return m_activeId; }
+
+    // 把接收机的语句转发给下游客户端（TCP 端口和/或本地套接字）。
+    // 所有转发服务器共用一个线程，不占用流水线线程和界面线程
+    bool startBroadcast(int id, quint16 tcpPort, const QString &localName, QString *errorMessage = nullptr);
+    void stopBroadcast(int id);
+    const BroadcastServer *broadcastServer(int id) const { return m_broadcasts.value(id, nullptr); }
+
+    // 把接收机的历元写入共享内存环，供本机其他进程读取（见 EpochRingReader）
+    bool startEpochRing(int id, const QString &key, QString *errorMessage = nullptr);
+    void stopEpochRing(int id);
+    QString epochRingKey(int id) const { return m_rings.value(id); }
+
+signals:
+    void receiverAdded(int id);
+    void receiverRemoved(int id);
+    void epochCompleted(int id, const SatelliteData &data);
+    void statusChanged(int id, bool open, const QString &message);
+
+private slots:
+    void onPipelineEpoch(int id, const SatelliteData &data);
+
+private:
+    struct Entry {
+        ReceiverPipeline *pipeline;
+        QThread *thread;
+    };
+
+    QMap<int, Entry> m_receivers;
+    QMap<int, BroadcastServer *> m_broadcasts;
+    QMap<int, QString> m_rings;
+    QThread *m_broadcastThread;
+    int m_nextId;
+    int m_activeId;
+};
+
+#endif // RECEIVERPIPELINE_H
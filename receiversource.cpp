@@ -0,0 +1,74 @@
+#include "receiversource.h"
+#include "networksource.h"
+#include <QRegularExpression>
+
+bool ReceiverSource::fromUrl(const QString &url, ReceiverSource &source)
+{
+    static const QRegularExpression networkPattern("^(tcp|tcp-listen|udp)://(\\[[^\\]]*\\]|[^:/]*):(\\d+)/?$");
+    static const QRegularExpression serialPattern("^(?:serial://)?([^@]+)(?:@(\\d+))?$");
+
+    const QString text = url.trimmed();
+    const QRegularExpressionMatch network = networkPattern.match(text);
+    if (network.hasMatch()) {
+        const int port = network.captured(3).toInt();
+        if (port <= 0 || port > 65535) {
+            return false;
+        }
+        const QString scheme = network.captured(1);
+        QString host = network.captured(2);
+        if (host.startsWith('[')) {
+            host = host.mid(1, host.size() - 2);   // IPv6 地址
+        }
+        if (scheme == "tcp" && host.isEmpty()) {
+            return false;
+        }
+        const Type type = scheme == "tcp" ? TcpClient : (scheme == "udp" ? Udp : TcpServer);
+        source = ReceiverSource(type, host, quint16(port));
+        return true;
+    }
+
+    if (text.contains("://") && !text.startsWith("serial://")) {
+        return false;
+    }
+    const QRegularExpressionMatch serial = serialPattern.match(text);
+    if (!serial.hasMatch()) {
+        return false;
+    }
+    const int baud = serial.captured(2).isEmpty() ? 9600 : serial.captured(2).toInt();
+    if (baud <= 0) {
+        return false;
+    }
+    source = ReceiverSource(serial.captured(1), baud);
+    return true;
+}
+
+QString ReceiverSource::toUrl() const
+{
+    const QString address = host.contains(':') ? QString("[%1]").arg(host) : host;
+    switch (type) {
+    case TcpClient: return QString("tcp://%1:%2").arg(address).arg(port);
+    case TcpServer: return QString("tcp-listen://%1:%2").arg(address).arg(port);
+    case Udp: return QString("udp://%1:%2").arg(address).arg(port);
+    default: return QString("serial://%1@%2").arg(portName).arg(baudRate);
+    }
+}
+
+QString ReceiverSource::displayName() const
+{
+    switch (type) {
+    case TcpClient: return QString("TCP %1:%2").arg(host).arg(port);
+    case TcpServer: return QString("TCP监听 %1:%2").arg(host.isEmpty() ? "*" : host).arg(port);
+    case Udp: return QString("UDP %1:%2").arg(host.isEmpty() ? "*" : host).arg(port);
+    default: return QString("%1 @ %2").arg(portName).arg(baudRate);
+    }
+}
+
+NetworkSource *ReceiverSource::createNetworkSource(QObject *parent) const
+{
+    switch (type) {
+    case TcpClient: return new NetworkSource(NetworkSource::TcpClient, host, port, parent);
+    case TcpServer: return new NetworkSource(NetworkSource::TcpServer, host, port, parent);
+    case Udp: return new NetworkSource(NetworkSource::Udp, host, port, parent);
+    default: return nullptr;
+    }
+}
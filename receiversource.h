@@ -0,0 +1,43 @@
+#ifndef RECEIVERSOURCE_H
+#define RECEIVERSOURCE_H
+
+#include <QString>
+
+class QObject;
+class NetworkSource;
+
+// 一个接收机数据源的配置：串口，或网络（TCP 客户端、TCP 服务端、UDP）
+struct ReceiverSource {
+    enum Type {
+        Serial,
+        TcpClient,
+        TcpServer,
+        Udp
+    };
+
+    Type type;
+    QString portName;          // 串口名
+    int baudRate;
+    QString host;              // 网络：TCP 客户端为对方地址，服务端和 UDP 为本地监听地址（空为所有网卡）
+    quint16 port;
+
+    ReceiverSource() : type(Serial), baudRate(9600), port(0) {}
+    ReceiverSource(const QString &serialPort, int baud)
+        : type(Serial), portName(serialPort), baudRate(baud), port(0) {}
+    ReceiverSource(Type networkType, const QString &networkHost, quint16 networkPort)
+        : type(networkType), baudRate(0), host(networkHost), port(networkPort) {}
+
+    bool isNetwork() const { return type != Serial; }
+
+    // 按网络数据源的类型创建 NetworkSource（尚未打开），串口数据源返回 nullptr
+    NetworkSource *createNetworkSource(QObject *parent = nullptr) const;
+
+    // 数据源地址：tcp://主机:端口（连接）、tcp-listen://[地址]:端口（监听）、
+    // udp://[地址]:端口、serial://端口名[@波特率]，也可以直接写串口名。
+    // 格式错误时返回 false
+    static bool fromUrl(const QString &url, ReceiverSource &source);
+    QString toUrl() const;
+    QString displayName() const;
+};
+
+#endif // RECEIVERSOURCE_H
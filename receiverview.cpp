@@ -0,0 +1,429 @@
+#include "receiverview.h"
+#include "serialmanager.h"
+#include "nmeaparser.h"
+#include "localframe.h"
+#include "broadcastserver.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QInputDialog>
+#include <QLineEdit>
+#include <QMessageBox>
+#include <QPainter>
+#include <QtMath>
+
+// 叠加图中每台接收机显示的最近历元数
+static const int kOverlayEpochs = 600;
+// 界面刷新间隔（毫秒）
+static const int kRefreshInterval = 500;
+
+// 表格列
+enum ReceiverColumn {
+    IdColumn,
+    SourceColumn,
+    StatusColumn,
+    BytesColumn,
+    SentenceColumn,
+    DroppedColumn,
+    EpochColumn,
+    FixColumn,
+    UsedColumn,
+    HdopColumn,
+    BroadcastColumn,
+    ColumnCount
+};
+
+// 所有接收机最近位置的叠加图（水平面，米）。
+// 原点取第一台有定位的接收机的第一个定位，之后保持不变，便于比较各接收机的偏差。
+class ReceiverOverlay : public QWidget
+{
+public:
+    explicit ReceiverOverlay(QWidget *parent = nullptr)
+        : QWidget(parent)
+        , m_manager(nullptr)
+    {
+        setMinimumHeight(220);
+    }
+
+    void setManager(const ReceiverManager *manager) { m_manager = manager; }
+    void resetOrigin() { m_frame.reset(); }
+
+protected:
+    void paintEvent(QPaintEvent *event) override
+    {
+        Q_UNUSED(event)
+
+        QPainter painter(this);
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        painter.fillRect(rect(), Qt::white);
+        painter.setPen(QColor(189, 195, 199));
+        painter.drawRect(rect().adjusted(0, 0, -1, -1));
+
+        if (!m_manager) {
+            return;
+        }
+
+        // 收集各接收机最近的定位（东、北）
+        QMap<int, QVector<QPointF>> tracks;
+        double extent = 1.0;
+        for (int id : m_manager->receiverIds()) {
+            const EpochHistoryPtr history = m_manager->receiver(id)->history();
+            const qint64 rows = history->size();
+            QVector<QPointF> &track = tracks[id];
+            track.reserve(int(qMin<qint64>(rows, kOverlayEpochs)));
+            for (qint64 i = qMax<qint64>(0, rows - kOverlayEpochs); i < rows; ++i) {
+                const EpochHistory::Row row = history->row(i);
+                if (row.fixQuality == 0) {
+                    continue;
+                }
+                if (!m_frame.isValid()) {
+                    m_frame.setOrigin(row.latitude, row.longitude, row.altitude);
+                }
+                double east, north, up;
+                m_frame.toEnu(row.latitude, row.longitude, row.altitude, east, north, up);
+                track.append(QPointF(east, north));
+                extent = qMax(extent, qMax(qAbs(east), qAbs(north)));
+            }
+        }
+
+        // 等比例缩放，原点在中心
+        const QPointF center = QRectF(rect()).center();
+        const double scale = (qMin(width(), height()) / 2.0 - 16) / (extent * 1.1);
+        painter.setPen(QPen(QColor(236, 240, 241), 1));
+        painter.drawLine(QPointF(center.x(), 0), QPointF(center.x(), height()));
+        painter.drawLine(QPointF(0, center.y()), QPointF(width(), center.y()));
+        painter.setPen(QColor(127, 140, 141));
+        painter.drawText(QRectF(4, 4, 200, 16), Qt::AlignLeft, QString("±%1 m").arg(extent * 1.1, 0, 'f', 1));
+
+        int legendY = 4;
+        for (auto it = tracks.constBegin(); it != tracks.constEnd(); ++it) {
+            const QColor color = ReceiverView::colorFor(it.key());
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(color);
+            for (const QPointF &point : it.value()) {
+                painter.drawEllipse(QPointF(center.x() + point.x() * scale, center.y() - point.y() * scale), 1.5, 1.5);
+            }
+            if (!it.value().isEmpty()) {
+                const QPointF &last = it.value().last();
+                painter.setPen(QPen(color.darker(150), 1.5));
+                painter.setBrush(Qt::NoBrush);
+                painter.drawEllipse(QPointF(center.x() + last.x() * scale, center.y() - last.y() * scale), 5, 5);
+            }
+
+            painter.setPen(color);
+            painter.drawText(QRectF(width() - 204, legendY, 200, 16), Qt::AlignRight,
+                             QString("#%1 %2").arg(it.key()).arg(m_manager->receiver(it.key())->source().displayName()));
+            legendY += 16;
+        }
+    }
+
+private:
+    const ReceiverManager *m_manager;
+    LocalFrame m_frame;
+};
+
+ReceiverView::ReceiverView(QWidget *parent)
+    : QWidget(parent)
+    , m_manager(nullptr)
+{
+    setWindowTitle("📡 多接收机");
+    setupUI();
+
+    m_refreshTimer = new QTimer(this);
+    m_refreshTimer->setInterval(kRefreshInterval);
+    connect(m_refreshTimer, &QTimer::timeout, this, &ReceiverView::refresh);
+}
+
+QColor ReceiverView::colorFor(int id)
+{
+    static const QColor palette[] = {
+        QColor(231, 76, 60), QColor(52, 152, 219), QColor(39, 174, 96), QColor(142, 68, 173),
+        QColor(230, 126, 34), QColor(22, 160, 133), QColor(192, 57, 43), QColor(41, 128, 185)
+    };
+    return palette[(id - 1 + 8) % 8];
+}
+
+void ReceiverView::setupUI()
+{
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(8, 8, 8, 8);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    m_addButton = new QPushButton("➕ 添加接收机...", this);
+    m_removeButton = new QPushButton("➖ 移除", this);
+    m_broadcastButton = new QPushButton("📤 转发...", this);
+    m_broadcastButton->setToolTip("把选中接收机的语句通过 TCP 或本地套接字转发给其他程序");
+    m_ringButton = new QPushButton("🧩 共享内存...", this);
+    m_ringButton->setToolTip("把选中接收机解析好的历元写入共享内存，本机其他程序不需要解析即可读取");
+    m_showButton = new QPushButton("🖥️ 在主视图显示", this);
+    m_fileButton = new QPushButton("📁 主视图显示文件回放", this);
+    buttonLayout->addWidget(m_addButton);
+    buttonLayout->addWidget(m_removeButton);
+    buttonLayout->addWidget(m_broadcastButton);
+    buttonLayout->addWidget(m_ringButton);
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(m_showButton);
+    buttonLayout->addWidget(m_fileButton);
+    mainLayout->addLayout(buttonLayout);
+
+    m_table = new QTableWidget(0, ColumnCount, this);
+    m_table->setHorizontalHeaderLabels(QStringList() << "编号" << "数据源" << "状态" << "字节" << "语句"
+                                       << "丢弃" << "历元" << "定位" << "卫星" << "HDOP" << "输出");
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_table->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_table->verticalHeader()->setVisible(false);
+    m_table->horizontalHeader()->setSectionResizeMode(SourceColumn, QHeaderView::Stretch);
+    mainLayout->addWidget(m_table, 1);
+
+    m_summaryLabel = new QLabel("没有接收机", this);
+    m_summaryLabel->setStyleSheet("QLabel { font-size: 9pt; color: #2c3e50; }");
+    mainLayout->addWidget(m_summaryLabel);
+
+    m_overlay = new ReceiverOverlay(this);
+    mainLayout->addWidget(m_overlay, 2);
+
+    connect(m_addButton, &QPushButton::clicked, this, &ReceiverView::onAddReceiver);
+    connect(m_removeButton, &QPushButton::clicked, this, &ReceiverView::onRemoveReceiver);
+    connect(m_broadcastButton, &QPushButton::clicked, this, &ReceiverView::onBroadcast);
+    connect(m_ringButton, &QPushButton::clicked, this, &ReceiverView::onEpochRing);
+    connect(m_showButton, &QPushButton::clicked, this, &ReceiverView::onShowSelected);
+    connect(m_fileButton, &QPushButton::clicked, this, &ReceiverView::onShowFile);
+}
+
+void ReceiverView::setManager(ReceiverManager *manager)
+{
+    m_manager = manager;
+    m_overlay->setManager(manager);
+    connect(m_manager, &ReceiverManager::statusChanged, this, &ReceiverView::onStatusChanged);
+    refresh();
+}
+
+int ReceiverView::selectedReceiver() const
+{
+    const int row = m_table->currentRow();
+    if (row < 0 || !m_table->item(row, IdColumn)) {
+        return -1;
+    }
+    return m_table->item(row, IdColumn)->data(Qt::UserRole).toInt();
+}
+
+void ReceiverView::onAddReceiver()
+{
+    if (!m_manager) {
+        return;
+    }
+
+    // 串口列表项形如 "COM3 - 描述"，也可以直接输入端口名（如 /dev/ttyUSB0）或网络地址
+    SerialManager probe;
+    QStringList choices = probe.getAvailablePorts();
+    choices << "tcp://127.0.0.1:10110" << "tcp-listen://:10110" << "udp://:10110";
+    bool ok = false;
+    const QString choice = QInputDialog::getItem(this, "➕ 添加接收机",
+                                                 "串口或网络地址 (tcp://主机:端口, tcp-listen://:端口, udp://:端口):",
+                                                 choices, 0, true, &ok);
+    if (!ok || choice.trimmed().isEmpty()) {
+        return;
+    }
+
+    ReceiverSource source;
+    if (!ReceiverSource::fromUrl(choice.section(" - ", 0, 0), source)) {
+        QMessageBox::warning(this, "➕ 添加接收机", QString("无法识别的数据源: %1").arg(choice));
+        return;
+    }
+
+    if (!source.isNetwork()) {
+        const QStringList baudRates = {"4800", "9600", "19200", "38400", "57600", "115200", "230400", "460800", "921600"};
+        const QString baud = QInputDialog::getItem(this, "➕ 添加接收机", "波特率:", baudRates, 1, true, &ok);
+        if (!ok || baud.toInt() <= 0) {
+            return;
+        }
+        source.baudRate = baud.toInt();
+    }
+
+    const int id = m_manager->addReceiver(source);
+    m_status[id] = "正在打开";
+    refresh();
+}
+
+void ReceiverView::onRemoveReceiver()
+{
+    const int id = selectedReceiver();
+    if (!m_manager || id < 0) {
+        return;
+    }
+
+    const bool wasActive = m_manager->activeReceiver() == id;
+    m_manager->removeReceiver(id);
+    m_status.remove(id);
+    if (m_manager->receiverIds().isEmpty()) {
+        m_overlay->resetOrigin();
+    }
+    if (wasActive) {
+        emit showReceiver(-1);
+    }
+    refresh();
+}
+
+void ReceiverView::onBroadcast()
+{
+    const int id = selectedReceiver();
+    if (!m_manager || id < 0) {
+        return;
+    }
+
+    // 已经在转发时再点一次停止转发
+    if (m_manager->broadcastServer(id)) {
+        m_manager->stopBroadcast(id);
+        refresh();
+        return;
+    }
+
+    bool ok = false;
+    const int port = QInputDialog::getInt(this, "📤 转发", "TCP 端口（0 表示不使用 TCP）:",
+                                          10110 + id, 0, 65535, 1, &ok);
+    if (!ok) {
+        return;
+    }
+    const QString localName = QInputDialog::getText(this, "📤 转发", "本地套接字名（留空表示不使用）:",
+                                                    QLineEdit::Normal, QString("nmea-inspector-%1").arg(id), &ok).trimmed();
+    if (!ok) {
+        return;
+    }
+    if (port == 0 && localName.isEmpty()) {
+        return;
+    }
+
+    QString error;
+    if (!m_manager->startBroadcast(id, static_cast<quint16>(port), localName, &error)) {
+        QMessageBox::warning(this, "📤 转发", error);
+    }
+    refresh();
+}
+
+void ReceiverView::onEpochRing()
+{
+    const int id = selectedReceiver();
+    if (!m_manager || id < 0) {
+        return;
+    }
+
+    // 已经在写共享内存时再点一次停止
+    if (!m_manager->epochRingKey(id).isEmpty()) {
+        m_manager->stopEpochRing(id);
+        refresh();
+        return;
+    }
+
+    bool ok = false;
+    const QString key = QInputDialog::getText(this, "🧩 共享内存", "共享内存名:", QLineEdit::Normal,
+                                              QString("nmea-inspector-epochs-%1").arg(id), &ok).trimmed();
+    if (!ok || key.isEmpty()) {
+        return;
+    }
+
+    QString error;
+    if (!m_manager->startEpochRing(id, key, &error)) {
+        QMessageBox::warning(this, "🧩 共享内存", error);
+    }
+    refresh();
+}
+
+void ReceiverView::onShowSelected()
+{
+    const int id = selectedReceiver();
+    if (id >= 0) {
+        emit showReceiver(id);
+        refresh();
+    }
+}
+
+void ReceiverView::onShowFile()
+{
+    emit showReceiver(-1);
+    refresh();
+}
+
+void ReceiverView::onStatusChanged(int id, bool open, const QString &message)
+{
+    Q_UNUSED(open)
+    m_status[id] = message;
+}
+
+void ReceiverView::refresh()
+{
+    if (!m_manager) {
+        return;
+    }
+
+    const QList<int> ids = m_manager->receiverIds();
+    m_table->setRowCount(ids.size());
+
+    qint64 totalEpochs = 0;
+    for (int row = 0; row < ids.size(); ++row) {
+        const ReceiverPipeline *pipeline = m_manager->receiver(ids[row]);
+        const EpochHistoryPtr history = pipeline->history();
+        const qint64 epochs = history->size();
+        totalEpochs += epochs;
+
+        QStringList values;
+        values << QString("#%1").arg(pipeline->id())
+               << pipeline->source().displayName()
+               << (m_manager->activeReceiver() == pipeline->id() ? "🖥️ " : "") + m_status.value(pipeline->id())
+               << QString::number(pipeline->byteCount())
+               << QString::number(pipeline->sentenceCount())
+               << QString::number(pipeline->droppedSentences())
+               << QString::number(epochs);
+        if (epochs > 0) {
+            const EpochHistory::Row last = history->row(epochs - 1);
+            values << NMEAParser::getFixTypeString(last.fixQuality)
+                   << QString::number(last.satellitesUsed)
+                   << QString::number(last.hdop, 'f', 1);
+        } else {
+            values << "-" << "-" << "-";
+        }
+
+        if (const BroadcastServer *server = m_manager->broadcastServer(pipeline->id())) {
+            QStringList endpoints;
+            if (server->tcpPort() > 0) {
+                endpoints << QString("TCP %1").arg(server->tcpPort());
+            }
+            if (!server->localName().isEmpty()) {
+                endpoints << server->localName();
+            }
+            QString text = QString("%1 · %2 个客户端").arg(endpoints.join(", ")).arg(server->clientCount());
+            if (server->droppedBytes() > 0) {
+                text += QString(" · 丢弃 %1 字节").arg(server->droppedBytes());
+            }
+            values << text;
+        } else {
+            values << "-";
+        }
+        const QString ringKey = m_manager->epochRingKey(pipeline->id());
+        if (!ringKey.isEmpty()) {
+            values.last() = (values.last() == "-" ? QString() : values.last() + " · ") + QString("共享内存 %1").arg(ringKey);
+        }
+
+        for (int column = 0; column < ColumnCount; ++column) {
+            QTableWidgetItem *item = m_table->item(row, column);
+            if (!item) {
+                item = new QTableWidgetItem();
+                m_table->setItem(row, column, item);
+            }
+            item->setText(values[column]);
+        }
+        m_table->item(row, IdColumn)->setData(Qt::UserRole, pipeline->id());
+        m_table->item(row, IdColumn)->setForeground(colorFor(pipeline->id()));
+    }
+
+    m_summaryLabel->setText(ids.isEmpty() ? QString("没有接收机")
+                                          : QString("%1 台接收机，共 %2 个历元").arg(ids.size()).arg(totalEpochs));
+    m_overlay->update();
+
+    // 没有接收机时不需要定时刷新
+    if (ids.isEmpty()) {
+        m_refreshTimer->stop();
+    } else if (!m_refreshTimer->isActive()) {
+        m_refreshTimer->start();
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef RECEIVERVIEW_H
+#define RECEIVERVIEW_H
+
+#include <QWidget>
+#include <QTableWidget>
+#include <QPushButton>
+#include <QLabel>
+#include <QTimer>
+#include "receiverpipeline.h"
+
+class ReceiverOverlay;
+
+// 多接收机视图：接收机列表（状态、数据量、最新历元）和所有接收机位置的叠加图。
+// 数据直接从各接收机的历史中读取，定时刷新，不为每个历元做界面工作；
+// 选中一台接收机后可以在主视图（星位图、信噪比、统计）中单独显示。
+class ReceiverView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit ReceiverView(QWidget *parent = nullptr);
+
+    // 接收机由主窗口管理，这里只读取显示
+    void setManager(ReceiverManager *manager);
+
+    static QColor colorFor(int id);
+
+signals:
+    // 在主视图中显示某台接收机，-1 表示回到文件回放
+    void showReceiver(int id);
+
+private slots:
+    void onAddReceiver();
+    void onRemoveReceiver();
+    void onBroadcast();
+    void onEpochRing();
+    void onShowSelected();
+    void onShowFile();
+    void onStatusChanged(int id, bool open, const QString &message);
+    void refresh();
+
+private:
+    void setupUI();
+    int selectedReceiver() const;
+
+    ReceiverManager *m_manager;
+    QMap<int, QString> m_status;
+
+    QTableWidget *m_table;
+    ReceiverOverlay *m_overlay;
+    QLabel *m_summaryLabel;
+    QPushButton *m_addButton;
+    QPushButton *m_removeButton;
+    QPushButton *m_broadcastButton;
+    QPushButton *m_ringButton;
+    QPushButton *m_showButton;
+    QPushButton *m_fileButton;
+    QTimer *m_refreshTimer;
+};
+
+#endif // RECEIVERVIEW_H
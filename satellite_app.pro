@@ -1,10 +1,13 @@
-QT += core widgets charts serialport
+QT += core widgets charts serialport network
 
 CONFIG += c++17
 
 TARGET = SatelliteApp
 TEMPLATE = app
 
+# 解析器、输入和历元历史在 nmeacore 静态库中
+include(core/nmeacore.pri)
+
 # 源文件
 SOURCES += \
     main.cpp \
@@ -12,12 +15,17 @@ SOURCES += \
     nmeaview.cpp \
     basicview.cpp \
     messageview.cpp \
+    fieldmodel.cpp \
+    viewhub.cpp \
     satelliteview.cpp \
+    skytrack.cpp \
     snrview.cpp \
-    nmeaparser.cpp \
-    satellitedata.cpp \
-    filemanager.cpp \
-    serialmanager.cpp \
+    waterfallview.cpp \
+    dopview.cpp \
+    gstview.cpp \
+    receiverview.cpp \
+    anomalytimeline.cpp \
+    batchdialog.cpp \
     chartmanager.cpp
 
 # 头文件
@@ -26,14 +34,19 @@ HEADERS += \
     nmeaview.h \
     basicview.h \
     messageview.h \
+    fieldmodel.h \
+    viewhub.h \
     satelliteview.h \
+    skytrack.h \
     snrview.h \
-    nmeaparser.h \
-    satellitedata.h \
-    filemanager.h \
-    serialmanager.h \
-    chartmanager.h \
-    gnssdata.h
+    waterfallview.h \
+    dopview.h \
+    gstview.h \
+    receiverview.h \
+    anomalytimeline.h \
+    batchdialog.h \
+    systemcolors.h \
+    chartmanager.h
 
 # UI文件
 FORMS += \
@@ -55,7 +68,6 @@ CONFIG(debug, debug|release) {
 CONFIG(release, debug|release) {
     DESTDIR = release
     OBJECTS_DIR = release/obj
-    MOC_DIR = release/obj
     MOC_DIR = release/moc
     RCC_DIR = release/rcc
     UI_DIR = release/ui
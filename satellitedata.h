@@ -4,7 +4,7 @@
 #include <QString>
 #include <QDateTime>
 #include <QList>
-#include <QColor>
+#include <QMetaType>
 
 // 卫星信息结构体
 struct SatelliteInfo {
@@ -14,7 +14,6 @@ struct SatelliteInfo {
     int snr;                   // 信噪比 (dB)
     QString system;            // 卫星系统 (GPS, BDS, GLN, GAL)
     bool used;                 // 是否用于定位
-    QColor color;              // 显示颜色
     
     SatelliteInfo() : id(0), elevation(0), azimuth(0), snr(0), used(false) {}
 };
@@ -24,10 +23,11 @@ struct NMEAField {
     QString name;              // 字段名称
     QString value;            // 字段值
     QString description;       // 字段描述
+    QString sentence;          // 所属语句（如 "GPGST"，同类多条语句时带序号 "GPGSV#2"）
     
     NMEAField() {}
-    NMEAField(const QString &n, const QString &v, const QString &d = "")
-        : name(n), value(v), description(d) {}
+    NMEAField(const QString &n, const QString &v, const QString &d = "", const QString &s = "")
+        : name(n), value(v), description(d), sentence(s) {}
 };
 
 // 卫星定位数据
@@ -39,6 +39,7 @@ struct SatelliteData {
     QString time;              // UTC时间 (hh:mm:ss)
     QString date;              // UTC日期 (yyyy:MM:dd)
     QString beijingTime;       // 北京时间
+    qint64 utcTimeMs;          // UTC 毫秒（已知日期时为 Unix 时间，否则为当天毫秒数）
     
     // 定位质量信息
     int satelliteCount;        // 可见卫星数
@@ -47,41 +48,41 @@ struct SatelliteData {
     double pdop;              // 位置精度因子
     double vdop;              // 垂直精度因子
     QString fixType;          // 定位类型
+    int fixQuality;           // GGA 定位质量 (0-8)
     
     // 运动信息
     double speed;             // 速度 (m/s)
     double course;            // 航向 (度)
     
+    // GST伪距误差统计（本历元收到GST时有效）
+    bool hasGst;
+    double gstRms;            // 伪距残差RMS (米)
+    double gstMajor;          // 误差椭圆半长轴 (米)
+    double gstMinor;          // 误差椭圆半短轴 (米)
+    double gstOrientation;    // 半长轴方向 (度，相对真北顺时针)
+    double gstSigmaLat;       // 纬度误差标准差 (米)
+    double gstSigmaLon;       // 经度误差标准差 (米)
+    double gstSigmaAlt;       // 高度误差标准差 (米)
+    
+    // 当前数据源累计的校验和错误语句数
+    int checksumErrors;
+    
     // 卫星信息
     QList<SatelliteInfo> satellites;
     
-    // NMEA字段信息
+    // 最近收到的每条语句的字段（按语句登记表解析，解析器开启字段记录时才有）
     QList<NMEAField> nmeaFields;
     
-    SatelliteData() : latitude(0.0), longitude(0.0), altitude(0.0),
+    SatelliteData() : latitude(0.0), longitude(0.0), altitude(0.0), utcTimeMs(0),
                      satelliteCount(0), usedSatelliteCount(0),
-                     hdop(0.0), pdop(0.0), vdop(0.0),
-                     speed(0.0), course(0.0) {}
+                     hdop(0.0), pdop(0.0), vdop(0.0), fixQuality(0),
+                     speed(0.0), course(0.0),
+                     hasGst(false), gstRms(0.0), gstMajor(0.0), gstMinor(0.0), gstOrientation(0.0),
+                     gstSigmaLat(0.0), gstSigmaLon(0.0), gstSigmaAlt(0.0),
+                     checksumErrors(0) {}
 };
 
-// 卫星系统颜色定义
-class SatelliteSystemColors {
-public:
-    static QColor getSystemColor(const QString &system) {
-        if (system == "GPS") return QColor(0, 100, 200);      // 蓝色
-        else if (system == "BDS") return QColor(255, 140, 0);  // 橙色
-        else if (system == "GLN") return QColor(0, 150, 0);   // 绿色
-        else if (system == "GAL") return QColor(150, 0, 150); // 紫色
-        else return QColor(128, 128, 128);                    // 灰色
-    }
-    
-    static QString getSystemName(const QString &system) {
-        if (system == "GPS") return "GPS";
-        else if (system == "BDS") return "北斗";
-        else if (system == "GLN") return "格洛纳斯";
-        else if (system == "GAL") return "伽利略";
-        else return "其他";
-    }
-};
+// 接收线程通过排队连接把历元送到界面线程
+Q_DECLARE_METATYPE(SatelliteData)
 
 #endif // SATELLITEDATA_H
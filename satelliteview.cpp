@@ -36,6 +36,20 @@ SatelliteView::SatelliteView(QWidget *parent)
     m_systemColors["QZSS"] = QColor(255, 165, 0);    // 橙色
     m_systemColors["SBAS"] = QColor(128, 128, 128);  // 灰色
     
+    // 轨迹画笔：按信噪比等级着色，使用 cosmetic 笔宽，缩放绘制时线宽不变
+    const QColor trailColors[SkyTrail::SnrClassCount] = {
+        QColor(170, 170, 170),   // 未跟踪
+        QColor(231, 76, 60),     // <20 dB
+        QColor(230, 126, 34),    // 20-30 dB
+        QColor(241, 196, 15),    // 30-40 dB
+        QColor(39, 174, 96)      // >=40 dB
+    };
+    for (int i = 0; i < SkyTrail::SnrClassCount; ++i) {
+        m_trailPens[i] = QPen(trailColors[i], 2);
+        m_trailPens[i].setCosmetic(true);
+        m_trailPens[i].setCapStyle(Qt::RoundCap);
+    }
+    
     setupUI();
     addTestData();
     
@@ -65,18 +79,21 @@ void SatelliteView::setupUI()
     m_bdsCheckBox = new QCheckBox("BDS", this);
     m_glnCheckBox = new QCheckBox("GLN", this);
     m_galCheckBox = new QCheckBox("GAL", this);
+    m_trailCheckBox = new QCheckBox("轨迹", this);
     
     // 默认全部选中
     m_gpsCheckBox->setChecked(true);
     m_bdsCheckBox->setChecked(true);
     m_glnCheckBox->setChecked(true);
     m_galCheckBox->setChecked(true);
+    m_trailCheckBox->setChecked(true);
     
     // 设置复选框位置（浮动在左上角）
     m_gpsCheckBox->move(10, 10);
     m_bdsCheckBox->move(110, 10);
     m_glnCheckBox->move(210, 10);
     m_galCheckBox->move(310, 10);
+    m_trailCheckBox->move(410, 10);
     
     // 设置复选框样式
     QString checkBoxStyle = "QCheckBox { background-color: rgba(255, 255, 255, 200); "
@@ -85,12 +102,14 @@ void SatelliteView::setupUI()
     m_bdsCheckBox->setStyleSheet(checkBoxStyle);
     m_glnCheckBox->setStyleSheet(checkBoxStyle);
     m_galCheckBox->setStyleSheet(checkBoxStyle);
+    m_trailCheckBox->setStyleSheet(checkBoxStyle);
     
     // 连接信号
     connect(m_gpsCheckBox, &QCheckBox::toggled, this, &SatelliteView::onSystemToggled);
     connect(m_bdsCheckBox, &QCheckBox::toggled, this, &SatelliteView::onSystemToggled);
     connect(m_glnCheckBox, &QCheckBox::toggled, this, &SatelliteView::onSystemToggled);
     connect(m_galCheckBox, &QCheckBox::toggled, this, &SatelliteView::onSystemToggled);
+    connect(m_trailCheckBox, &QCheckBox::toggled, this, &SatelliteView::onSystemToggled);
 }
 
 void SatelliteView::updateData(const SatelliteData &data)
@@ -196,6 +215,11 @@ void SatelliteView::drawRadarChart(QPainter &painter)
     // 绘制网格
     drawGrid(painter);
     
+    // 绘制历史轨迹（在卫星下方）
+    if (m_trailCheckBox->isChecked()) {
+        drawTrails(painter);
+    }
+    
     // 绘制卫星
     drawSatellites(painter);
     
@@ -277,13 +301,7 @@ void SatelliteView::drawSatellites(QPainter &painter)
     
     for (const SatelliteInfo &satellite : m_visibleSatellites) {
         // 检查系统是否被选中
-        bool systemVisible = false;
-        if (satellite.system == "GPS" && m_gpsCheckBox->isChecked()) systemVisible = true;
-        if (satellite.system == "BDS" && m_bdsCheckBox->isChecked()) systemVisible = true;
-        if (satellite.system == "GLN" && m_glnCheckBox->isChecked()) systemVisible = true;
-        if (satellite.system == "GAL" && m_galCheckBox->isChecked()) systemVisible = true;
-        
-        if (!systemVisible) continue;
+        if (!isSystemVisible(satellite.system)) continue;
         
         // 计算卫星位置（在变换后的坐标系中）
         double radius = m_radius * (90 - satellite.elevation) / 90.0;
@@ -326,6 +344,60 @@ void SatelliteView::drawSatellites(QPainter &painter)
     }
 }
 
+bool SatelliteView::isSystemVisible(const QString &system) const
+{
+    if (system == "GPS") return m_gpsCheckBox->isChecked();
+    if (system == "BDS") return m_bdsCheckBox->isChecked();
+    if (system == "GLN") return m_glnCheckBox->isChecked();
+    if (system == "GAL") return m_galCheckBox->isChecked();
+    return false;
+}
+
+void SatelliteView::recordTrackSamples(const SatelliteData &data)
+{
+    // 每个完整的历元调用一次，每颗卫星记录一个样本
+    for (const SatelliteInfo &satellite : data.satellites) {
+        if (satellite.id <= 0 || satellite.elevation < 0 || satellite.elevation > 90) {
+            continue;
+        }
+        
+        SkyTrackSample sample(satellite.azimuth, satellite.elevation, satellite.snr);
+        m_trails[qMakePair(satellite.system, satellite.id)].append(sample);
+    }
+}
+
+void SatelliteView::clearTracks()
+{
+    m_trails.clear();
+    update();
+}
+
+void SatelliteView::drawTrails(QPainter &painter)
+{
+    // 路径以单位圆坐标缓存，这里只需缩放到当前半径；每条轨迹只把新增样本追加进路径
+    painter.save();
+    painter.scale(m_radius, m_radius);
+    painter.setBrush(Qt::NoBrush);
+    
+    for (auto it = m_trails.begin(); it != m_trails.end(); ++it) {
+        if (!isSystemVisible(it.key().first)) {
+            continue;
+        }
+        
+        SkyTrail &trail = it.value();
+        trail.syncPaths();
+        for (int level = 0; level < SkyTrail::SnrClassCount; ++level) {
+            const QPainterPath &path = trail.path(level);
+            if (!path.isEmpty()) {
+                painter.setPen(m_trailPens[level]);
+                painter.drawPath(path);
+            }
+        }
+    }
+    
+    painter.restore();
+}
+
 void SatelliteView::drawColorLegend(QPainter &painter)
 {
     // 绘制多系统统计信息
@@ -10,7 +10,11 @@
 #include <QHBoxLayout>
 #include <QGroupBox>
 #include <QMap>
+#include <QHash>
+#include <QPair>
+#include <QPen>
 #include "satellitedata.h"
+#include "skytrack.h"
 
 class SatelliteView : public QWidget
 {
@@ -21,6 +25,10 @@ public:
     ~SatelliteView();
 
     void updateData(const SatelliteData &data);
+    
+    // 记录卫星轨迹样本：每个完整的历元调用一次（视图隐藏时也需要调用，避免轨迹出现空缺）
+    void recordTrackSamples(const SatelliteData &data);
+    void clearTracks();
 
 protected:
     void paintEvent(QPaintEvent *event) override;
@@ -35,6 +43,8 @@ private:
     void drawGrid(QPainter &painter);
     void drawLabels(QPainter &painter);
     void drawSatellites(QPainter &painter);
+    void drawTrails(QPainter &painter);
+    bool isSystemVisible(const QString &system) const;
     void drawColorLegend(QPainter &painter);
     
     // 计算卫星在雷达图上的位置
@@ -49,6 +59,7 @@ private:
     QCheckBox *m_bdsCheckBox;
     QCheckBox *m_glnCheckBox;
     QCheckBox *m_galCheckBox;
+    QCheckBox *m_trailCheckBox;
     
     // 数据
     SatelliteData m_currentData;
@@ -62,6 +73,10 @@ private:
     
     // 系统颜色
     QMap<QString, QColor> m_systemColors;
+    
+    // 每颗卫星（系统, PRN）的历史轨迹
+    QHash<QPair<QString, int>, SkyTrail> m_trails;
+    QPen m_trailPens[SkyTrail::SnrClassCount];
 };
 
 #endif // SATELLITEVIEW_H
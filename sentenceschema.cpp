@@ -0,0 +1,408 @@
+#include "sentenceschema.h"
+#include <cstring>
+#include <iterator>
+
+// ---- 字段表（fields[0] 为地址之后的第一个字段） ----
+
+static constexpr FieldSchema kGgaFields[] = {
+    {"UTC时间", FieldType::Time, "", "定位时刻"},
+    {"纬度", FieldType::Latitude, "", ""},
+    {"纬度半球", FieldType::Char, "", "N=北纬 S=南纬"},
+    {"经度", FieldType::Longitude, "", ""},
+    {"经度半球", FieldType::Char, "", "E=东经 W=西经"},
+    {"定位质量", FieldType::Integer, "", "0=无定位 1=单点 2=差分 4=RTK固定 5=RTK浮点 6=推算"},
+    {"使用卫星数", FieldType::Integer, "", ""},
+    {"HDOP", FieldType::Real, "", "水平精度因子"},
+    {"海拔", FieldType::Real, "m", "相对大地水准面"},
+    {"海拔单位", FieldType::Char, "", ""},
+    {"大地水准面差距", FieldType::Real, "m", "椭球高 = 海拔 + 差距"},
+    {"差距单位", FieldType::Char, "", ""},
+    {"差分龄期", FieldType::Real, "s", "最近一次差分改正的时间"},
+    {"差分站ID", FieldType::Text, "", ""}
+};
+
+static constexpr FieldSchema kGllFields[] = {
+    {"纬度", FieldType::Latitude, "", ""},
+    {"纬度半球", FieldType::Char, "", "N=北纬 S=南纬"},
+    {"经度", FieldType::Longitude, "", ""},
+    {"经度半球", FieldType::Char, "", "E=东经 W=西经"},
+    {"UTC时间", FieldType::Time, "", ""},
+    {"状态", FieldType::Char, "", "A=有效 V=无效"},
+    {"模式", FieldType::Char, "", "A=自主 D=差分 E=推算 N=无效"}
+};
+
+static constexpr FieldSchema kGnsFields[] = {
+    {"UTC时间", FieldType::Time, "", "定位时刻"},
+    {"纬度", FieldType::Latitude, "", ""},
+    {"纬度半球", FieldType::Char, "", "N=北纬 S=南纬"},
+    {"经度", FieldType::Longitude, "", ""},
+    {"经度半球", FieldType::Char, "", "E=东经 W=西经"},
+    {"模式", FieldType::Text, "", "每个卫星系统一个字符（GPS/GLONASS/Galileo/BDS...）：N=无 A=单点 D=差分 P=精密 R=RTK固定 F=RTK浮点 E=推算"},
+    {"使用卫星数", FieldType::Integer, "", ""},
+    {"HDOP", FieldType::Real, "", "水平精度因子"},
+    {"海拔", FieldType::Real, "m", "相对大地水准面"},
+    {"大地水准面差距", FieldType::Real, "m", ""},
+    {"差分龄期", FieldType::Real, "s", ""},
+    {"差分站ID", FieldType::Text, "", ""},
+    {"导航状态", FieldType::Char, "", "S=安全 C=警告 U=不安全 V=无效（NMEA 4.1）"}
+};
+
+static constexpr FieldSchema kGrsFields[] = {
+    {"UTC时间", FieldType::Time, "", "对应 GGA 的时刻"},
+    {"残差模式", FieldType::Integer, "", "0=残差用于计算位置 1=位置确定后重新计算"},
+    {"残差1", FieldType::Real, "m", "顺序与 GSA 中的卫星相同"},
+    {"残差2", FieldType::Real, "m", ""},
+    {"残差3", FieldType::Real, "m", ""},
+    {"残差4", FieldType::Real, "m", ""},
+    {"残差5", FieldType::Real, "m", ""},
+    {"残差6", FieldType::Real, "m", ""},
+    {"残差7", FieldType::Real, "m", ""},
+    {"残差8", FieldType::Real, "m", ""},
+    {"残差9", FieldType::Real, "m", ""},
+    {"残差10", FieldType::Real, "m", ""},
+    {"残差11", FieldType::Real, "m", ""},
+    {"残差12", FieldType::Real, "m", ""},
+    {"系统ID", FieldType::Integer, "", "1=GPS 2=GLONASS 3=Galileo 4=BDS（NMEA 4.1）"},
+    {"信号ID", FieldType::Integer, "", ""}
+};
+
+static constexpr FieldSchema kGsaFields[] = {
+    {"模式", FieldType::Char, "", "M=手动 A=自动"},
+    {"定位类型", FieldType::Integer, "", "1=无定位 2=二维 3=三维"},
+    {"卫星号1", FieldType::Integer, "", "参与定位的卫星"},
+    {"卫星号2", FieldType::Integer, "", ""},
+    {"卫星号3", FieldType::Integer, "", ""},
+    {"卫星号4", FieldType::Integer, "", ""},
+    {"卫星号5", FieldType::Integer, "", ""},
+    {"卫星号6", FieldType::Integer, "", ""},
+    {"卫星号7", FieldType::Integer, "", ""},
+    {"卫星号8", FieldType::Integer, "", ""},
+    {"卫星号9", FieldType::Integer, "", ""},
+    {"卫星号10", FieldType::Integer, "", ""},
+    {"卫星号11", FieldType::Integer, "", ""},
+    {"卫星号12", FieldType::Integer, "", ""},
+    {"PDOP", FieldType::Real, "", "位置精度因子"},
+    {"HDOP", FieldType::Real, "", "水平精度因子"},
+    {"VDOP", FieldType::Real, "", "垂直精度因子"},
+    {"系统ID", FieldType::Integer, "", "1=GPS 2=GLONASS 3=Galileo 4=BDS（NMEA 4.1）"}
+};
+
+static constexpr FieldSchema kGstFields[] = {
+    {"UTC时间", FieldType::Time, "", ""},
+    {"伪距残差RMS", FieldType::Real, "m", ""},
+    {"误差椭圆半长轴", FieldType::Real, "m", "1σ"},
+    {"误差椭圆半短轴", FieldType::Real, "m", "1σ"},
+    {"半长轴方向", FieldType::Real, "°", "相对真北顺时针"},
+    {"纬度误差σ", FieldType::Real, "m", ""},
+    {"经度误差σ", FieldType::Real, "m", ""},
+    {"高度误差σ", FieldType::Real, "m", ""}
+};
+
+static constexpr FieldSchema kGsvFields[] = {
+    {"语句总数", FieldType::Integer, "", ""},
+    {"语句序号", FieldType::Integer, "", ""},
+    {"可见卫星数", FieldType::Integer, "", "本系统的可见卫星"},
+    {"卫星号", FieldType::Integer, "", ""},
+    {"仰角", FieldType::Integer, "°", ""},
+    {"方位角", FieldType::Integer, "°", ""},
+    {"信噪比", FieldType::Integer, "dB-Hz", "空表示未跟踪"}
+};
+
+static constexpr FieldSchema kHdtFields[] = {
+    {"航向", FieldType::Real, "°", "真北航向（双天线测向）"},
+    {"真北标志", FieldType::Char, "", "T=真北"}
+};
+
+static constexpr FieldSchema kMssFields[] = {
+    {"信号强度", FieldType::Real, "dB", "信标接收机"},
+    {"信噪比", FieldType::Real, "dB", ""},
+    {"信标频率", FieldType::Real, "kHz", ""},
+    {"信标比特率", FieldType::Integer, "bps", ""},
+    {"通道号", FieldType::Integer, "", ""}
+};
+
+static constexpr FieldSchema kPqtmEpeFields[] = {
+    {"消息版本", FieldType::Integer, "", ""},
+    {"北向误差", FieldType::Real, "m", "估计的定位误差"},
+    {"东向误差", FieldType::Real, "m", ""},
+    {"天向误差", FieldType::Real, "m", ""},
+    {"水平误差", FieldType::Real, "m", ""},
+    {"三维误差", FieldType::Real, "m", ""}
+};
+
+static constexpr FieldSchema kPqtmVernoFields[] = {
+    {"固件版本", FieldType::Text, "", ""},
+    {"编译日期", FieldType::Text, "", ""},
+    {"编译时间", FieldType::Text, "", ""}
+};
+
+static constexpr FieldSchema kPubx00Fields[] = {
+    {"消息编号", FieldType::Integer, "", "00=位置"},
+    {"UTC时间", FieldType::Time, "", ""},
+    {"纬度", FieldType::Latitude, "", ""},
+    {"纬度半球", FieldType::Char, "", ""},
+    {"经度", FieldType::Longitude, "", ""},
+    {"经度半球", FieldType::Char, "", ""},
+    {"椭球高", FieldType::Real, "m", ""},
+    {"导航状态", FieldType::Text, "", "NF=无定位 DR=推算 G2/G3=单点 D2/D3=差分 RK=推算组合 TT=授时"},
+    {"水平精度", FieldType::Real, "m", ""},
+    {"垂直精度", FieldType::Real, "m", ""},
+    {"地速", FieldType::Real, "km/h", ""},
+    {"航向", FieldType::Real, "°", ""},
+    {"垂直速度", FieldType::Real, "m/s", "向下为正"},
+    {"差分龄期", FieldType::Real, "s", ""},
+    {"HDOP", FieldType::Real, "", ""},
+    {"VDOP", FieldType::Real, "", ""},
+    {"TDOP", FieldType::Real, "", ""},
+    {"使用卫星数", FieldType::Integer, "", ""},
+    {"保留", FieldType::Text, "", ""},
+    {"推算标志", FieldType::Integer, "", ""}
+};
+
+static constexpr FieldSchema kPubx03Fields[] = {
+    {"消息编号", FieldType::Integer, "", "03=卫星状态"},
+    {"卫星数", FieldType::Integer, "", ""},
+    {"卫星号", FieldType::Integer, "", ""},
+    {"状态", FieldType::Char, "", "-=未使用 U=参与定位 e=仅有星历"},
+    {"方位角", FieldType::Integer, "°", ""},
+    {"仰角", FieldType::Integer, "°", ""},
+    {"载噪比", FieldType::Integer, "dB-Hz", ""},
+    {"锁定时间", FieldType::Integer, "s", ""}
+};
+
+static constexpr FieldSchema kPubx04Fields[] = {
+    {"消息编号", FieldType::Integer, "", "04=时间"},
+    {"UTC时间", FieldType::Time, "", ""},
+    {"UTC日期", FieldType::Date, "", ""},
+    {"周内秒", FieldType::Real, "s", "GPS 时"},
+    {"GPS周", FieldType::Integer, "", ""},
+    {"闰秒", FieldType::Text, "s", "带 D 表示使用固件默认值"},
+    {"钟差", FieldType::Integer, "ns", ""},
+    {"钟漂", FieldType::Real, "ns/s", ""},
+    {"脉冲粒度", FieldType::Integer, "ns", ""}
+};
+
+static constexpr FieldSchema kRmcFields[] = {
+    {"UTC时间", FieldType::Time, "", ""},
+    {"状态", FieldType::Char, "", "A=有效 V=无效"},
+    {"纬度", FieldType::Latitude, "", ""},
+    {"纬度半球", FieldType::Char, "", "N=北纬 S=南纬"},
+    {"经度", FieldType::Longitude, "", ""},
+    {"经度半球", FieldType::Char, "", "E=东经 W=西经"},
+    {"地速", FieldType::Real, "kn", ""},
+    {"航向", FieldType::Real, "°", "真北"},
+    {"UTC日期", FieldType::Date, "", ""},
+    {"磁偏角", FieldType::Real, "°", ""},
+    {"磁偏角方向", FieldType::Char, "", "E/W"},
+    {"模式", FieldType::Char, "", "A=自主 D=差分 E=推算 N=无效 R=RTK固定 F=RTK浮点"},
+    {"导航状态", FieldType::Char, "", "NMEA 4.1"}
+};
+
+static constexpr FieldSchema kTxtFields[] = {
+    {"语句总数", FieldType::Integer, "", ""},
+    {"语句序号", FieldType::Integer, "", ""},
+    {"文本类型", FieldType::Integer, "", "00=错误 01=警告 02=通知 07=用户"},
+    {"文本", FieldType::Text, "", ""}
+};
+
+static constexpr FieldSchema kVtgFields[] = {
+    {"真北航向", FieldType::Real, "°", ""},
+    {"真北标志", FieldType::Char, "", "T"},
+    {"磁北航向", FieldType::Real, "°", ""},
+    {"磁北标志", FieldType::Char, "", "M"},
+    {"地速", FieldType::Real, "kn", ""},
+    {"节标志", FieldType::Char, "", "N"},
+    {"地速", FieldType::Real, "km/h", ""},
+    {"公里标志", FieldType::Char, "", "K"},
+    {"模式", FieldType::Char, "", "A=自主 D=差分 E=推算 N=无效"}
+};
+
+static constexpr FieldSchema kZdaFields[] = {
+    {"UTC时间", FieldType::Time, "", ""},
+    {"日", FieldType::Integer, "", ""},
+    {"月", FieldType::Integer, "", ""},
+    {"年", FieldType::Integer, "", ""},
+    {"时区小时", FieldType::Integer, "", "本地时间 = UTC + 时区"},
+    {"时区分钟", FieldType::Integer, "", ""}
+};
+
+// ---- 登记表（按类型排序，查找时二分） ----
+
+template <int N>
+static constexpr SentenceSchema sentence(const char *type, const char *description, const FieldSchema (&fields)[N],
+                                         SentenceDecoder decoder = SentenceDecoder::None,
+                                         int repeatFrom = -1, int groupField = 0)
+{
+    return SentenceSchema{type, description, fields, N, decoder, repeatFrom, groupField};
+}
+
+static constexpr SentenceSchema kSchemas[] = {
+    sentence("GGA", "定位数据", kGgaFields, SentenceDecoder::GGA),
+    sentence("GLL", "地理位置", kGllFields, SentenceDecoder::GLL),
+    sentence("GNS", "多系统定位数据", kGnsFields, SentenceDecoder::GNS),
+    sentence("GRS", "伪距残差", kGrsFields),
+    sentence("GSA", "参与定位的卫星和精度因子", kGsaFields, SentenceDecoder::GSA),
+    sentence("GST", "伪距误差统计", kGstFields, SentenceDecoder::GST),
+    sentence("GSV", "可见卫星", kGsvFields, SentenceDecoder::GSV, 3, 2),
+    sentence("HDT", "真北航向", kHdtFields),
+    sentence("MSS", "信标接收机信号状态", kMssFields),
+    sentence("PQTMEPE", "移远：估计定位误差", kPqtmEpeFields),
+    sentence("PQTMVERNO", "移远：固件版本", kPqtmVernoFields),
+    sentence("PUBX,00", "u-blox：位置", kPubx00Fields),
+    sentence("PUBX,03", "u-blox：卫星状态", kPubx03Fields, SentenceDecoder::None, 2),
+    sentence("PUBX,04", "u-blox：时间", kPubx04Fields),
+    sentence("RMC", "推荐最小定位数据", kRmcFields, SentenceDecoder::RMC),
+    sentence("TXT", "文本消息", kTxtFields, SentenceDecoder::None, -1, 2),
+    sentence("VTG", "地面航向和速度", kVtgFields, SentenceDecoder::VTG),
+    sentence("ZDA", "时间和日期", kZdaFields, SentenceDecoder::ZDA)
+};
+
+static constexpr int kSchemaCount = int(std::size(kSchemas));
+
+static constexpr int compareType(const char *a, const char *b)
+{
+    while (*a && *a == *b) {
+        ++a;
+        ++b;
+    }
+    return int(static_cast<unsigned char>(*a)) - int(static_cast<unsigned char>(*b));
+}
+
+static constexpr bool schemasSorted()
+{
+    for (int i = 1; i < kSchemaCount; ++i) {
+        if (compareType(kSchemas[i - 1].type, kSchemas[i].type) >= 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(schemasSorted(), "kSchemas 必须按类型排序且不能重复");
+
+const SentenceSchema *SentenceRegistry::find(const QString &address, const QString &firstField)
+{
+    // 查找键不分配内存：标准语句去掉两个字母的发送者标识，专有语句用完整地址
+    char key[16];
+    int length = 0;
+    auto append = [&](const QChar *text, int count) {
+        for (int i = 0; i < count; ++i) {
+            if (length >= int(sizeof(key)) - 1) {
+                return false;
+            }
+            key[length++] = text[i].toLatin1();
+        }
+        return true;
+    };
+
+    if (address.startsWith('P')) {
+        if (!append(address.constData(), address.length())) {
+            return nullptr;
+        }
+        // u-blox 的 PUBX 按消息编号区分
+        if (address == QLatin1String("PUBX")) {
+            const QChar comma(',');
+            if (!append(&comma, 1) || !append(firstField.constData(), firstField.length())) {
+                return nullptr;
+            }
+        }
+    } else if (address.length() == 5) {
+        append(address.constData() + 2, 3);
+    } else {
+        return nullptr;
+    }
+    key[length] = '\0';
+
+    int low = 0;
+    int high = kSchemaCount - 1;
+    while (low <= high) {
+        const int middle = (low + high) / 2;
+        const int order = std::strcmp(kSchemas[middle].type, key);
+        if (order == 0) {
+            return &kSchemas[middle];
+        }
+        if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle - 1;
+        }
+    }
+    return nullptr;
+}
+
+const FieldSchema *SentenceRegistry::field(const SentenceSchema &schema, int index, int *repeat)
+{
+    if (repeat) {
+        *repeat = 0;
+    }
+    if (index < 0) {
+        return nullptr;
+    }
+    if (schema.repeatFrom < 0) {
+        return index < schema.fieldCount ? &schema.fields[index] : nullptr;
+    }
+    if (index < schema.repeatFrom) {
+        return &schema.fields[index];
+    }
+
+    const int groupSize = schema.fieldCount - schema.repeatFrom;
+    const int offset = index - schema.repeatFrom;
+    if (repeat) {
+        *repeat = offset / groupSize + 1;
+    }
+    return &schema.fields[schema.repeatFrom + offset % groupSize];
+}
+
+QString SentenceRegistry::formatValue(const FieldSchema &field, const QString &raw)
+{
+    if (raw.isEmpty()) {
+        return QString();
+    }
+
+    QString value = raw;
+    switch (field.type) {
+    case FieldType::Time:
+        if (raw.length() >= 6) {
+            value = raw.mid(0, 2) + ":" + raw.mid(2, 2) + ":" + raw.mid(4);
+        }
+        break;
+    case FieldType::Date:
+        if (raw.length() == 6) {
+            value = "20" + raw.mid(4, 2) + "-" + raw.mid(2, 2) + "-" + raw.mid(0, 2);
+        }
+        break;
+    case FieldType::Latitude:
+    case FieldType::Longitude: {
+        // 度分格式转换为度
+        const int degreeDigits = field.type == FieldType::Latitude ? 2 : 3;
+        bool okDegrees = false, okMinutes = false;
+        const double degrees = raw.left(degreeDigits).toDouble(&okDegrees);
+        const double minutes = raw.mid(degreeDigits).toDouble(&okMinutes);
+        if (okDegrees && okMinutes) {
+            value = QString::number(degrees + minutes / 60.0, 'f', 7) + "°";
+        }
+        break;
+    }
+    case FieldType::Text:
+    case FieldType::Char:
+    case FieldType::Integer:
+    case FieldType::Real:
+        break;
+    }
+
+    if (field.unit[0] != '\0') {
+        const QString unit = QString::fromUtf8(field.unit);
+        value += unit == "°" ? unit : " " + unit;
+    }
+    return value;
+}
+
+int SentenceRegistry::schemaCount()
+{
+    return kSchemaCount;
+}
+
+const SentenceSchema &SentenceRegistry::schemaAt(int index)
+{
+    return kSchemas[index];
+}
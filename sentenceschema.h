@@ -0,0 +1,70 @@
+#ifndef SENTENCESCHEMA_H
+#define SENTENCESCHEMA_H
+
+#include <QtGlobal>
+#include <QString>
+
+// 字段的数据类型，决定显示格式
+enum class FieldType : quint8 {
+    Text,
+    Char,           // 单字符标志（半球、状态、模式）
+    Integer,
+    Real,
+    Time,           // hhmmss.ss
+    Date,           // ddmmyy
+    Latitude,       // ddmm.mmmm
+    Longitude       // dddmm.mmmm
+};
+
+// 语句的解码方式：None 表示只按字段表显示，其他值对应 NMEAParser 中的解码函数
+enum class SentenceDecoder : quint8 {
+    None,
+    GGA,
+    RMC,
+    GSV,
+    GSA,
+    GLL,
+    VTG,
+    ZDA,
+    GST,
+    GNS
+};
+
+struct FieldSchema {
+    const char *name;
+    FieldType type;
+    const char *unit;
+    const char *description;
+};
+
+struct SentenceSchema {
+    const char *type;               // 标准语句为去掉发送者标识的三个字母（"GST"），专有语句为完整地址（"PQTMEPE"、"PUBX,00"）
+    const char *description;
+    const FieldSchema *fields;      // fields[0] 对应语句的第一个数据字段
+    int fieldCount;
+    SentenceDecoder decoder;
+    int repeatFrom;                 // 从这个字段开始按组重复（GSV 每颗卫星一组），-1 表示不重复
+    int groupField;                 // 多条同类语句按这个字段区分（GSV 的语句序号），0 表示不区分
+};
+
+// 语句登记表：每种语句的字段表在编译期确定（sentenceschema.cpp 中按类型排序的常量数组），
+// 解析器据此分派解码函数，消息视图据此显示字段名称、单位和说明。
+// 字段表只用于分派和显示：各解码函数仍按 NMEA 规定的固定位置读取字段，修改字段表不会改变解码。
+// 增加一种语句只需要在表中加一行字段定义；没有登记的语句只多一次二分查找。
+class SentenceRegistry
+{
+public:
+    // address 为 '$' 之后的地址（"GPGST"、"PUBX"），firstField 为第一个数据字段（PUBX 的消息编号）
+    static const SentenceSchema *find(const QString &address, const QString &firstField);
+
+    // 第 index 个数据字段对应的定义，超出字段表时按重复组计算；repeat 返回所在的组号（从 1 开始，不重复时为 0）
+    static const FieldSchema *field(const SentenceSchema &schema, int index, int *repeat = nullptr);
+
+    // 按字段类型和单位格式化原始字段
+    static QString formatValue(const FieldSchema &field, const QString &raw);
+
+    static int schemaCount();
+    static const SentenceSchema &schemaAt(int index);
+};
+
+#endif // SENTENCESCHEMA_H
@@ -1,5 +1,6 @@
 #include "serialmanager.h"
 #include <QDebug>
+#include <QMetaMethod>
 
 SerialManager::SerialManager(QObject *parent)
     : QObject(parent)
@@ -142,6 +143,14 @@ void SerialManager::sendData(const QByteArray &data)
 void SerialManager::onDataReceived()
 {
     QByteArray data = m_serialPort->readAll();
+    emit bytesReceived(data);
+    
+    // 文本信号只在有人连接时才转换和发出（接收机流水线只使用原始字节）
+    static const QMetaMethod dataReceivedSignal = QMetaMethod::fromSignal(&SerialManager::dataReceived);
+    if (!isSignalConnected(dataReceivedSignal)) {
+        return;
+    }
+    
     QString dataString = QString::fromUtf8(data);
     
     // 发送接收到的数据
@@ -38,8 +38,10 @@ public:
     void sendData(const QByteArray &data);
 
 signals:
-    // 数据接收信号
+    // 数据接收信号（文本，只在有连接时转换）
     void dataReceived(const QString &data);
+    // 原始字节（数据块边界与语句无关，交给 NMEAFramer 切分）
+    void bytesReceived(const QByteArray &data);
     // 串口状态变化信号
     void portStatusChanged(bool isOpen);
     // 错误信号
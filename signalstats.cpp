@@ -0,0 +1,196 @@
+#include "signalstats.h"
+#include <QFile>
+#include <QTextStream>
+#include <QStringList>
+#include <QtMath>
+#include <cstring>
+#include <algorithm>
+
+SnrAccumulator::SnrAccumulator()
+    : count(0)
+    , mean(0.0)
+    , m2(0.0)
+    , minimum(0)
+    , maximum(0)
+{
+    memset(histogram, 0, sizeof(histogram));
+}
+
+void SnrAccumulator::add(int snr)
+{
+    snr = qBound(0, snr, HistogramSize - 1);
+
+    // Welford 增量更新
+    ++count;
+    const double delta = snr - mean;
+    mean += delta / double(count);
+    m2 += delta * (snr - mean);
+
+    if (count == 1) {
+        minimum = maximum = snr;
+    } else {
+        minimum = qMin(minimum, snr);
+        maximum = qMax(maximum, snr);
+    }
+    ++histogram[snr];
+}
+
+void SnrAccumulator::merge(const SnrAccumulator &other)
+{
+    if (other.count == 0) {
+        return;
+    }
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+
+    // Chan 等人的并行合并公式
+    const double total = double(count + other.count);
+    const double delta = other.mean - mean;
+    mean += delta * double(other.count) / total;
+    m2 += other.m2 + delta * delta * double(count) * double(other.count) / total;
+    count += other.count;
+
+    minimum = qMin(minimum, other.minimum);
+    maximum = qMax(maximum, other.maximum);
+    for (int i = 0; i < HistogramSize; ++i) {
+        histogram[i] += other.histogram[i];
+    }
+}
+
+double SnrAccumulator::standardDeviation() const
+{
+    return qSqrt(variance());
+}
+
+int SnrAccumulator::percentile(double fraction) const
+{
+    if (count == 0) {
+        return 0;
+    }
+
+    // 需要累计到的样本数（最近秩）
+    const quint64 rank = qMax<quint64>(1, quint64(qCeil(qBound(0.0, fraction, 1.0) * double(count))));
+    quint64 cumulative = 0;
+    for (int i = 0; i < HistogramSize; ++i) {
+        cumulative += histogram[i];
+        if (cumulative >= rank) {
+            return i;
+        }
+    }
+    return maximum;
+}
+
+SignalStatistics::SignalStatistics()
+    : m_epochCount(0)
+{
+}
+
+void SignalStatistics::addEpoch(const QList<SatelliteInfo> &satellites)
+{
+    ++m_epochCount;
+    for (const SatelliteInfo &satellite : satellites) {
+        if (satellite.id <= 0 || satellite.snr <= 0) {
+            continue;
+        }
+        m_prns[qMakePair(satellite.system, satellite.id)].add(satellite.snr);
+        m_systems[satellite.system].add(satellite.snr);
+    }
+}
+
+void SignalStatistics::merge(const SignalStatistics &other)
+{
+    for (auto it = other.m_prns.constBegin(); it != other.m_prns.constEnd(); ++it) {
+        m_prns[it.key()].merge(it.value());
+    }
+    for (auto it = other.m_systems.constBegin(); it != other.m_systems.constEnd(); ++it) {
+        m_systems[it.key()].merge(it.value());
+    }
+    m_epochCount += other.m_epochCount;
+}
+
+void SignalStatistics::clear()
+{
+    m_prns.clear();
+    m_systems.clear();
+    m_epochCount = 0;
+}
+
+// 与 SNRView 的面板顺序保持一致
+static int systemRank(const QString &system)
+{
+    static const QStringList order = {"GPS", "BDS", "GLN", "GAL", "QZSS", "SBAS", "NavIC"};
+    const int index = order.indexOf(system);
+    return index < 0 ? order.size() : index;
+}
+
+static bool systemLessThan(const QString &a, const QString &b)
+{
+    const int rankA = systemRank(a);
+    const int rankB = systemRank(b);
+    return rankA != rankB ? rankA < rankB : a < b;
+}
+
+QList<QString> SignalStatistics::sortedSystems() const
+{
+    QList<QString> systems = m_systems.keys();
+    std::sort(systems.begin(), systems.end(), systemLessThan);
+    return systems;
+}
+
+QList<SignalStatistics::PrnKey> SignalStatistics::sortedPrns(const QString &system) const
+{
+    QList<PrnKey> keys;
+    for (auto it = m_prns.constBegin(); it != m_prns.constEnd(); ++it) {
+        if (system.isEmpty() || it.key().first == system) {
+            keys.append(it.key());
+        }
+    }
+    std::sort(keys.begin(), keys.end(), [](const PrnKey &a, const PrnKey &b) {
+        if (a.first != b.first) {
+            return systemLessThan(a.first, b.first);
+        }
+        return a.second < b.second;
+    });
+    return keys;
+}
+
+bool SignalStatistics::exportCsv(const QString &fileName, QString *errorMessage) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        if (errorMessage) {
+            *errorMessage = file.errorString();
+        }
+        return false;
+    }
+
+    QTextStream stream(&file);
+    stream.setCodec("UTF-8");
+    stream << "system,prn,samples,min,max,mean,stddev,p10,p50,p90\n";
+
+    auto writeRow = [&stream](const QString &system, const QString &prn, const SnrAccumulator &acc) {
+        stream << system << ',' << prn << ',' << acc.count << ','
+               << acc.minimum << ',' << acc.maximum << ','
+               << QString::number(acc.mean, 'f', 2) << ','
+               << QString::number(acc.standardDeviation(), 'f', 2) << ','
+               << acc.percentile(0.1) << ',' << acc.percentile(0.5) << ',' << acc.percentile(0.9) << '\n';
+    };
+
+    for (const QString &system : sortedSystems()) {
+        writeRow(system, "ALL", m_systems.value(system));
+        for (const PrnKey &key : sortedPrns(system)) {
+            writeRow(system, QString::number(key.second), m_prns.value(key));
+        }
+    }
+
+    stream.flush();
+    if (stream.status() != QTextStream::Ok) {
+        if (errorMessage) {
+            *errorMessage = file.errorString();
+        }
+        return false;
+    }
+    return true;
+}
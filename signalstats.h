@@ -0,0 +1,64 @@
+#ifndef SIGNALSTATS_H
+#define SIGNALSTATS_H
+
+#include <QString>
+#include <QHash>
+#include <QPair>
+#include <QList>
+#include "satellitedata.h"
+
+// 单个信噪比样本序列的累计统计。
+// 均值、方差使用 Welford 增量公式，分位数来自固定的 0~99 dB-Hz 直方图，
+// 每个样本 O(1)；两个累计量可以直接合并（分块统计或多线程统计后汇总）。
+struct SnrAccumulator {
+    enum { HistogramSize = 100 };
+
+    quint64 count;
+    double mean;
+    double m2;                 // 与均值之差的平方和
+    int minimum;
+    int maximum;
+    quint32 histogram[HistogramSize];
+
+    SnrAccumulator();
+
+    void add(int snr);
+    void merge(const SnrAccumulator &other);
+
+    double variance() const { return count > 1 ? m2 / double(count - 1) : 0.0; }
+    double standardDeviation() const;
+    // 最近秩分位数，fraction 取 0~1
+    int percentile(double fraction) const;
+};
+
+// 按 PRN 和按卫星系统的信噪比统计。
+// 输入为每个完整历元的卫星列表，未跟踪（信噪比为 0）的卫星不计入。
+class SignalStatistics
+{
+public:
+    typedef QPair<QString, int> PrnKey;
+
+    SignalStatistics();
+
+    void addEpoch(const QList<SatelliteInfo> &satellites);
+    void merge(const SignalStatistics &other);
+    void clear();
+
+    quint64 epochCount() const { return m_epochCount; }
+    const QHash<PrnKey, SnrAccumulator> &prnStatistics() const { return m_prns; }
+    const QHash<QString, SnrAccumulator> &systemStatistics() const { return m_systems; }
+
+    // 按系统、PRN 排序后的键
+    QList<QString> sortedSystems() const;
+    QList<PrnKey> sortedPrns(const QString &system = QString()) const;
+
+    // 导出为 CSV（每个系统一行汇总，后面是各 PRN）
+    bool exportCsv(const QString &fileName, QString *errorMessage = nullptr) const;
+
+private:
+    QHash<PrnKey, SnrAccumulator> m_prns;
+    QHash<QString, SnrAccumulator> m_systems;
+    quint64 m_epochCount;
+};
+
+#endif // SIGNALSTATS_H
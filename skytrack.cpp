@@ -0,0 +1,109 @@
+#include "skytrack.h"
+#include <QtMath>
+
+// 相邻路径点的最小间距（单位圆坐标，约为半径的0.5%）。
+// 卫星运动缓慢，1Hz 采样的大部分样本落在同一像素内，跳过它们后
+// 路径点数只与卫星在天空中划过的弧长有关，而与记录时长无关。
+static const qreal kMinStep = 0.005;
+
+// 相邻样本距离超过该值时视为轨迹中断（卫星落下后在别处重新升起）
+static const qreal kMaxJump = 0.25;
+
+SkyTrackBuffer::SkyTrackBuffer(int capacity)
+    : m_capacity(qMax(1, capacity))
+    , m_total(0)
+{
+}
+
+void SkyTrackBuffer::append(const SkyTrackSample &sample)
+{
+    if (m_samples.size() < m_capacity) {
+        m_samples.append(sample);
+    } else {
+        m_samples[int(m_total % m_capacity)] = sample;
+    }
+    ++m_total;
+}
+
+SkyTrail::SkyTrail(int capacity)
+    : m_buffer(capacity)
+    , m_pathStart(0)
+    , m_pathEnd(0)
+    , m_lastClass(0)
+    , m_hasLastPoint(false)
+{
+}
+
+int SkyTrail::snrClass(int snr)
+{
+    if (snr <= 0) return 0;    // 未跟踪
+    if (snr < 20) return 1;    // 弱
+    if (snr < 30) return 2;
+    if (snr < 40) return 3;
+    return 4;                  // 强
+}
+
+QPointF SkyTrail::toUnitPoint(const SkyTrackSample &sample)
+{
+    const qreal radius = (90.0 - qBound(0.0f, sample.elevation, 90.0f)) / 90.0;
+    const qreal azimuth = qDegreesToRadians(qreal(sample.azimuth));
+    return QPointF(radius * qSin(azimuth), -radius * qCos(azimuth));
+}
+
+void SkyTrail::resetPaths(qint64 start)
+{
+    for (QPainterPath &path : m_paths) {
+        path = QPainterPath();
+    }
+    m_pathStart = start;
+    m_pathEnd = start;
+    m_hasLastPoint = false;
+}
+
+void SkyTrail::syncPaths()
+{
+    const qint64 first = m_buffer.firstSequence();
+    const qint64 total = m_buffer.totalCount();
+
+    // 路径中已被覆盖的样本超过容量的1/4时重建，重建代价摊到每个样本仍为 O(1)，
+    // 同时保证路径长度不超过缓冲区容量的1.25倍
+    if (m_pathEnd < first || first - m_pathStart > m_buffer.capacity() / 4) {
+        resetPaths(first);
+    }
+
+    for (qint64 sequence = m_pathEnd; sequence < total; ++sequence) {
+        addToPaths(m_buffer.sample(sequence));
+    }
+    m_pathEnd = total;
+}
+
+void SkyTrail::addToPaths(const SkyTrackSample &sample)
+{
+    const QPointF point = toUnitPoint(sample);
+    const int snrLevel = snrClass(sample.snr);
+
+    if (!m_hasLastPoint) {
+        m_lastPoint = point;
+        m_lastClass = snrLevel;
+        m_hasLastPoint = true;
+        return;
+    }
+
+    const QPointF delta = point - m_lastPoint;
+    const qreal distanceSquared = QPointF::dotProduct(delta, delta);
+    if (snrLevel == m_lastClass && distanceSquared < kMinStep * kMinStep) {
+        return;
+    }
+
+    // 每段的颜色取终点样本的信噪比等级
+    if (distanceSquared <= kMaxJump * kMaxJump) {
+        QPainterPath &path = m_paths[snrLevel];
+        if (path.elementCount() == 0 || path.currentPosition() != m_lastPoint) {
+            path.moveTo(m_lastPoint);
+        }
+        path.lineTo(point);
+    }
+
+    m_lastPoint = point;
+    m_lastClass = snrLevel;
+}
@@ -0,0 +1,76 @@
+#ifndef SKYTRACK_H
+#define SKYTRACK_H
+
+#include <QVector>
+#include <QPainterPath>
+#include <QPointF>
+
+// 星空轨迹样本
+struct SkyTrackSample {
+    float azimuth;             // 方位角 (度)
+    float elevation;           // 仰角 (度)
+    quint8 snr;                // 信噪比 (dB)，0 表示未跟踪
+
+    SkyTrackSample() : azimuth(0.0f), elevation(0.0f), snr(0) {}
+    SkyTrackSample(float az, float el, int s)
+        : azimuth(az), elevation(el), snr(quint8(qBound(0, s, 255))) {}
+};
+
+// 固定容量的环形缓冲区：追加为 O(1)，写满后覆盖最旧的样本。
+// 样本按累计序号访问，序号小于 firstSequence() 的样本已被覆盖。
+class SkyTrackBuffer
+{
+public:
+    explicit SkyTrackBuffer(int capacity = 4 * 3600);
+
+    void append(const SkyTrackSample &sample);
+
+    int capacity() const { return m_capacity; }
+    int size() const { return m_samples.size(); }
+    bool isEmpty() const { return m_samples.isEmpty(); }
+    qint64 totalCount() const { return m_total; }
+    qint64 firstSequence() const { return m_total - m_samples.size(); }
+
+    const SkyTrackSample &sample(qint64 sequence) const { return m_samples[int(sequence % m_capacity)]; }
+    const SkyTrackSample &last() const { return sample(m_total - 1); }
+
+private:
+    QVector<SkyTrackSample> m_samples;
+    int m_capacity;
+    qint64 m_total;
+};
+
+// 单颗卫星的轨迹：环形缓冲区 + 按信噪比等级分段缓存的绘制路径。
+// 路径使用单位圆坐标（半径1，仰角0°在边缘，北向上），绘制时再缩放，
+// 因此窗口缩放不会使缓存失效。
+class SkyTrail
+{
+public:
+    enum { SnrClassCount = 5 };
+
+    explicit SkyTrail(int capacity = 4 * 3600);
+
+    void append(const SkyTrackSample &sample) { m_buffer.append(sample); }
+    const SkyTrackBuffer &buffer() const { return m_buffer; }
+
+    // 把新样本增量加入缓存路径；被覆盖的旧样本累计过多时整体重建一次
+    void syncPaths();
+    const QPainterPath &path(int snrClass) const { return m_paths[snrClass]; }
+
+    static int snrClass(int snr);
+    static QPointF toUnitPoint(const SkyTrackSample &sample);
+
+private:
+    void resetPaths(qint64 start);
+    void addToPaths(const SkyTrackSample &sample);
+
+    SkyTrackBuffer m_buffer;
+    QPainterPath m_paths[SnrClassCount];
+    qint64 m_pathStart;        // 路径中最旧样本的序号
+    qint64 m_pathEnd;          // 下一个待加入路径的样本序号
+    QPointF m_lastPoint;
+    int m_lastClass;
+    bool m_hasLastPoint;
+};
+
+#endif // SKYTRACK_H
@@ -1,8 +1,12 @@
 #include "snrview.h"
 #include <QDebug>
+#include <QPaintEvent>
+#include <QVector>
 
 SNRView::SNRView(QWidget *parent)
     : QWidget(parent)
+    , m_barBrushTop(-1)
+    , m_barBrushBottom(-1)
 {
     setWindowTitle("📊 载噪比分析");
     setMinimumSize(700, 500);
@@ -27,7 +31,9 @@ SNRView::SNRView(QWidget *parent)
     m_systemColors["GAL"] = QColor(138, 43, 226);    // 蓝紫色
     m_systemColors["QZSS"] = QColor(255, 165, 0);    // 橙色
     m_systemColors["SBAS"] = QColor(128, 128, 128);  // 灰色
+    m_systemColors["NavIC"] = QColor(0, 128, 128);   // 青色
     
+    setupFonts();
     setupUI();
     // 移除静态测试数据，使用真实NMEA数据
     // addTestData();
@@ -95,25 +101,77 @@ void SNRView::setupUI()
     m_viewLabel->setStyleSheet(labelStyle2);
 }
 
+void SNRView::setupFonts()
+{
+    m_titleFont = font();
+    m_titleFont.setPointSize(18);
+    m_titleFont.setBold(true);
+
+    m_statusFont = font();
+    m_statusFont.setPointSize(10);
+
+    m_placeholderFont = font();
+    m_placeholderFont.setPointSize(14);
+    m_placeholderFont.setItalic(true);
+
+    m_panelTitleFont = font();
+    m_panelTitleFont.setPointSize(12);
+    m_panelTitleFont.setBold(true);
+
+    m_axisFont = font();
+    m_axisFont.setPointSize(9);
+
+    m_barLabelFont = font();
+    m_barLabelFont.setPointSize(8);
+    m_barLabelFont.setBold(true);
+}
+
+// 比较柱状图相关字段，未变化的系统面板无需重绘
+static bool sameBars(const QList<SatelliteInfo> &a, const QList<SatelliteInfo> &b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (int i = 0; i < a.size(); ++i) {
+        if (a[i].id != b[i].id || a[i].snr != b[i].snr || a[i].used != b[i].used) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void SNRView::updateData(const SatelliteData &data)
 {
+    const int previousCount = m_currentData.satelliteCount;
     m_currentData = data;
     
     // 按系统分组卫星
-    m_systemSatellites.clear();
+    QMap<QString, QList<SatelliteInfo>> grouped;
     for (const SatelliteInfo &satellite : data.satellites) {
         // 为没有信噪比的卫星设置默认值
         SatelliteInfo sat = satellite;
         if (sat.snr <= 0) {
             sat.snr = 30 + (sat.id % 30); // 设置30-60之间的随机值
         }
-        m_systemSatellites[sat.system].append(sat);
+        grouped[sat.system].append(sat);
     }
     
-    // 如果没有数据，不添加测试数据，让界面显示等待状态
-    // if (m_systemSatellites.isEmpty()) {
-    //     addTestData();
-    // }
+    // 系统集合或各系统卫星数量变化时面板尺寸会变，需要重新布局
+    bool layoutChanged = grouped.size() != m_systemSatellites.size();
+    for (auto it = grouped.cbegin(); !layoutChanged && it != grouped.cend(); ++it) {
+        auto old = m_systemSatellites.constFind(it.key());
+        layoutChanged = old == m_systemSatellites.cend() || old.value().size() != it.value().size();
+    }
+    
+    QStringList changedSystems;
+    if (!layoutChanged) {
+        for (auto it = grouped.cbegin(); it != grouped.cend(); ++it) {
+            if (!sameBars(m_systemSatellites.value(it.key()), it.value())) {
+                changedSystems.append(it.key());
+            }
+        }
+    }
+    m_systemSatellites = grouped;
     
     // 更新信息标签
     int usedCount = data.usedSatelliteCount;
@@ -121,70 +179,69 @@ void SNRView::updateData(const SatelliteData &data)
     m_usedLabel->setText(QString("Used/View: %1/%2").arg(usedCount).arg(viewCount));
     m_viewLabel->setText(QString("Tracked/View: %1/%2").arg(viewCount).arg(viewCount));
     
-    qDebug() << "SNRView::updateData - 系统数:" << m_systemSatellites.size();
+    if (layoutChanged) {
+        qDebug() << "SNRView::updateData - 重新布局，系统数:" << m_systemSatellites.size();
+        layoutPanels();
+        update();
+        return;
+    }
     
-    update();
+    // 只重绘数据发生变化的面板
+    for (const QString &system : changedSystems) {
+        PanelCache &panel = m_panels[system];
+        panel.dirty = true;
+        update(panel.rect);
+    }
+    if (previousCount != viewCount) {
+        update(QRect(0, 60, width(), 30));
+    }
 }
 
 void SNRView::paintEvent(QPaintEvent *event)
 {
-    Q_UNUSED(event)
-    
-    qDebug() << "SNRView::paintEvent - 开始绘制";
-    
     try {
         QPainter painter(this);
         painter.setRenderHint(QPainter::Antialiasing);
-        
-        // 计算绘制区域（为标签留出空间）
-        int topMargin = 50;  // 为标签留出空间
-        int sideMargin = 20;
-        m_chartArea = QRect(sideMargin, topMargin, width() - 2 * sideMargin, height() - topMargin - sideMargin);
-        
-        // 确保绘制区域有效
-        if (m_chartArea.width() <= 0 || m_chartArea.height() <= 0) {
-            qDebug() << "绘制区域无效，跳过绘制";
-            return;
-        }
-        
-        qDebug() << "绘制区域:" << m_chartArea;
+        const QRect dirtyRect = event->rect();
         
         // 绘制专业背景
         QLinearGradient gradient(0, 0, 0, height());
         gradient.setColorAt(0, QColor(248, 249, 250));
         gradient.setColorAt(1, QColor(240, 242, 245));
-        painter.fillRect(rect(), gradient);
+        painter.fillRect(dirtyRect, gradient);
         
         // 绘制标题区域
         QRect titleRect(0, 0, width(), 60);
-        QLinearGradient titleGradient(0, 0, 0, 60);
-        titleGradient.setColorAt(0, QColor(52, 152, 219));
-        titleGradient.setColorAt(1, QColor(41, 128, 185));
-        painter.fillRect(titleRect, titleGradient);
-        
-        // 绘制标题文字
-        painter.setPen(QColor(255, 255, 255));
-        QFont titleFont = painter.font();
-        titleFont.setPointSize(18);
-        titleFont.setBold(true);
-        painter.setFont(titleFont);
-        painter.drawText(titleRect, Qt::AlignCenter, "📊 载噪比分析 (SNR Analysis)");
+        if (titleRect.intersects(dirtyRect)) {
+            QLinearGradient titleGradient(0, 0, 0, 60);
+            titleGradient.setColorAt(0, QColor(52, 152, 219));
+            titleGradient.setColorAt(1, QColor(41, 128, 185));
+            painter.fillRect(titleRect, titleGradient);
+            
+            // 绘制标题文字
+            painter.setPen(QColor(255, 255, 255));
+            painter.setFont(m_titleFont);
+            painter.drawText(titleRect, Qt::AlignCenter, "📊 载噪比分析 (SNR Analysis)");
+        }
         
         // 绘制状态信息（在标题下方）
-        painter.setPen(QColor(52, 73, 94));
-        QFont statusFont = painter.font();
-        statusFont.setPointSize(10);
-        statusFont.setBold(false);
-        painter.setFont(statusFont);
-        QString statusText = QString("活跃系统: %1 | 总卫星数: %2")
-                           .arg(m_systemSatellites.size())
-                           .arg(m_currentData.satelliteCount);
-        painter.drawText(QRect(0, 65, width(), 20), Qt::AlignCenter, statusText);
+        QRect statusRect(0, 65, width(), 20);
+        if (statusRect.intersects(dirtyRect)) {
+            painter.setPen(QColor(52, 73, 94));
+            painter.setFont(m_statusFont);
+            QString statusText = QString("活跃系统: %1 | 总卫星数: %2")
+                               .arg(m_systemSatellites.size())
+                               .arg(m_currentData.satelliteCount);
+            painter.drawText(statusRect, Qt::AlignCenter, statusText);
+        }
         
-        // 绘制载噪比图表
-        drawSNRCharts(painter);
+        // 确保绘制区域有效
+        if (m_chartArea.width() <= 0 || m_chartArea.height() <= 0) {
+            return;
+        }
         
-        qDebug() << "SNRView::paintEvent - 绘制完成";
+        // 绘制载噪比图表
+        drawSNRCharts(painter, dirtyRect);
         
     } catch (const std::exception& e) {
         qDebug() << "SNRView::paintEvent异常:" << e.what();
@@ -193,56 +250,158 @@ void SNRView::paintEvent(QPaintEvent *event)
     }
 }
 
-void SNRView::drawSNRCharts(QPainter &painter)
+QStringList SNRView::orderedSystems() const
 {
-    qDebug() << "SNRView::drawSNRCharts - 系统数:" << m_systemSatellites.size();
+    // 按系统优先级排序，其余系统按名称排在后面
+    static const QStringList systemOrder = {"GPS", "BDS", "GLN", "GAL", "QZSS", "SBAS", "NavIC"};
+    
+    QStringList systems;
+    for (const QString &system : systemOrder) {
+        if (!m_systemSatellites.value(system).isEmpty()) {
+            systems.append(system);
+        }
+    }
+    for (auto it = m_systemSatellites.cbegin(); it != m_systemSatellites.cend(); ++it) {
+        if (!it.value().isEmpty() && !systemOrder.contains(it.key())) {
+            systems.append(it.key());
+        }
+    }
+    return systems;
+}
+
+void SNRView::layoutPanels()
+{
+    m_panelOrder = orderedSystems();
+    m_barBrushes.clear();
+    
+    // 移除已消失系统的缓存
+    for (auto it = m_panels.begin(); it != m_panels.end();) {
+        if (m_panelOrder.contains(it.key())) {
+            ++it;
+        } else {
+            it = m_panels.erase(it);
+        }
+    }
+    
+    const int count = m_panelOrder.size();
+    if (count == 0) {
+        return;
+    }
     
     // 调整绘制区域，为标题留出空间
-    QRect chartArea = m_chartArea.adjusted(0, 20, 0, 0);
+    const QRect area = m_chartArea.adjusted(0, 20, 0, 0);
+    const int spacing = 15;
+    
+    // 选择列数：让面板尽量接近 1.6:1 的宽高比，系统再多也能全部放下
+    int columns = 1;
+    double bestScore = -1.0;
+    for (int cols = 1; cols <= count; ++cols) {
+        const int rows = (count + cols - 1) / cols;
+        const double cellWidth = double(area.width() - (cols - 1) * spacing) / cols;
+        const double cellHeight = double(area.height() - (rows - 1) * spacing) / rows;
+        const double score = qMin(cellWidth / 1.6, cellHeight);
+        if (score > bestScore) {
+            bestScore = score;
+            columns = cols;
+        }
+    }
     
-    // 计算每个系统的图表区域（2x2布局）
-    int chartWidth = chartArea.width() / 2 - 15;
-    int chartHeight = chartArea.height() / 2 - 15;
+    // 所有面板等高，柱子渐变画刷因此可以在面板之间共享
+    const int rows = (count + columns - 1) / columns;
+    const int cellHeight = qMax(0, (area.height() - (rows - 1) * spacing) / rows);
     
-    // 动态获取有数据的系统
-    QStringList systems;
-    for (auto it = m_systemSatellites.begin(); it != m_systemSatellites.end(); ++it) {
-        if (!it.value().isEmpty()) {
-            systems.append(it.key());
+    for (int row = 0; row < rows; ++row) {
+        const int first = row * columns;
+        const int last = qMin(first + columns, count);
+        
+        // 同一行内按卫星数量分配宽度，卫星多的系统（如BDS）获得更宽的面板
+        int totalWeight = 0;
+        for (int i = first; i < last; ++i) {
+            totalWeight += qMax(6, m_systemSatellites.value(m_panelOrder[i]).size());
+        }
+        const int rowWidth = area.width() - (last - first - 1) * spacing;
+        
+        int x = area.x();
+        for (int i = first; i < last; ++i) {
+            const int weight = qMax(6, m_systemSatellites.value(m_panelOrder[i]).size());
+            const int panelWidth = (i == last - 1) ? area.right() + 1 - x
+                                                   : rowWidth * weight / totalWeight;
+            
+            PanelCache &panel = m_panels[m_panelOrder[i]];
+            panel.rect = QRect(x, area.y() + row * (cellHeight + spacing), panelWidth, cellHeight);
+            panel.pixmap = QPixmap();
+            panel.dirty = true;
+            
+            x += panelWidth + spacing;
         }
     }
+}
+
+void SNRView::renderPanel(const QString &system, PanelCache &panel)
+{
+    if (panel.pixmap.isNull()) {
+        const qreal ratio = devicePixelRatioF();
+        panel.pixmap = QPixmap(panel.rect.size() * ratio);
+        panel.pixmap.setDevicePixelRatio(ratio);
+    }
+    panel.pixmap.fill(Qt::transparent);
+    panel.dirty = false;
     
+    if (panel.rect.width() <= 10 || panel.rect.height() <= 35) {
+        return;
+    }
+    
+    QPainter painter(&panel.pixmap);
+    painter.setRenderHint(QPainter::Antialiasing);
+    
+    // 面板顶部25像素用于系统标题，其余为图表区域
+    QRect chartRect(5, 30, panel.rect.width() - 10, panel.rect.height() - 35);
+    QColor color = m_systemColors.value(system, QColor(128, 128, 128));
+    drawSystemChart(painter, system, m_systemSatellites.value(system), chartRect, color);
+}
+
+void SNRView::drawSNRCharts(QPainter &painter, const QRect &dirtyRect)
+{
     // 如果没有数据，显示提示信息
-    if (systems.isEmpty()) {
+    if (m_panelOrder.isEmpty()) {
         painter.setPen(QColor(149, 165, 166));
-        QFont font = painter.font();
-        font.setPointSize(14);
-        font.setItalic(true);
-        painter.setFont(font);
-        painter.drawText(chartArea, Qt::AlignCenter, "等待NMEA数据...\n请加载NMEA文件");
+        painter.setFont(m_placeholderFont);
+        painter.drawText(m_chartArea.adjusted(0, 20, 0, 0), Qt::AlignCenter, "等待NMEA数据...\n请加载NMEA文件");
         return;
     }
     
-    int chartIndex = 0;
-    for (const QString &system : systems) {
-        
-        int row = chartIndex / 2;
-        int col = chartIndex % 2;
-        
-        QRect systemRect(chartArea.x() + col * (chartWidth + 15) + 10,
-                        chartArea.y() + row * (chartHeight + 15) + 10,
-                        chartWidth, chartHeight);
-        
-        QColor color = m_systemColors.value(system, QColor(128, 128, 128));
-        
-        qDebug() << "绘制系统:" << system << "卫星数:" << m_systemSatellites[system].size() 
-                 << "区域:" << systemRect;
+    for (const QString &system : m_panelOrder) {
+        PanelCache &panel = m_panels[system];
+        if (!panel.rect.intersects(dirtyRect)) {
+            continue;
+        }
         
-        drawSystemChart(painter, system, m_systemSatellites[system], systemRect, color);
-        chartIndex++;
+        if (panel.dirty || panel.pixmap.isNull()) {
+            renderPanel(system, panel);
+        }
+        painter.drawPixmap(panel.rect.topLeft(), panel.pixmap);
     }
 }
 
+const QBrush &SNRView::barBrush(const QColor &color, int top, int bottom)
+{
+    // 所有面板等高，同一颜色的渐变画刷可以复用；面板高度变化时整体失效
+    if (top != m_barBrushTop || bottom != m_barBrushBottom) {
+        m_barBrushes.clear();
+        m_barBrushTop = top;
+        m_barBrushBottom = bottom;
+    }
+    
+    auto it = m_barBrushes.find(color.rgb());
+    if (it == m_barBrushes.end()) {
+        QLinearGradient gradient(0, top, 0, bottom);
+        gradient.setColorAt(0, color.lighter(130));
+        gradient.setColorAt(1, color.darker(120));
+        it = m_barBrushes.insert(color.rgb(), QBrush(gradient));
+    }
+    return it.value();
+}
+
 void SNRView::drawSystemChart(QPainter &painter, const QString &system, 
                             const QList<SatelliteInfo> &satellites, 
                             const QRect &rect, const QColor &color)
@@ -261,92 +420,99 @@ void SNRView::drawSystemChart(QPainter &painter, const QString &system,
     
     // 绘制系统标题
     painter.setPen(QColor(255, 255, 255));
-    QFont titleFont = painter.font();
-    titleFont.setPointSize(12);
-    titleFont.setBold(true);
-    painter.setFont(titleFont);
-    painter.drawText(titleRect, Qt::AlignCenter, system);
+    painter.setFont(m_panelTitleFont);
+    painter.drawText(titleRect, Qt::AlignCenter, QString("%1 (%2)").arg(system).arg(satellites.size()));
     
     // 计算柱状图参数
     int maxHeight = rect.height() - 80; // 为标签留出更多空间
     int baseY = rect.bottom() - 40;
-    int barWidth = (rect.width() - 80) / satellites.size();
-    barWidth = qMax(25, qMin(barWidth, 50)); // 限制柱子宽度
+    int plotLeft = rect.x() + 50;
+    int plotWidth = rect.right() - 20 - plotLeft;
+    if (maxHeight <= 0 || plotWidth <= 0 || satellites.isEmpty()) {
+        return;
+    }
+    
+    // 柱宽随卫星数自适应：卫星很多时柱子变窄而不是溢出面板
+    int slotWidth = qBound(1, plotWidth / satellites.size(), 50);
+    int gap = slotWidth >= 12 ? qMin(8, slotWidth / 4) : (slotWidth >= 4 ? 1 : 0);
+    int barWidth = qMax(1, slotWidth - gap);
     
     // 绘制Y轴
     painter.setPen(QPen(QColor(100, 100, 100), 2));
     painter.drawLine(rect.x() + 40, rect.y() + 20, rect.x() + 40, baseY);
     
     // 绘制Y轴标签（0到60，每15一个刻度）
-    painter.setPen(QColor(100, 100, 100));
-    QFont axisFont = painter.font();
-    axisFont.setPointSize(9);
-    painter.setFont(axisFont);
-    
+    painter.setFont(m_axisFont);
+    QPen axisTextPen(QColor(100, 100, 100));
+    QPen gridPen(QColor(230, 230, 230), 1, Qt::DashLine);
     for (int i = 0; i <= 4; ++i) {
         int value = i * 15;
         int y = baseY - (i * maxHeight / 4);
+        painter.setPen(axisTextPen);
         painter.drawText(rect.x() + 10, y + 4, QString::number(value));
         
         // 绘制水平网格线
-        painter.setPen(QPen(QColor(230, 230, 230), 1, Qt::DashLine));
+        painter.setPen(gridPen);
         painter.drawLine(rect.x() + 40, y, rect.right() - 20, y);
-        painter.setPen(QPen(QColor(100, 100, 100), 2));
     }
     
-    // 绘制柱状图
+    // 先收集所有柱子，再按颜色批量填充
+    QVector<QRect> usedBars;
+    QVector<QRect> unusedBars;
+    QVector<QRect> usedMarkers;
+    usedBars.reserve(satellites.size());
+    unusedBars.reserve(satellites.size());
+    
     for (int i = 0; i < satellites.size(); ++i) {
         const SatelliteInfo &satellite = satellites[i];
         
         int barHeight = (satellite.snr * maxHeight) / 60; // 最大SNR为60
         barHeight = qBound(0, barHeight, maxHeight);
         
-        int x = rect.x() + 50 + i * barWidth;
-        int y = baseY - barHeight;
-        
-        qDebug() << "绘制系统" << system << "卫星" << satellite.id 
-                 << "SNR=" << satellite.snr << "高度=" << barHeight 
-                 << "位置=(" << x << "," << y << ")";
-        
-        // 设置颜色和渐变
-        QColor barColor = color;
-        if (!satellite.used) {
-            barColor = QColor(200, 200, 200); // 未使用的卫星显示为灰色
+        QRect bar(plotLeft + i * slotWidth, baseY - barHeight, barWidth, barHeight);
+        if (satellite.used) {
+            usedBars.append(bar);
+            if (barWidth >= 10 && barHeight >= 10) {
+                usedMarkers.append(QRect(bar.right() - 7, bar.top() + 2, 6, 6));
+            }
+        } else {
+            unusedBars.append(bar); // 未使用的卫星显示为灰色
         }
-        
-        // 创建柱子渐变效果
-        QLinearGradient barGradient(x, y, x, y + barHeight);
-        barGradient.setColorAt(0, barColor.lighter(130));
-        barGradient.setColorAt(1, barColor.darker(120));
-        
-        // 绘制柱子（带圆角）
-        painter.setPen(QPen(barColor.darker(150), 1));
-        painter.setBrush(QBrush(barGradient));
-        painter.drawRoundedRect(x, y, barWidth - 8, barHeight, 4, 4);
-        
-        // 绘制卫星ID（X轴标签）
-        painter.setPen(QColor(52, 73, 94));
-        QFont labelFont = painter.font();
-        labelFont.setPointSize(8);
-        labelFont.setBold(true);
-        painter.setFont(labelFont);
-        painter.drawText(x + (barWidth - 8) / 2 - 5, baseY + 15, 
+    }
+    
+    painter.setPen(Qt::NoPen);
+    if (!usedBars.isEmpty()) {
+        painter.setBrush(barBrush(color, baseY - maxHeight, baseY));
+        painter.drawRects(usedBars);
+    }
+    if (!unusedBars.isEmpty()) {
+        painter.setBrush(barBrush(QColor(200, 200, 200), baseY - maxHeight, baseY));
+        painter.drawRects(unusedBars);
+    }
+    
+    // 绘制使用状态指示器
+    if (!usedMarkers.isEmpty()) {
+        painter.setBrush(QBrush(QColor(46, 204, 113)));
+        for (const QRect &marker : usedMarkers) {
+            painter.drawEllipse(marker);
+        }
+    }
+    
+    // 绘制卫星ID（X轴标签）和SNR值；柱子太窄时隔几根标注一次，避免文字重叠
+    painter.setFont(m_barLabelFont);
+    painter.setPen(QColor(52, 73, 94));
+    int labelStep = slotWidth >= 20 ? 1 : (20 + slotWidth - 1) / slotWidth;
+    bool showValues = slotWidth >= 20;
+    for (int i = 0; i < satellites.size(); i += labelStep) {
+        const SatelliteInfo &satellite = satellites[i];
+        int centerX = plotLeft + i * slotWidth + barWidth / 2;
+        painter.drawText(QRect(centerX - 15, baseY + 3, 30, 14), Qt::AlignHCenter | Qt::AlignTop,
                         QString::number(satellite.id));
         
-        // 绘制SNR值（柱子顶部）
-        painter.setPen(QColor(255, 255, 255));
-        QFont valueFont = painter.font();
-        valueFont.setPointSize(8);
-        valueFont.setBold(true);
-        painter.setFont(valueFont);
-        painter.drawText(x + (barWidth - 8) / 2 - 8, y - 8, 
-                        QString::number(satellite.snr));
-        
-        // 绘制使用状态指示器
-        if (satellite.used) {
-            painter.setPen(QPen(QColor(46, 204, 113), 2));
-            painter.setBrush(QBrush(QColor(46, 204, 113)));
-            painter.drawEllipse(x + barWidth - 12, y + 2, 6, 6);
+        if (showValues) {
+            int barHeight = qBound(0, (satellite.snr * maxHeight) / 60, maxHeight);
+            painter.drawText(QRect(centerX - 15, baseY - barHeight - 16, 30, 14), Qt::AlignCenter,
+                            QString::number(satellite.snr));
         }
     }
 }
@@ -439,6 +605,7 @@ void SNRView::resizeEvent(QResizeEvent *event)
     int topMargin = 50;
     int sideMargin = 20;
     m_chartArea = QRect(sideMargin, topMargin, width() - 2 * sideMargin, height() - topMargin - sideMargin);
+    layoutPanels();
     
     // 重新计算标签位置（右下角）
     if (m_usedLabel && m_viewLabel) {
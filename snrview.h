@@ -8,6 +8,10 @@
 #include <QHBoxLayout>
 #include <QGroupBox>
 #include <QMap>
+#include <QHash>
+#include <QPixmap>
+#include <QFont>
+#include <QBrush>
 #include "satellitedata.h"
 
 class SNRView : public QWidget
@@ -25,12 +29,24 @@ protected:
     void resizeEvent(QResizeEvent *event) override;
 
 private:
+    // 单个系统面板的缓存（只有数据变化的面板才重新绘制）
+    struct PanelCache {
+        QRect rect;            // 面板在控件中的位置
+        QPixmap pixmap;        // 已绘制好的面板图像
+        bool dirty = true;     // 数据或尺寸变化后需要重绘
+    };
+
     void setupUI();
-    void drawSNRCharts(QPainter &painter);
-    void drawSystemChart(QPainter &painter, const QString &system, 
-                        const QList<SatelliteInfo> &satellites, 
+    void setupFonts();
+    void layoutPanels();
+    QStringList orderedSystems() const;
+    void renderPanel(const QString &system, PanelCache &panel);
+    void drawSNRCharts(QPainter &painter, const QRect &dirtyRect);
+    void drawSystemChart(QPainter &painter, const QString &system,
+                        const QList<SatelliteInfo> &satellites,
                         const QRect &rect, const QColor &color);
-    
+    const QBrush &barBrush(const QColor &color, int top, int bottom);
+
     // 添加测试数据
     void addTestData();
 
@@ -38,16 +54,29 @@ private:
     // UI组件（简化为浮动标签）
     QLabel *m_usedLabel;
     QLabel *m_viewLabel;
-    
+
     // 数据
     SatelliteData m_currentData;
     QMap<QString, QList<SatelliteInfo>> m_systemSatellites;
-    
+
     // 绘制参数
     QRect m_chartArea;
-    
+    QStringList m_panelOrder;
+    QHash<QString, PanelCache> m_panels;
+
     // 系统颜色
     QMap<QString, QColor> m_systemColors;
+
+    // 预先创建的字体和画刷（避免每根柱子重复构造）
+    QFont m_titleFont;
+    QFont m_statusFont;
+    QFont m_placeholderFont;
+    QFont m_panelTitleFont;
+    QFont m_axisFont;
+    QFont m_barLabelFont;
+    QHash<QRgb, QBrush> m_barBrushes;
+    int m_barBrushTop;
+    int m_barBrushBottom;
 };
 
 #endif // SNRVIEW_H
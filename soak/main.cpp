@@ -0,0 +1,538 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QLocalSocket>
+#include <QLoggingCategory>
+#include <QTextStream>
+#include <QThread>
+#include <QTimer>
+#include <QVector>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include "nmeagenerator.h"
+#include "pseudoterminal.h"
+#include "pacedwriter.h"
+#include "receiverpipeline.h"
+#include "broadcastserver.h"
+
+// 写入时间戳按历元号取模保存，读取端落后超过这么多历元时无法计算延迟
+static const int kStampSlots = 65536;
+// 延迟直方图：10 微秒一格，最多 2 秒，更长的计入溢出
+static const qint64 kBucketNs = 10000;
+static const int kBuckets = 200000;
+
+// 端到端延迟直方图（历元最后一个字节写入伪终端 → 解析完该历元的 ZDA）
+class LatencyHistogram
+{
+public:
+    LatencyHistogram() : m_buckets(kBuckets, 0), m_overflow(0), m_count(0), m_max(0) {}
+
+    void add(qint64 ns)
+    {
+        const qint64 bucket = qMax<qint64>(0, ns) / kBucketNs;
+        if (bucket < kBuckets) {
+            ++m_buckets[int(bucket)];
+        } else {
+            ++m_overflow;
+        }
+        ++m_count;
+        m_max = qMax(m_max, ns);
+    }
+
+    void reset()
+    {
+        m_buckets.fill(0);
+        m_overflow = 0;
+        m_count = 0;
+        m_max = 0;
+    }
+
+    qint64 count() const { return m_count; }
+    double maxMs() const { return m_max / 1e6; }
+
+    // 百分位（毫秒，取所在格的上沿）
+    double percentileMs(double p) const
+    {
+        if (m_count == 0) {
+            return 0.0;
+        }
+        const qint64 rank = qMax<qint64>(1, qint64(m_count * p / 100.0 + 0.999999));
+        qint64 seen = 0;
+        for (int i = 0; i < kBuckets; ++i) {
+            seen += m_buckets[i];
+            if (seen >= rank) {
+                return (i + 1) * kBucketNs / 1e6;
+            }
+        }
+        return maxMs();
+    }
+
+    QString summary() const
+    {
+        return QString("p50 %1 ms，p99 %2 ms，p99.9 %3 ms，最大 %4 ms（%5 个样本）")
+            .arg(percentileMs(50), 0, 'f', 2).arg(percentileMs(99), 0, 'f', 2)
+            .arg(percentileMs(99.9), 0, 'f', 2).arg(maxMs(), 0, 'f', 2).arg(m_count);
+    }
+
+private:
+    QVector<qint64> m_buckets;
+    qint64 m_overflow;
+    qint64 m_count;
+    qint64 m_max;
+};
+
+// 写入线程和主线程共享的状态
+struct SoakShared {
+    std::atomic<bool> stop{false};
+    std::atomic<bool> finished{false};
+    std::atomic<bool> writeFailed{false};       // 写入伪终端出错，写入线程提前结束
+    std::atomic<qint64> epochs{0};              // 完整写入伪终端的历元
+    std::atomic<qint64> sentences{0};           // 其中的语句
+    std::atomic<qint64> corrupted[NMEAGenerator::CorruptionKinds] = {};    // 其中被故意破坏的语句（按破坏方式）
+    std::atomic<qint64> writtenBytes{0};
+    std::atomic<qint64> droppedEpochs{0};       // 带宽不足、积压超过上限而没有写入的历元
+    std::atomic<qint64> backlogHighWater{0};    // 写入端等待写入伪终端的字节
+    std::atomic<qint64> kernelHighWater{0};     // 伪终端内核缓冲区中等待 SerialManager 读取的字节
+    std::atomic<qint64> stamps[kStampSlots];    // 历元号 → 结束该历元的字节写入的时间
+
+    qint64 corruptedTotal() const
+    {
+        qint64 total = 0;
+        for (const std::atomic<qint64> &count : corrupted) {
+            total += count.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+};
+
+static void raiseHighWater(std::atomic<qint64> &mark, qint64 value)
+{
+    qint64 current = mark.load(std::memory_order_relaxed);
+    while (value > current && !mark.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+// 写入线程：按时钟生成历元，按波特率限速写入伪终端主设备。
+// 收到 stop 后不再生成新历元，但把已生成的写完，避免最后半个历元被算成丢失
+static void runWriter(SoakShared &shared, PseudoTerminal &pty, const GeneratorConfig &config,
+                      double byteRate, qint64 maxEpochs, const QElapsedTimer &clock)
+{
+    NMEAGenerator generator(config);
+
+    PacedWriter writer(&pty, byteRate);
+
+    // 已放入 writer 的历元及其在 writer 中的累计字节位置。
+    // 解析器收到下一个历元的第一条语句时才结束上一个历元，所以上一个历元的时间戳
+    // 在本历元第一条语句（trigger 之前）写入时打上
+    struct PendingEpoch {
+        qint64 index;
+        qint64 previous;        // 上一个写入的历元，没有时为 -1
+        qint64 trigger;
+        qint64 end;
+        int sentences;
+        int corrupted[NMEAGenerator::CorruptionKinds];
+    };
+    QVector<PendingEpoch> epochs;
+    int epochsOffset = 0;
+    int stampOffset = 0;
+    qint64 previous = -1;
+
+    const qint64 startNs = clock.nsecsElapsed();
+    writer.refill(startNs);
+
+    for (;;) {
+        const qint64 nowNs = clock.nsecsElapsed();
+        const bool stopping = shared.stop.load(std::memory_order_relaxed)
+                              || (maxEpochs > 0 && generator.epochCount() >= maxEpochs);
+        if (stopping && writer.backlog() == 0) {
+            break;
+        }
+
+        const qint64 due = stopping ? 0 : qint64((nowNs - startNs) / 1e9 * config.rateHz) + 1;
+        while (generator.epochCount() < due && (maxEpochs <= 0 || generator.epochCount() < maxEpochs)) {
+            PendingEpoch epoch;
+            epoch.index = generator.epochCount();
+            epoch.previous = previous;
+            const qint64 sentencesBefore = generator.sentenceCount();
+            qint64 corruptedBefore[NMEAGenerator::CorruptionKinds];
+            for (int kind = 0; kind < NMEAGenerator::CorruptionKinds; ++kind) {
+                corruptedBefore[kind] = generator.corruptedCount(NMEAGenerator::Corruption(kind));
+            }
+            const QByteArray bytes = generator.nextEpoch();
+            const qint64 begin = writer.queuedBytes();
+            if (!writer.enqueue(bytes)) {
+                continue;
+            }
+            epoch.trigger = begin + bytes.indexOf('\n') + 1;
+            epoch.end = writer.queuedBytes();
+            epoch.sentences = int(generator.sentenceCount() - sentencesBefore);
+            for (int kind = 0; kind < NMEAGenerator::CorruptionKinds; ++kind) {
+                epoch.corrupted[kind] = int(generator.corruptedCount(NMEAGenerator::Corruption(kind)) - corruptedBefore[kind]);
+            }
+            epochs.append(epoch);
+            previous = epoch.index;
+        }
+        shared.droppedEpochs.store(writer.droppedBlocks(), std::memory_order_relaxed);
+        raiseHighWater(shared.backlogHighWater, writer.backlog());
+
+        const qint64 allowed = writer.refill(nowNs);
+        // 写之前打时间戳：接收端可能在 write() 返回之前就读到数据
+        const qint64 stampNs = clock.nsecsElapsed();
+        for (; stampOffset < epochs.size() && epochs[stampOffset].trigger <= writer.writtenBytes() + allowed; ++stampOffset) {
+            if (epochs[stampOffset].previous >= 0) {
+                shared.stamps[epochs[stampOffset].previous % kStampSlots].store(stampNs, std::memory_order_release);
+            }
+        }
+        if (writer.write(allowed) < 0) {
+            shared.writeFailed.store(true, std::memory_order_relaxed);
+            break;
+        }
+        shared.writtenBytes.store(writer.writtenBytes(), std::memory_order_relaxed);
+
+        // 只有完整写入的历元才计入期望收到的语句
+        while (epochsOffset < epochs.size() && epochs[epochsOffset].end <= writer.writtenBytes()) {
+            shared.sentences.fetch_add(epochs[epochsOffset].sentences, std::memory_order_relaxed);
+            for (int kind = 0; kind < NMEAGenerator::CorruptionKinds; ++kind) {
+                shared.corrupted[kind].fetch_add(epochs[epochsOffset].corrupted[kind], std::memory_order_relaxed);
+            }
+            shared.epochs.fetch_add(1, std::memory_order_release);
+            ++epochsOffset;
+        }
+        const int done = qMin(epochsOffset, stampOffset);
+        if (done > 1024 && done > epochs.size() / 2) {
+            epochs.remove(0, done);
+            epochsOffset -= done;
+            stampOffset -= done;
+        }
+
+        raiseHighWater(shared.kernelHighWater, pty.queuedBytes());
+        QThread::usleep(200);
+    }
+    shared.finished.store(true, std::memory_order_release);
+}
+
+// 从历元的 UTC 时间推算历元号（生成器的时间从 start 开始，每历元 1/rateHz 秒）。
+// 生成器把毫秒四舍五入后截断到百分之一秒，实际时刻在 [显示值 - 0.5, 显示值 + 9.5] 毫秒之内，
+// 频率不超过 100 Hz 时这个区间里只有一个历元
+static qint64 epochIndex(const SatelliteData &data, const GeneratorConfig &config)
+{
+    if (!data.timestamp.isValid()) {
+        return -1;
+    }
+    const qint64 msecs = config.start.msecsTo(data.timestamp);
+    return qint64(std::ceil((msecs - 0.5) * config.rateHz / 1000.0));
+}
+
+// nmea-soak：接收路径的长时间浸泡测试。
+//
+//     soak/nmea-soak --baud 921600 --rate 20 --satellites 120 --seconds 14400
+//     soak/nmea-soak --baud 460800 --rate 10 --corrupt 0.001 --max-p99-ms 20
+//
+// 创建伪终端，写入线程把 NMEAGenerator 生成的数据按波特率限速写入主设备；
+// 接收端与图形界面相同：ReceiverManager 在自己的线程中运行 ReceiverPipeline
+// （SerialManager → NMEAFramer → NMEAParser → 历史），历元经跨线程队列送到主线程，
+// 语句经转发服务器送给一个本地套接字客户端。
+// 统计语句丢失、成帧/校验错误、各级缓冲区和队列的最高水位和端到端延迟百分位，
+// 按阈值判定通过（退出码 0）或失败（退出码 1），无法开始测试时退出码 2。
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("nmea-soak");
+    app.setApplicationVersion("1.0.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("伪终端 + 接收流水线 + 转发服务的高波特率浸泡测试");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption baudOption(QStringList() << "baud", "波特率（按每字节 10 位限速写入）", "baud", "921600");
+    QCommandLineOption rateOption(QStringList() << "rate", "历元频率（1-100 Hz）", "Hz", "10");
+    QCommandLineOption satellitesOption(QStringList() << "satellites", "可见卫星总数（每个系统最多 36 颗）", "n", "40");
+    QCommandLineOption systemsOption(QStringList() << "systems", "卫星系统 GP,GL,GA,GB,GQ", "list", "GP,GL,GA,GB");
+    QCommandLineOption corruptOption(QStringList() << "corrupt", "每条语句被破坏的概率", "p", "0");
+    QCommandLineOption seedOption(QStringList() << "seed", "随机种子", "n", "1");
+    QCommandLineOption secondsOption(QStringList() << "seconds", "写入时长（秒）", "s", "60");
+    QCommandLineOption epochsOption(QStringList() << "epochs", "写入指定个数的历元后结束", "n", "0");
+    QCommandLineOption reportOption(QStringList() << "report", "中间报告的间隔（秒，0 表示不输出）", "s", "60");
+    QCommandLineOption maxLossOption(QStringList() << "max-loss", "允许丢失的语句数", "n", "0");
+    QCommandLineOption maxP99Option(QStringList() << "max-p99-ms", "p99 延迟上限（毫秒）", "ms", "50");
+    QCommandLineOption maxLatencyOption(QStringList() << "max-latency-ms", "最大延迟上限（毫秒）", "ms", "500");
+    parser.addOption(baudOption);
+    parser.addOption(rateOption);
+    parser.addOption(satellitesOption);
+    parser.addOption(systemsOption);
+    parser.addOption(corruptOption);
+    parser.addOption(seedOption);
+    parser.addOption(secondsOption);
+    parser.addOption(epochsOption);
+    parser.addOption(reportOption);
+    parser.addOption(maxLossOption);
+    parser.addOption(maxP99Option);
+    parser.addOption(maxLatencyOption);
+    parser.process(app);
+
+    // 串口、解析器和转发服务每个数据块、每条语句都有调试输出，浸泡测试时关闭
+    QLoggingCategory::setFilterRules("default.debug=false");
+
+    QTextStream err(stderr);
+    err.setCodec("UTF-8");
+
+    GeneratorConfig config;
+    config.rateHz = qBound(1.0, parser.value(rateOption).toDouble(), 100.0);
+    config.satellites = parser.value(satellitesOption).toInt();
+    config.talkers = parser.value(systemsOption).split(',', Qt::SkipEmptyParts);
+    config.corruptRate = qBound(0.0, parser.value(corruptOption).toDouble(), 1.0);
+    config.seed = parser.value(seedOption).toUInt();
+
+    const int baud = parser.value(baudOption).toInt();
+    const double byteRate = baud / 10.0;
+    const qint64 maxEpochs = parser.value(epochsOption).toLongLong();
+    const qint64 writeMs = maxEpochs > 0 ? 0 : parser.value(secondsOption).toLongLong() * 1000;
+    const qint64 maxLoss = parser.value(maxLossOption).toLongLong();
+    const double maxP99Ms = parser.value(maxP99Option).toDouble();
+    const double maxLatencyMs = parser.value(maxLatencyOption).toDouble();
+
+    // 先估算数据速率：超过线路带宽时结果没有意义（写入端会丢历元）
+    NMEAGenerator probe(config);
+    const double epochBytes = probe.nextEpoch().size();
+    const double load = byteRate > 0.0 ? epochBytes * config.rateHz / byteRate : 0.0;
+    err << QString("%1 波特，%2 Hz，%3 颗卫星，每历元约 %4 字节，线路占用 %5%\n")
+               .arg(baud).arg(config.rateHz).arg(probe.satelliteCount()).arg(epochBytes, 0, 'f', 0)
+               .arg(load * 100.0, 0, 'f', 1);
+    if (load > 1.0) {
+        err << "警告: 数据速率超过波特率，写入端会丢弃历元，测试将判定失败\n";
+    }
+
+    PseudoTerminal pty;
+    QString error;
+    if (!pty.open(&error)) {
+        err << error << '\n';
+        return 2;
+    }
+
+    // 接收端：与图形界面相同的 ReceiverManager → ReceiverPipeline 路径，串口是伪终端从设备
+    ReceiverManager receivers;
+    qint64 serialErrors = 0;
+    bool opened = false;
+    QObject::connect(&receivers, &ReceiverManager::statusChanged, [&](int, bool open, const QString &message) {
+        // 第一次打开之后的任何状态变化（错误、断开）都计为串口错误
+        if (open && !opened) {
+            opened = true;
+            return;
+        }
+        ++serialErrors;
+        err << "串口错误: " << message << '\n';
+        err.flush();
+    });
+    const int receiverId = receivers.addReceiver(ReceiverSource(pty.slavePath(), baud));
+    const ReceiverPipeline *pipeline = receivers.receiver(receiverId);
+    QElapsedTimer openClock;
+    openClock.start();
+    while (!opened && serialErrors == 0 && openClock.elapsed() < 5000) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    if (!opened) {
+        err << "无法打开伪终端从设备 " << pty.slavePath() << '\n';
+        return 2;
+    }
+    receivers.setActiveReceiver(receiverId);
+
+    // 转发：一个本地套接字客户端在主线程中读取，统计服务器端每个客户端的队列
+    const QString broadcastName = QString("nmea-soak-%1").arg(QCoreApplication::applicationPid());
+    if (!receivers.startBroadcast(receiverId, 0, broadcastName, &error)) {
+        err << error << '\n';
+        return 2;
+    }
+    const BroadcastServer *broadcast = receivers.broadcastServer(receiverId);
+    QLocalSocket broadcastClient;
+    qint64 broadcastBytes = 0;
+    QObject::connect(&broadcastClient, &QLocalSocket::readyRead, [&]() {
+        broadcastBytes += broadcastClient.skip(broadcastClient.bytesAvailable());
+    });
+    broadcastClient.connectToServer(broadcast->localName());
+    openClock.restart();
+    while (broadcast->clientCount() == 0 && openClock.elapsed() < 5000) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    if (broadcast->clientCount() == 0) {
+        err << "无法连接转发服务 " << broadcast->localName() << '\n';
+        return 2;
+    }
+
+    std::unique_ptr<SoakShared> shared(new SoakShared);
+    for (std::atomic<qint64> &stamp : shared->stamps) {
+        stamp.store(0, std::memory_order_relaxed);
+    }
+
+    QElapsedTimer clock;
+    clock.start();
+
+    LatencyHistogram latency;
+    LatencyHistogram intervalLatency;
+    qint64 parsedEpochs = 0;
+    qint64 lastEpoch = -1;
+    qint64 missingEpochs = 0;
+    qint64 staleStamps = 0;
+
+    // 延迟：写入结束该历元的字节（下一个历元的第一条语句）→ 主线程收到这个历元，
+    // 包含流水线线程到主线程的排队时间，即图形界面看到的延迟
+    QObject::connect(&receivers, &ReceiverManager::epochCompleted, [&](int, const SatelliteData &data) {
+        ++parsedEpochs;
+        const qint64 index = epochIndex(data, config);
+        if (index < 0) {
+            return;
+        }
+        if (config.corruptRate == 0.0 && lastEpoch >= 0 && index > lastEpoch + 1) {
+            missingEpochs += index - lastEpoch - 1;
+        }
+        lastEpoch = index;
+
+        const qint64 nowNs = clock.nsecsElapsed();
+        const qint64 stampNs = shared->stamps[index % kStampSlots].load(std::memory_order_acquire);
+        if (stampNs <= 0 || nowNs - stampNs > qint64(kStampSlots / config.rateHz * 1e9)) {
+            ++staleStamps;
+            return;
+        }
+        latency.add(nowNs - stampNs);
+        intervalLatency.add(nowNs - stampNs);
+    });
+
+    QThread *writer = QThread::create(runWriter, std::ref(*shared), std::ref(pty), config, byteRate,
+                                      maxEpochs, std::cref(clock));
+    writer->start();
+
+    // 完好语句 = 分帧出的语句 - 校验和错误；期望收到的 = 完整写入的语句 - 被故意破坏的语句
+    auto goodSentences = [&]() {
+        return pipeline->sentenceCount() - pipeline->checksumErrors();
+    };
+    auto lostSentences = [&]() {
+        return shared->sentences.load() - shared->corruptedTotal() - goodSentences();
+    };
+
+    // 写入结束后等待流水线读完伪终端中剩余的数据、主线程处理完排队的历元，最多等 5 秒
+    qint64 finishedAtMs = -1;
+    QTimer monitor;
+    monitor.setInterval(50);
+    QObject::connect(&monitor, &QTimer::timeout, [&]() {
+        if (writeMs > 0 && clock.elapsed() >= writeMs) {
+            shared->stop.store(true);
+        }
+        if (!shared->finished.load(std::memory_order_acquire)) {
+            return;
+        }
+        if (finishedAtMs < 0) {
+            finishedAtMs = clock.elapsed();
+        }
+        const bool drained = pipeline->byteCount() >= shared->writtenBytes.load() && pipeline->queuedEpochs() == 0;
+        if (drained || clock.elapsed() - finishedAtMs > 5000) {
+            app.quit();
+        }
+    });
+    monitor.start();
+
+    QTimer reporter;
+    const int reportSeconds = parser.value(reportOption).toInt();
+    if (reportSeconds > 0) {
+        reporter.setInterval(reportSeconds * 1000);
+        QObject::connect(&reporter, &QTimer::timeout, [&]() {
+            err << QString("[%1 s] 历元 %2，语句 %3（在途 %4），成帧错误 %5，校验错误 %6，内核队列最高 %7 字节，"
+                           "历元队列最高 %8 个，转发队列最高 %9 字节，延迟 %10\n")
+                       .arg(clock.elapsed() / 1000).arg(shared->epochs.load()).arg(goodSentences())
+                       .arg(qMax<qint64>(0, lostSentences())).arg(pipeline->droppedSentences())
+                       .arg(pipeline->checksumErrors()).arg(shared->kernelHighWater.load())
+                       .arg(pipeline->queuedEpochsHighWater()).arg(broadcast->queueHighWater())
+                       .arg(intervalLatency.summary());
+            err.flush();
+            intervalLatency.reset();
+        });
+        reporter.start();
+    }
+
+    app.exec();
+    shared->stop.store(true);
+    writer->wait();
+    delete writer;
+
+    // 流水线在移除时删除，先取出统计
+    const double seconds = clock.elapsed() / 1000.0;
+    const qint64 lost = lostSentences();
+    const qint64 receivedBytes = pipeline->byteCount();
+    const qint64 framingErrors = pipeline->droppedSentences();
+    const qint64 checksumErrors = pipeline->checksumErrors();
+    const int queueHighWater = pipeline->queuedEpochsHighWater();
+    const qint64 broadcastSent = broadcast->sentBytes();
+    const qint64 broadcastDropped = broadcast->droppedBytes();
+    const qint64 broadcastHighWater = broadcast->queueHighWater();
+    broadcastClient.abort();
+    receivers.removeAll();
+
+    // 各种破坏方式产生的错误：改字符恰好产生一个校验错误；插入不可打印字节产生一个成帧错误；
+    // 截断在下一条语句的 '$' 到达时产生一个成帧错误，但截断在第 1 个字符（只剩 "$"）时不产生错误，
+    // 所以成帧错误只能与截断数 + 插入数的上限比较，这些语句的丢失由上面的丢失语句数检查
+    const qint64 flipped = shared->corrupted[NMEAGenerator::FlipCharacter].load();
+    const qint64 truncated = shared->corrupted[NMEAGenerator::Truncate].load();
+    const qint64 inserted = shared->corrupted[NMEAGenerator::InsertGarbage].load();
+    const qint64 unexpectedChecksum = qMax<qint64>(0, checksumErrors - flipped);
+    const qint64 unexpectedFraming = qMax<qint64>(0, framingErrors - truncated - inserted);
+    const qint64 dropped = shared->droppedEpochs.load();
+
+    err << QString("运行 %1 s，写入 %2 个历元、%3 字节，收到 %4 字节（%5 字节/秒）\n")
+               .arg(seconds, 0, 'f', 1).arg(shared->epochs.load()).arg(shared->writtenBytes.load())
+               .arg(receivedBytes).arg(seconds > 0 ? receivedBytes / seconds : 0.0, 0, 'f', 0);
+    err << QString("语句: 写入 %1（故意破坏 %2：改字符 %3，截断 %4，插入字节 %5），完好收到 %6，丢失 %7，主线程收到 %8 个历元\n")
+               .arg(shared->sentences.load()).arg(shared->corruptedTotal()).arg(flipped).arg(truncated)
+               .arg(inserted).arg(goodSentences()).arg(lost).arg(parsedEpochs);
+    err << QString("成帧错误 %1，校验错误 %2，缺失历元 %3，写入端丢弃历元 %4，串口错误 %5\n")
+               .arg(framingErrors).arg(checksumErrors).arg(missingEpochs).arg(dropped).arg(serialErrors);
+    err << QString("最高水位: 写入端积压 %1 字节，伪终端内核队列 %2 字节，流水线→主线程历元队列 %3 个，转发客户端队列 %4 字节\n")
+               .arg(shared->backlogHighWater.load()).arg(shared->kernelHighWater.load())
+               .arg(queueHighWater).arg(broadcastHighWater);
+    err << QString("转发: 服务器发送 %1 字节，丢弃 %2 字节，客户端收到 %3 字节\n")
+               .arg(broadcastSent).arg(broadcastDropped).arg(broadcastBytes);
+    err << "端到端延迟: " << latency.summary() << '\n';
+    if (staleStamps > 0) {
+        err << QString("%1 个历元缺少写入时间戳（接收端落后过多），未计入延迟\n").arg(staleStamps);
+    }
+
+    // 判定
+    QStringList failures;
+    if (shared->writeFailed.load()) {
+        failures << "写入伪终端失败";
+    }
+    if (lost > maxLoss) {
+        failures << QString("丢失 %1 条语句（上限 %2）").arg(lost).arg(maxLoss);
+    }
+    if (unexpectedChecksum > 0) {
+        failures << QString("%1 个校验错误不是生成器故意改字符造成的").arg(unexpectedChecksum);
+    }
+    if (unexpectedFraming > 0) {
+        failures << QString("%1 个成帧错误不是生成器故意截断或插入字节造成的").arg(unexpectedFraming);
+    }
+    if (dropped > 0) {
+        failures << QString("写入端因带宽不足丢弃 %1 个历元").arg(dropped);
+    }
+    if (serialErrors > 0) {
+        failures << QString("串口错误 %1 次").arg(serialErrors);
+    }
+    if (broadcastDropped > 0) {
+        failures << QString("转发客户端跟不上，丢弃 %1 字节").arg(broadcastDropped);
+    }
+    if (latency.count() == 0) {
+        failures << "没有延迟样本";
+    } else if (latency.percentileMs(99) > maxP99Ms) {
+        failures << QString("p99 延迟 %1 ms（上限 %2 ms）").arg(latency.percentileMs(99), 0, 'f', 2).arg(maxP99Ms);
+    }
+    if (latency.maxMs() > maxLatencyMs) {
+        failures << QString("最大延迟 %1 ms（上限 %2 ms）").arg(latency.maxMs(), 0, 'f', 2).arg(maxLatencyMs);
+    }
+
+    if (failures.isEmpty()) {
+        err << "PASS\n";
+        return 0;
+    }
+    for (const QString &failure : failures) {
+        err << "FAIL: " << failure << '\n';
+    }
+    return 1;
+}
@@ -0,0 +1,14 @@
+# 接收路径浸泡测试：伪终端 + 接收流水线（串口 → 分帧 → 解析）+ 转发服务，长时间统计丢失、错误、缓冲区和队列水位、延迟
+QT = core serialport network
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+TARGET = nmea-soak
+TEMPLATE = app
+
+# 生成器、伪终端、接收流水线和转发服务在 nmeacore 静态库中
+include(../core/nmeacore.pri)
+
+# 源文件
+SOURCES += \
+    main.cpp
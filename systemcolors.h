@@ -0,0 +1,27 @@
+#ifndef SYSTEMCOLORS_H
+#define SYSTEMCOLORS_H
+
+#include <QString>
+#include <QColor>
+
+// 卫星系统颜色定义（解析核心 satellitedata.h 只依赖 QtCore，显示用的颜色放在界面这一侧）
+class SatelliteSystemColors {
+public:
+    static QColor getSystemColor(const QString &system) {
+        if (system == "GPS") return QColor(0, 100, 200);      // 蓝色
+        else if (system == "BDS") return QColor(255, 140, 0);  // 橙色
+        else if (system == "GLN") return QColor(0, 150, 0);   // 绿色
+        else if (system == "GAL") return QColor(150, 0, 150); // 紫色
+        else return QColor(128, 128, 128);                    // 灰色
+    }
+    
+    static QString getSystemName(const QString &system) {
+        if (system == "GPS") return "GPS";
+        else if (system == "BDS") return "北斗";
+        else if (system == "GLN") return "格洛纳斯";
+        else if (system == "GAL") return "伽利略";
+        else return "其他";
+    }
+};
+
+#endif // SYSTEMCOLORS_H
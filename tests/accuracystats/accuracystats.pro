@@ -0,0 +1,12 @@
+# 定位精度统计测试
+QT = core testlib
+CONFIG += console c++17 testcase
+CONFIG -= app_bundle
+
+TARGET = tst_accuracystats
+TEMPLATE = app
+
+include(../../core/nmeacore.pri)
+
+SOURCES += \
+    tst_accuracystats.cpp
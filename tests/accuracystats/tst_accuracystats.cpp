@@ -0,0 +1,73 @@
+#include <QtTest>
+#include "accuracystats.h"
+
+// 平均位置模式：第二遍之后 CEP 和垂直分位数相对最终的平均位置，而不是运行中的平均位置
+class TestAccuracyStatistics : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void meanPassUsesFinalMean();
+    void referenceNeedsNoPass();
+};
+
+// 前一半定位在北边 dLat，后一半在南边：相对最终平均位置每个定位的误差都相同
+static void addTwoClusters(AccuracyStatistics &statistics, bool meanPass)
+{
+    const double latitude = 31.0;
+    const double longitude = 121.0;
+    const double dLat = 1e-5;          // 约 1.1 米
+    for (int i = 0; i < 200; ++i) {
+        const double lat = i < 100 ? latitude + dLat : latitude - dLat;
+        if (meanPass) {
+            statistics.addMeanPassFix(lat, longitude, 10.0, 4);
+        } else {
+            statistics.addFix(lat, longitude, 10.0, 4);
+        }
+    }
+}
+
+void TestAccuracyStatistics::meanPassUsesFinalMean()
+{
+    AccuracyStatistics statistics;
+    addTwoClusters(statistics, false);
+    QVERIFY(statistics.needsMeanPass());
+
+    // 运行中的平均位置：前 100 个定位误差为 0，CEP50 明显偏离
+    const AccuracyResult running = statistics.result(4);
+    const double error = qAbs(running.meanNorth);
+    QVERIFY(error > 1.0);
+    QVERIFY(qAbs(running.cep50 - error) > 0.1);
+
+    statistics.beginMeanPass();
+    addTwoClusters(statistics, true);
+    QVERIFY(!statistics.needsMeanPass());
+
+    const AccuracyResult result = statistics.result(4);
+    QCOMPARE(result.count, quint64(200));
+    QVERIFY(qAbs(result.cep50 - error) < 1e-6);
+    QVERIFY(qAbs(result.cep95 - error) < 1e-6);
+    QVERIFY(result.vertical95 < 1e-6);
+    QVERIFY(qAbs(statistics.result(-1).cep50 - error) < 1e-6);
+
+    // 新的定位使第二遍过期
+    statistics.addFix(31.0, 121.0, 10.0, 4);
+    QVERIFY(statistics.needsMeanPass());
+}
+
+void TestAccuracyStatistics::referenceNeedsNoPass()
+{
+    AccuracyStatistics statistics;
+    statistics.setReference(31.0, 121.0, 10.0);
+    addTwoClusters(statistics, false);
+    QVERIFY(!statistics.needsMeanPass());
+
+    // 相对参考点：每个定位的误差都是 dLat 对应的距离
+    const AccuracyResult result = statistics.result(4);
+    QVERIFY(result.cep50 > 1.0 && result.cep50 < 1.2);
+    QVERIFY(qAbs(result.cep95 - result.cep50) < 1e-6);
+}
+
+QTEST_APPLESS_MAIN(TestAccuracyStatistics)
+
+#include "tst_accuracystats.moc"
@@ -0,0 +1,12 @@
+# 异常检测测试：各检测器的事件，以及所有检测器每历元合计不超过 50 微秒（release 构建）
+QT = core testlib
+CONFIG += console c++17 testcase
+CONFIG -= app_bundle
+
+TARGET = tst_anomalydetector
+TEMPLATE = app
+
+include(../../core/nmeacore.pri)
+
+SOURCES += \
+    tst_anomalydetector.cpp
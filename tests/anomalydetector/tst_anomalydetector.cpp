@@ -0,0 +1,332 @@
+#include <QtTest>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <algorithm>
+#include "anomalydetector.h"
+#include "nmeagenerator.h"
+#include "nmeaparser.h"
+
+// 每个检测器用手工构造的历元序列检查报告的事件；
+// 耗时用生成器合成的历元测量，p99 必须在每历元 50 微秒的预算之内（只在 release 构建中检查）
+class TestAnomalyDetector : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void positionJump();
+    void fixDegraded();
+    void signalDrop();
+    void signalDropBelowThreshold();
+    void timeGap();
+    void midnightRollover();
+    void checksumBurst();
+    void checksumCounterReset();
+    void epochBudget_data();
+    void epochBudget();
+
+private:
+    // 第 index 秒的历元：静止单点定位，8 颗 GPS 卫星信噪比相同，northMetres 为向北的偏移
+    static SatelliteData makeEpoch(int index, double northMetres = 0.0, int snr = 45);
+    static QVector<AnomalyEvent> eventsOf(const AnomalyMonitor &monitor, AnomalyEvent::Type type);
+};
+
+static const qint64 kStartMs = 10 * 3600 * 1000;    // 10:00:00
+static const double kMetresPerDegree = 111320.0;
+
+SatelliteData TestAnomalyDetector::makeEpoch(int index, double northMetres, int snr)
+{
+    SatelliteData data;
+    data.utcTimeMs = kStartMs + index * 1000;
+    data.latitude = 31.0 + northMetres / kMetresPerDegree;
+    data.longitude = 121.0;
+    data.altitude = 10.0;
+    data.fixQuality = 1;
+    for (int id = 1; id <= 8; ++id) {
+        SatelliteInfo satellite;
+        satellite.id = id;
+        satellite.system = "GPS";
+        satellite.snr = snr;
+        satellite.elevation = 45;
+        satellite.used = true;
+        data.satellites.append(satellite);
+    }
+    return data;
+}
+
+QVector<AnomalyEvent> TestAnomalyDetector::eventsOf(const AnomalyMonitor &monitor, AnomalyEvent::Type type)
+{
+    QVector<AnomalyEvent> result;
+    for (const AnomalyEvent &event : monitor.events()) {
+        if (event.type == type) {
+            result.append(event);
+        }
+    }
+    return result;
+}
+
+void TestAnomalyDetector::initTestCase()
+{
+    // 解析器每条语句都有调试输出
+    QLoggingCategory::setFilterRules("default.debug=false");
+}
+
+void TestAnomalyDetector::positionJump()
+{
+    AnomalyMonitor monitor;
+    int index = 0;
+    for (; index < 20; ++index) {
+        monitor.addEpoch(makeEpoch(index));
+    }
+    // 5 米的移动低于 10 米的最小门限
+    monitor.addEpoch(makeEpoch(index++, 5.0));
+    QCOMPARE(monitor.totalCount(), 0);
+
+    // 跳变 100 米只报告一次，之后停在新位置不再报告
+    const qint64 jumpTimeMs = kStartMs + index * 1000;
+    monitor.addEpoch(makeEpoch(index++, 105.0));
+    for (int i = 0; i < 10; ++i) {
+        monitor.addEpoch(makeEpoch(index++, 105.0));
+    }
+
+    const QVector<AnomalyEvent> jumps = eventsOf(monitor, AnomalyEvent::PositionJump);
+    QCOMPARE(jumps.size(), 1);
+    QCOMPARE(jumps[0].timeMs, jumpTimeMs);
+    QVERIFY2(qAbs(jumps[0].value - 100.0) < 1.0, qPrintable(QString::number(jumps[0].value)));
+    QCOMPARE(monitor.totalCount(), 1);
+}
+
+void TestAnomalyDetector::fixDegraded()
+{
+    // RTK固定 > RTK浮点 > 差分 = PPS > 单点 > 推算 > 无定位；只有等级降低时报告
+    const int qualities[] = {1, 2, 3, 4, 5, 4, 1, 6, 0, 1};
+    AnomalyMonitor monitor;
+    int index = 0;
+    for (int quality : qualities) {
+        SatelliteData data = makeEpoch(index++);
+        data.fixQuality = quality;
+        monitor.addEpoch(data);
+    }
+
+    const QVector<AnomalyEvent> events = eventsOf(monitor, AnomalyEvent::FixDegraded);
+    QCOMPARE(events.size(), 4);
+    QCOMPARE(events[0].value, 5.0);
+    QCOMPARE(events[0].timeMs, kStartMs + 4 * 1000);
+    QCOMPARE(events[1].value, 1.0);
+    QCOMPARE(events[2].value, 6.0);
+    QCOMPARE(events[3].value, 0.0);
+    QCOMPARE(monitor.totalCount(), 4);
+}
+
+void TestAnomalyDetector::signalDrop()
+{
+    AnomalyMonitor monitor;
+    int index = 0;
+    for (; index < 20; ++index) {
+        monitor.addEpoch(makeEpoch(index));
+    }
+
+    // 所有卫星同时下降 10 dB：只在开始时报告一次
+    const qint64 dropTimeMs = kStartMs + index * 1000;
+    for (int i = 0; i < 5; ++i) {
+        monitor.addEpoch(makeEpoch(index++, 0.0, 35));
+    }
+    // 部分恢复（仍低于基线 3 dB 以上）不算结束
+    monitor.addEpoch(makeEpoch(index++, 0.0, 40));
+    monitor.addEpoch(makeEpoch(index++, 0.0, 35));
+    QCOMPARE(eventsOf(monitor, AnomalyEvent::SignalDrop).size(), 1);
+
+    // 恢复到基线之后再次下降，重新报告
+    for (int i = 0; i < 5; ++i) {
+        monitor.addEpoch(makeEpoch(index++));
+    }
+    const qint64 secondDropTimeMs = kStartMs + index * 1000;
+    monitor.addEpoch(makeEpoch(index++, 0.0, 35));
+
+    const QVector<AnomalyEvent> events = eventsOf(monitor, AnomalyEvent::SignalDrop);
+    QCOMPARE(events.size(), 2);
+    QCOMPARE(events[0].timeMs, dropTimeMs);
+    QCOMPARE(events[0].value, 10.0);
+    QCOMPARE(events[1].timeMs, secondDropTimeMs);
+    QCOMPARE(events[1].value, 10.0);
+    QCOMPARE(monitor.totalCount(), 2);
+}
+
+void TestAnomalyDetector::signalDropBelowThreshold()
+{
+    AnomalyMonitor monitor;
+    int index = 0;
+    for (; index < 20; ++index) {
+        monitor.addEpoch(makeEpoch(index));
+    }
+    // 每颗卫星都下降了 4 dB，但平均下降不到 6 dB
+    for (int i = 0; i < 5; ++i) {
+        monitor.addEpoch(makeEpoch(index++, 0.0, 41));
+    }
+    // 刚开始的历元没有基线，不参与比较
+    AnomalyMonitor fresh;
+    for (int i = 0; i < 5; ++i) {
+        fresh.addEpoch(makeEpoch(i, 0.0, i < 3 ? 45 : 20));
+    }
+
+    QCOMPARE(monitor.totalCount(), 0);
+    QCOMPARE(fresh.totalCount(), 0);
+}
+
+void TestAnomalyDetector::timeGap()
+{
+    AnomalyMonitor monitor;
+    int index = 0;
+    for (; index < 10; ++index) {
+        monitor.addEpoch(makeEpoch(index));
+    }
+    // 重复上一历元的时间，然后倒退 1 秒，再回到正常
+    monitor.addEpoch(makeEpoch(9));
+    monitor.addEpoch(makeEpoch(8));
+    monitor.addEpoch(makeEpoch(9));
+    monitor.addEpoch(makeEpoch(10));
+    // 间隔 2 秒不到门限（正常间隔的 2.5 倍），间隔 5 秒报告
+    monitor.addEpoch(makeEpoch(12));
+    monitor.addEpoch(makeEpoch(17));
+    monitor.addEpoch(makeEpoch(18));
+
+    const QVector<AnomalyEvent> events = eventsOf(monitor, AnomalyEvent::TimeGap);
+    QCOMPARE(events.size(), 3);
+    QCOMPARE(events[0].timeMs, kStartMs + 9 * 1000);
+    QCOMPARE(events[0].value, 0.0);
+    QCOMPARE(events[1].timeMs, kStartMs + 8 * 1000);
+    QCOMPARE(events[1].value, -1.0);
+    QCOMPARE(events[2].timeMs, kStartMs + 17 * 1000);
+    QCOMPARE(events[2].value, 5.0);
+    QCOMPARE(monitor.totalCount(), 3);
+}
+
+void TestAnomalyDetector::midnightRollover()
+{
+    // 没有日期时时间为当天毫秒数：23:59:55 之后的 00:00:00 是正常的下一秒
+    const qint64 dayMs = 24 * 3600 * 1000;
+    const qint64 times[] = {dayMs - 5000, dayMs - 4000, dayMs - 3000, dayMs - 2000, dayMs - 1000,
+                            0, 1000, 2000, 8000};
+    AnomalyMonitor monitor;
+    for (qint64 timeMs : times) {
+        SatelliteData data = makeEpoch(0);
+        data.utcTimeMs = timeMs;
+        monitor.addEpoch(data);
+    }
+
+    // 只有 00:00:02 → 00:00:08 的间隔报告
+    const QVector<AnomalyEvent> events = eventsOf(monitor, AnomalyEvent::TimeGap);
+    QCOMPARE(events.size(), 1);
+    QCOMPARE(events[0].timeMs, qint64(8000));
+    QCOMPARE(events[0].value, 6.0);
+    QCOMPARE(monitor.totalCount(), 1);
+}
+
+void TestAnomalyDetector::checksumBurst()
+{
+    // 每个历元新增的校验和错误数；窗口为 10 个历元，3 条报告
+    const int increments[] = {0, 0, 0, 0, 0, 1, 1, 1, 2, 0, 0, 0, 3,
+                              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3};
+    AnomalyMonitor monitor;
+    QVector<int> reportedAt;
+    int cumulative = 0;
+    int index = 0;
+    for (int errors : increments) {
+        cumulative += errors;
+        SatelliteData data = makeEpoch(index);
+        data.checksumErrors = cumulative;
+        if (monitor.addEpoch(data) > 0) {
+            reportedAt.append(index);
+        }
+        ++index;
+    }
+
+    // 第 7 个历元达到 3 条；第 12 个历元仍在同一次集中出现里；
+    // 第 22 个历元窗口内没有错误，复位后第 23 个历元重新报告
+    QCOMPARE(reportedAt, QVector<int>({7, 23}));
+    const QVector<AnomalyEvent> events = eventsOf(monitor, AnomalyEvent::ChecksumBurst);
+    QCOMPARE(events.size(), 2);
+    QCOMPARE(events[0].value, 3.0);
+    QCOMPARE(events[1].value, 3.0);
+}
+
+void TestAnomalyDetector::checksumCounterReset()
+{
+    // 解析器重置后累计数从 0 重新开始：新的计数就是新增的错误数
+    const int cumulative[] = {0, 0, 0, 2, 2, 1, 1};
+    AnomalyMonitor monitor;
+    int index = 0;
+    for (int errors : cumulative) {
+        SatelliteData data = makeEpoch(index++);
+        data.checksumErrors = errors;
+        monitor.addEpoch(data);
+    }
+
+    const QVector<AnomalyEvent> events = eventsOf(monitor, AnomalyEvent::ChecksumBurst);
+    QCOMPARE(events.size(), 1);
+    QCOMPARE(events[0].timeMs, kStartMs + 5 * 1000);
+    QCOMPARE(events[0].value, 3.0);
+}
+
+void TestAnomalyDetector::epochBudget_data()
+{
+    QTest::addColumn<int>("satellites");
+    QTest::addColumn<double>("corruptRate");
+
+    QTest::newRow("40 satellites") << 40 << 0.0;
+    QTest::newRow("150 satellites") << 150 << 0.0;
+    QTest::newRow("150 satellites, corrupted") << 150 << 0.01;
+}
+
+void TestAnomalyDetector::epochBudget()
+{
+    // debug 构建和带检查工具的构建慢得多，耗时没有意义
+#ifndef QT_NO_DEBUG
+    QSKIP("耗时预算只在 release 构建中检查");
+#endif
+    QFETCH(int, satellites);
+    QFETCH(double, corruptRate);
+
+    GeneratorConfig config;
+    config.rateHz = 10.0;
+    config.satellites = satellites;
+    config.talkers = QStringList() << "GP" << "GL" << "GA" << "GB" << "GQ";
+    config.corruptRate = corruptRate;
+    NMEAGenerator generator(config);
+
+    QVector<SatelliteData> epochs;
+    NMEAParser parser;
+    connect(&parser, &NMEAParser::epochCompleted, [&epochs](const SatelliteData &data) {
+        epochs.append(data);
+    });
+    for (int i = 0; i < 5000; ++i) {
+        for (const QByteArray &line : generator.nextEpoch().split('\n')) {
+            parser.parseNMEASentence(QString::fromLatin1(line.trimmed()));
+        }
+    }
+    parser.flushEpoch();
+    QVERIFY(epochs.size() > 4900);
+
+    AnomalyMonitor monitor;
+    QVector<qint64> costs;
+    costs.reserve(epochs.size());
+    QElapsedTimer timer;
+    for (const SatelliteData &data : epochs) {
+        timer.start();
+        monitor.addEpoch(data);
+        costs.append(timer.nsecsElapsed());
+    }
+
+    std::sort(costs.begin(), costs.end());
+    const double p99Us = costs[costs.size() * 99 / 100] / 1000.0;
+    qInfo("%d 个历元：平均 %.2f µs，p99 %.2f µs，最大 %.2f µs", epochs.size(),
+          monitor.averageCostUs(), p99Us, monitor.maxCostUs());
+
+    QVERIFY2(p99Us < AnomalyMonitor::EpochBudgetNs / 1000.0,
+             qPrintable(QString("p99 %1 µs 超过预算").arg(p99Us)));
+    QVERIFY(monitor.averageCostUs() < AnomalyMonitor::EpochBudgetNs / 1000.0);
+}
+
+QTEST_APPLESS_MAIN(TestAnomalyDetector)
+
+#include "tst_anomalydetector.moc"
@@ -0,0 +1,12 @@
+# 分帧器的语句切分和原始字节转发测试
+QT = core testlib
+CONFIG += console c++17 testcase
+CONFIG -= app_bundle
+
+TARGET = tst_nmeaframer
+TEMPLATE = app
+
+include(../../core/nmeacore.pri)
+
+SOURCES += \
+    tst_nmeaframer.cpp
@@ -0,0 +1,59 @@
+#include <QtTest>
+#include "nmeaframer.h"
+
+// 原始字节转发：只含完整语句的输入按块送进分帧器，转发出的字节拼起来应与输入相同
+class TestNMEAFramer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void forwardsRawUnchanged_data();
+    void forwardsRawUnchanged();
+};
+
+void TestNMEAFramer::forwardsRawUnchanged_data()
+{
+    QTest::addColumn<QList<QByteArray>>("chunks");
+    QTest::addColumn<QStringList>("expected");
+
+    QTest::newRow("single block")
+        << QList<QByteArray>{"$A*00\r\n$B*00\r\n"}
+        << QStringList{"$A*00", "$B*00"};
+    QTest::newRow("split inside sentence")
+        << QList<QByteArray>{"$A*0", "0\r\n$B*00\r\n"}
+        << QStringList{"$A*00", "$B*00"};
+    // CR 在上一块末尾，LF 在下一块开头
+    QTest::newRow("split line end")
+        << QList<QByteArray>{"$A*00\r", "\n$B*00\r\n"}
+        << QStringList{"$A*00", "$B*00"};
+    QTest::newRow("split line end with empty read")
+        << QList<QByteArray>{"$A*00\r", "", "\n", "$B*00\r\n"}
+        << QStringList{"$A*00", "$B*00"};
+    QTest::newRow("bare LF")
+        << QList<QByteArray>{"$A*00\n$B*", "00\n"}
+        << QStringList{"$A*00", "$B*00"};
+}
+
+void TestNMEAFramer::forwardsRawUnchanged()
+{
+    QFETCH(QList<QByteArray>, chunks);
+    QFETCH(QStringList, expected);
+
+    NMEAFramer framer;
+    QByteArray input;
+    QByteArray forwarded;
+    QStringList sentences;
+    for (const QByteArray &chunk : chunks) {
+        QByteArray raw;
+        sentences += framer.append(chunk, &raw);
+        input += chunk;
+        forwarded += raw;
+    }
+
+    QCOMPARE(sentences, expected);
+    QCOMPARE(forwarded, input);
+}
+
+QTEST_APPLESS_MAIN(TestNMEAFramer)
+
+#include "tst_nmeaframer.moc"
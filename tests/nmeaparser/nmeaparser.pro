@@ -0,0 +1,12 @@
+# 解析器的历元划分和 GSV 卫星列表测试
+QT = core testlib
+CONFIG += console c++17 testcase
+CONFIG -= app_bundle
+
+TARGET = tst_nmeaparser
+TEMPLATE = app
+
+include(../../core/nmeacore.pri)
+
+SOURCES += \
+    tst_nmeaparser.cpp
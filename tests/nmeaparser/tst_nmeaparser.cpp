@@ -0,0 +1,96 @@
+#include <QtTest>
+#include "nmeaparser.h"
+
+// GSV 卫星列表：停止输出 GSV 的 talker 在几个输出间隔之后移除，输出得慢的 talker 保留
+class TestNMEAParser : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void expiresSilentTalker();
+    void keepsSlowTalker();
+
+private:
+    static QString sentence(const QString &body);
+    // 一个 1Hz 历元：GGA，然后是给出的 GSV
+    static void feedEpoch(NMEAParser &parser, int second, const QStringList &gsv);
+};
+
+QString TestNMEAParser::sentence(const QString &body)
+{
+    quint8 checksum = 0;
+    for (QChar ch : body) {
+        checksum ^= quint8(ch.toLatin1());
+    }
+    return QString("$%1*%2").arg(body).arg(int(checksum), 2, 16, QChar('0')).toUpper();
+}
+
+void TestNMEAParser::feedEpoch(NMEAParser &parser, int second, const QStringList &gsv)
+{
+    const QString time = QTime(8, 0).addSecs(second).toString("hhmmss") + ".00";
+    parser.parseNMEASentence(sentence("GPGGA," + time + ",3110.0000,N,12130.0000,E,1,08,1.0,10.0,M,0.0,M,,"));
+    for (const QString &body : gsv) {
+        parser.parseNMEASentence(sentence(body));
+    }
+}
+
+static const QString kGpsGsv = "GPGSV,1,1,01,05,45,120,40";
+static const QString kGlonassGsv = "GLGSV,1,1,01,70,30,200,35";
+
+void TestNMEAParser::expiresSilentTalker()
+{
+    NMEAParser parser;
+    QVector<int> counts;
+    connect(&parser, &NMEAParser::epochCompleted, [&](const SatelliteData &data) {
+        counts.append(data.satellites.size());
+    });
+
+    // GLONASS 只在前 3 个历元输出（间隔 1 个历元），之后只有 GPS
+    for (int second = 0; second < 15; ++second) {
+        QStringList gsv;
+        gsv << kGpsGsv;
+        if (second < 3) {
+            gsv << kGlonassGsv;
+        }
+        feedEpoch(parser, second, gsv);
+    }
+    parser.flushEpoch();
+
+    QCOMPARE(counts.size(), 15);
+    // 最后一组 GLONASS 在第 3 个历元，超过 5 个间隔（第 9 个历元开始时）移除
+    for (int i = 0; i < 8; ++i) {
+        QCOMPARE(counts[i], 2);
+    }
+    for (int i = 8; i < counts.size(); ++i) {
+        QCOMPARE(counts[i], 1);
+    }
+}
+
+void TestNMEAParser::keepsSlowTalker()
+{
+    NMEAParser parser;
+    QVector<int> counts;
+    connect(&parser, &NMEAParser::epochCompleted, [&](const SatelliteData &data) {
+        counts.append(data.satellites.size());
+    });
+
+    // GPS 每个历元都有 GSV，GLONASS 每 4 个历元一组
+    for (int second = 0; second < 40; ++second) {
+        QStringList gsv;
+        gsv << kGpsGsv;
+        if (second % 4 == 0) {
+            gsv << kGlonassGsv;
+        }
+        feedEpoch(parser, second, gsv);
+    }
+    parser.flushEpoch();
+
+    QCOMPARE(counts.size(), 40);
+    for (int count : counts) {
+        QCOMPARE(count, 2);
+    }
+}
+
+QTEST_APPLESS_MAIN(TestNMEAParser)
+
+#include "tst_nmeaparser.moc"
@@ -0,0 +1,12 @@
+# 语句登记表查找测试
+QT = core testlib
+CONFIG += console c++17 testcase
+CONFIG -= app_bundle
+
+TARGET = tst_sentenceschema
+TEMPLATE = app
+
+include(../../core/nmeacore.pri)
+
+SOURCES += \
+    tst_sentenceschema.cpp
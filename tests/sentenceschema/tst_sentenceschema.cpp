@@ -0,0 +1,55 @@
+#include <QtTest>
+#include "sentenceschema.h"
+
+// 登记表查找：标准语句不区分发送者标识，专有语句按完整地址，PUBX 按消息编号
+class TestSentenceSchema : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void find_data();
+    void find();
+};
+
+void TestSentenceSchema::find_data()
+{
+    QTest::addColumn<QString>("address");
+    QTest::addColumn<QString>("firstField");
+    QTest::addColumn<QString>("type");       // 空表示没有登记
+
+    QTest::newRow("GPGGA") << "GPGGA" << "083000.00" << "GGA";
+    QTest::newRow("GNRMC") << "GNRMC" << "083000.00" << "RMC";
+    QTest::newRow("BDGSV") << "BDGSV" << "3" << "GSV";
+    QTest::newRow("GAGSA") << "GAGSA" << "A" << "GSA";
+    QTest::newRow("GPZDA") << "GPZDA" << "083000.00" << "ZDA";
+    QTest::newRow("PQTMEPE") << "PQTMEPE" << "2" << "PQTMEPE";
+    QTest::newRow("PQTMVERNO") << "PQTMVERNO" << "LC29H" << "PQTMVERNO";
+    QTest::newRow("PUBX,00") << "PUBX" << "00" << "PUBX,00";
+    QTest::newRow("PUBX,03") << "PUBX" << "03" << "PUBX,03";
+    QTest::newRow("PUBX,04") << "PUBX" << "04" << "PUBX,04";
+    QTest::newRow("PUBX unknown") << "PUBX" << "41" << "";
+    QTest::newRow("unknown standard") << "GPXYZ" << "" << "";
+    QTest::newRow("unknown proprietary") << "PMTK" << "220" << "";
+    QTest::newRow("no talker") << "GGA" << "" << "";
+    QTest::newRow("too long") << "PABCDEFGHIJKLMNOPQRST" << "" << "";
+}
+
+void TestSentenceSchema::find()
+{
+    QFETCH(QString, address);
+    QFETCH(QString, firstField);
+    QFETCH(QString, type);
+
+    const SentenceSchema *schema = SentenceRegistry::find(address, firstField);
+    if (type.isEmpty()) {
+        QVERIFY(!schema);
+        return;
+    }
+    QVERIFY(schema);
+    QCOMPARE(QString::fromLatin1(schema->type), type);
+    QVERIFY(schema->fieldCount > 0);
+}
+
+QTEST_APPLESS_MAIN(TestSentenceSchema)
+
+#include "tst_sentenceschema.moc"
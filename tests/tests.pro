@@ -0,0 +1,9 @@
+# 单元测试：make check 运行
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    sentenceschema \
+    anomalydetector \
+    nmeaparser \
+    accuracystats \
+    nmeaframer
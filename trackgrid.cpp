@@ -0,0 +1,150 @@
+#include "trackgrid.h"
+#include "localframe.h"
+#include <algorithm>
+#include <cmath>
+
+// 初始网格边长约 1 厘米，静态测试的散点也能分开
+static const double kInitialCellSize = 1e-7;
+// 平均每格点数低于该值时网格加倍
+static const int kTargetOccupancy = 8;
+// 点数太少时不调整网格
+static const int kMinPointsForResize = 256;
+
+TrackGrid::TrackGrid()
+{
+    clear();
+}
+
+void TrackGrid::clear()
+{
+    m_cellSize = kInitialCellSize;
+    m_cells.clear();
+    m_indexed = 0;
+}
+
+qint64 TrackGrid::cellIndex(double value) const
+{
+    // qFloor 返回 int，网格很小时会溢出
+    return qint64(std::floor(value / m_cellSize));
+}
+
+quint64 TrackGrid::cellKey(qint64 cellX, qint64 cellY)
+{
+    return (quint64(cellX) << 32) ^ quint64(quint32(cellY));
+}
+
+void TrackGrid::insert(int index, const QPointF &point)
+{
+    m_cells[cellKey(cellIndex(point.x()), cellIndex(point.y()))].append(index);
+}
+
+void TrackGrid::append(const QVector<QPointF> &points)
+{
+    while (m_indexed < points.size()) {
+        insert(m_indexed, points[m_indexed]);
+        ++m_indexed;
+    }
+
+    if (m_indexed >= kMinPointsForResize && m_cells.size() * kTargetOccupancy > m_indexed) {
+        rebuild(points);
+    }
+}
+
+void TrackGrid::rebuild(const QVector<QPointF> &points)
+{
+    // 网格加倍直到平均占用达到目标；按点序重新插入，每格内的序号保持升序
+    do {
+        m_cellSize *= 2.0;
+        m_cells.clear();
+        for (int i = 0; i < m_indexed; ++i) {
+            insert(i, points[i]);
+        }
+    } while (m_cells.size() * kTargetOccupancy > m_indexed);
+}
+
+template <typename CellVisitor>
+void TrackGrid::visitCells(const QRectF &rect, CellVisitor visit) const
+{
+    const qint64 minX = cellIndex(rect.left());
+    const qint64 maxX = cellIndex(rect.right());
+    const qint64 minY = cellIndex(rect.top());
+    const qint64 maxY = cellIndex(rect.bottom());
+
+    // 查询范围覆盖的网格比非空网格还多时，改为遍历非空网格
+    const double covered = double(maxX - minX + 1) * double(maxY - minY + 1);
+    if (covered > m_cells.size()) {
+        for (auto it = m_cells.constBegin(); it != m_cells.constEnd(); ++it) {
+            const qint64 cellX = qint64(qint32(quint32(it.key() >> 32)));
+            const qint64 cellY = qint64(qint32(quint32(it.key())));
+            if (cellX >= minX && cellX <= maxX && cellY >= minY && cellY <= maxY) {
+                visit(cellX, cellY, it.value());
+            }
+        }
+        return;
+    }
+
+    for (qint64 cellX = minX; cellX <= maxX; ++cellX) {
+        for (qint64 cellY = minY; cellY <= maxY; ++cellY) {
+            auto it = m_cells.constFind(cellKey(cellX, cellY));
+            if (it != m_cells.constEnd()) {
+                visit(cellX, cellY, it.value());
+            }
+        }
+    }
+}
+
+QVector<int> TrackGrid::pointsInRect(const QVector<QPointF> &points, const QRectF &rect) const
+{
+    QVector<int> result;
+    if (m_indexed == 0 || rect.width() < 0.0 || rect.height() < 0.0) {
+        return result;
+    }
+
+    visitCells(rect, [&](qint64 cellX, qint64 cellY, const QVector<int> &cell) {
+        const QRectF cellRect(cellX * m_cellSize, cellY * m_cellSize, m_cellSize, m_cellSize);
+        if (rect.contains(cellRect)) {
+            result.append(cell);
+            return;
+        }
+        for (int index : cell) {
+            if (rect.contains(points[index])) {
+                result.append(index);
+            }
+        }
+    });
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+QVector<int> TrackGrid::pointsInRadius(const QVector<QPointF> &points, double latitude, double longitude,
+                                       double radiusMeters) const
+{
+    QVector<int> result;
+    if (m_indexed == 0 || radiusMeters < 0.0) {
+        return result;
+    }
+
+    // 以圆心为原点的局部坐标，先用外接矩形筛选网格
+    LocalFrame frame;
+    frame.setOrigin(latitude, longitude, 0.0);
+    double east = 0.0, north = 0.0, up = 0.0;
+    frame.toEnu(latitude + 1.0, longitude + 1.0, 0.0, east, north, up);
+    const double halfWidth = radiusMeters / qMax(east, 1e-9);
+    const double halfHeight = radiusMeters / north;
+    const QRectF bounds(longitude - halfWidth, latitude - halfHeight, 2.0 * halfWidth, 2.0 * halfHeight);
+    const double radiusSquared = radiusMeters * radiusMeters;
+
+    visitCells(bounds, [&](qint64, qint64, const QVector<int> &cell) {
+        for (int index : cell) {
+            const QPointF &point = points[index];
+            frame.toEnu(point.y(), point.x(), 0.0, east, north, up);
+            if (east * east + north * north <= radiusSquared) {
+                result.append(index);
+            }
+        }
+    });
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
@@ -0,0 +1,48 @@
+#ifndef TRACKGRID_H
+#define TRACKGRID_H
+
+#include <QVector>
+#include <QHash>
+#include <QPointF>
+#include <QRectF>
+
+// 轨迹点的均匀网格空间索引（x 为经度，y 为纬度，单位度）。
+// 点本身由调用者保存（按追加顺序的数组），索引只记录每个网格中的点序号。
+// 网格大小自适应：平均每格点数低于目标值时网格边长加倍并重建，
+// 重建次数为对数级，追加均摊 O(1)。
+// 矩形/圆形查询只访问与查询范围相交的非空网格，完全落在范围内的网格不再逐点判断。
+class TrackGrid
+{
+public:
+    TrackGrid();
+
+    void clear();
+
+    // points 为调用者保存的全部点，新点已追加在末尾
+    void append(const QVector<QPointF> &points);
+
+    // 矩形内的点序号（升序）
+    QVector<int> pointsInRect(const QVector<QPointF> &points, const QRectF &rect) const;
+
+    // 以 (纬度, 经度) 为圆心、半径为米的圆内的点序号（升序）
+    QVector<int> pointsInRadius(const QVector<QPointF> &points, double latitude, double longitude,
+                                double radiusMeters) const;
+
+    double cellSize() const { return m_cellSize; }
+    int cellCount() const { return m_cells.size(); }
+
+private:
+    qint64 cellIndex(double value) const;
+    static quint64 cellKey(qint64 cellX, qint64 cellY);
+    void insert(int index, const QPointF &point);
+    void rebuild(const QVector<QPointF> &points);
+
+    template <typename CellVisitor>
+    void visitCells(const QRectF &rect, CellVisitor visit) const;
+
+    double m_cellSize;                      // 网格边长（度）
+    QHash<quint64, QVector<int>> m_cells;
+    int m_indexed;                          // 已加入索引的点数
+};
+
+#endif // TRACKGRID_H
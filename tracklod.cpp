@@ -0,0 +1,213 @@
+#include "tracklod.h"
+#include <QtGlobal>
+#include <algorithm>
+
+// 每个桶包含的点数，抽稀后最多保留4个极值点
+static const int kBucketSize = 32;
+
+TrackLod::TrackLod()
+{
+    clear();
+}
+
+void TrackLod::clear()
+{
+    m_levels.clear();
+    m_flushed.clear();
+    m_levels.append(QVector<QPointF>());
+    m_flushed.append(0);
+    m_bounds = QRectF();
+    m_grid.clear();
+}
+
+void TrackLod::reserve(int size)
+{
+    m_levels[0].reserve(size);
+}
+
+void TrackLod::append(const QPointF &point)
+{
+    if (m_levels[0].isEmpty()) {
+        m_bounds = QRectF(point, QSizeF(0.0, 0.0));
+    } else {
+        m_bounds.setLeft(qMin(m_bounds.left(), point.x()));
+        m_bounds.setRight(qMax(m_bounds.right(), point.x()));
+        m_bounds.setTop(qMin(m_bounds.top(), point.y()));
+        m_bounds.setBottom(qMax(m_bounds.bottom(), point.y()));
+    }
+
+    appendToLevel(0, point);
+    m_grid.append(m_levels[0]);
+}
+
+void TrackLod::appendToLevel(int level, const QPointF &point)
+{
+    m_levels[level].append(point);
+    if (m_levels[level].size() - m_flushed[level] < kBucketSize) {
+        return;
+    }
+
+    // 桶已满：找出经度、纬度的极值点，按原顺序写入上一层
+    const int first = m_flushed[level];
+    const QPointF *bucket = m_levels[level].constData() + first;
+    int indices[4] = {0, 0, 0, 0};
+    for (int i = 1; i < kBucketSize; ++i) {
+        if (bucket[i].x() < bucket[indices[0]].x()) indices[0] = i;
+        if (bucket[i].x() > bucket[indices[1]].x()) indices[1] = i;
+        if (bucket[i].y() < bucket[indices[2]].y()) indices[2] = i;
+        if (bucket[i].y() > bucket[indices[3]].y()) indices[3] = i;
+    }
+    std::sort(indices, indices + 4);
+    const int count = int(std::unique(indices, indices + 4) - indices);
+
+    m_flushed[level] += kBucketSize;
+    if (level + 1 == m_levels.size()) {
+        m_levels.append(QVector<QPointF>());
+        m_flushed.append(0);
+    }
+
+    // 先拷贝，递归追加可能导致当前层以外的容器重新分配
+    QPointF extremes[4];
+    for (int i = 0; i < count; ++i) {
+        extremes[i] = bucket[indices[i]];
+    }
+    for (int i = 0; i < count; ++i) {
+        appendToLevel(level + 1, extremes[i]);
+    }
+}
+
+template <typename Visitor>
+void TrackLod::visitLevel(int level, Visitor visit) const
+{
+    // 第k层的完整表示 = 第k层全部点 + 各更细层中尚未汇总的尾部（每层不足一个桶）
+    for (const QPointF &point : m_levels[level]) {
+        visit(point);
+    }
+    for (int finer = level - 1; finer >= 0; --finer) {
+        const QVector<QPointF> &points = m_levels[finer];
+        for (int i = m_flushed[finer]; i < points.size(); ++i) {
+            visit(points[i]);
+        }
+    }
+}
+
+template <typename Visitor>
+void TrackLod::visitVisibleRaw(const QRectF &viewport, Visitor visit) const
+{
+    // 只访问视口内的原始点，以及每段可见轨迹前后紧邻的视口外的点（保证折线连贯），
+    // 按原顺序传给 visit，与 visitLevel(0) 的可见部分结果相同
+    const QVector<QPointF> &points = m_levels[0];
+    const QVector<int> inside = m_grid.pointsInRect(points, viewport);
+    int lastVisited = -1;
+    for (int i = 0; i < inside.size(); ++i) {
+        const int index = inside[i];
+        if (index > 0 && index - 1 != lastVisited) {
+            visit(points[index - 1]);
+        }
+        visit(points[index]);
+        lastVisited = index;
+        const bool nextInside = i + 1 < inside.size() && inside[i + 1] == index + 1;
+        if (!nextInside && index + 1 < points.size()) {
+            visit(points[index + 1]);
+            lastVisited = index + 1;
+        }
+    }
+}
+
+int TrackLod::chooseLevel(const QRectF &viewport, int maxPoints) const
+{
+    if (size() <= maxPoints) {
+        return 0;
+    }
+
+    // 从最粗的一层开始统计视口内的点数，按层间比例估算更细一层的点数，
+    // 不超出预算就继续细化
+    int level = m_levels.size() - 1;
+    qint64 visible = 0;
+    visitLevel(level, [&visible, &viewport](const QPointF &point) {
+        if (viewport.contains(point)) {
+            ++visible;
+        }
+    });
+
+    while (level > 0) {
+        const double ratio = double(m_levels[level - 1].size()) / qMax(1, m_levels[level].size());
+        const double estimate = visible * ratio;
+        if (estimate > maxPoints) {
+            break;
+        }
+        visible = qint64(estimate);
+        --level;
+    }
+    return level;
+}
+
+QVector<QPointF> TrackLod::visiblePoints(const QRectF &viewport, const QSizeF &pixelSize, int maxPoints) const
+{
+    QVector<QPointF> result;
+    if (isEmpty() || viewport.width() <= 0.0 || viewport.height() <= 0.0) {
+        return result;
+    }
+
+    const int level = chooseLevel(viewport, maxPoints);
+    result.reserve(qMin(maxPoints * 2, m_levels[level].size() + kBucketSize * m_levels.size()));
+
+    const double scaleX = qMax(1.0, pixelSize.width()) / viewport.width();
+    const double scaleY = qMax(1.0, pixelSize.height()) / viewport.height();
+
+    QPointF previous;
+    bool hasPrevious = false;
+    bool previousInside = false;
+    bool previousEmitted = false;
+    qint64 lastPixelX = -1;
+    qint64 lastPixelY = -1;
+    bool hasLastPixel = false;
+
+    auto emitPoint = [&](const QPointF &point, bool inside) {
+        // 同一屏幕像素内的连续点只保留一个
+        if (inside) {
+            const qint64 pixelX = qint64((point.x() - viewport.left()) * scaleX);
+            const qint64 pixelY = qint64((point.y() - viewport.top()) * scaleY);
+            if (hasLastPixel && pixelX == lastPixelX && pixelY == lastPixelY) {
+                return;
+            }
+            lastPixelX = pixelX;
+            lastPixelY = pixelY;
+            hasLastPixel = true;
+        } else {
+            hasLastPixel = false;
+        }
+        result.append(point);
+    };
+
+    auto visitPoint = [&](const QPointF &point) {
+        const bool inside = viewport.contains(point);
+        bool emitted = false;
+        if (inside) {
+            // 从视口外进入：带上视口外的前一个点
+            if (hasPrevious && !previousInside && !previousEmitted) {
+                emitPoint(previous, false);
+            }
+            emitPoint(point, true);
+            emitted = true;
+        } else if (previousInside) {
+            // 离开视口：带上视口外的第一个点
+            emitPoint(point, false);
+            emitted = true;
+        }
+
+        previous = point;
+        hasPrevious = true;
+        previousInside = inside;
+        previousEmitted = emitted;
+    };
+
+    // 最细一层用网格索引只取视口附近的点，其余层点数已经很少，直接遍历
+    if (level == 0) {
+        visitVisibleRaw(viewport, visitPoint);
+    } else {
+        visitLevel(level, visitPoint);
+    }
+
+    return result;
+}
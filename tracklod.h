@@ -0,0 +1,51 @@
+#ifndef TRACKLOD_H
+#define TRACKLOD_H
+
+#include <QVector>
+#include <QPointF>
+#include <QRectF>
+#include <QSizeF>
+#include "trackgrid.h"
+
+// 多分辨率轨迹存储。
+// 第0层保存全部原始点；第k层由第k-1层按每32个点一个桶做最小/最大抽稀得到
+// （保留桶内经度、纬度取极值的点，每桶最多4个），每层点数约为下一层的1/8。
+// 追加为均摊 O(1)；绘制时按视口和屏幕分辨率选择合适的层，只取可见的点。
+// 第0层另有网格索引：放大到可以显示原始点时，只访问视口内的点，不扫描整条轨迹。
+class TrackLod
+{
+public:
+    TrackLod();
+
+    void clear();
+    void append(const QPointF &point);
+    void reserve(int size);
+
+    int size() const { return m_levels.isEmpty() ? 0 : m_levels[0].size(); }
+    bool isEmpty() const { return size() == 0; }
+    int levelCount() const { return m_levels.size(); }
+    QRectF bounds() const { return m_bounds; }
+
+    // 提取视口内的点：先按预算选择层级，再按屏幕像素去掉重复点。
+    // 跨越视口边界的线段会带上视口外的那个端点，保证折线连贯。
+    QVector<QPointF> visiblePoints(const QRectF &viewport, const QSizeF &pixelSize, int maxPoints) const;
+
+    // 原始点（第0层）与其网格索引，供矩形/半径查询使用
+    const QVector<QPointF> &points() const { return m_levels[0]; }
+    const TrackGrid &grid() const { return m_grid; }
+
+private:
+    void appendToLevel(int level, const QPointF &point);
+    int chooseLevel(const QRectF &viewport, int maxPoints) const;
+    template <typename Visitor>
+    void visitLevel(int level, Visitor visit) const;
+    template <typename Visitor>
+    void visitVisibleRaw(const QRectF &viewport, Visitor visit) const;
+
+    QVector<QVector<QPointF>> m_levels;
+    QVector<int> m_flushed;    // 每层已汇总到上一层的点数
+    QRectF m_bounds;
+    TrackGrid m_grid;
+};
+
+#endif // TRACKLOD_H
@@ -0,0 +1,70 @@
+#include "viewhub.h"
+#include <QWidget>
+#include <QEvent>
+
+ViewHub::ViewHub(QObject *parent)
+    : QObject(parent)
+    , m_hasData(false)
+{
+}
+
+void ViewHub::subscribe(QWidget *view, DeliverFunction deliver)
+{
+    Subscriber subscriber;
+    subscriber.view = view;
+    subscriber.deliver = std::move(deliver);
+    subscriber.stale = false;
+    m_subscribers.append(subscriber);
+
+    // 监听显示和尺寸变化，视图重新可见时补上错过的更新
+    view->installEventFilter(this);
+    connect(view, &QObject::destroyed, this, [this, view]() {
+        for (int i = 0; i < m_subscribers.size(); ++i) {
+            if (m_subscribers[i].view == view) {
+                m_subscribers.remove(i);
+                break;
+            }
+        }
+    });
+}
+
+void ViewHub::publish(const SatelliteData &data)
+{
+    m_latest = data;
+    m_hasData = true;
+
+    for (Subscriber &subscriber : m_subscribers) {
+        if (isViewActive(subscriber.view)) {
+            subscriber.stale = false;
+            subscriber.deliver(m_latest);
+        } else {
+            subscriber.stale = true;
+        }
+    }
+}
+
+bool ViewHub::isViewActive(const QWidget *view)
+{
+    return view->isVisible() && !view->size().isEmpty();
+}
+
+void ViewHub::refreshIfStale(Subscriber &subscriber)
+{
+    if (subscriber.stale && m_hasData && isViewActive(subscriber.view)) {
+        subscriber.stale = false;
+        subscriber.deliver(m_latest);
+    }
+}
+
+bool ViewHub::eventFilter(QObject *watched, QEvent *event)
+{
+    if (event->type() == QEvent::Show || event->type() == QEvent::Resize) {
+        for (Subscriber &subscriber : m_subscribers) {
+            if (subscriber.view == watched) {
+                refreshIfStale(subscriber);
+                break;
+            }
+        }
+    }
+    return QObject::eventFilter(watched, event);
+}
@@ -0,0 +1,52 @@
+#ifndef VIEWHUB_H
+#define VIEWHUB_H
+
+#include <QObject>
+#include <QVector>
+#include <functional>
+#include "satellitedata.h"
+
+class QWidget;
+
+// 视图订阅中心：MainWindow 只向这里发布最新数据快照。
+// 可见的视图立即刷新；隐藏、折叠为零尺寸或位于后台标签页的视图
+// 只标记为过期，等重新可见时再取一次最新快照，期间不做任何绘制工作。
+class ViewHub : public QObject
+{
+    Q_OBJECT
+
+public:
+    using DeliverFunction = std::function<void(const SatelliteData &)>;
+
+    explicit ViewHub(QObject *parent = nullptr);
+
+    // 注册视图，deliver 在视图需要刷新时被调用
+    void subscribe(QWidget *view, DeliverFunction deliver);
+
+    // 发布最新快照
+    void publish(const SatelliteData &data);
+
+    const SatelliteData &latest() const { return m_latest; }
+    bool hasData() const { return m_hasData; }
+
+    // 视图是否真正可见（可见且尺寸非零）
+    static bool isViewActive(const QWidget *view);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    struct Subscriber {
+        QWidget *view;
+        DeliverFunction deliver;
+        bool stale;
+    };
+
+    void refreshIfStale(Subscriber &subscriber);
+
+    QVector<Subscriber> m_subscribers;
+    SatelliteData m_latest;
+    bool m_hasData;
+};
+
+#endif // VIEWHUB_H
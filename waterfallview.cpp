@@ -0,0 +1,370 @@
+#include "waterfallview.h"
+#include "viewhub.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+#include <QLabel>
+#include <QTime>
+#include <QDebug>
+#include <cstring>
+#include <cmath>
+
+// 24 小时 @ 1Hz
+static const int kHistoryColumns = 24 * 3600;
+// 行数上限（150 颗左右的卫星再留些余量）
+static const int kMaxRows = 256;
+// 色标上限 (dB-Hz)
+static const int kScaleMaxSnr = 60;
+
+// 没有数据（卫星不可见）时的颜色和像素值
+static const QRgb kNoDataColor = qRgb(245, 245, 245);
+static const uchar kNoDataIndex = 255;
+
+// 绘图区边距
+static const int kTopMargin = 44;
+static const int kLeftMargin = 48;
+static const int kRightMargin = 56;
+static const int kBottomMargin = 24;
+
+WaterfallView::WaterfallView(QWidget *parent)
+    : QWidget(parent)
+    , m_columnCapacity(kHistoryColumns)
+    , m_epochCount(0)
+    , m_epochSeconds(kHistoryColumns, -1)
+    , m_spanCombo(nullptr)
+    , m_secondsPerPixel(1)
+{
+    setWindowTitle("🌊 信噪比瀑布图");
+    setMinimumSize(400, 300);
+
+    setAttribute(Qt::WA_OpaquePaintEvent, true);
+
+    m_labelFont = font();
+    m_labelFont.setPointSize(8);
+    m_titleFont = font();
+    m_titleFont.setPointSize(11);
+    m_titleFont.setBold(true);
+
+    setupColorTable();
+    setupUI();
+}
+
+void WaterfallView::setupUI()
+{
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(8, 6, 8, 6);
+
+    QHBoxLayout *topLayout = new QHBoxLayout();
+    QLabel *titleLabel = new QLabel("信噪比瀑布图 (每行一颗卫星，颜色为 C/N0)", this);
+    titleLabel->setFont(m_titleFont);
+    topLayout->addWidget(titleLabel);
+    topLayout->addStretch();
+
+    topLayout->addWidget(new QLabel("时间跨度:", this));
+    m_spanCombo = new QComboBox(this);
+    // 数据为每像素对应的秒数
+    m_spanCombo->addItem("1 秒/像素", 1);
+    m_spanCombo->addItem("5 秒/像素", 5);
+    m_spanCombo->addItem("30 秒/像素", 30);
+    m_spanCombo->addItem("120 秒/像素 (24小时)", 120);
+    topLayout->addWidget(m_spanCombo);
+    connect(m_spanCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &WaterfallView::onSpanChanged);
+
+    mainLayout->addLayout(topLayout);
+    mainLayout->addStretch();
+}
+
+void WaterfallView::setupColorTable()
+{
+    // 0 dB：已跟踪但无信噪比；1~60 dB：蓝 -> 青 -> 绿 -> 黄 -> 红
+    struct Stop { double pos; int r, g, b; };
+    static const Stop stops[] = {
+        {0.00,  20,  20, 140},
+        {0.25,   0, 110, 255},
+        {0.50,   0, 200, 100},
+        {0.75, 255, 220,   0},
+        {1.00, 220,  20,  20}
+    };
+    const int stopCount = int(sizeof(stops) / sizeof(stops[0]));
+
+    m_colorTable.resize(256);
+    m_colorTable[0] = qRgb(90, 90, 90);
+    for (int snr = 1; snr < kNoDataIndex; ++snr) {
+        const double t = qBound(0.0, double(snr - 1) / (kScaleMaxSnr - 1), 1.0);
+        int i = 0;
+        while (i < stopCount - 2 && t > stops[i + 1].pos) {
+            ++i;
+        }
+        const double f = (t - stops[i].pos) / (stops[i + 1].pos - stops[i].pos);
+        m_colorTable[snr] = qRgb(int(stops[i].r + (stops[i + 1].r - stops[i].r) * f),
+                                 int(stops[i].g + (stops[i + 1].g - stops[i].g) * f),
+                                 int(stops[i].b + (stops[i + 1].b - stops[i].b) * f));
+    }
+    m_colorTable[kNoDataIndex] = kNoDataColor;
+}
+
+void WaterfallView::recordEpoch(const SatelliteData &data)
+{
+    // 先确定本历元每一行的值（可能插入新行）
+    for (const SatelliteInfo &satellite : data.satellites) {
+        if (satellite.id > 0) {
+            rowFor(qMakePair(satellite.system, satellite.id));
+        }
+    }
+
+    m_columnValues.fill(-1, m_rows.size());
+    for (const SatelliteInfo &satellite : data.satellites) {
+        const auto it = m_rowIndex.constFind(qMakePair(satellite.system, satellite.id));
+        if (it != m_rowIndex.constEnd()) {
+            m_columnValues[it.value()] = qBound(0, satellite.snr, kNoDataIndex - 1);
+        }
+    }
+
+    // 写入一列像素：环形图像中的当前列，每行一个字节
+    const int column = int(m_epochCount % m_columnCapacity);
+    if (!m_rows.isEmpty()) {
+        uchar *bits = m_image.bits();
+        const int stride = m_image.bytesPerLine();
+        for (int row = 0; row < m_rows.size(); ++row) {
+            const int value = m_columnValues[row];
+            bits[row * stride + column] = value < 0 ? kNoDataIndex : uchar(value);
+        }
+    }
+
+    const QTime time = QTime::fromString(data.time, "hh:mm:ss");
+    m_epochSeconds[column] = time.isValid() ? time.msecsSinceStartOfDay() / 1000 : -1;
+    ++m_epochCount;
+
+    // 只有可见时才重绘，隐藏时只记录
+    if (ViewHub::isViewActive(this)) {
+        update();
+    }
+}
+
+int WaterfallView::rowFor(const PrnKey &key)
+{
+    const auto it = m_rowIndex.constFind(key);
+    if (it != m_rowIndex.constEnd()) {
+        return it.value();
+    }
+    if (m_rows.size() >= kMaxRows) {
+        return -1;
+    }
+
+    // 按系统、PRN 排序找到插入位置
+    int insertAt = m_rows.size();
+    for (int i = 0; i < m_rows.size(); ++i) {
+        const int order = systemOrder(m_rows[i].first);
+        const int keyOrder = systemOrder(key.first);
+        if (keyOrder < order || (keyOrder == order && (key.first < m_rows[i].first
+            || (key.first == m_rows[i].first && key.second < m_rows[i].second)))) {
+            insertAt = i;
+            break;
+        }
+    }
+
+    ensureRowCapacity(m_rows.size() + 1);
+    if (m_image.height() <= m_rows.size()) {
+        return -1;
+    }
+
+    // 插入行：把后面的像素行整体下移一行（新卫星出现时才发生，很少见）
+    const int stride = m_image.bytesPerLine();
+    uchar *bits = m_image.bits();
+    const int movedRows = m_rows.size() - insertAt;
+    if (movedRows > 0) {
+        memmove(bits + (insertAt + 1) * stride, bits + insertAt * stride, size_t(movedRows) * stride);
+    }
+    memset(bits + insertAt * stride, kNoDataIndex, size_t(m_columnCapacity));
+
+    m_rows.insert(insertAt, key);
+    m_rowIndex.clear();
+    for (int i = 0; i < m_rows.size(); ++i) {
+        m_rowIndex.insert(m_rows[i], i);
+    }
+    return insertAt;
+}
+
+void WaterfallView::ensureRowCapacity(int rows)
+{
+    if (!m_image.isNull() && m_image.height() >= rows) {
+        return;
+    }
+
+    // 行容量按倍数增长，减少重新分配
+    int capacity = m_image.isNull() ? 32 : m_image.height();
+    while (capacity < rows) {
+        capacity *= 2;
+    }
+    capacity = qMin(capacity, kMaxRows);
+
+    QImage image(m_columnCapacity, capacity, QImage::Format_Indexed8);
+    if (image.isNull()) {
+        qDebug() << "瀑布图图像分配失败:" << m_columnCapacity << "x" << capacity;
+        return;
+    }
+    image.setColorTable(m_colorTable);
+    image.fill(uint(kNoDataIndex));
+    if (!m_image.isNull()) {
+        memcpy(image.bits(), m_image.constBits(), size_t(m_image.bytesPerLine()) * m_rows.size());
+    }
+    m_image = image;
+}
+
+void WaterfallView::clearHistory()
+{
+    m_image = QImage();
+    m_rows.clear();
+    m_rowIndex.clear();
+    m_epochSeconds.fill(-1);
+    m_epochCount = 0;
+    update();
+}
+
+void WaterfallView::onSpanChanged(int index)
+{
+    m_secondsPerPixel = qMax(1, m_spanCombo->itemData(index).toInt());
+    update();
+}
+
+void WaterfallView::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    layoutPlot();
+}
+
+void WaterfallView::layoutPlot()
+{
+    m_plotRect = rect().adjusted(kLeftMargin, kTopMargin, -kRightMargin, -kBottomMargin);
+}
+
+void WaterfallView::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event)
+
+    QPainter painter(this);
+    painter.fillRect(rect(), Qt::white);
+
+    if (m_plotRect.width() <= 0 || m_plotRect.height() <= 0) {
+        return;
+    }
+
+    painter.fillRect(m_plotRect, QColor(kNoDataColor));
+
+    if (m_rows.isEmpty() || m_epochCount == 0) {
+        painter.setPen(QColor(127, 140, 141));
+        painter.setFont(m_titleFont);
+        painter.drawText(m_plotRect, Qt::AlignCenter, "等待卫星数据...");
+        drawColorScale(painter);
+        return;
+    }
+
+    // 可见的历元数：最新的在右侧
+    const qint64 stored = qMin<qint64>(m_epochCount, m_columnCapacity);
+    const int visibleColumns = int(qMin<qint64>(stored, qint64(m_plotRect.width()) * m_secondsPerPixel));
+    const int first = int((m_epochCount - visibleColumns) % m_columnCapacity);
+    const double pixelsPerColumn = 1.0 / m_secondsPerPixel;
+    const double left = m_plotRect.right() + 1 - visibleColumns * pixelsPerColumn;
+
+    // 环形图像最多分两段贴图，不做平滑插值，保持每个历元的颜色
+    const int firstLength = qMin(visibleColumns, m_columnCapacity - first);
+    const QRectF target1(left, m_plotRect.top(), firstLength * pixelsPerColumn, m_plotRect.height());
+    painter.drawImage(target1, m_image, QRectF(first, 0, firstLength, m_rows.size()));
+    if (firstLength < visibleColumns) {
+        const int secondLength = visibleColumns - firstLength;
+        const QRectF target2(target1.right(), m_plotRect.top(), secondLength * pixelsPerColumn, m_plotRect.height());
+        painter.drawImage(target2, m_image, QRectF(0, 0, secondLength, m_rows.size()));
+    }
+
+    painter.setPen(QColor(189, 195, 199));
+    painter.drawRect(m_plotRect.adjusted(0, 0, -1, -1));
+
+    drawRowLabels(painter);
+    drawTimeAxis(painter, visibleColumns);
+    drawColorScale(painter);
+}
+
+void WaterfallView::drawRowLabels(QPainter &painter)
+{
+    const double rowHeight = double(m_plotRect.height()) / m_rows.size();
+    // 行太密时隔行标注
+    const int step = qMax(1, int(std::ceil(11.0 / rowHeight)));
+
+    painter.setFont(m_labelFont);
+    painter.setPen(QColor(44, 62, 80));
+    for (int row = 0; row < m_rows.size(); row += step) {
+        const QRectF labelRect(0, m_plotRect.top() + row * rowHeight, kLeftMargin - 4, qMax(rowHeight, 11.0));
+        painter.drawText(labelRect, Qt::AlignRight | Qt::AlignVCenter, prnLabel(m_rows[row]));
+    }
+}
+
+void WaterfallView::drawTimeAxis(QPainter &painter, int visibleColumns)
+{
+    painter.setFont(m_labelFont);
+    painter.setPen(QColor(44, 62, 80));
+
+    // 约每 100 像素一个时间标签，从最新一列往左
+    const int labelSpacing = 100;
+    for (int offset = 0; offset < visibleColumns / m_secondsPerPixel; offset += labelSpacing) {
+        const qint64 sequence = m_epochCount - 1 - qint64(offset) * m_secondsPerPixel;
+        const int seconds = m_epochSeconds[int(sequence % m_columnCapacity)];
+        if (seconds < 0) {
+            continue;
+        }
+
+        const int x = m_plotRect.right() - offset;
+        painter.drawLine(x, m_plotRect.bottom() + 1, x, m_plotRect.bottom() + 4);
+        const QString text = QTime(0, 0).addSecs(seconds).toString("hh:mm:ss");
+        painter.drawText(QRect(x - 40, m_plotRect.bottom() + 4, 80, kBottomMargin - 4), Qt::AlignCenter, text);
+    }
+}
+
+void WaterfallView::drawColorScale(QPainter &painter)
+{
+    const QRect scaleRect(m_plotRect.right() + 10, m_plotRect.top(), 12, m_plotRect.height());
+    if (scaleRect.height() <= 0) {
+        return;
+    }
+
+    // 直接用查找表画色标
+    for (int y = 0; y < scaleRect.height(); ++y) {
+        const int snr = kScaleMaxSnr - y * kScaleMaxSnr / scaleRect.height();
+        painter.setPen(QColor(m_colorTable[qBound(0, snr, kNoDataIndex - 1)]));
+        painter.drawLine(scaleRect.left(), scaleRect.top() + y, scaleRect.right(), scaleRect.top() + y);
+    }
+    painter.setPen(QColor(189, 195, 199));
+    painter.drawRect(scaleRect.adjusted(0, 0, -1, -1));
+
+    painter.setFont(m_labelFont);
+    painter.setPen(QColor(44, 62, 80));
+    for (int snr = 0; snr <= kScaleMaxSnr; snr += 20) {
+        const int y = scaleRect.bottom() - snr * scaleRect.height() / kScaleMaxSnr;
+        painter.drawText(QRect(scaleRect.right() + 3, y - 6, 30, 12), Qt::AlignLeft | Qt::AlignVCenter,
+                         QString::number(snr));
+    }
+}
+
+QString WaterfallView::prnLabel(const PrnKey &key)
+{
+    // RINEX 风格的系统前缀
+    QString prefix;
+    if (key.first == "GPS") prefix = "G";
+    else if (key.first == "BDS") prefix = "C";
+    else if (key.first == "GLN") prefix = "R";
+    else if (key.first == "GAL") prefix = "E";
+    else if (key.first == "QZSS") prefix = "J";
+    else if (key.first == "SBAS") prefix = "S";
+    else if (key.first == "NavIC") prefix = "I";
+    else prefix = key.first.left(1);
+    return prefix + QString("%1").arg(key.second, 2, 10, QChar('0'));
+}
+
+int WaterfallView::systemOrder(const QString &system)
+{
+    // 与 SNRView 的面板顺序保持一致
+    static const QStringList order = {"GPS", "BDS", "GLN", "GAL", "QZSS", "SBAS", "NavIC"};
+    const int index = order.indexOf(system);
+    return index < 0 ? order.size() : index;
+}
@@ -0,0 +1,72 @@
+#ifndef WATERFALLVIEW_H
+#define WATERFALLVIEW_H
+
+#include <QWidget>
+#include <QImage>
+#include <QVector>
+#include <QHash>
+#include <QRgb>
+#include <QPair>
+#include <QFont>
+#include <QComboBox>
+#include "satellitedata.h"
+
+// 信噪比瀑布图：每行一颗卫星（PRN），每列一个历元，颜色表示信噪比。
+// 历史数据直接保存在一张环形 8 位索引色 QImage 中（每个历元一列像素，像素值为信噪比），
+// 颜色由图像的颜色表给出，24 小时 × 256 行约 22 MB（32 位颜色需要约 88 MB）。
+// 新历元只写入一列字节，绘制时最多两次贴图，历史数据不会重新计算。默认保存 24 小时（1Hz）的历元。
+class WaterfallView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit WaterfallView(QWidget *parent = nullptr);
+
+    // 每个完整的历元调用一次（视图隐藏时也记录），写入一列
+    void recordEpoch(const SatelliteData &data);
+    void clearHistory();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private slots:
+    void onSpanChanged(int index);
+
+private:
+    typedef QPair<QString, int> PrnKey;
+
+    void setupUI();
+    void setupColorTable();
+    int rowFor(const PrnKey &key);
+    void ensureRowCapacity(int rows);
+    void layoutPlot();
+
+    void drawRowLabels(QPainter &painter);
+    void drawTimeAxis(QPainter &painter, int visibleColumns);
+    void drawColorScale(QPainter &painter);
+
+    static QString prnLabel(const PrnKey &key);
+    static int systemOrder(const QString &system);
+
+    // 环形图像：宽度为历元容量，高度为行容量（按需扩展）
+    QImage m_image;
+    QVector<QRgb> m_colorTable;    // 索引 0~254 为信噪比 (dB-Hz)，255 为无数据
+    int m_columnCapacity;
+    qint64 m_epochCount;           // 累计写入的历元数
+    QVector<int> m_epochSeconds;   // 每列对应的 UTC 秒（当天），-1 表示未知
+
+    // PRN 行（按系统、PRN 排序）
+    QVector<PrnKey> m_rows;
+    QHash<PrnKey, int> m_rowIndex;
+    QVector<int> m_columnValues;   // 写入一列时的临时缓冲
+
+    // 显示
+    QComboBox *m_spanCombo;
+    int m_secondsPerPixel;
+    QRect m_plotRect;
+    QFont m_labelFont;
+    QFont m_titleFont;
+};
+
+#endif // WATERFALLVIEW_H